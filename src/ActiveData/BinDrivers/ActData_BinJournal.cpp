@@ -0,0 +1,841 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <ActData_BinJournal.h>
+
+// Active Data includes
+#include <ActData_BinDrivers.h>
+#include <ActData_MeshAttr.h>
+#include <ActData_MeshMDelta.h>
+
+// OCCT includes
+#include <BinDrivers.hxx>
+#include <BinMDF_ADriver.hxx>
+#include <BinMDF_ADriverTable.hxx>
+#include <BinMNaming_NamedShapeDriver.hxx>
+#include <BinObjMgt_Persistent.hxx>
+#include <BinObjMgt_RRelocationTable.hxx>
+#include <BinObjMgt_SRelocationTable.hxx>
+#include <Message.hxx>
+#include <NCollection_DataMap.hxx>
+#include <NCollection_Map.hxx>
+#include <OSD_File.hxx>
+#include <OSD_Path.hxx>
+#include <Standard_GUID.hxx>
+#include <TColStd_SequenceOfAsciiString.hxx>
+#include <TDataStd_BooleanList.hxx>
+#include <TDataStd_ExtStringList.hxx>
+#include <TDataStd_IntegerList.hxx>
+#include <TDataStd_RealList.hxx>
+#include <TDataStd_ReferenceList.hxx>
+#include <TDataStd_TreeNode.hxx>
+#include <TDF_AttributeDelta.hxx>
+#include <TDF_ListIteratorOfAttributeDeltaList.hxx>
+#include <TDF_Tool.hxx>
+#include <TNaming_NamedShape.hxx>
+
+// Standard includes
+#include <cstring>
+#include <sstream>
+
+#undef COUT_DEBUG
+
+//-----------------------------------------------------------------------------
+// Binary format
+//-----------------------------------------------------------------------------
+
+//! Signature of the journal file. The last character is the format version.
+#define JOURNAL_SIGNATURE "ADJ2"
+#define JOURNAL_SIGNATURE_SIZE 4
+
+//! Tag opening each record.
+#define JOURNAL_RECORD_TAG 0x52444A41
+
+//! Size of the record header: tag, payload size and checksum.
+#define JOURNAL_RECORD_HEADER_SIZE 12
+
+namespace
+{
+  //! Attribute touched by a transaction.
+  struct t_touched
+  {
+    TDF_Label     label;      //!< Label of the attribute.
+    Standard_GUID id;         //!< ID of the attribute.
+    Standard_Boolean isDelta; //!< Whether only the mesh deltas are recorded.
+    NCollection_Sequence<Handle(ActData_MeshMDelta)> meshDeltas; //!< Mesh deltas.
+
+    t_touched() : isDelta(Standard_True) {}
+  };
+
+  //! FNV-1a checksum of the given bytes.
+  unsigned int checksum(const char* theData, const size_t theSize)
+  {
+    unsigned int hash = 2166136261u;
+    for ( size_t i = 0; i < theSize; ++i )
+    {
+      hash ^= (unsigned char) theData[i];
+      hash *= 16777619u;
+    }
+    return hash;
+  }
+
+  void putInt(std::ostream& theOut, const int theVal)
+  {
+    theOut.write( (const char*) &theVal, sizeof(int) );
+  }
+
+  Standard_Boolean getInt(std::istream& theIn, int& theVal)
+  {
+    theIn.read( (char*) &theVal, sizeof(int) );
+    return theIn.good();
+  }
+
+  void putString(std::ostream& theOut, const std::string& theStr)
+  {
+    putInt( theOut, (int) theStr.size() );
+    theOut.write( theStr.data(), theStr.size() );
+  }
+
+  Standard_Boolean getString(std::istream& theIn, std::string& theStr)
+  {
+    int len = 0;
+    if ( !getInt(theIn, len) || len < 0 )
+      return Standard_False;
+
+    theStr.resize(len);
+    if ( len )
+      theIn.read( &theStr[0], len );
+
+    return theIn.good();
+  }
+
+  void putString(std::ostream& theOut, const TCollection_AsciiString& theStr)
+  {
+    putString( theOut, std::string( theStr.ToCString() ) );
+  }
+
+  void putGUID(std::ostream& theOut, const Standard_GUID& theGUID)
+  {
+    char buff[Standard_GUID_SIZE_ALLOC];
+    Standard_PCharacter pBuff = buff;
+    theGUID.ToCString(pBuff);
+    putString( theOut, std::string(buff) );
+  }
+
+  void putEntry(std::ostream& theOut, const TDF_Label& theLab)
+  {
+    TCollection_AsciiString entry;
+    TDF_Tool::Entry(theLab, entry);
+    putString(theOut, entry);
+  }
+
+  //! Splits the journal contents into the valid records.
+  //! \param[in]  theBuff    journal contents.
+  //! \param[out] theRecords offsets of the record payloads.
+  //! \param[out] theSizes   sizes of the record payloads.
+  //! \return size of the valid prefix of the journal.
+  size_t scanRecords(const std::string&                  theBuff,
+                     NCollection_Sequence<size_t>&       theRecords,
+                     NCollection_Sequence<unsigned int>& theSizes)
+  {
+    size_t pos = JOURNAL_SIGNATURE_SIZE;
+    while ( pos + JOURNAL_RECORD_HEADER_SIZE <= theBuff.size() )
+    {
+      int          tag  = 0;
+      unsigned int size = 0, sum = 0;
+      memcpy( &tag,  theBuff.data() + pos,     4 );
+      memcpy( &size, theBuff.data() + pos + 4, 4 );
+      memcpy( &sum,  theBuff.data() + pos + 8, 4 );
+
+      const size_t payload = pos + JOURNAL_RECORD_HEADER_SIZE;
+      if ( tag != JOURNAL_RECORD_TAG || payload + size > theBuff.size() )
+        break; // Torn record
+
+      if ( checksum(theBuff.data() + payload, size) != sum )
+        break; // Corrupted record
+
+      theRecords.Append(payload);
+      theSizes.Append(size);
+      pos = payload + size;
+    }
+    return pos;
+  }
+
+  //! Reads the whole file into memory.
+  Standard_Boolean readFile(const TCollection_AsciiString& theFilename,
+                            std::string&                   theBuff)
+  {
+    std::ifstream FILE( theFilename.ToCString(), std::ios::in | std::ios::binary );
+    if ( !FILE.is_open() )
+      return Standard_False;
+
+    std::ostringstream content;
+    content << FILE.rdbuf();
+    theBuff = content.str();
+    return Standard_True;
+  }
+
+  //! Checks whether the persistent driver of the given attribute appends
+  //! the persistent items to the target instead of replacing its contents.
+  Standard_Boolean isPastedByAppending(const Handle(TDF_Attribute)& theAttr)
+  {
+    return theAttr->IsKind( STANDARD_TYPE(TDataStd_BooleanList) )   ||
+           theAttr->IsKind( STANDARD_TYPE(TDataStd_ExtStringList) ) ||
+           theAttr->IsKind( STANDARD_TYPE(TDataStd_IntegerList) )   ||
+           theAttr->IsKind( STANDARD_TYPE(TDataStd_RealList) )      ||
+           theAttr->IsKind( STANDARD_TYPE(TDataStd_ReferenceList) );
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Construction & destruction
+//-----------------------------------------------------------------------------
+
+//! Constructor.
+//! \param[in] theFilename name of the journal file.
+ActData_BinJournal::ActData_BinJournal(const TCollection_AsciiString& theFilename)
+: Standard_Transient (),
+  m_filename         (theFilename),
+  m_iSize            (0),
+  m_iNbRecords       (0)
+{
+  // The same drivers as for the full binary save
+  m_drivers = BinDrivers::AttributeDrivers( Message::DefaultMessenger() );
+  ActData_BinDrivers::AddDrivers( m_drivers, Message::DefaultMessenger() );
+}
+
+//! Destructor.
+ActData_BinJournal::~ActData_BinJournal()
+{
+  this->Close();
+}
+
+//-----------------------------------------------------------------------------
+// File management
+//-----------------------------------------------------------------------------
+
+//! Opens the journal file for appending. A missing file is created. If
+//! the file ends with a torn record, the torn tail is cut off, so that the
+//! records appended from now on remain reachable by replay.
+//! \return true in case of success, false -- otherwise.
+Standard_Boolean ActData_BinJournal::Open()
+{
+  this->Close();
+
+  std::string buff;
+  NCollection_Sequence<size_t>       records;
+  NCollection_Sequence<unsigned int> sizes;
+  //
+  const Standard_Boolean isValid = readFile(m_filename, buff)
+                                && buff.size() >= JOURNAL_SIGNATURE_SIZE
+                                && buff.compare(0, JOURNAL_SIGNATURE_SIZE, JOURNAL_SIGNATURE) == 0;
+
+  if ( !isValid )
+    return this->Truncate();
+
+  const size_t validSize = scanRecords(buff, records, sizes);
+  //
+  if ( validSize < buff.size() )
+  {
+    // Rewrite the valid prefix
+    std::ofstream FILE( m_filename.ToCString(), std::ios::out | std::ios::binary | std::ios::trunc );
+    if ( !FILE.is_open() )
+      return Standard_False;
+
+    FILE.write( buff.data(), validSize );
+  }
+
+  m_out.open( m_filename.ToCString(), std::ios::out | std::ios::binary | std::ios::app );
+  if ( !m_out.is_open() )
+    return Standard_False;
+
+  m_iSize      = validSize;
+  m_iNbRecords = records.Length();
+  return Standard_True;
+}
+
+//! Closes the journal file.
+void ActData_BinJournal::Close()
+{
+  if ( m_out.is_open() )
+    m_out.close();
+}
+
+//! Empties the journal and keeps it open for appending. This is done once
+//! the Document is fully saved, so that the journal starts over from the
+//! new full save.
+//! \return true in case of success, false -- otherwise.
+Standard_Boolean ActData_BinJournal::Truncate()
+{
+  this->Close();
+
+  m_out.open( m_filename.ToCString(), std::ios::out | std::ios::binary | std::ios::trunc );
+  if ( !m_out.is_open() )
+    return Standard_False;
+
+  m_out.write(JOURNAL_SIGNATURE, JOURNAL_SIGNATURE_SIZE);
+  m_out.flush();
+
+  m_iSize      = JOURNAL_SIGNATURE_SIZE;
+  m_iNbRecords = 0;
+  return m_out.good();
+}
+
+//! Closes and deletes the journal file. This is done once the Document is
+//! closed normally, so that the journal found on opening indicates that the
+//! Document was not closed properly.
+//! \return true in case of success, false -- otherwise.
+Standard_Boolean ActData_BinJournal::Remove()
+{
+  this->Close();
+
+  m_iSize      = 0;
+  m_iNbRecords = 0;
+
+  OSD_Path path(m_filename);
+  OSD_File file(path);
+  //
+  if ( !file.Exists() )
+    return Standard_True;
+
+  file.Remove();
+  return !file.Failed();
+}
+
+//! Checks whether the journal file contains at least one valid record, i.e.
+//! whether there is anything to replay.
+//! \return true/false.
+Standard_Boolean ActData_BinJournal::HasRecords() const
+{
+  std::string buff;
+  if ( !readFile(m_filename, buff) )
+    return Standard_False;
+
+  if ( buff.size() < JOURNAL_SIGNATURE_SIZE ||
+       buff.compare(0, JOURNAL_SIGNATURE_SIZE, JOURNAL_SIGNATURE) != 0 )
+    return Standard_False;
+
+  NCollection_Sequence<size_t>       records;
+  NCollection_Sequence<unsigned int> sizes;
+  scanRecords(buff, records, sizes);
+
+  return !records.IsEmpty();
+}
+
+//-----------------------------------------------------------------------------
+// Writing
+//-----------------------------------------------------------------------------
+
+//! Appends one record for the passed deltas. The record stores the current
+//! state of every attribute touched by the deltas, so the deltas can be
+//! taken either from the Undo or from the Redo stack. Mesh Attributes are
+//! the exception: if a mesh was only modified, its Modification Deltas are
+//! recorded instead of the entire mesh. Such deltas are replayed as they
+//! are, therefore the passed deltas should follow in the order they have
+//! been applied to the Document.
+//!
+//! The record payload is composed of the following sections:
+//! - names of the attribute types;
+//! - attributes which do not exist anymore as {entry, GUID};
+//! - relocation table as {index, entry, GUID} to resolve the references
+//!   between attributes against the Document being replayed;
+//! - shape section of the Named Shapes;
+//! - attributes as {entry, GUID, persistent data};
+//! - modified meshes as {entry, GUID, compression tolerance, deltas}.
+//!
+//! \param[in] theDeltas deltas to record in the order of their application.
+//! \return true in case of success, false -- otherwise.
+Standard_Boolean
+  ActData_BinJournal::Append(const NCollection_Sequence<Handle(TDF_Delta)>& theDeltas)
+{
+  if ( !this->IsOpen() )
+    return Standard_False;
+
+  /* ==================================
+   *  Collect the touched attributes
+   * ================================== */
+
+  NCollection_Sequence<t_touched>         touched;
+  NCollection_DataMap<TCollection_AsciiString, Standard_Integer> visited;
+  TColStd_SequenceOfAsciiString           typeNames;
+  NCollection_Map<TCollection_AsciiString> typeNameSet;
+  //
+  for ( NCollection_Sequence<Handle(TDF_Delta)>::Iterator dit(theDeltas); dit.More(); dit.Next() )
+  {
+    if ( dit.Value().IsNull() )
+      continue;
+
+    for ( TDF_ListIteratorOfAttributeDeltaList ait( dit.Value()->AttributeDeltas() ); ait.More(); ait.Next() )
+    {
+      const Handle(TDF_AttributeDelta)& attrDelta = ait.Value();
+
+      char buff[Standard_GUID_SIZE_ALLOC];
+      Standard_PCharacter pBuff = buff;
+      attrDelta->ID().ToCString(pBuff);
+
+      TCollection_AsciiString key;
+      TDF_Tool::Entry(attrDelta->Label(), key);
+      key += "|";
+      key += buff;
+
+      // Mesh changes are collected from all deltas. If the Mesh Attribute
+      // has been added, removed or backed up in full, its state is recorded
+      Handle(ActData_MeshMDelta) meshDelta = Handle(ActData_MeshMDelta)::DownCast(attrDelta);
+      //
+      if ( visited.IsBound(key) )
+      {
+        t_touched& item = touched( visited.Find(key) );
+        //
+        if ( meshDelta.IsNull() )
+          item.isDelta = Standard_False;
+        else
+          item.meshDeltas.Append(meshDelta);
+
+        continue;
+      }
+
+      t_touched item;
+      item.label   = attrDelta->Label();
+      item.id      = attrDelta->ID();
+      item.isDelta = !meshDelta.IsNull();
+      //
+      if ( item.isDelta )
+        item.meshDeltas.Append(meshDelta);
+      //
+      touched.Append(item);
+      visited.Bind( key, touched.Length() );
+
+      // Type names are bound to drivers all at once
+      Handle(TDF_Attribute) attr;
+      if ( item.label.FindAttribute(item.id, attr) )
+      {
+        TCollection_AsciiString typeName( attr->DynamicType()->Name() );
+        if ( typeNameSet.Add(typeName) )
+          typeNames.Append(typeName);
+      }
+    }
+  }
+
+  if ( touched.IsEmpty() )
+    return Standard_True;
+
+  m_drivers->AssignIds(typeNames);
+
+  Handle(BinMDF_ADriver) nsDriverBase;
+  m_drivers->GetDriver(STANDARD_TYPE(TNaming_NamedShape), nsDriverBase);
+  Handle(BinMNaming_NamedShapeDriver)
+    nsDriver = Handle(BinMNaming_NamedShapeDriver)::DownCast(nsDriverBase);
+  //
+  if ( !nsDriver.IsNull() )
+    nsDriver->Clear();
+
+  /* ==============================
+   *  Serialize attributes
+   * ============================== */
+
+  std::ostringstream attrSection  (std::ios::out | std::ios::binary);
+  std::ostringstream removeSection(std::ios::out | std::ios::binary);
+  std::ostringstream meshSection  (std::ios::out | std::ios::binary);
+  BinObjMgt_SRelocationTable reloc;
+  int nbAttrs = 0, nbRemoved = 0, nbMeshes = 0;
+  //
+  for ( NCollection_Sequence<t_touched>::Iterator it(touched); it.More(); it.Next() )
+  {
+    const t_touched& item = it.Value();
+
+    Handle(TDF_Attribute) attr;
+    if ( !item.label.FindAttribute(item.id, attr) )
+    {
+      putEntry(removeSection, item.label);
+      putGUID(removeSection, item.id);
+      ++nbRemoved;
+      continue;
+    }
+
+    Handle(ActData_MeshAttr) meshAttr = Handle(ActData_MeshAttr)::DownCast(attr);
+    //
+    if ( item.isDelta && !meshAttr.IsNull() )
+    {
+      putEntry(meshSection, item.label);
+      putGUID(meshSection, item.id);
+      //
+      const Standard_Real tol = meshAttr->GetCompressionTolerance();
+      meshSection.write( (const char*) &tol, sizeof(Standard_Real) );
+      //
+      putInt( meshSection, item.meshDeltas.Length() );
+      for ( Standard_Integer d = 1; d <= item.meshDeltas.Length(); ++d )
+        item.meshDeltas(d)->Write(meshSection);
+
+      ++nbMeshes;
+      continue;
+    }
+
+    // Attributes without persistent drivers are not saved in full either
+    Handle(BinMDF_ADriver) driver;
+    const Standard_Integer typeId = m_drivers->GetDriver(attr->DynamicType(), driver);
+    //
+    if ( typeId <= 0 || driver.IsNull() )
+      continue;
+
+    BinObjMgt_Persistent pers;
+    pers.SetId( reloc.Add(attr) );
+    pers.SetTypeId(typeId);
+    driver->Paste(attr, pers, reloc);
+
+    putEntry(attrSection, item.label);
+    putGUID(attrSection, item.id);
+    pers.Write(attrSection);
+    ++nbAttrs;
+  }
+
+  // Relocation table is complete only after all attributes are pasted
+  std::ostringstream relocSection(std::ios::out | std::ios::binary);
+  int nbReloc = 0;
+  //
+  for ( Standard_Integer i = 1; i <= reloc.Extent(); ++i )
+  {
+    Handle(TDF_Attribute) attr = Handle(TDF_Attribute)::DownCast( reloc.FindKey(i) );
+    if ( attr.IsNull() || attr->Label().IsNull() )
+      continue;
+
+    putInt(relocSection, i);
+    putEntry(relocSection, attr->Label());
+    putGUID(relocSection, attr->ID());
+    ++nbReloc;
+  }
+
+  std::ostringstream shapeSection(std::ios::out | std::ios::binary);
+  if ( !nsDriver.IsNull() )
+    nsDriver->WriteShapeSection(shapeSection);
+
+  /* ==============================
+   *  Compose and flush the record
+   * ============================== */
+
+  std::ostringstream payload(std::ios::out | std::ios::binary);
+  //
+  putInt( payload, typeNames.Length() );
+  for ( Standard_Integer i = 1; i <= typeNames.Length(); ++i )
+    putString( payload, typeNames(i) );
+  //
+  putInt( payload, nbRemoved );
+  payload << removeSection.str();
+  //
+  putInt( payload, nbReloc );
+  payload << relocSection.str();
+  //
+  putString( payload, shapeSection.str() );
+  //
+  putInt( payload, nbAttrs );
+  payload << attrSection.str();
+  //
+  putInt( payload, nbMeshes );
+  payload << meshSection.str();
+
+  const std::string  data = payload.str();
+  const unsigned int size = (unsigned int) data.size();
+  const unsigned int sum  = checksum( data.data(), data.size() );
+  //
+  putInt( m_out, JOURNAL_RECORD_TAG );
+  m_out.write( (const char*) &size, 4 );
+  m_out.write( (const char*) &sum,  4 );
+  m_out.write( data.data(), data.size() );
+  m_out.flush();
+
+  if ( !m_out.good() )
+    return Standard_False;
+
+  m_iSize += JOURNAL_RECORD_HEADER_SIZE + data.size();
+  m_iNbRecords++;
+  return Standard_True;
+}
+
+//-----------------------------------------------------------------------------
+// Reading
+//-----------------------------------------------------------------------------
+
+//! Replays the journal over the passed Document which is normally opened
+//! from the last full save. The Document is modified directly, so the
+//! caller is responsible for disabling the transactional mode. Replay stops
+//! at the first torn or corrupted record.
+//! \param[in] theDoc Document to replay the journal over.
+//! \return number of replayed records.
+Standard_Integer
+  ActData_BinJournal::Replay(const Handle(TDocStd_Document)& theDoc)
+{
+  std::string buff;
+  if ( theDoc.IsNull() || !readFile(m_filename, buff) )
+    return 0;
+
+  if ( buff.size() < JOURNAL_SIGNATURE_SIZE ||
+       buff.compare(0, JOURNAL_SIGNATURE_SIZE, JOURNAL_SIGNATURE) != 0 )
+    return 0;
+
+  NCollection_Sequence<size_t>       records;
+  NCollection_Sequence<unsigned int> sizes;
+  scanRecords(buff, records, sizes);
+
+  Standard_Integer nbReplayed = 0;
+  for ( Standard_Integer r = 1; r <= records.Length(); ++r )
+  {
+    std::istringstream IN( buff.substr( records(r), sizes(r) ),
+                           std::ios::in | std::ios::binary );
+
+    if ( !this->readRecord(IN, theDoc) )
+      break;
+
+    nbReplayed++;
+  }
+
+#if defined COUT_DEBUG
+  std::cout << "Journal: " << nbReplayed << " record(s) replayed" << std::endl;
+#endif
+
+  return nbReplayed;
+}
+
+//! Applies one record to the Document.
+//! \param[in] theIn  record payload.
+//! \param[in] theDoc Document to modify.
+//! \return true in case of success, false -- otherwise.
+Standard_Boolean
+  ActData_BinJournal::readRecord(std::istream&                   theIn,
+                                 const Handle(TDocStd_Document)& theDoc)
+{
+  const Handle(TDF_Data)& data = theDoc->GetData();
+  std::string str, guidStr;
+  int num = 0;
+
+  // Type names
+  TColStd_SequenceOfAsciiString typeNames;
+  if ( !getInt(theIn, num) )
+    return Standard_False;
+  //
+  for ( int i = 0; i < num; ++i )
+  {
+    if ( !getString(theIn, str) )
+      return Standard_False;
+
+    typeNames.Append( TCollection_AsciiString( str.c_str() ) );
+  }
+  m_drivers->AssignIds(typeNames);
+
+  // Removed attributes
+  if ( !getInt(theIn, num) )
+    return Standard_False;
+  //
+  for ( int i = 0; i < num; ++i )
+  {
+    if ( !getString(theIn, str) || !getString(theIn, guidStr) )
+      return Standard_False;
+
+    TDF_Label lab;
+    TDF_Tool::Label( data, str.c_str(), lab, Standard_False );
+    //
+    if ( !lab.IsNull() )
+      lab.ForgetAttribute( Standard_GUID( guidStr.c_str() ) );
+  }
+
+  // Relocation table is bound to the existing attributes, so that the
+  // references to the attributes not recorded in the journal are resolved
+  BinObjMgt_RRelocationTable reloc;
+  if ( !getInt(theIn, num) )
+    return Standard_False;
+  //
+  for ( int i = 0; i < num; ++i )
+  {
+    int index = 0;
+    if ( !getInt(theIn, index) || !getString(theIn, str) || !getString(theIn, guidStr) )
+      return Standard_False;
+
+    TDF_Label lab;
+    TDF_Tool::Label( data, str.c_str(), lab, Standard_False );
+    //
+    Handle(TDF_Attribute) attr;
+    if ( !lab.IsNull() && lab.FindAttribute( Standard_GUID( guidStr.c_str() ), attr ) )
+      reloc.Bind(index, attr);
+  }
+
+  // Shapes
+  if ( !getString(theIn, str) )
+    return Standard_False;
+  //
+  Handle(BinMDF_ADriver) nsDriverBase;
+  m_drivers->GetDriver(STANDARD_TYPE(TNaming_NamedShape), nsDriverBase);
+  Handle(BinMNaming_NamedShapeDriver)
+    nsDriver = Handle(BinMNaming_NamedShapeDriver)::DownCast(nsDriverBase);
+  //
+  if ( !nsDriver.IsNull() )
+  {
+    nsDriver->Clear();
+
+    if ( !str.empty() )
+    {
+      std::istringstream shapeSection(str, std::ios::in | std::ios::binary);
+      nsDriver->ReadShapeSection(shapeSection);
+    }
+  }
+
+  // Attributes
+  if ( !getInt(theIn, num) )
+    return Standard_False;
+  //
+  Standard_Boolean isOk = Standard_True;
+  for ( int i = 0; i < num && isOk; ++i )
+  {
+    if ( !getString(theIn, str) || !getString(theIn, guidStr) )
+    {
+      isOk = Standard_False;
+      break;
+    }
+
+    BinObjMgt_Persistent pers;
+    pers.Read(theIn);
+    //
+    if ( !theIn.good() )
+    {
+      isOk = Standard_False;
+      break;
+    }
+
+    Handle(BinMDF_ADriver) driver = m_drivers->GetDriver( pers.TypeId() );
+    if ( driver.IsNull() )
+      continue;
+
+    TDF_Label lab;
+    TDF_Tool::Label( data, str.c_str(), lab, Standard_True );
+
+    // Attribute is taken from the Label, then from the relocation table
+    // (if it was created by reference), and only then is created anew
+    Handle(TDF_Attribute) attr;
+    const Standard_GUID    attrId( guidStr.c_str() );
+    const Standard_Boolean isBound = reloc.IsBound( pers.Id() );
+    const Standard_Boolean isFound = lab.FindAttribute(attrId, attr);
+    //
+    if ( !isFound )
+    {
+      if ( isBound )
+        attr = Handle(TDF_Attribute)::DownCast( reloc.Find( pers.Id() ) );
+      else
+        attr = driver->NewEmpty();
+    }
+
+    if ( attr.IsNull() )
+      continue;
+
+    if ( isFound && isPastedByAppending(attr) )
+    {
+      // Drivers of the lists append the items to the target, so the record
+      // is pasted into a new attribute which is then moved onto the existing
+      // one
+      Handle(TDF_Attribute) pasted = driver->NewEmpty();
+      isOk = driver->Paste(pers, pasted, reloc);
+      attr->Restore(pasted);
+    }
+    else
+    {
+      // Driver of the Tree Nodes appends the children, so the existing ones
+      // are detached first. The Node itself is kept in its place as it is
+      // linked to its father and siblings by the father's record
+      Handle(TDataStd_TreeNode) treeNode = Handle(TDataStd_TreeNode)::DownCast(attr);
+      //
+      if ( isFound && !treeNode.IsNull() )
+      {
+        while ( treeNode->HasFirst() )
+          treeNode->First()->Remove();
+      }
+
+      // New attribute is attached before pasting as the standard retrieval
+      // does. If its ID is defined by the contents (e.g. for Tree Nodes) and
+      // clashes with another attribute of the Label, it is attached after
+      if ( attr->Label().IsNull() && !lab.IsAttribute( attr->ID() ) )
+        lab.AddAttribute(attr);
+
+      isOk = driver->Paste(pers, attr, reloc);
+
+      if ( attr->Label().IsNull() && !lab.IsAttribute( attr->ID() ) )
+        lab.AddAttribute(attr);
+    }
+
+    if ( !isBound )
+      reloc.Bind(pers.Id(), attr);
+  }
+
+  if ( !nsDriver.IsNull() )
+    nsDriver->Clear();
+
+  if ( !isOk )
+    return Standard_False;
+
+  // Modified meshes
+  if ( !getInt(theIn, num) )
+    return Standard_False;
+  //
+  for ( int i = 0; i < num; ++i )
+  {
+    Standard_Real tol = 0.0;
+    if ( !getString(theIn, str) || !getString(theIn, guidStr) )
+      return Standard_False;
+
+    theIn.read( (char*) &tol, sizeof(Standard_Real) );
+    //
+    int nbDeltas = 0;
+    if ( !getInt(theIn, nbDeltas) )
+      return Standard_False;
+
+    TDF_Label lab;
+    TDF_Tool::Label( data, str.c_str(), lab, Standard_False );
+    //
+    Handle(TDF_Attribute) attr;
+    if ( !lab.IsNull() )
+      lab.FindAttribute( Standard_GUID( guidStr.c_str() ), attr );
+    //
+    Handle(ActData_MeshAttr) meshAttr = Handle(ActData_MeshAttr)::DownCast(attr);
+    if ( meshAttr.IsNull() )
+      return Standard_False; // Journal does not match the Document
+
+    for ( int d = 0; d < nbDeltas; ++d )
+    {
+      Handle(ActData_MeshMDelta) meshDelta = new ActData_MeshMDelta(meshAttr);
+      if ( !meshDelta->Read(theIn) )
+        return Standard_False;
+
+      meshDelta->Apply();
+    }
+
+    // The saved tolerance is the final one whatever the Deltas have set
+    meshAttr->SetCompressionTolerance(tol, Standard_False);
+  }
+
+  return Standard_True;
+}
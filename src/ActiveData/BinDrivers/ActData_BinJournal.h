@@ -0,0 +1,152 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+#ifndef ActData_BinJournal_HeaderFile
+#define ActData_BinJournal_HeaderFile
+
+// Active Data includes
+#include <ActData_Common.h>
+
+// OCCT includes
+#include <NCollection_Sequence.hxx>
+#include <TCollection_AsciiString.hxx>
+#include <TDF_Delta.hxx>
+#include <TDocStd_Document.hxx>
+
+// Standard includes
+#include <fstream>
+
+// OCCT forward declarations
+class BinMDF_ADriverTable;
+
+DEFINE_STANDARD_HANDLE(ActData_BinJournal, Standard_Transient)
+
+//! \ingroup AD_DF
+//!
+//! Write-ahead journal of the committed changes. The journal complements the
+//! last full save of the Document with a sequence of binary records, one per
+//! committed transaction (or Undo/Redo). Each record contains the current
+//! state of the attributes touched by the transaction, serialized with the
+//! same attribute drivers as the full binary save, plus the identifiers of
+//! the attributes which do not exist anymore. Meshes are not serialized in
+//! full on each change: the Modification Deltas of the Mesh Attributes are
+//! recorded instead.
+//!
+//! Records are flushed as soon as they are written. Every record is guarded
+//! by its length and checksum, so that a record torn by a crash is detected
+//! and ignored on replay together with everything after it.
+//!
+//! The journal file is removed once the Document is closed normally.
+//! Therefore, a journal found next to the Document file means that the
+//! Document was not closed properly, and the journaled changes can be
+//! recovered.
+class ActData_BinJournal : public Standard_Transient
+{
+public:
+
+  // OCCT RTTI
+  DEFINE_STANDARD_RTTI_INLINE(ActData_BinJournal, Standard_Transient)
+
+public:
+
+  ActData_EXPORT
+    ActData_BinJournal(const TCollection_AsciiString& theFilename);
+
+  ActData_EXPORT
+    ~ActData_BinJournal();
+
+public:
+
+  ActData_EXPORT Standard_Boolean
+    Open();
+
+  ActData_EXPORT void
+    Close();
+
+  ActData_EXPORT Standard_Boolean
+    Truncate();
+
+  ActData_EXPORT Standard_Boolean
+    Remove();
+
+  ActData_EXPORT Standard_Boolean
+    HasRecords() const;
+
+  ActData_EXPORT Standard_Boolean
+    Append(const NCollection_Sequence<Handle(TDF_Delta)>& theDeltas);
+
+  ActData_EXPORT Standard_Integer
+    Replay(const Handle(TDocStd_Document)& theDoc);
+
+public:
+
+  //! \return name of the journal file.
+  const TCollection_AsciiString& GetFilename() const
+  {
+    return m_filename;
+  }
+
+  //! \return true if the journal is open for appending.
+  Standard_Boolean IsOpen() const
+  {
+    return m_out.is_open();
+  }
+
+  //! \return number of bytes in the journal file.
+  Standard_Size Size() const
+  {
+    return m_iSize;
+  }
+
+  //! \return number of records in the journal file.
+  Standard_Integer NbRecords() const
+  {
+    return m_iNbRecords;
+  }
+
+protected:
+
+  Standard_Boolean
+    readRecord(std::istream&                   theIn,
+               const Handle(TDocStd_Document)& theDoc);
+
+protected:
+
+  TCollection_AsciiString     m_filename;   //!< Journal file.
+  std::ofstream               m_out;        //!< Output stream for appending.
+  Standard_Size               m_iSize;      //!< Size of the journal in bytes.
+  Standard_Integer            m_iNbRecords; //!< Number of records.
+  Handle(BinMDF_ADriverTable) m_drivers;    //!< Attribute drivers.
+
+};
+
+#endif
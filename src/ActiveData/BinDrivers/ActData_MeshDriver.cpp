@@ -33,11 +33,51 @@
 // Own include
 #include <ActData_MeshDriver.h>
 
+// Active Data includes
+#include <ActData_DocumentStateAttr.h>
+#include <ActData_MeshPayload.h>
+
 // OCCT includes
 #include <BinObjMgt_Persistent.hxx>
 
 #undef COUT_DEBUG
 
+namespace
+{
+  //! Pushes a 64-bit value as two integers.
+  void putSize(BinObjMgt_Persistent& out, const Standard_Size val)
+  {
+    const unsigned long long v = val;
+    out << (Standard_Integer) (v & 0xFFFFFFFFull) << (Standard_Integer) (v >> 32);
+  }
+
+  //! Reads a 64-bit value pushed by putSize().
+  void getSize(const BinObjMgt_Persistent& in, Standard_Size& val)
+  {
+    Standard_Integer lo = 0, hi = 0;
+    in >> lo >> hi;
+    val = (Standard_Size) ( ( (unsigned long long) (unsigned int) hi << 32 ) | (unsigned int) lo );
+  }
+
+  //! Checks whether the passed IDs are exactly firstID .. firstID+N-1 and
+  //! fills the slots so that slots[ID - firstID] is the position of ID.
+  bool denseSlots(const std::vector<Standard_Integer>& IDs,
+                  const Standard_Integer               firstID,
+                  std::vector<Standard_Integer>&       slots)
+  {
+    const Standard_Integer nb = (Standard_Integer) IDs.size();
+    slots.assign(nb, -1);
+    for ( Standard_Integer i = 0; i < nb; ++i )
+    {
+      const Standard_Integer k = IDs[i] - firstID;
+      if ( k < 0 || k >= nb || slots[k] != -1 )
+        return false;
+      slots[k] = i;
+    }
+    return true;
+  }
+}
+
 //! Constructor accepting Message Driver for the parent class.
 //! \param theMsgDriver [in] Message Driver for parent.
 ActData_MeshDriver::ActData_MeshDriver(const Handle(Message_Messenger)& theMsgDriver)
@@ -80,12 +120,18 @@ Standard_Boolean
   // Create new Mesh DS
   aMeshAttr->NewEmptyMesh();
 
-  // Read from the input stream
-  Read<BinObjMgt_Persistent>(FromPersistent, aMeshAttr);
+  // Read from the input stream (any known version of the record)
+  const Standard_Boolean isOk = Read<BinObjMgt_Persistent>(FromPersistent, aMeshAttr);
 
   // Enable accumulation of deltas
   aMeshAttr->DeltaModeOn();
 
+  if ( !isOk )
+  {
+    myMessageDriver->Send("ERROR: corrupted or unsupported mesh record", Message_Fail);
+    return Standard_False;
+  }
+
   return Standard_True;
 }
 
@@ -109,6 +155,258 @@ void ActData_MeshDriver::Paste(const Handle(TDF_Attribute)& FromTransient,
     return;
   }
 
-  // Write to the output stream
+  // Keep the mesh in the sidecar file if the Document is saved with one
+  Handle(ActData_DocumentStateAttr) aState = ActData_DocumentStateAttr::Find( aMeshAttr->Label() );
+  if ( !aState.IsNull() && WriteExternal(aMeshAttr, aState->GetPayloadStore(), ToPersistent) )
+    return;
+
+  // Write to the output stream as a versioned block record
   Write<BinObjMgt_Persistent>(aMeshAttr, ToPersistent);
 }
+
+//! Writes the reference to the mesh payload kept in the passed sidecar
+//! store. The payload which is not yet materialized is reused as is (it
+//! is copied if it resides in another sidecar file). Otherwise the mesh
+//! is encoded and put to the store, where it is written only if no blob
+//! with the same content is there.
+//! \param meshAttr [in] Mesh Attribute to write.
+//! \param store    [in] sidecar store.
+//! \param out      [in] persistence buffer.
+//! \return true in case of success, false -- otherwise.
+Standard_Boolean
+  ActData_MeshDriver::WriteExternal(const Handle(ActData_MeshAttr)&         meshAttr,
+                                    const Handle(ActData_MeshPayloadStore)& store,
+                                    BinObjMgt_Persistent&                   out)
+{
+  if ( store.IsNull() || !store->IsOpen() )
+    return Standard_False;
+
+  Handle(ActData_MeshPayload) aPayload = meshAttr->GetPayload();
+  if ( !aPayload.IsNull() )
+  {
+    aPayload = store->Put(aPayload);
+  }
+  else
+  {
+    std::string aBytes;
+    if ( !ActData_MeshPayload::Encode(meshAttr->GetMesh(), meshAttr->GetCompressionTolerance(), aBytes) )
+      return Standard_False;
+
+    aPayload = store->Put(aBytes);
+  }
+
+  if ( aPayload.IsNull() )
+    return Standard_False;
+
+  out << -Standard_Integer(FormatVersion_External);
+  putSize( out, aPayload->Offset() );
+  putSize( out, aPayload->Size() );
+  putSize( out, aPayload->Hash() );
+  out.PutAsciiString( store->Name() );
+
+  return Standard_True;
+}
+
+//! Reads the reference to the external mesh payload whose version tag is
+//! already consumed. The store of the Document being opened is not known
+//! here, so the unresolved payload is bound to the Attribute. The Data Model
+//! resolves it once the Document is opened, still without decoding the mesh.
+//! \param in       [in]     persistence buffer.
+//! \param meshAttr [in/out] Mesh Attribute to bind the payload to.
+//! \return true in case of success, false -- otherwise.
+Standard_Boolean
+  ActData_MeshDriver::readExternal(const BinObjMgt_Persistent& in,
+                                   Handle(ActData_MeshAttr)&   meshAttr)
+{
+  Standard_Size           anOffset = 0, aSize = 0, aHash = 0;
+  TCollection_AsciiString aName;
+  //
+  getSize(in, anOffset);
+  getSize(in, aSize);
+  getSize(in, aHash);
+  in.GetAsciiString(aName);
+
+  if ( !in.IsOK() )
+    return Standard_False;
+
+  meshAttr->SetPayload( new ActData_MeshPayload(aName, anOffset, aSize, aHash) );
+  return Standard_True;
+}
+
+//! Gathers the mesh entities into flat blocks.
+//! \param mesh   [in]  mesh to gather the entities from.
+//! \param blocks [out] mesh blocks.
+void ActData_MeshDriver::gatherBlocks(const Handle(ActData_Mesh)& mesh,
+                                      ActData_MeshBlocks&         blocks)
+{
+  blocks = ActData_MeshBlocks();
+  blocks.NodeIDs.reserve( mesh->NbNodes() );
+  blocks.Coords.reserve( 3*mesh->NbNodes() );
+
+  ActData_Mesh_ElementsIterator aMeshNodesIt(mesh, ActData_Mesh_ET_Node);
+  for ( ; aMeshNodesIt.More(); aMeshNodesIt.Next() )
+  {
+    Handle(ActData_Mesh_Node)
+      aNode = Handle(ActData_Mesh_Node)::DownCast( aMeshNodesIt.GetValue() );
+
+    blocks.NodeIDs.push_back( aNode->GetID() );
+    blocks.Coords.push_back( aNode->Pnt().X() );
+    blocks.Coords.push_back( aNode->Pnt().Y() );
+    blocks.Coords.push_back( aNode->Pnt().Z() );
+  }
+
+  ActData_Mesh_ElementsIterator aMeshEdgesIt(mesh, ActData_Mesh_ET_Edge);
+  for ( ; aMeshEdgesIt.More(); aMeshEdgesIt.Next() )
+  {
+    const Handle(ActData_Mesh_Element)& anElem = aMeshEdgesIt.GetValue();
+
+    Standard_Integer aNode1, aNode2;
+    anElem->GetEdgeDefinedByNodes(1, aNode1, aNode2);
+
+    blocks.EdgeIDs.push_back( anElem->GetID() );
+    blocks.EdgeNodes.push_back(aNode1);
+    blocks.EdgeNodes.push_back(aNode2);
+  }
+
+  ActData_Mesh_ElementsIterator aMeshElemsIt(mesh, ActData_Mesh_ET_Face);
+  for ( ; aMeshElemsIt.More(); aMeshElemsIt.Next() )
+  {
+    const Handle(ActData_Mesh_Element)& anElem = aMeshElemsIt.GetValue();
+
+    Standard_Integer aFaceNodeIds[4];
+    Standard_Integer aNbFaceNodes;
+
+    // Proceed with TRIANGLE elements
+    if ( anElem->IsInstance( STANDARD_TYPE(ActData_Mesh_Triangle) ) )
+    {
+      anElem->GetFaceDefinedByNodes(3, aFaceNodeIds, aNbFaceNodes);
+
+      blocks.TriIDs.push_back( anElem->GetID() );
+      blocks.TriNodes.insert(blocks.TriNodes.end(), aFaceNodeIds, aFaceNodeIds + 3);
+    }
+    // Proceed with QUADRANGLE elements
+    else if ( anElem->IsInstance( STANDARD_TYPE(ActData_Mesh_Quadrangle) ) )
+    {
+      anElem->GetFaceDefinedByNodes(4, aFaceNodeIds, aNbFaceNodes);
+
+      blocks.QuadIDs.push_back( anElem->GetID() );
+      blocks.QuadNodes.insert(blocks.QuadNodes.end(), aFaceNodeIds, aFaceNodeIds + 4);
+    }
+  }
+}
+
+//! Restores the mesh entities from flat blocks. If the IDs are dense
+//! (1..N, as for any mesh which was not edited by removal) and the mesh
+//! is empty, nodes and runs of faces go through bulk construction.
+//! Otherwise the entities are restored one by one with their original IDs.
+//! \param blocks [in] mesh blocks.
+//! \param mesh   [in] mesh to restore the entities into.
+//! \return true in case of success, false -- otherwise.
+Standard_Boolean
+  ActData_MeshDriver::restoreBlocks(const ActData_MeshBlocks&   blocks,
+                                    const Handle(ActData_Mesh)& mesh)
+{
+  const Standard_Integer aNbNodes = (Standard_Integer) blocks.NodeIDs.size();
+  const Standard_Integer aNbEdges = (Standard_Integer) blocks.EdgeIDs.size();
+  const Standard_Integer aNbTris  = (Standard_Integer) blocks.TriIDs.size();
+  const Standard_Integer aNbQuads = (Standard_Integer) blocks.QuadIDs.size();
+
+  const std::vector<Standard_Real>&    aCoords    = blocks.Coords;
+  const std::vector<Standard_Integer>& aEdgeNodes = blocks.EdgeNodes;
+  const std::vector<Standard_Integer>& aTriNodes  = blocks.TriNodes;
+  const std::vector<Standard_Integer>& aQuadNodes = blocks.QuadNodes;
+
+  const Standard_Boolean isEmpty = (mesh->NbNodes() == 0 &&
+                                    mesh->NbEdges() == 0 &&
+                                    mesh->NbFaces() == 0);
+
+  /* ====================
+   *  Restore mesh nodes
+   * ==================== */
+
+  std::vector<Standard_Integer> aSlots;
+  if ( isEmpty && denseSlots(blocks.NodeIDs, 1, aSlots) )
+  {
+    // Lay out the coordinates in the ID order
+    std::vector<Standard_Real> anOrdered( aCoords.size() );
+    for ( Standard_Integer i = 0; i < aNbNodes; ++i )
+    {
+      const Standard_Integer src = aSlots[i];
+      anOrdered[3*i]     = aCoords[3*src];
+      anOrdered[3*i + 1] = aCoords[3*src + 1];
+      anOrdered[3*i + 2] = aCoords[3*src + 2];
+    }
+
+    if ( aNbNodes && mesh->AddNodes(&anOrdered[0], aNbNodes) != 1 )
+      return Standard_False;
+  }
+  else
+  {
+    for ( Standard_Integer i = 0; i < aNbNodes; ++i )
+      mesh->AddNodeWithID(aCoords[3*i], aCoords[3*i + 1], aCoords[3*i + 2], blocks.NodeIDs[i]);
+  }
+
+  /* =======================
+   *  Restore mesh elements
+   * ======================= */
+
+  // Edges, triangles and quadrangles share the same ID space. Each slot
+  // encodes the index of the element in its block and the block itself
+  std::vector<Standard_Integer> anElemIDs;
+  anElemIDs.reserve(aNbEdges + aNbTris + aNbQuads);
+  anElemIDs.insert( anElemIDs.end(), blocks.EdgeIDs.begin(), blocks.EdgeIDs.end() );
+  anElemIDs.insert( anElemIDs.end(), blocks.TriIDs.begin(),  blocks.TriIDs.end() );
+  anElemIDs.insert( anElemIDs.end(), blocks.QuadIDs.begin(), blocks.QuadIDs.end() );
+
+  if ( isEmpty && denseSlots(anElemIDs, 1, aSlots) )
+  {
+    const Standard_Integer aNbElems = (Standard_Integer) anElemIDs.size();
+    std::vector<Standard_Integer> aRun;
+
+    // Walk the IDs in ascending order, grouping runs of same-sized faces
+    Standard_Integer id = 1;
+    while ( id <= aNbElems )
+    {
+      const Standard_Integer slot = aSlots[id - 1];
+      if ( slot < aNbEdges )
+      {
+        if ( !mesh->AddEdgeWithID(aEdgeNodes[2*slot], aEdgeNodes[2*slot + 1], id) )
+          return Standard_False;
+        ++id;
+        continue;
+      }
+
+      const Standard_Boolean isTri  = (slot < aNbEdges + aNbTris);
+      const Standard_Integer nbFN   = isTri ? 3 : 4;
+      const Standard_Integer runID  = id;
+      aRun.clear();
+
+      for ( ; id <= aNbElems; ++id )
+      {
+        const Standard_Integer s = aSlots[id - 1];
+        if ( s < aNbEdges || (s < aNbEdges + aNbTris) != isTri )
+          break;
+
+        const Standard_Integer* aNodes = isTri ? &aTriNodes[3*(s - aNbEdges)]
+                                               : &aQuadNodes[4*(s - aNbEdges - aNbTris)];
+        aRun.insert(aRun.end(), aNodes, aNodes + nbFN);
+      }
+
+      const Standard_Integer aRunSize = (Standard_Integer) aRun.size() / nbFN;
+      if ( mesh->AddFaces(&aRun[0], aRunSize, nbFN) != runID )
+        return Standard_False;
+    }
+  }
+  else
+  {
+    for ( Standard_Integer i = 0; i < aNbEdges; ++i )
+      mesh->AddEdgeWithID(aEdgeNodes[2*i], aEdgeNodes[2*i + 1], blocks.EdgeIDs[i]);
+
+    for ( Standard_Integer i = 0; i < aNbTris; ++i )
+      mesh->AddFaceWithID(const_cast<Standard_Integer*>(&aTriNodes[3*i]), 3, blocks.TriIDs[i]);
+
+    for ( Standard_Integer i = 0; i < aNbQuads; ++i )
+      mesh->AddFaceWithID(const_cast<Standard_Integer*>(&aQuadNodes[4*i]), 4, blocks.QuadIDs[i]);
+  }
+  return Standard_True;
+}
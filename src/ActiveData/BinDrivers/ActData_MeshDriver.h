@@ -36,6 +36,8 @@
 // Active Data includes
 #include <ActData_Common.h>
 #include <ActData_MeshAttr.h>
+#include <ActData_MeshCodec.h>
+#include <ActData_MeshPayloadStore.h>
 
 // Mesh includes
 #include <ActData_Mesh_ElementsIterator.h>
@@ -47,6 +49,13 @@
 #include <BinMDF_ADriver.hxx>
 #include <Message_Messenger.hxx>
 
+// STL includes
+#include <climits>
+#include <vector>
+
+// OCCT forward declarations
+class BinObjMgt_Persistent;
+
 DEFINE_STANDARD_HANDLE(ActData_MeshDriver, BinMDF_ADriver)
 
 //! \ingroup AD_DF
@@ -59,14 +68,116 @@ public:
   // OCCT RTTI
   DEFINE_STANDARD_RTTI_INLINE(ActData_MeshDriver, BinMDF_ADriver)
 
+public:
+
+  //! Versions of the persistent mesh record. The legacy record carries no
+  //! version tag and starts with the (non-negative) number of nodes, so the
+  //! versioned records start with the negated version number instead.
+  enum FormatVersion
+  {
+    FormatVersion_Legacy   = 1, //!< Per-item IDs, coordinates and face sizes.
+    FormatVersion_Blocks   = 2, //!< Contiguous typed blocks per entity kind.
+    FormatVersion_External = 3, //!< Reference to a payload in a sidecar file.
+    FormatVersion_Compact  = 4  //!< Quantized and delta-coded blocks.
+  };
+
 public:
 
   //---------------------------------------------------------------------------
 
+  //! Writes the mesh as a versioned record of contiguous typed blocks:
+  //! <pre>
+  //!   -FormatVersion_Blocks
+  //!   NbNodes NbEdges NbTriangles NbQuadrangles
+  //!   node IDs     | node coordinates (X, Y, Z)
+  //!   edge IDs     | edge nodes (2 per edge)
+  //!   triangle IDs | triangle nodes (3 per triangle)
+  //!   quad IDs     | quadrangle nodes (4 per quadrangle)
+  //! </pre>
+  //! Each block is pushed with a single PutIntArray() or PutRealArray() call.
+  //!
+  //! If the Attribute has a compression tolerance, the blocks are encoded
+  //! with ActData_MeshCodec instead:
+  //! <pre>
+  //!   -FormatVersion_Compact
+  //!   NbNodes NbEdges NbTriangles NbQuadrangles
+  //!   Tolerance OriginX OriginY OriginZ
+  //!   NbBytes | encoded blocks
+  //! </pre>
   template <typename TStream>
   static bool
     Write(const Handle(ActData_MeshAttr)& meshAttr,
           TStream&                        out)
+  {
+    const Handle(ActData_Mesh)& aMeshDS = meshAttr->GetMesh();
+    if ( aMeshDS.IsNull() )
+    {
+      return Standard_False;
+    }
+
+    ActData_MeshBlocks aBlocks;
+    gatherBlocks(aMeshDS, aBlocks);
+
+    /* =================================
+     *  Push compact record if possible
+     * ================================= */
+
+    const Standard_Real aTolerance = meshAttr->GetCompressionTolerance();
+    if ( aTolerance > 0.0 )
+    {
+      gp_XYZ                     anOrigin;
+      std::vector<Standard_Byte> aBytes;
+
+      // The codec refuses the mesh which does not fit the grid
+      if ( ActData_MeshCodec::Encode(aBlocks, aTolerance, anOrigin, aBytes) &&
+           aBytes.size() <= (Standard_Size) INT_MAX )
+      {
+        out << -Standard_Integer(FormatVersion_Compact);
+        putCounts(out, aBlocks);
+        out << aTolerance << anOrigin.X() << anOrigin.Y() << anOrigin.Z();
+        out << Standard_Integer( aBytes.size() );
+
+        if ( !aBytes.empty() )
+          out.PutByteArray( &aBytes[0], (Standard_Integer) aBytes.size() );
+
+        return Standard_True;
+      }
+    }
+
+    /* ==============================
+     *  Push blocks to binary buffer
+     * ============================== */
+
+    out << -Standard_Integer(FormatVersion_Blocks);
+    putCounts(out, aBlocks);
+
+    putIntBlock  (out, aBlocks.NodeIDs);
+    putRealBlock (out, aBlocks.Coords);
+    putIntBlock  (out, aBlocks.EdgeIDs);
+    putIntBlock  (out, aBlocks.EdgeNodes);
+    putIntBlock  (out, aBlocks.TriIDs);
+    putIntBlock  (out, aBlocks.TriNodes);
+    putIntBlock  (out, aBlocks.QuadIDs);
+    putIntBlock  (out, aBlocks.QuadNodes);
+
+    return Standard_True;
+  }
+
+  //---------------------------------------------------------------------------
+
+  ActData_EXPORT static Standard_Boolean
+    WriteExternal(const Handle(ActData_MeshAttr)&         meshAttr,
+                  const Handle(ActData_MeshPayloadStore)& store,
+                  BinObjMgt_Persistent&                   out);
+
+  //---------------------------------------------------------------------------
+
+  //! Writes the mesh in the legacy (unversioned) format where every ID,
+  //! coordinate and face size is pushed individually. Edges are not stored.
+  template <typename TStream>
+  static bool
+    WriteLegacy(const Handle(ActData_MeshAttr)& meshAttr,
+                TStream&                        out)
   {
     /* ==================================
      *  Push mesh nodes to binary buffer
@@ -144,18 +255,50 @@ public:
 
   //---------------------------------------------------------------------------
 
+  //! Reads the mesh record of any known version into the (empty) Mesh DS
+  //! of the passed attribute.
   template <typename TStream>
   static Standard_Boolean
     Read(const TStream&            in,
          Handle(ActData_MeshAttr)& meshAttr)
+  {
+    Standard_Integer aTag;
+    in >> aTag;
+
+    // Legacy record starts with the number of nodes
+    if ( aTag >= 0 )
+      return readLegacy(in, aTag, meshAttr);
+
+    if ( -aTag == FormatVersion_Blocks )
+      return readBlocks(in, meshAttr);
+
+    if ( -aTag == FormatVersion_External )
+      return readExternal(in, meshAttr);
+
+    if ( -aTag == FormatVersion_Compact )
+      return readCompact(in, meshAttr);
+
+    return Standard_False; // Record of unknown version
+  }
+
+  //---------------------------------------------------------------------------
+
+protected:
+
+  //! Reads the legacy record whose number of nodes is already consumed.
+  template <typename TStream>
+  static Standard_Boolean
+    readLegacy(const TStream&            in,
+               const Standard_Integer    aNbNodes,
+               Handle(ActData_MeshAttr)& meshAttr)
   {
     /* ==========================================================
-     *  Read number of nodes and elements from the binary buffer
+     *  Read number of elements from the binary buffer
      * ========================================================== */
 
     // Read data
-    Standard_Integer aNbNodes, aNbFaces;
-    in >> aNbNodes >> aNbFaces;
+    Standard_Integer aNbFaces;
+    in >> aNbFaces;
 
     /* ====================
      *  Restore mesh nodes
@@ -212,6 +355,146 @@ public:
 
   //---------------------------------------------------------------------------
 
+  //! Reads the block record whose version tag is already consumed.
+  template <typename TStream>
+  static Standard_Boolean
+    readBlocks(const TStream&            in,
+               Handle(ActData_MeshAttr)& meshAttr)
+  {
+    ActData_MeshBlocks aBlocks;
+    if ( !getCounts(in, aBlocks) )
+      return Standard_False;
+
+    getIntBlock  (in, aBlocks.NodeIDs);
+    getRealBlock (in, aBlocks.Coords);
+    getIntBlock  (in, aBlocks.EdgeIDs);
+    getIntBlock  (in, aBlocks.EdgeNodes);
+    getIntBlock  (in, aBlocks.TriIDs);
+    getIntBlock  (in, aBlocks.TriNodes);
+    getIntBlock  (in, aBlocks.QuadIDs);
+    getIntBlock  (in, aBlocks.QuadNodes);
+
+    if ( !in.IsOK() )
+      return Standard_False;
+
+    return restoreBlocks( aBlocks, meshAttr->GetMesh() );
+  }
+
+  //---------------------------------------------------------------------------
+
+  //! Reads the compact record whose version tag is already consumed. The
+  //! compression tolerance of the record is kept in the Attribute, so the
+  //! mesh is compressed again when saved.
+  template <typename TStream>
+  static Standard_Boolean
+    readCompact(const TStream&            in,
+                Handle(ActData_MeshAttr)& meshAttr)
+  {
+    ActData_MeshBlocks aBlocks;
+    if ( !getCounts(in, aBlocks) )
+      return Standard_False;
+
+    Standard_Real    aTolerance, anOriginX, anOriginY, anOriginZ;
+    Standard_Integer aNbBytes;
+    in >> aTolerance >> anOriginX >> anOriginY >> anOriginZ >> aNbBytes;
+
+    if ( !in.IsOK() || aNbBytes < 0 )
+      return Standard_False;
+
+    std::vector<Standard_Byte> aBytes(aNbBytes);
+    if ( aNbBytes )
+      in.GetByteArray(&aBytes[0], aNbBytes);
+
+    if ( !in.IsOK() )
+      return Standard_False;
+
+    if ( !ActData_MeshCodec::Decode(aNbBytes ? &aBytes[0] : NULL, aBytes.size(),
+                                    aTolerance, gp_XYZ(anOriginX, anOriginY, anOriginZ),
+                                    aBlocks) )
+      return Standard_False;
+
+    if ( !restoreBlocks( aBlocks, meshAttr->GetMesh() ) )
+      return Standard_False;
+
+    meshAttr->SetCompressionTolerance(aTolerance, Standard_False);
+    return Standard_True;
+  }
+
+  //---------------------------------------------------------------------------
+
+  ActData_EXPORT static Standard_Boolean
+    readExternal(const BinObjMgt_Persistent& in,
+                 Handle(ActData_MeshAttr)&   meshAttr);
+
+  //! References to external payloads are carried by the binary persistence
+  //! of the Document only.
+  template <typename TStream>
+  static Standard_Boolean
+    readExternal(const TStream&,
+                 Handle(ActData_MeshAttr)&)
+  {
+    return Standard_False;
+  }
+
+  //---------------------------------------------------------------------------
+
+  ActData_EXPORT static void
+    gatherBlocks(const Handle(ActData_Mesh)& mesh,
+                 ActData_MeshBlocks&         blocks);
+
+  ActData_EXPORT static Standard_Boolean
+    restoreBlocks(const ActData_MeshBlocks&   blocks,
+                  const Handle(ActData_Mesh)& mesh);
+
+  template <typename TStream>
+  static void putCounts(TStream& out, const ActData_MeshBlocks& blocks)
+  {
+    out << Standard_Integer( blocks.NodeIDs.size() )
+        << Standard_Integer( blocks.EdgeIDs.size() )
+        << Standard_Integer( blocks.TriIDs.size() )
+        << Standard_Integer( blocks.QuadIDs.size() );
+  }
+
+  template <typename TStream>
+  static Standard_Boolean getCounts(const TStream& in, ActData_MeshBlocks& blocks)
+  {
+    Standard_Integer aNbNodes, aNbEdges, aNbTris, aNbQuads;
+    in >> aNbNodes >> aNbEdges >> aNbTris >> aNbQuads;
+    if ( !in.IsOK() || aNbNodes < 0 || aNbEdges < 0 || aNbTris < 0 || aNbQuads < 0 )
+      return Standard_False;
+
+    blocks.Resize(aNbNodes, aNbEdges, aNbTris, aNbQuads);
+    return Standard_True;
+  }
+
+  template <typename TStream>
+  static void putIntBlock(TStream& out, std::vector<Standard_Integer>& block)
+  {
+    if ( !block.empty() )
+      out.PutIntArray( &block[0], (Standard_Integer) block.size() );
+  }
+
+  template <typename TStream>
+  static void putRealBlock(TStream& out, std::vector<Standard_Real>& block)
+  {
+    if ( !block.empty() )
+      out.PutRealArray( &block[0], (Standard_Integer) block.size() );
+  }
+
+  template <typename TStream>
+  static void getIntBlock(const TStream& in, std::vector<Standard_Integer>& block)
+  {
+    if ( !block.empty() )
+      in.GetIntArray( &block[0], (Standard_Integer) block.size() );
+  }
+
+  template <typename TStream>
+  static void getRealBlock(const TStream& in, std::vector<Standard_Real>& block)
+  {
+    if ( !block.empty() )
+      in.GetRealArray( &block[0], (Standard_Integer) block.size() );
+  }
+
 // Construction:
 public:
 
@@ -44,9 +44,12 @@
 #include <ActData_BoolVarNode.h>
 #include <ActData_CAFConverter.h>
 #include <ActData_CAFConverterFw.h>
+#include <ActData_ChildIndex.h>
 #include <ActData_DependencyAnalyzer.h>
+#include <ActData_DocumentStateAttr.h>
 #include <ActData_ExtTransactionEngine.h>
 #include <ActData_IntVarNode.h>
+#include <ActData_MeshAttr.h>
 #include <ActData_RealEvaluatorFunc.h>
 #include <ActData_RealVarNode.h>
 #include <ActData_SequentialFuncIterator.h>
@@ -62,6 +65,7 @@
 // OCCT includes
 #include <Standard_ProgramError.hxx>
 #include <TDataStd_Integer.hxx>
+#include <TDF_ChildIDIterator.hxx>
 #include <TDF_ListIteratorOfLabelList.hxx>
 #include <TDF_Tool.hxx>
 #include <TFunction_DoubleMapIteratorOfDoubleMapOfIntegerLabel.hxx>
@@ -102,6 +106,12 @@ ActData_BaseModel::ActData_BaseModel(const Standard_Boolean useExtTransactions)
   m_versionStatus = Version_Undefined;
   m_bSimpleTxMode = !useExtTransactions;
   m_iFuncExecutionFlags = ExecFlags_NoFlags;
+  m_bPackedLogBook = Standard_False;
+  m_undoMemLimit = 0;
+  m_fCoalesceWindow = 0.0;
+  m_bJournaling = Standard_False;
+  m_journalCompactSize = 0;
+  m_bExternalPayloads = Standard_False;
 }
 
 //----------------------------------------------------------------------------
@@ -112,6 +122,16 @@ ActData_BaseModel::ActData_BaseModel(const Standard_Boolean useExtTransactions)
 //! \return true in case of success, false -- otherwise.
 Standard_Boolean ActData_BaseModel::NewEmpty()
 {
+  // New Document has no full save to be journaled against. The journal of
+  // the previous Document is dropped as its changes are abandoned
+  if ( !m_journal.IsNull() )
+  {
+    m_journal->Remove();
+    m_journal.Nullify();
+    m_journalBase.Clear();
+  }
+  m_payloads.Nullify();
+
   // Initialize consistent Data Model structure
   Handle(TDocStd_Document) aDoc = this->newDocument();
   this->init(aDoc);
@@ -204,14 +224,31 @@ Standard_Boolean
     return Standard_False;
   }
 
+  // Meshes saved out of the Document are resolved against its sidecar
+  // file. They are only mapped here and decoded on first access
+  Handle(ActData_MeshPayloadStore)
+    aPayloads = new ActData_MeshPayloadStore(theFilename + ".adp");
+  //
+  const Standard_Integer nbUnresolved = resolvePayloads(aDoc, aPayloads);
+  //
+  if ( nbUnresolved )
+    theNotifier.SendLogMessage(LogWarn(Normal) << "%1 mesh(es) not found in sidecar file %2."
+                                               << nbUnresolved << aPayloads->GetFilename());
+
   this->init(aDoc);
   this->initPartitions();
   this->initFunctionDrivers();
 
+  m_payloads = aPayloads;
+
   m_status |= MS_Saved;
   if ( this->IsModified() )
     m_status -= MS_Modified;
 
+  // Bring the changes committed after the last full save
+  if ( m_bJournaling )
+    this->attachJournal(theFilename, Standard_True);
+
   return Standard_True;
 }
 
@@ -222,6 +259,25 @@ void ActData_BaseModel::Release(const VersionStatus theVersionStatus)
   if ( m_doc.IsNull() )
     return;
 
+  // Packed LogBook goes away together with the Document
+  m_packedLogBook.Nullify();
+
+  // Changes which are not saved are abandoned on normal closing, so the
+  // journal is removed. Only the journal left by an abnormal termination
+  // is found and replayed on the next opening
+  if ( !m_journal.IsNull() )
+  {
+    m_journal->Remove();
+    m_journal.Nullify();
+  }
+  m_journalBase.Clear();
+
+  // Payloads which are not yet materialized keep their store alive
+  m_payloads.Nullify();
+
+  // Snapshots of the released Document cannot be reused
+  this->InvalidateSnapshots();
+
   /* ================
    *  Close Document
    * ================ */
@@ -267,6 +323,33 @@ Standard_Boolean
 
   const Handle(ActData_Application)& anApp = ActData_Application::Instance();
 
+  // Prepare the sidecar file for the meshes. An existing sidecar file is
+  // always appended, even if it belongs to another Document: the unloaded
+  // meshes may still map it, so it is never truncated. Besides, the payloads
+  // which are already there are not rewritten
+  Handle(ActData_MeshPayloadStore) aPayloads;
+  if ( m_bExternalPayloads )
+  {
+    const TCollection_AsciiString aSidecar = theFilename + ".adp";
+    //
+    if ( !m_payloads.IsNull() && m_payloads->GetFilename() == aSidecar )
+      aPayloads = m_payloads;
+    else
+      aPayloads = new ActData_MeshPayloadStore(aSidecar);
+
+    if ( !aPayloads->Open(Standard_False) )
+    {
+      theNotifier.SendLogMessage(LogErr(Normal) << "Cannot open sidecar file %1." << aSidecar);
+      return Standard_False;
+    }
+  }
+
+  // Mesh Attribute driver finds the store on the state of the Document
+  Handle(ActData_DocumentStateAttr) aState = ActData_DocumentStateAttr::Find(m_rootLabel);
+  //
+  if ( !aState.IsNull() )
+    aState->SetPayloadStore(aPayloads);
+
   // Write
   PCDM_StoreStatus writerStatus = PCDM_SS_WriteFailure;
   //
@@ -276,11 +359,19 @@ Standard_Boolean
   }
   catch ( Standard_Failure exc )
   {
+    if ( !aState.IsNull() )
+      aState->SetPayloadStore(nullptr);
+
     std::cout << "OCCT exception:"         << std::endl;
     std::cout << exc.DynamicType()->Name() << std::endl;
     std::cout << exc.GetMessageString()    << std::endl;
     return Standard_False;
   }
+  if ( !aState.IsNull() )
+    aState->SetPayloadStore(nullptr);
+  //
+  if ( !aPayloads.IsNull() )
+    aPayloads->Close();
   //
   // Check status
   if ( writerStatus != PCDM_SS_OK )
@@ -299,10 +390,17 @@ Standard_Boolean
     return Standard_False;
   }
 
+  if ( !aPayloads.IsNull() )
+    m_payloads = aPayloads;
+
   m_status |= MS_Saved;
   if ( this->IsModified() )
     m_status -= MS_Modified;
 
+  // Full save supersedes the journal
+  if ( m_bJournaling )
+    this->attachJournal(theFilename, Standard_False);
+
   return Standard_True;
 }
 
@@ -396,6 +494,10 @@ void ActData_BaseModel::CommitCommand(ActAPI_TxData theData)
 
   // Set status to MODIFIED
   m_status |= MS_Modified;
+
+  // Fold the grown journal into the full save
+  if ( !m_journal.IsNull() && m_journalCompactSize && m_journal->Size() > m_journalCompactSize )
+    this->CompactJournal();
 }
 
 //! Performs Undo operation.
@@ -450,6 +552,262 @@ Standard_Integer ActData_BaseModel::NbRedos() const
   return m_trEngine->NbRedos();
 }
 
+//! Sets the memory cap for the Undo history. Once the estimated size of
+//! the stacked deltas exceeds the cap, the oldest deltas are discarded
+//! without being spilled to disk. The cap survives re-initialization of
+//! the Data Model.
+//! \param theNbBytes [in] memory cap in bytes (0 for unlimited).
+void ActData_BaseModel::SetUndoMemoryLimit(const Standard_Size theNbBytes)
+{
+  m_undoMemLimit = theNbBytes;
+
+  if ( !m_trEngine.IsNull() )
+    m_trEngine->SetUndoMemoryLimit(m_undoMemLimit);
+}
+
+//! \return estimated size of the Undo history in bytes. The size is
+//!         tracked only if the memory cap is set.
+Standard_Size ActData_BaseModel::GetUndoMemoryUsage() const
+{
+  return m_trEngine.IsNull() ? 0 : m_trEngine->GetUndoMemoryUsage();
+}
+
+//! Sets the time window for coalescing of consecutive commits affecting
+//! the same Parameters. The window survives re-initialization of the Data
+//! Model.
+//! \param[in] theSeconds time window in seconds (0 to disable).
+void ActData_BaseModel::SetCoalescingWindow(const Standard_Real theSeconds)
+{
+  m_fCoalesceWindow = theSeconds;
+
+  if ( !m_trEngine.IsNull() )
+    m_trEngine->SetCoalescingWindow(m_fCoalesceWindow);
+}
+
+//! Starts a coalescing run, so that all subsequent commits affecting the
+//! same Parameters are merged into a single Undo step until the run is
+//! ended. This is intended for interactive manipulations committing a
+//! transaction per mouse event.
+//! \param[in] theKey client-supplied key of the run.
+void ActData_BaseModel::BeginCoalescing(const TCollection_AsciiString& theKey)
+{
+  m_trEngine->BeginCoalescing(theKey);
+}
+
+//! Ends the current coalescing run.
+void ActData_BaseModel::EndCoalescing()
+{
+  m_trEngine->EndCoalescing();
+}
+
+//! Sets a named savepoint in the currently open command.
+//! \param[in] theName name of the savepoint.
+void ActData_BaseModel::SetSavepoint(const TCollection_AsciiString& theName)
+{
+  m_trEngine->SetSavepoint(theName);
+}
+
+//! Rolls back the modifications made after the given savepoint keeping
+//! the command open. Use this instead of aborting the whole command if
+//! only its last steps have to be discarded.
+//! \param[in] theName name of the savepoint.
+void ActData_BaseModel::RollbackToSavepoint(const TCollection_AsciiString& theName)
+{
+  m_trEngine->RollbackToSavepoint(theName);
+}
+
+//! Releases the given savepoint keeping the modifications made after it.
+//! \param[in] theName name of the savepoint.
+void ActData_BaseModel::ReleaseSavepoint(const TCollection_AsciiString& theName)
+{
+  m_trEngine->ReleaseSavepoint(theName);
+}
+
+//! Checks whether the open command has a savepoint with the given name.
+//! \param[in] theName name of the savepoint.
+//! \return true/false.
+Standard_Boolean ActData_BaseModel::HasSavepoint(const TCollection_AsciiString& theName) const
+{
+  return m_trEngine->HasSavepoint(theName);
+}
+
+//! Sets the collector of per-commit statistics such as the number of
+//! attribute deltas by type, the retained bytes, the commit latency and
+//! the Labels with the largest backups. The collector survives
+//! re-initialization of the Data Model.
+//! \param[in] theStats statistics collector to set (null to disable).
+void ActData_BaseModel::SetTxStatistics(const Handle(ActData_TxStatistics)& theStats)
+{
+  m_txStats = theStats;
+
+  if ( !m_trEngine.IsNull() )
+    m_trEngine->SetStatistics(m_txStats);
+}
+
+//! Enables or disables the write-ahead journal. Once enabled, each commit,
+//! Undo and Redo appends a compact binary record of the touched attributes
+//! to the journal file residing next to the Document file (with ".jnl"
+//! extension appended). The journal is removed once the Document is
+//! released, so it remains on disk only if the application terminates
+//! abnormally. On opening, such a journal is replayed over the last full
+//! save, so that the committed changes survive a crash. Use
+//! HasRecoverableChanges() to offer the recovery to the user before opening,
+//! and DiscardJournal() to open the last full save instead. Enabling takes
+//! effect on the next Open() or SaveAs(). Disabling removes the journal.
+//! \param[in] isOn                   true to enable, false to disable.
+//! \param[in] theCompactionThreshold journal size in bytes at which the
+//!                                   Document is fully saved and the journal
+//!                                   is emptied (0 to disable compaction).
+void ActData_BaseModel::SetJournaling(const Standard_Boolean isOn,
+                                      const Standard_Size    theCompactionThreshold)
+{
+  m_bJournaling        = isOn;
+  m_journalCompactSize = theCompactionThreshold;
+
+  if ( !m_bJournaling && !m_journal.IsNull() )
+  {
+    m_journal->Remove();
+    m_journal.Nullify();
+    m_journalBase.Clear();
+
+    if ( !m_trEngine.IsNull() )
+      m_trEngine->SetJournal(m_journal);
+  }
+}
+
+//! Enables or disables keeping the meshes out of the Document. Once
+//! enabled, the mesh payloads are saved to the sidecar file residing next
+//! to the Document file (with ".adp" extension appended), and the Document
+//! stores the references to them. The payloads of the opened Document are
+//! memory-mapped and decoded lazily, on first access to each mesh. Saving
+//! the Document to the same file appends only the payloads which changed.
+//! Documents with the external payloads are opened regardless of this
+//! setting, which takes effect on the next SaveAs().
+//! \param isOn [in] true to enable, false to embed the meshes.
+void ActData_BaseModel::SetExternalPayloads(const Standard_Boolean isOn)
+{
+  m_bExternalPayloads = isOn;
+}
+
+//! Folds the journal into the full save of the Document. The Document is
+//! saved to the file it has been opened from (or saved to), and the journal
+//! is emptied. The modification status of the Data Model is kept as the
+//! compaction is not a user-level save.
+//! \return true in case of success, false -- otherwise.
+Standard_Boolean ActData_BaseModel::CompactJournal()
+{
+  if ( m_journal.IsNull() || m_journalBase.IsEmpty() || this->HasOpenCommand() )
+    return Standard_False;
+
+  const Standard_Integer status = m_status;
+  //
+  if ( !this->SaveAs(m_journalBase, nullptr) )
+    return Standard_False;
+
+  m_status = status;
+  return Standard_True;
+}
+
+//! Checks whether the given Document file has the journal left by an
+//! abnormal termination, i.e. whether there are committed changes which
+//! would be replayed by Open() with journaling enabled.
+//! \param[in] theFilename name of the Document file.
+//! \return true if there are changes to recover, false -- otherwise.
+Standard_Boolean
+  ActData_BaseModel::HasRecoverableChanges(const TCollection_AsciiString& theFilename)
+{
+  Handle(ActData_BinJournal) journal = new ActData_BinJournal(theFilename + ".jnl");
+  return journal->HasRecords();
+}
+
+//! Removes the journal of the given Document file, so that the changes
+//! left by an abnormal termination are not replayed on opening.
+//! \param[in] theFilename name of the Document file.
+//! \return true in case of success, false -- otherwise.
+Standard_Boolean
+  ActData_BaseModel::DiscardJournal(const TCollection_AsciiString& theFilename)
+{
+  Handle(ActData_BinJournal) journal = new ActData_BinJournal(theFilename + ".jnl");
+  return journal->Remove();
+}
+
+//! Binds the unresolved mesh payloads read from the just opened Document to
+//! the passed sidecar store. The store is local to the Document, so it is
+//! not known to the Mesh Attribute driver while the Document is being read.
+//! The Attributes whose payloads are not found in the store are left empty.
+//! \param[in] theDoc   opened Document.
+//! \param[in] theStore sidecar store of the Document.
+//! \return number of payloads which are not found.
+Standard_Integer
+  ActData_BaseModel::resolvePayloads(const Handle(TDocStd_Document)&         theDoc,
+                                     const Handle(ActData_MeshPayloadStore)& theStore)
+{
+  Standard_Integer nbUnresolved = 0;
+
+  for ( TDF_ChildIDIterator it(theDoc->Main().Root(), ActData_MeshAttr::GUID(), Standard_True); it.More(); it.Next() )
+  {
+    Handle(ActData_MeshAttr) aMeshAttr = Handle(ActData_MeshAttr)::DownCast( it.Value() );
+    //
+    const Handle(ActData_MeshPayload)& aPayload = aMeshAttr->GetPayload();
+    if ( aPayload.IsNull() || aPayload->IsResolved() )
+      continue;
+
+    Handle(ActData_MeshPayload) aResolved = aPayload->Resolve(theStore);
+    //
+    if ( aResolved.IsNull() )
+      nbUnresolved++;
+
+    aMeshAttr->SetPayload(aResolved);
+  }
+
+  return nbUnresolved;
+}
+
+//! Binds the Data Model to the journal of the given Document file.
+//! \param[in] theFilename name of the Document file.
+//! \param[in] toReplay    true to replay the existing journal over the
+//!                        Document, false to start the journal over.
+void ActData_BaseModel::attachJournal(const TCollection_AsciiString& theFilename,
+                                      const Standard_Boolean         toReplay)
+{
+  // Changes of the previously bound file are saved to the new one
+  if ( !m_journal.IsNull() )
+    m_journal->Remove();
+
+  m_journal     = new ActData_BinJournal(theFilename + ".jnl");
+  m_journalBase = theFilename;
+
+  Standard_Boolean isOk;
+  if ( toReplay )
+  {
+    // Records are applied directly as they are already committed
+    m_trEngine->DisableTransactions();
+    const Standard_Integer nbReplayed = m_journal->Replay(m_doc);
+    m_trEngine->EnableTransactions();
+
+    if ( nbReplayed )
+    {
+      // Replayed records could have changed the children and the Document
+      // differs from its full save now
+      ActData_ChildIndex::Release(m_rootLabel);
+      this->InvalidateSnapshots();
+      m_status |= MS_Modified;
+    }
+
+    isOk = m_journal->Open();
+  }
+  else
+    isOk = m_journal->Truncate();
+
+  if ( !isOk )
+  {
+    m_journal.Nullify();
+    m_journalBase.Clear();
+  }
+
+  m_trEngine->SetJournal(m_journal);
+}
+
 //! \return map of Data Node IDs modified in the current transaction.
 Handle(ActAPI_HNodeIdMap) ActData_BaseModel::GetModifiedNodes() const
 {
@@ -492,6 +850,146 @@ Handle(ActAPI_HNodeIdMap) ActData_BaseModel::GetModifiedNodes() const
   return res;
 }
 
+//----------------------------------------------------------------------------
+// Change feed
+//----------------------------------------------------------------------------
+
+//! Subscribes the passed observer to the change feed of the Data Model.
+//! The observer is notified after each commit, undo and redo with the
+//! added, removed and modified Nodes and Parameters. Unlike
+//! GetModifiedNodes(), the feed is built right from the OCAF delta, so no
+//! string manipulations are required to get the Node IDs.
+//! \param theObserver [in] observer to subscribe.
+void ActData_BaseModel::AddChangeObserver(const Handle(ActAPI_IChangeObserver)& theObserver)
+{
+  m_trEngine->AddChangeObserver(theObserver);
+}
+
+//! Unsubscribes the passed observer from the change feed of the Data Model.
+//! \param theObserver [in] observer to unsubscribe.
+void ActData_BaseModel::RemoveChangeObserver(const Handle(ActAPI_IChangeObserver)& theObserver)
+{
+  m_trEngine->RemoveChangeObserver(theObserver);
+}
+
+//! \return change feed of the last transactional operation or null handle
+//!         if nobody is subscribed to the change feed.
+Handle(ActAPI_ChangeFeed) ActData_BaseModel::LastChangeFeed() const
+{
+  return m_trEngine->LastChangeFeed();
+}
+
+//----------------------------------------------------------------------------
+// Snapshots for concurrent reading
+//----------------------------------------------------------------------------
+
+//! Captures an immutable snapshot of the requested Partitions. The snapshot
+//! can be queried from many threads concurrently, while the Data Model
+//! itself is being modified. Partitions which were not modified since the
+//! previous snapshot are shared with it. Capturing itself accesses OCAF,
+//! so it has to be done from the thread owning the Data Model.
+//! \param thePartitionIds [in] IDs of the Partitions to capture. If empty,
+//!        all Partitions are captured.
+//! \return snapshot.
+Handle(ActData_ModelSnapshot)
+  ActData_BaseModel::CaptureSnapshot(const TColStd_PackedMapOfInteger& thePartitionIds)
+{
+  if ( m_snapshotBuilder.IsNull() )
+  {
+    m_snapshotBuilder = new ActData_SnapshotBuilder;
+    this->AddChangeObserver(m_snapshotBuilder);
+  }
+
+  ActData_SnapshotBuilder::t_partitions partitions;
+  //
+  for ( PartitionMap::Iterator it(*m_partitionMap); it.More(); it.Next() )
+  {
+    if ( thePartitionIds.IsEmpty() || thePartitionIds.Contains( it.Key() ) )
+      partitions.Bind( it.Key(), it.Value() );
+  }
+
+  return m_snapshotBuilder->Capture(partitions);
+}
+
+//! Forces the next snapshot to capture all Partitions anew. Use this method
+//! after modifications made with transactions disabled as such modifications
+//! are not reported in the change feed.
+void ActData_BaseModel::InvalidateSnapshots()
+{
+  if ( !m_snapshotBuilder.IsNull() )
+    m_snapshotBuilder->Invalidate();
+}
+
+//----------------------------------------------------------------------------
+// Change-set diff
+//----------------------------------------------------------------------------
+
+//! Captures the content hashes of all Nodes of the Data Model.
+//! \return digest of the current state.
+Handle(ActData_ModelDigest) ActData_BaseModel::CaptureDigest() const
+{
+  ActData_ModelDigest::t_partitions partitions;
+  //
+  for ( PartitionMap::Iterator it(*m_partitionMap); it.More(); it.Next() )
+    partitions.Append( it.Value() );
+
+  return new ActData_ModelDigest(partitions);
+}
+
+//! Computes the difference between the state the Data Model had the given
+//! number of Undo steps ago and the current state. The Document is rolled
+//! back and forth without notifying the observers and without affecting
+//! the Undo/Redo history.
+//! \param theNbUndoes [in] number of Undo steps to look back.
+//! \return difference from the earlier state to the current one.
+Handle(ActData_ModelDiff)
+  ActData_BaseModel::DiffWithUndo(const Standard_Integer theNbUndoes)
+{
+  if ( this->HasOpenCommand() )
+    Standard_ProgramError::Raise("Diff is not allowed with open command");
+
+  Handle(ActData_ModelDigest) later = this->CaptureDigest();
+
+  // The Document is brought back even if the digest cannot be captured
+  const Standard_Integer nbRewound = m_trEngine->rewind(theNbUndoes);
+  Handle(ActData_ModelDigest) earlier;
+  try
+  {
+    earlier = this->CaptureDigest();
+  }
+  catch ( ... )
+  {
+    m_trEngine->forward(nbRewound);
+    throw;
+  }
+  m_trEngine->forward(nbRewound);
+
+  return ActData_ModelDiff::Compute(earlier, later);
+}
+
+//! Computes the difference between the Data Model stored in the given file
+//! and the current state. The file is opened with a clone of this Data
+//! Model, which is released once its digest is captured. The file must not
+//! be the one this Data Model was opened from or saved to, as OCAF does
+//! not retrieve the same Document twice (use DiffWithUndo() instead).
+//! \param theFilename [in] file of the Data Model to compare with.
+//! \return difference from the stored state to the current one or null
+//!         handle if the file cannot be opened.
+Handle(ActData_ModelDiff)
+  ActData_BaseModel::DiffWithFile(const TCollection_AsciiString& theFilename) const
+{
+  Handle(ActData_BaseModel)
+    other = Handle(ActData_BaseModel)::DownCast( this->Clone() );
+
+  if ( other.IsNull() || !other->Open(theFilename, nullptr) )
+    return NULL;
+
+  Handle(ActData_ModelDigest) earlier = other->CaptureDigest();
+  other->Release();
+
+  return ActData_ModelDiff::Compute( earlier, this->CaptureDigest() );
+}
+
 //----------------------------------------------------------------------------
 // Services for working with Data Model structure
 //----------------------------------------------------------------------------
@@ -1319,6 +1817,12 @@ void ActData_BaseModel::FuncPlotterOff()
 //! Cleans up the LogBook section.
 void ActData_BaseModel::FuncReleaseLogBook()
 {
+  if ( !m_packedLogBook.IsNull() )
+  {
+    m_packedLogBook->Release(ActData_PackedLogBook::Flag_All);
+    return;
+  }
+
   TDF_Label aLogBookLab = this->accessLogBookSection(Standard_False);
 
   if ( !aLogBookLab.IsNull() )
@@ -1341,6 +1845,23 @@ void ActData_BaseModel::FuncSetExecutionFlags(const Standard_Integer theFlags)
   m_iFuncExecutionFlags = theFlags;
 }
 
+//! Switches the LogBook between the OCAF-based and the packed storage. In
+//! the packed mode, TOUCHED, IMPACTED, FORCED and HEAVY DEPLOYMENT records
+//! are kept as transient bit flags which are synchronized with Undo/Redo
+//! by the Transaction Engine. Such records are never persisted, which is
+//! the same as for the OCAF-based LogBook whose attributes have no storage
+//! drivers. The records existing at the moment of switching are not
+//! migrated, so the mode should be chosen before any modification is done.
+//! \param isOn [in] true to enable the packed LogBook, false -- to get back
+//!        to the OCAF-based one.
+void ActData_BaseModel::SetPackedLogBook(const Standard_Boolean isOn)
+{
+  m_bPackedLogBook = isOn;
+
+  if ( !m_rootLabel.IsNull() )
+    this->applyLogBookMode();
+}
+
 //----------------------------------------------------------------------------
 // Construction internals
 //----------------------------------------------------------------------------
@@ -1409,10 +1930,36 @@ void ActData_BaseModel::init(const Handle(TDocStd_Document)& theDoc)
   // Initialize Engines
   m_funcCtx = new ActData_FuncExecutionCtx();
   m_copyPasteEngine = new ActData_CopyPasteEngine(this);
+  //
+  Handle(ActData_TransactionEngine) prevTrEngine = m_trEngine;
   if ( m_bSimpleTxMode )
     m_trEngine = new ActData_TransactionEngine(m_doc);
   else
     m_trEngine = new ActData_ExtTransactionEngine(m_doc);
+
+  // Change observers, the Undo memory cap, the coalescing window, the
+  // statistics collector and the journal survive re-initialization of the
+  // Data Model
+  if ( !prevTrEngine.IsNull() )
+    m_trEngine->m_changeObservers = prevTrEngine->m_changeObservers;
+
+  if ( m_undoMemLimit )
+    m_trEngine->SetUndoMemoryLimit(m_undoMemLimit);
+
+  m_trEngine->SetCoalescingWindow(m_fCoalesceWindow);
+  m_trEngine->SetStatistics(m_txStats);
+  m_trEngine->SetJournal(m_journal);
+
+  // Snapshots of another Document cannot be reused
+  this->InvalidateSnapshots();
+
+  // Transient state of the Document is settled out of any transaction,
+  // so that Undo/Redo never remove it
+  m_trEngine->DisableTransactions();
+  ActData_DocumentStateAttr::Set(m_rootLabel);
+  m_trEngine->EnableTransactions();
+
+  this->applyLogBookMode();
 }
 
 //! Creates new CAF Document.
@@ -1704,3 +2251,20 @@ TDF_Label ActData_BaseModel::accessLogBookSection(const Standard_Boolean toCreat
 {
   return m_rootLabel.FindChild(StructureTag_LogBook, toCreate);
 }
+
+//! Attaches or detaches the packed LogBook for the underlying Document
+//! according to the current LogBook mode.
+void ActData_BaseModel::applyLogBookMode()
+{
+  if ( m_bPackedLogBook )
+  {
+    if ( m_packedLogBook.IsNull() )
+      m_packedLogBook = new ActData_PackedLogBook();
+  }
+  else
+    m_packedLogBook.Nullify();
+
+  ActData_DocumentStateAttr::Find(m_rootLabel)->SetPackedLogBook(m_packedLogBook);
+
+  m_trEngine->SetPackedLogBook(m_packedLogBook);
+}
@@ -39,6 +39,9 @@
 #include <ActData_CopyPasteEngine.h>
 #include <ActData_FuncExecutionCtx.h>
 #include <ActData_LogBook.h>
+#include <ActData_MeshPayloadStore.h>
+#include <ActData_ModelDiff.h>
+#include <ActData_SnapshotBuilder.h>
 
 // Active Data (API) includes
 #include <ActAPI_IModel.h>
@@ -185,6 +188,136 @@ public:
   ActData_EXPORT virtual Handle(ActAPI_HNodeIdMap)
     GetModifiedNodes() const;
 
+  ActData_EXPORT void
+    SetUndoMemoryLimit(const Standard_Size theNbBytes);
+
+  //! \return memory cap for the Undo history in bytes (0 for unlimited).
+  Standard_Size GetUndoMemoryLimit() const
+  {
+    return m_undoMemLimit;
+  }
+
+  ActData_EXPORT Standard_Size
+    GetUndoMemoryUsage() const;
+
+  ActData_EXPORT void
+    SetCoalescingWindow(const Standard_Real theSeconds);
+
+  //! \return time window in seconds for the consecutive commits to be
+  //!         coalesced (0 if disabled).
+  Standard_Real GetCoalescingWindow() const
+  {
+    return m_fCoalesceWindow;
+  }
+
+  ActData_EXPORT void
+    BeginCoalescing(const TCollection_AsciiString& theKey);
+
+  ActData_EXPORT void
+    EndCoalescing();
+
+  ActData_EXPORT void
+    SetSavepoint(const TCollection_AsciiString& theName);
+
+  ActData_EXPORT void
+    RollbackToSavepoint(const TCollection_AsciiString& theName);
+
+  ActData_EXPORT void
+    ReleaseSavepoint(const TCollection_AsciiString& theName);
+
+  ActData_EXPORT Standard_Boolean
+    HasSavepoint(const TCollection_AsciiString& theName) const;
+
+  ActData_EXPORT void
+    SetTxStatistics(const Handle(ActData_TxStatistics)& theStats);
+
+  //! \return collector of per-commit statistics (null if disabled).
+  const Handle(ActData_TxStatistics)& GetTxStatistics() const
+  {
+    return m_txStats;
+  }
+
+// Journaling:
+public:
+
+  ActData_EXPORT void
+    SetJournaling(const Standard_Boolean isOn,
+                  const Standard_Size    theCompactionThreshold = 0);
+
+  //! \return true if the committed changes are journaled.
+  Standard_Boolean IsJournaling() const
+  {
+    return m_bJournaling;
+  }
+
+  //! \return write-ahead journal of the Document (null if the Document has
+  //!         not been opened or saved with journaling on).
+  const Handle(ActData_BinJournal)& GetJournal() const
+  {
+    return m_journal;
+  }
+
+  ActData_EXPORT Standard_Boolean
+    CompactJournal();
+
+  ActData_EXPORT static Standard_Boolean
+    HasRecoverableChanges(const TCollection_AsciiString& theFilename);
+
+  ActData_EXPORT static Standard_Boolean
+    DiscardJournal(const TCollection_AsciiString& theFilename);
+
+// External payloads:
+public:
+
+  ActData_EXPORT void
+    SetExternalPayloads(const Standard_Boolean isOn);
+
+  //! \return true if the meshes are saved out of the Document.
+  Standard_Boolean IsExternalPayloads() const
+  {
+    return m_bExternalPayloads;
+  }
+
+  //! \return sidecar store of the Document (null if the Document has not
+  //!         been opened or saved yet).
+  const Handle(ActData_MeshPayloadStore)& GetPayloadStore() const
+  {
+    return m_payloads;
+  }
+
+// Change feed:
+public:
+
+  ActData_EXPORT void
+    AddChangeObserver(const Handle(ActAPI_IChangeObserver)& theObserver);
+
+  ActData_EXPORT void
+    RemoveChangeObserver(const Handle(ActAPI_IChangeObserver)& theObserver);
+
+  ActData_EXPORT Handle(ActAPI_ChangeFeed)
+    LastChangeFeed() const;
+
+// Snapshots for concurrent reading:
+public:
+
+  ActData_EXPORT Handle(ActData_ModelSnapshot)
+    CaptureSnapshot(const TColStd_PackedMapOfInteger& thePartitionIds = TColStd_PackedMapOfInteger());
+
+  ActData_EXPORT void
+    InvalidateSnapshots();
+
+// Change-set diff:
+public:
+
+  ActData_EXPORT Handle(ActData_ModelDigest)
+    CaptureDigest() const;
+
+  ActData_EXPORT Handle(ActData_ModelDiff)
+    DiffWithUndo(const Standard_Integer theNbUndoes);
+
+  ActData_EXPORT Handle(ActData_ModelDiff)
+    DiffWithFile(const TCollection_AsciiString& theFilename) const;
+
 // Services for managing Document's structure:
 public:
 
@@ -323,6 +456,16 @@ public:
   ActData_EXPORT virtual void
     FuncSetExecutionFlags(const Standard_Integer theFlags);
 
+  ActData_EXPORT void
+    SetPackedLogBook(const Standard_Boolean isOn);
+
+  //! \return true if the LogBook records are kept in the transient packed
+  //!         storage instead of OCAF attributes.
+  Standard_Boolean IsPackedLogBook() const
+  {
+    return m_bPackedLogBook;
+  }
+
 public:
 
   //! Default implementation of this method does not nothing but returns `true`.
@@ -391,6 +534,20 @@ protected:
   ActData_EXPORT virtual Handle(ActData_CAFConverter)
     converterFw();
 
+// Mesh payload internals:
+private:
+
+  static Standard_Integer
+    resolvePayloads(const Handle(TDocStd_Document)&         theDoc,
+                    const Handle(ActData_MeshPayloadStore)& theStore);
+
+// Journaling internals:
+private:
+
+  void
+    attachJournal(const TCollection_AsciiString& theFilename,
+                  const Standard_Boolean         toReplay);
+
 // Copy & Paste internals:
 private:
 
@@ -406,6 +563,9 @@ private:
   TDF_Label
     accessLogBookSection(const Standard_Boolean toCreate = Standard_True);
 
+  void
+    applyLogBookMode();
+
 // Construction internals for descendant classes:
 private:
 
@@ -476,6 +636,36 @@ private:
   //! Flags for fine-tuning Execution process of Tree Functions.
   Standard_Integer m_iFuncExecutionFlags;
 
+  //! Indicates whether the LogBook records are kept in the packed storage.
+  Standard_Boolean m_bPackedLogBook;
+
+  //! Memory cap for the Undo history in bytes (0 for unlimited).
+  Standard_Size m_undoMemLimit;
+
+  //! Time window in seconds for the commits to be coalesced (0 to disable).
+  Standard_Real m_fCoalesceWindow;
+
+  //! Collector of per-commit statistics (null if disabled).
+  Handle(ActData_TxStatistics) m_txStats;
+
+  //! Indicates whether the committed changes are journaled.
+  Standard_Boolean m_bJournaling;
+
+  //! Journal size in bytes triggering compaction (0 to disable).
+  Standard_Size m_journalCompactSize;
+
+  //! Write-ahead journal of the Document.
+  Handle(ActData_BinJournal) m_journal;
+
+  //! File of the last full save which the journal complements.
+  TCollection_AsciiString m_journalBase;
+
+  //! Indicates whether the meshes are saved to the sidecar file.
+  Standard_Boolean m_bExternalPayloads;
+
+  //! Sidecar store of the mesh payloads of the Document.
+  Handle(ActData_MeshPayloadStore) m_payloads;
+
 // Data containers:
 private:
 
@@ -503,6 +693,12 @@ private:
   //! Execution context for Tree Functions.
   Handle(ActData_FuncExecutionCtx) m_funcCtx;
 
+  //! Packed LogBook (used only if the packed mode is on).
+  Handle(ActData_PackedLogBook) m_packedLogBook;
+
+  //! Builder of snapshots (allocated on first request).
+  Handle(ActData_SnapshotBuilder) m_snapshotBuilder;
+
 };
 
 #endif
@@ -381,27 +381,30 @@ Handle(ActAPI_IChildIterator)
   return new ActData_BaseChildIterator(this, isAllLevels);
 }
 
-//! Provides "direct" access to the child Node by its one-based index.
-//! This method is actually based on iterator, so do not expect too much
-//! from its performance.
+//! Provides direct access to the child Node by its one-based index. The
+//! access is served by the cached child index, so only the first call after
+//! a change in the children walks the Tree Node list.
 //! \param oneBased_idx [in] 1-based index of the child Node to access.
-//! \return child Node.
+//! \return child Node or null handle if the index is out of range.
 Handle(ActAPI_INode)
   ActData_BaseNode::GetChildNode(const Standard_Integer oneBased_idx) const
 {
-  Handle(ActAPI_IChildIterator) cit = this->GetChildIterator();
-  //
-  int                  current_idx = 1;
-  Handle(ActAPI_INode) current_n;
-  //
-  while ( current_idx < oneBased_idx )
-  {
-    ++current_idx;
-    cit->Next();
-  }
-  current_n = cit->Value();
+  return ActData_ChildIndex::Access(m_label)->Child(oneBased_idx);
+}
+
+//! \return number of direct children of this Node.
+Standard_Integer ActData_BaseNode::GetNbChildren() const
+{
+  return ActData_ChildIndex::Access(m_label)->NbChildren();
+}
 
-  return current_n;
+//! Returns cached index of the direct children of this Node. The index
+//! gives access to the children by their positions without settling
+//! the Nodes which are not requested.
+//! \return child index.
+Handle(ActData_ChildIndex) ActData_BaseNode::GetChildIndex() const
+{
+  return ActData_ChildIndex::Access(m_label);
 }
 
 //! Collects all children of this Node.
@@ -409,17 +412,11 @@ Handle(ActAPI_INode)
 //! \return number of children.
 int ActData_BaseNode::GetChildren(Handle(ActAPI_HNodeList)& theChildren) const
 {
-  int res = 0;
-  theChildren = new ActAPI_HNodeList;
-
-  for ( Handle(ActAPI_IChildIterator) cit = this->GetChildIterator();
-        cit->More(); cit->Next() )
-  {
-    theChildren->Append( cit->Value() );
-    ++res;
-  }
+  Handle(ActData_ChildIndex) index = ActData_ChildIndex::Access(m_label);
+  //
+  theChildren = index->Children( 1, index->NbChildren() );
 
-  return res;
+  return theChildren->Extent();
 }
 
 //! Adds a child Node to this one.
@@ -439,12 +436,82 @@ void ActData_BaseNode::AddChildNode(const Handle(ActAPI_INode)& theNode)
   // Put record into LogBook
   //-------------------------
 
-  // Prepare LogBook Data Cursor
-  TDF_Label aLogBookSection =
-    m_label.Root().FindChild(ActData_BaseModel::StructureTag_LogBook);
+  // IMPACT record is placed today
+  ActData_LogBook::Access(m_label).Impact(m_label);
+}
+
+//! Adds a batch of child Nodes to this one. Unlike calling AddChildNode()
+//! in a loop, the new children are chained one after another without
+//! re-scanning the sibling list, and a single IMPACT record is placed
+//! into the LogBook for the whole batch. The batch is validated before
+//! anything is changed: if any of the Nodes is null, detached, or is this
+//! Node or one of its ancestors, none of the Nodes is added.
+//! \param theNodes [in] child Nodes to add (in order).
+//! \return true in case of success, false -- otherwise.
+Standard_Boolean ActData_BaseNode::AddChildNodes(const Handle(ActAPI_HNodeList)& theNodes)
+{
+  if ( theNodes.IsNull() || theNodes->IsEmpty() )
+    return Standard_True;
+
+  // Validate the whole batch before changing anything
+  for ( ActAPI_NodeList::Iterator nit(*theNodes); nit.More(); nit.Next() )
+    if ( !this->isAcceptableChild( Handle(ActData_BaseNode)::DownCast( nit.Value() ) ) )
+      return Standard_False;
+
+  // Let this method recover possibly missing parent Tree Node attribute
+  Handle(TDataStd_TreeNode) aParentTN = m_paramScope.Meta->GetCAFTreeNode();
+  if ( aParentTN.IsNull() )
+  {
+    aParentTN = TDataStd_TreeNode::Set( m_paramScope.Meta->RootLabel(),
+                                        TDataStd_TreeNode::GetDefaultTreeID() );
+  }
+
+  // Find the current last child once
+  Handle(TDataStd_TreeNode) aPrevTN = aParentTN->Last();
+  //
+  ActData_ChildIndex::Invalidate(m_label);
+
+  for ( ActAPI_NodeList::Iterator nit(*theNodes); nit.More(); nit.Next() )
+  {
+    Handle(ActData_BaseNode)
+      BN = Handle(ActData_BaseNode)::DownCast( nit.Value() );
+    //
+    Handle(ActData_MetaParameter) aChildMeta = BN->m_paramScope.Meta;
+
+    // Let this method recover possibly missing child Tree Node attribute
+    Handle(TDataStd_TreeNode) aChildTN = aChildMeta->GetCAFTreeNode();
+    if ( aChildTN.IsNull() )
+    {
+      aChildTN = TDataStd_TreeNode::Set( aChildMeta->RootLabel(),
+                                         TDataStd_TreeNode::GetDefaultTreeID() );
+    }
+    else if ( aChildTN == aPrevTN )
+    {
+      continue; // Already the last child
+    }
+    else if ( aChildTN->HasFather() )
+    {
+      ActData_ChildIndex::Invalidate( aChildTN->Father()->Label().Father() );
+      aChildTN->Remove();
+    }
+
+    // Chain after the previously added sibling
+    if ( aPrevTN.IsNull() )
+      aParentTN->Prepend(aChildTN);
+    else
+      aPrevTN->InsertAfter(aChildTN);
+
+    aPrevTN = aChildTN;
+  }
+
+  //-------------------------
+  // Put record into LogBook
+  //-------------------------
 
   // IMPACT record is placed today
-  ActData_LogBook(aLogBookSection).Impact(m_label);
+  ActData_LogBook::Access(m_label).Impact(m_label);
+
+  return Standard_True;
 }
 
 //! Attempts to remove the passed Data Node as child one.
@@ -468,12 +535,8 @@ Standard_Boolean ActData_BaseNode::RemoveChildNode(const Handle(ActAPI_INode)& t
 
   if ( isOk )
   {
-    // Prepare LogBook Data Cursor
-    TDF_Label aLogBookSection =
-      m_label.Root().FindChild(ActData_BaseModel::StructureTag_LogBook);
-
     // IMPACT record is placed today
-    ActData_LogBook(aLogBookSection).Impact(m_label);
+    ActData_LogBook::Access(m_label).Impact(m_label);
   }
 
   return isOk;
@@ -988,6 +1051,29 @@ void ActData_BaseNode::registerParameter(const Standard_Integer               th
   }
 }
 
+//! Checks that the passed Node can become a child of this one. Neither
+//! this Node nor any of its ancestors can, as that would make a cycle in
+//! the tree.
+//! \param theNode [in] candidate child Node.
+//! \return true if the Node is acceptable, false -- otherwise.
+Standard_Boolean
+  ActData_BaseNode::isAcceptableChild(const Handle(ActData_BaseNode)& theNode) const
+{
+  if ( theNode.IsNull() || theNode->IsDetached() || theNode->m_label == m_label )
+    return Standard_False;
+
+  Handle(TDataStd_TreeNode) aChildTN = theNode->m_paramScope.Meta->GetCAFTreeNode();
+  if ( aChildTN.IsNull() )
+    return Standard_True; // Not in the tree, so cannot be an ancestor
+
+  for ( Handle(TDataStd_TreeNode) aTN = m_paramScope.Meta->GetCAFTreeNode(); !aTN.IsNull(); aTN = aTN->Father() )
+  {
+    if ( aTN == aChildTN )
+      return Standard_False;
+  }
+  return Standard_True;
+}
+
 //! Node removal routine. This method deletes the Node with all existing
 //! references gracefully. It should be noted that as a result of this
 //! method the Execution Graph can happen to be modified.
@@ -1139,6 +1225,14 @@ void ActData_BaseNode::remove(const Standard_Boolean canAffectExGraph)
    *  Clean up the Node itself
    * ========================== */
 
+  // Forgetting the Tree Node detaches this Node from its parent, so the
+  // cached child indices of both are dropped
+  Handle(TDataStd_TreeNode) aTreeNode = m_paramScope.Meta->GetCAFTreeNode();
+  if ( !aTreeNode.IsNull() && aTreeNode->HasFather() )
+    ActData_ChildIndex::Invalidate( aTreeNode->Father()->Label().Father() );
+  //
+  ActData_ChildIndex::Invalidate(m_label);
+
   ActData_Utils::RemoveWithReferences(m_label);
 }
 
@@ -1334,8 +1428,12 @@ Handle(ActAPI_HParameterList)
 //! \param isExpanding [in] indicates whether to fill OCAF with data or to use
 //!                         the existing OCAF structure (must be compatible
 //!                         with the format of Node).
-void ActData_BaseNode::attach(const TDF_Label&       theLabel,
-                              const Standard_Boolean isExpanding)
+//! \param theMTime    [in] modification time to stamp the expanded user
+//!                         Parameters with (if null, each Parameter is
+//!                         stamped on its own).
+void ActData_BaseNode::attach(const TDF_Label&         theLabel,
+                              const Standard_Boolean   isExpanding,
+                              const Handle(HIntArray)& theMTime)
 {
   // Settle Node to the passed TDF Label
   m_label = theLabel;
@@ -1361,6 +1459,9 @@ void ActData_BaseNode::attach(const TDF_Label&       theLabel,
    *  to sub-Labels of USER sub-container
    * =========================================================== */
 
+  // Root of USER sub-container is resolved once for all Parameters
+  TDF_Label aParamLabRoot;
+  //
   for ( auto pid = m_paramScope.User->cbegin(); pid != m_paramScope.User->cend(); ++pid )
   {
     const Handle(ActData_UserParameter)& aBaseParam =
@@ -1369,10 +1470,17 @@ void ActData_BaseNode::attach(const TDF_Label&       theLabel,
     Standard_Integer aNewTag = pid->first;
 
     // Allow construction of sub-Labels in EXPANDING mode ONLY
-    TDF_Label aParamLabRoot = m_label.FindChild(TagUser, isExpanding);
+    if ( aParamLabRoot.IsNull() )
+      aParamLabRoot = m_label.FindChild(TagUser, isExpanding);
+    //
     TDF_Label aParamLab = aParamLabRoot.FindChild(aNewTag, isExpanding);
 
-    isExpanding ? aBaseParam->expandOn(aParamLab) : aBaseParam->settleOn(aParamLab);
+    if ( !isExpanding )
+      aBaseParam->settleOn(aParamLab);
+    else if ( theMTime.IsNull() )
+      aBaseParam->expandOn(aParamLab);
+    else
+      aBaseParam->expandOn(aParamLab, theMTime);
   }
 }
 
@@ -34,6 +34,7 @@
 #define ActData_BaseNode_HeaderFile
 
 // Active Data includes
+#include <ActData_ChildIndex.h>
 #include <ActData_IntParameter.h>
 #include <ActData_MetaParameter.h>
 #include <ActData_NameParameter.h>
@@ -335,12 +336,21 @@ public:
   ActData_EXPORT virtual Handle(ActAPI_INode)
     GetChildNode(const Standard_Integer oneBased_idx) const;
 
+  ActData_EXPORT virtual Standard_Integer
+    GetNbChildren() const;
+
+  ActData_EXPORT Handle(ActData_ChildIndex)
+    GetChildIndex() const;
+
   ActData_EXPORT virtual int
     GetChildren(Handle(ActAPI_HNodeList)& theChildren) const;
 
   ActData_EXPORT virtual void
     AddChildNode(const Handle(ActAPI_INode)& theNode);
 
+  ActData_EXPORT virtual Standard_Boolean
+    AddChildNodes(const Handle(ActAPI_HNodeList)& theNodes);
+
   ActData_EXPORT virtual Standard_Boolean
     RemoveChildNode(const Handle(ActAPI_INode)& theNode);
 
@@ -439,8 +449,9 @@ protected:
 protected:
 
   ActData_EXPORT void
-    attach(const TDF_Label& theLabel,
-           const Standard_Boolean isExpanding);
+    attach(const TDF_Label&         theLabel,
+           const Standard_Boolean   isExpanding,
+           const Handle(HIntArray)& theMTime = NULL);
 
   ActData_EXPORT Standard_Boolean
     canSettleOn(const TDF_Label& theLabel);
@@ -459,6 +470,9 @@ protected:
                       const Handle(ActAPI_IUserParameter)& theParam,
                       const Standard_Boolean isExpressible = Standard_False);
 
+  ActData_EXPORT Standard_Boolean
+    isAcceptableChild(const Handle(ActData_BaseNode)& theNode) const;
+
   ActData_EXPORT void
     remove(const Standard_Boolean canAffectExGraph);
 
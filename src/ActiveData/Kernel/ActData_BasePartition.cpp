@@ -34,10 +34,13 @@
 #include <ActData_BasePartition.h>
 
 // Active Data includes
+#include <ActData_BaseModel.h>
 #include <ActData_BaseNode.h>
+#include <ActData_NodeFactory.h>
 #include <ActData_Utils.h>
 
 // OCCT includes
+#include <TDF_TagSource.hxx>
 #include <TDF_Tool.hxx>
 
 /* =========================================================================
@@ -150,6 +153,64 @@ ActAPI_DataObjectId ActData_BasePartition::AddNode(const Handle(ActAPI_INode)& t
   return ActData_Utils::GetEntry(aNodeLab);
 }
 
+//! Creates the given number of Nodes of the Partition's type in one go.
+//! The tag source of the Partition is advanced once for the whole batch,
+//! and, if a parent Node is passed, all new Nodes are attached to it as
+//! children with a single IMPACT record in the LogBook.
+//!
+//! OCAF offers no way to reserve child Labels, so the Labels are created
+//! in ascending order of tags instead. Each new Label is then appended
+//! right after the last found child without scanning the siblings. The
+//! default data of all Parameters are created in one pass per Node, and
+//! all Parameters share one modification timestamp.
+//! \param theNbNodes [in] number of Nodes to create.
+//! \param theParent  [in] optional parent Node for the new ones.
+//! \return list of the created Nodes in the order of their tags.
+Handle(ActAPI_HNodeList)
+  ActData_BasePartition::AddNodes(const Standard_Integer      theNbNodes,
+                                  const Handle(ActAPI_INode)& theParent)
+{
+  Handle(ActAPI_HNodeList) aResult = new ActAPI_HNodeList;
+  if ( theNbNodes <= 0 )
+    return aResult;
+
+  // Check that the Partition's Node type is registered
+  TCollection_AsciiString aNodeType( this->GetNodeType()->Name() );
+  if ( !ActData_NodeFactory::GetAllocMap().IsBound(aNodeType) )
+    Standard_ProgramError::Raise("Unexpected Node type");
+
+  // Check the parent before creating anything
+  Handle(ActData_BaseNode) aParent = Handle(ActData_BaseNode)::DownCast(theParent);
+  if ( !theParent.IsNull() && ( aParent.IsNull() || aParent->IsDetached() ) )
+    Standard_ProgramError::Raise("Parent Node is not attached");
+
+  // Reserve the range of tags at once
+  Handle(TDF_TagSource) aTagSource = TDF_TagSource::Set(m_label);
+  const Standard_Integer aFirstTag = aTagSource->Get() + 1;
+  aTagSource->Set(aFirstTag + theNbNodes - 1);
+
+  // All Parameters of the batch share one modification timestamp
+  Handle(HIntArray) aMTime;
+  if ( ActData_BaseModel::MTime_On )
+    aMTime = ActAux_TimeStampTool::AsChunked( ActAux_TimeStampTool::Generate() );
+
+  // Expand Data Nodes on the new TDF Labels in ascending order of tags
+  for ( Standard_Integer tag = aFirstTag; tag < aFirstTag + theNbNodes; ++tag )
+  {
+    Handle(ActData_BaseNode)
+      aNode = Handle(ActData_BaseNode)::DownCast( ActData_NodeFactory::NodeInstanceByType(aNodeType) );
+    //
+    aNode->attach( m_label.FindChild(tag, Standard_True), Standard_True, aMTime );
+    aResult->Append(aNode);
+  }
+
+  // Attach to parent as a batch
+  if ( !aParent.IsNull() )
+    aParent->AddChildNodes(aResult);
+
+  return aResult;
+}
+
 Standard_Boolean
   ActData_BasePartition::GetNode(const Standard_Integer theNodeNum,
                                  const Handle(ActAPI_INode)& theNode) const
@@ -112,6 +112,10 @@ public:
   ActData_EXPORT virtual ActAPI_DataObjectId
     AddNode(const Handle(ActAPI_INode)& theNode);
 
+  ActData_EXPORT virtual Handle(ActAPI_HNodeList)
+    AddNodes(const Standard_Integer      theNbNodes,
+             const Handle(ActAPI_INode)& theParent = NULL);
+
   ActData_EXPORT virtual Standard_Boolean
     GetNode(const Standard_Integer theNodeNum,
             const Handle(ActAPI_INode)& theNode) const;
@@ -385,9 +385,7 @@ Standard_Boolean
   ActData_TreeFunctionDriver::MustExecute(const Handle(TFunction_Logbook)&) const
 {
   // Prepare LogBook Data Cursor
-  TDF_Label aLogBookSection =
-    this->Label().Root().FindChild(ActData_BaseModel::StructureTag_LogBook);
-  ActData_LogBook LogBook(aLogBookSection);
+  ActData_LogBook LogBook = ActData_LogBook::Access( this->Label() );
 
   // Tree Function
   if ( LogBook.IsForced( this->Label() ) )
@@ -0,0 +1,163 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <ActData_ChildIndex.h>
+
+// Active Data includes
+#include <ActData_BaseNode.h>
+#include <ActData_DocumentStateAttr.h>
+#include <ActData_NodeFactory.h>
+#include <ActData_Utils.h>
+
+// OCCT includes
+#include <TDataStd_ChildNodeIterator.hxx>
+
+//-----------------------------------------------------------------------------
+// Cache
+//-----------------------------------------------------------------------------
+
+//! Returns the child index for the Node settled on the given Label. The
+//! index is built if it is not cached yet. If the Document keeps no
+//! transient state, the index is built anew on each call.
+//! \param[in] theNodeLab root Label of the Node.
+//! \return child index.
+Handle(ActData_ChildIndex) ActData_ChildIndex::Access(const TDF_Label& theNodeLab)
+{
+  if ( theNodeLab.IsNull() )
+    Standard_ProgramError::Raise("Cannot access detached data");
+
+  Handle(ActData_DocumentStateAttr) state = ActData_DocumentStateAttr::Find(theNodeLab);
+  if ( state.IsNull() )
+    return new ActData_ChildIndex(theNodeLab);
+
+  ActData_DocumentStateAttr::t_childIndices& indices = state->ChangeChildIndices();
+  //
+  const Handle(ActData_ChildIndex)* pIndex = indices.Seek(theNodeLab);
+  if ( pIndex )
+    return *pIndex;
+
+  Handle(ActData_ChildIndex) index = new ActData_ChildIndex(theNodeLab);
+  indices.Bind(theNodeLab, index);
+  return index;
+}
+
+//! Drops the cached child index of the Node settled on the given Label.
+//! \param[in] theNodeLab root Label of the Node.
+void ActData_ChildIndex::Invalidate(const TDF_Label& theNodeLab)
+{
+  Handle(ActData_DocumentStateAttr) state = ActData_DocumentStateAttr::Find(theNodeLab);
+  //
+  if ( !state.IsNull() )
+    state->ChangeChildIndices().UnBind(theNodeLab);
+}
+
+//! Drops all cached child indices of the OCAF Document owning the given
+//! Label.
+//! \param[in] theLab any Label of the OCAF Document.
+void ActData_ChildIndex::Release(const TDF_Label& theLab)
+{
+  Handle(ActData_DocumentStateAttr) state = ActData_DocumentStateAttr::Find(theLab);
+  //
+  if ( !state.IsNull() )
+    state->ChangeChildIndices().Clear();
+}
+
+//! Checks whether the child index of the Node settled on the given Label
+//! is currently cached.
+//! \param[in] theNodeLab root Label of the Node.
+//! \return true/false.
+Standard_Boolean ActData_ChildIndex::IsCached(const TDF_Label& theNodeLab)
+{
+  Handle(ActData_DocumentStateAttr) state = ActData_DocumentStateAttr::Find(theNodeLab);
+  //
+  return !state.IsNull() && state->GetChildIndices().IsBound(theNodeLab);
+}
+
+//-----------------------------------------------------------------------------
+// Access
+//-----------------------------------------------------------------------------
+
+//! Settles the child Node with the given index.
+//! \param[in] oneBased_idx 1-based index of the child.
+//! \return child Node or null handle if the index is out of range.
+Handle(ActAPI_INode)
+  ActData_ChildIndex::Child(const Standard_Integer oneBased_idx) const
+{
+  if ( oneBased_idx < 1 || oneBased_idx > this->NbChildren() )
+    return NULL;
+
+  return ActData_NodeFactory::NodeSettle( this->ChildLabel(oneBased_idx) );
+}
+
+//! Settles the child Nodes in the given range of indices. The range is
+//! clamped to the available children.
+//! \param[in] oneBased_first 1-based index of the first child.
+//! \param[in] oneBased_last  1-based index of the last child.
+//! \return child Nodes.
+Handle(ActAPI_HNodeList)
+  ActData_ChildIndex::Children(const Standard_Integer oneBased_first,
+                               const Standard_Integer oneBased_last) const
+{
+  Handle(ActAPI_HNodeList) aResult = new ActAPI_HNodeList;
+  //
+  const Standard_Integer first = Max(oneBased_first, 1);
+  const Standard_Integer last  = Min( oneBased_last, this->NbChildren() );
+  //
+  for ( Standard_Integer i = first; i <= last; ++i )
+    aResult->Append( ActData_NodeFactory::NodeSettle( this->ChildLabel(i) ) );
+
+  return aResult;
+}
+
+//-----------------------------------------------------------------------------
+// Construction
+//-----------------------------------------------------------------------------
+
+//! Builds the index by walking the children of the given Node once.
+//! \param[in] theNodeLab root Label of the Node.
+ActData_ChildIndex::ActData_ChildIndex(const TDF_Label& theNodeLab)
+: Standard_Transient()
+{
+  TDF_Label aMetaLab = theNodeLab.FindChild(ActData_BaseNode::TagInternal, Standard_False);
+  if ( aMetaLab.IsNull() )
+    return;
+
+  Handle(TDataStd_TreeNode) aTreeNode = ActData_Utils::AccessTreeNode(aMetaLab, Standard_False);
+  if ( aTreeNode.IsNull() )
+    return;
+
+  // Use the convention that Tree Node attribute is nested into Internal
+  // scope of the Node, so the Node's Label is the father of its owner
+  for ( TDataStd_ChildNodeIterator it(aTreeNode, Standard_False); it.More(); it.Next() )
+    m_children.push_back( it.Value()->Label().Father() );
+}
@@ -0,0 +1,128 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+#ifndef ActData_ChildIndex_HeaderFile
+#define ActData_ChildIndex_HeaderFile
+
+// Active Data includes
+#include <ActData_Common.h>
+
+// Active Data (API) includes
+#include <ActAPI_INode.h>
+
+// OCCT includes
+#include <TDF_Label.hxx>
+
+// Standard includes
+#include <vector>
+
+DEFINE_STANDARD_HANDLE(ActData_ChildIndex, Standard_Transient)
+
+//! \ingroup AD_DF
+//!
+//! Cached index of the direct children of a Data Node. The children of a
+//! Node are stored in OCAF as a linked list of TDataStd_TreeNode attributes,
+//! so counting them or accessing the i-th one requires a walk over the list.
+//! The index flattens this list into an array of root Labels of the child
+//! Nodes, giving constant-time counts and random access. The child Nodes
+//! are not settled until requested, so ranges of children can be visited
+//! by Labels only.
+//!
+//! The indices are cached by ActData_DocumentStateAttr of the Document and
+//! are built on first access. An index is dropped as soon as the children
+//! of its Node change through the Active Data API or the Node itself is
+//! deleted. All indices of a Document are dropped on Commit, Abort, Undo and
+//! Redo, so the changes made directly in OCAF are taken into account once
+//! the command is closed.
+class ActData_ChildIndex : public Standard_Transient
+{
+public:
+
+  // OCCT RTTI
+  DEFINE_STANDARD_RTTI_INLINE(ActData_ChildIndex, Standard_Transient)
+
+// Cache:
+public:
+
+  ActData_EXPORT static Handle(ActData_ChildIndex)
+    Access(const TDF_Label& theNodeLab);
+
+  ActData_EXPORT static void
+    Invalidate(const TDF_Label& theNodeLab);
+
+  ActData_EXPORT static void
+    Release(const TDF_Label& theLab);
+
+  ActData_EXPORT static Standard_Boolean
+    IsCached(const TDF_Label& theNodeLab);
+
+// Access:
+public:
+
+  //! \return number of children.
+  Standard_Integer NbChildren() const
+  {
+    return (Standard_Integer) m_children.size();
+  }
+
+  //! Returns root Label of the child Node with the given index.
+  //! \param[in] oneBased_idx 1-based index of the child.
+  //! \return child Label.
+  const TDF_Label& ChildLabel(const Standard_Integer oneBased_idx) const
+  {
+    return m_children[oneBased_idx - 1];
+  }
+
+  //! \return root Labels of all children in their order.
+  const std::vector<TDF_Label>& Labels() const
+  {
+    return m_children;
+  }
+
+  ActData_EXPORT Handle(ActAPI_INode)
+    Child(const Standard_Integer oneBased_idx) const;
+
+  ActData_EXPORT Handle(ActAPI_HNodeList)
+    Children(const Standard_Integer oneBased_first,
+             const Standard_Integer oneBased_last) const;
+
+private:
+
+  ActData_ChildIndex(const TDF_Label& theNodeLab);
+
+private:
+
+  std::vector<TDF_Label> m_children; //!< Root Labels of child Nodes.
+
+};
+
+#endif
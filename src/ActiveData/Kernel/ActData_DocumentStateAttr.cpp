@@ -0,0 +1,98 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <ActData_DocumentStateAttr.h>
+
+// OCCT includes
+#include <Standard_GUID.hxx>
+
+//-----------------------------------------------------------------------------
+
+Handle(ActData_DocumentStateAttr) ActData_DocumentStateAttr::Set(const TDF_Label& label)
+{
+  const TDF_Label root = label.Root();
+
+  Handle(ActData_DocumentStateAttr) A;
+  //
+  if ( !root.FindAttribute(GUID(), A) )
+  {
+    A = new ActData_DocumentStateAttr();
+    root.AddAttribute(A);
+  }
+  return A;
+}
+
+//-----------------------------------------------------------------------------
+
+Handle(ActData_DocumentStateAttr) ActData_DocumentStateAttr::Find(const TDF_Label& label)
+{
+  Handle(ActData_DocumentStateAttr) A;
+  //
+  if ( !label.IsNull() )
+    label.Root().FindAttribute(GUID(), A);
+
+  return A;
+}
+
+//-----------------------------------------------------------------------------
+
+const Standard_GUID& ActData_DocumentStateAttr::GUID()
+{
+  static Standard_GUID AttrGUID("5E0C9F7A-3B21-4D8E-A6C4-1F92D7B03E58");
+  return AttrGUID;
+}
+
+//-----------------------------------------------------------------------------
+
+const Standard_GUID& ActData_DocumentStateAttr::ID() const
+{
+  return GUID();
+}
+
+//-----------------------------------------------------------------------------
+
+Handle(TDF_Attribute) ActData_DocumentStateAttr::NewEmpty() const
+{
+  return new ActData_DocumentStateAttr();
+}
+
+//-----------------------------------------------------------------------------
+
+void ActData_DocumentStateAttr::Restore(const Handle(TDF_Attribute)&)
+{}
+
+//-----------------------------------------------------------------------------
+
+void ActData_DocumentStateAttr::Paste(const Handle(TDF_Attribute)&,
+                                      const Handle(TDF_RelocationTable)&) const
+{}
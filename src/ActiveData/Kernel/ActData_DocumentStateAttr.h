@@ -0,0 +1,171 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+#ifndef ActData_DocumentStateAttr_HeaderFile
+#define ActData_DocumentStateAttr_HeaderFile
+
+// Active Data includes
+#include <ActData_ChildIndex.h>
+#include <ActData_MeshPayloadStore.h>
+#include <ActData_PackedLogBook.h>
+
+// OCCT includes
+#include <NCollection_DataMap.hxx>
+#include <TDF_Attribute.hxx>
+#include <TDF_LabelMapHasher.hxx>
+
+DEFINE_STANDARD_HANDLE(ActData_DocumentStateAttr, TDF_Attribute)
+
+//! \ingroup AD_DF
+//!
+//! OCAF Attribute keeping the transient state of a Document on its root
+//! Label, so that the state is found from any Label of the Document and
+//! goes away together with the Document. The Attribute is settled once
+//! out of any transaction and is never backed up, so Undo/Redo do not
+//! affect it. It has no storage driver, so it is not persisted.
+class ActData_DocumentStateAttr : public TDF_Attribute
+{
+public:
+
+  // OCCT RTTI
+  DEFINE_STANDARD_RTTI_INLINE(ActData_DocumentStateAttr, TDF_Attribute)
+
+public:
+
+  //! Cached child indices by root Labels of Nodes.
+  typedef NCollection_DataMap<TDF_Label,
+                              Handle(ActData_ChildIndex),
+                              TDF_LabelMapHasher> t_childIndices;
+
+public:
+
+  //! Default constructor.
+  ActData_DocumentStateAttr() = default;
+
+public:
+
+  //! Settles down new Attribute to the root of the Document owning the
+  //! given Label. The Document must not be in a transaction.
+  //! \param[in] label any Label of the Document.
+  //! \return Attribute settled down onto the root Label.
+  ActData_EXPORT static Handle(ActData_DocumentStateAttr)
+    Set(const TDF_Label& label);
+
+  //! Finds the Attribute on the root of the Document owning the given Label.
+  //! \param[in] label any Label of the Document.
+  //! \return Attribute or null handle if it is not settled.
+  ActData_EXPORT static Handle(ActData_DocumentStateAttr)
+    Find(const TDF_Label& label);
+
+  //! Returns statically defined GUID for the Attribute.
+  //! \return statically defined GUID.
+  ActData_EXPORT static const Standard_GUID&
+    GUID();
+
+// Attribute's core methods:
+public:
+
+  //! Accessor for GUID associated with this kind of OCAF Attribute.
+  //! \return GUID of the OCAF Attribute.
+  ActData_EXPORT virtual const Standard_GUID&
+    ID() const;
+
+  //! \return new instance of Attribute.
+  ActData_EXPORT virtual Handle(TDF_Attribute)
+    NewEmpty() const;
+
+  //! The transient state is never backed up, so there is nothing to restore.
+  //! \param[in] from OCAF Attribute to copy data from.
+  ActData_EXPORT virtual void
+    Restore(const Handle(TDF_Attribute)& from);
+
+  //! The transient state belongs to its Document, so it is not copied.
+  //! \param[in] into       where to paste.
+  //! \param[in] relocTable relocation table.
+  ActData_EXPORT virtual void
+    Paste(const Handle(TDF_Attribute)&       into,
+          const Handle(TDF_RelocationTable)& relocTable) const;
+
+// Getters/setters:
+public:
+
+  //! Sets the packed LogBook of the Document.
+  //! \param[in] logBook packed LogBook to set (null for the attribute-based
+  //!                    LogBook).
+  void SetPackedLogBook(const Handle(ActData_PackedLogBook)& logBook)
+  {
+    m_packedLogBook = logBook;
+  }
+
+  //! \return packed LogBook of the Document (null if the Document uses the
+  //!         attribute-based LogBook).
+  const Handle(ActData_PackedLogBook)& GetPackedLogBook() const
+  {
+    return m_packedLogBook;
+  }
+
+  //! Sets the sidecar store the meshes of the Document are saved to.
+  //! \param[in] store sidecar store to set (null to embed the meshes).
+  void SetPayloadStore(const Handle(ActData_MeshPayloadStore)& store)
+  {
+    m_payloads = store;
+  }
+
+  //! \return sidecar store the meshes of the Document are saved to (null
+  //!         if the meshes are embedded into the Document).
+  const Handle(ActData_MeshPayloadStore)& GetPayloadStore() const
+  {
+    return m_payloads;
+  }
+
+  //! \return cached child indices of the Document's Nodes.
+  t_childIndices& ChangeChildIndices()
+  {
+    return m_childIndices;
+  }
+
+  //! \return cached child indices of the Document's Nodes.
+  const t_childIndices& GetChildIndices() const
+  {
+    return m_childIndices;
+  }
+
+// Member fields:
+private:
+
+  Handle(ActData_PackedLogBook)    m_packedLogBook; //!< Packed LogBook.
+  Handle(ActData_MeshPayloadStore) m_payloads;      //!< Sidecar store of the meshes.
+  t_childIndices                   m_childIndices;  //!< Cached child indices.
+
+};
+
+#endif
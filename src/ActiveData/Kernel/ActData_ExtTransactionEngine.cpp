@@ -38,72 +38,92 @@
 //! \param UndoLimit [in] Undo Limit to set.
 ActData_ExtTransactionEngine::ActData_ExtTransactionEngine(const Handle(TDocStd_Document)& Doc,
                                                            const Standard_Integer UndoLimit)
-: ActData_TransactionEngine(Doc, UndoLimit)
+: ActData_TransactionEngine(Doc, UndoLimit),
+  m_iHead    (0),
+  m_iNbItems (0)
 {
 }
 
-//! Customized Undo method for extended transactions.
-//! \param theNbUndoes [in] number of Undo operations to perform one-by-one.
-//! \return affected Parameters.
-Handle(ActAPI_TxRes)
-  ActData_ExtTransactionEngine::Undo(const Standard_Integer theNbUndoes)
+//! Commits current transaction without user data. An empty data item is
+//! bound to the committed delta, so that the history remains aligned with
+//! the deltas stacked by the Document.
+void ActData_ExtTransactionEngine::CommitCommand()
 {
-  if ( m_undoData.IsEmpty() )
-    return NULL; // There is nothing to Undo
+  this->CommitCommandExt( ActAPI_TxData() );
+}
 
-  // Perform actual Undo
-  Handle(ActAPI_TxRes)
-    result = ActData_TransactionEngine::Undo(theNbUndoes);
+//! Commits current transaction.
+//! \param theData [in] user-data to bind to transaction being committed.
+void ActData_ExtTransactionEngine::CommitCommandExt(const ActAPI_TxData& theData)
+{
+  // OCAF discards the Redo deltas only if it stacks the committed one
+  const Standard_Integer nbRedo = this->NbRedoData();
+  //
+  Handle(TDF_Delta) last;
+  if ( !m_doc->GetUndos().IsEmpty() )
+    last = m_doc->GetUndos().Last();
 
-  // Juggle naming stack
-  for ( Standard_Integer NbDone = 0; NbDone < theNbUndoes; NbDone++ )
-  {
-    m_redoData.Prepend( m_undoData.First() );
-    m_undoData.Remove(1);
-  }
+  // Perform general commit first, so that Modification Delta is passed to
+  // OCCT native stack
+  ActData_TransactionEngine::CommitCommand();
+
+  if ( m_doc->GetUndos().IsEmpty() || m_doc->GetUndos().Last() == last )
+    return; // Nothing has been stacked
+
+  // Juggle TxData history. Coalesced commit continues the transaction whose
+  // user data is kept
+  this->clearRedoHistory(nbRedo);
+  //
+  if ( !this->IsLastCommitCoalesced() )
+    this->pushHistory(theData);
 
-  return result;
+  // OCAF could have pushed the oldest deltas out
+  while ( m_iNbItems > m_doc->GetAvailableUndos() )
+    this->popOldestHistory();
 }
 
-//! Customized Redo method for extended transactions.
-//! \param theNbRedoes [in] number of Redo operations to perform one-by-one.
-//! \return affected Parameters.
-Handle(ActAPI_TxRes)
-  ActData_ExtTransactionEngine::Redo(const Standard_Integer theNbRedoes)
+//! Discards the given number of the oldest Undo deltas together with the
+//! user data bound to them.
+//! \param theNbTrimmed [in] number of deltas to discard.
+void ActData_ExtTransactionEngine::trimOldestUndos(const Standard_Integer theNbTrimmed)
 {
-  if ( m_redoData.IsEmpty() )
-    return NULL; // There is nothing to Redo
+  const Standard_Integer nbUndo = m_doc->GetAvailableUndos();
 
-  // Perform actual Redo
-  Handle(ActAPI_TxRes)
-    result = ActData_TransactionEngine::Redo(theNbRedoes);
+  ActData_TransactionEngine::trimOldestUndos(theNbTrimmed);
 
-  // Juggle naming stack
-  for ( Standard_Integer NbDone = 0; NbDone < theNbRedoes; NbDone++ )
-  {
-    m_undoData.Prepend( m_redoData.First() );
-    m_redoData.Remove(1);
-  }
+  // The oldest user data items are at the head of the ring
+  for ( Standard_Integer k = m_doc->GetAvailableUndos(); k < nbUndo; ++k )
+    this->popOldestHistory();
+}
 
-  return result;
+//! \return number of user data items bound to Undo Modification Deltas.
+Standard_Integer ActData_ExtTransactionEngine::NbUndoData() const
+{
+  return Min(m_doc->GetAvailableUndos(), m_iNbItems - this->NbRedoData());
 }
 
-//! Commits current transaction.
-//! \param theData [in] user-data to bind to transaction being committed.
-void ActData_ExtTransactionEngine::CommitCommandExt(const ActAPI_TxData& theData)
+//! \return number of user data items bound to Redo Modification Deltas.
+Standard_Integer ActData_ExtTransactionEngine::NbRedoData() const
 {
-  // Perform general commit first, so that Modification Delta is passed to
-  // OCCT native stack
-  ActData_TransactionEngine::CommitCommand();
+  return Min(m_doc->GetAvailableRedos(), m_iNbItems);
+}
 
-  // Juggle TxData stack
-  m_undoData.Prepend(theData);
-  m_redoData.Clear();
+//! Accessor for the sequence of user data associated with Undo Modification
+//! Deltas. This collection is ordered from the most fresh transaction to
+//! the most long-standing one from the left to the right.
+//! \return collection of user data for Undo Modification Deltas.
+ActAPI_TxDataSeq ActData_ExtTransactionEngine::GetUndoData() const
+{
+  return *this->GetUndoData( this->NbUndoData() );
+}
 
-  // Proceed with Undo Limit
-  Standard_Integer UndoLimit = m_doc->GetUndoLimit();
-  if ( m_undoData.Length() > UndoLimit )
-    m_undoData.Remove( m_undoData.Length() );
+//! Accessor for the sequence of user data associated with Redo Modification
+//! Deltas. This collection is ordered from the next transaction to Redo to
+//! the farthest one from the left to the right.
+//! \return collection of user data for Redo Modification Deltas.
+ActAPI_TxDataSeq ActData_ExtTransactionEngine::GetRedoData() const
+{
+  return *this->GetRedoData( this->NbRedoData() );
 }
 
 //! Accessor for the sequence of user data associated with Undo Modification
@@ -115,9 +135,12 @@ void ActData_ExtTransactionEngine::CommitCommandExt(const ActAPI_TxData& theData
 Handle(ActAPI_HTxDataSeq)
   ActData_ExtTransactionEngine::GetUndoData(const Standard_Integer theDepth) const
 {
+  const Standard_Integer nbStale = this->nbStaleHistory();
+  const Standard_Integer nbUndo  = this->NbUndoData();
+
   Handle(ActAPI_HTxDataSeq) aResult = new ActAPI_HTxDataSeq();
-  for ( Standard_Integer i = 1; i <= Min(m_undoData.Length(), theDepth); ++i )
-    aResult->Append( m_undoData.Value(i) );
+  for ( Standard_Integer i = 1; i <= Min(nbUndo, theDepth); ++i )
+    aResult->Append( this->historyItem(nbStale + nbUndo - i) );
 
   return aResult;
 }
@@ -127,13 +150,86 @@ Handle(ActAPI_HTxDataSeq)
 //! the given depth.
 //! \param theDepth [in] depth to limit the collection of data items
 //!        being accessed.
-//! \return collection of user data for Undo Modification Deltas.
+//! \return collection of user data for Redo Modification Deltas.
 Handle(ActAPI_HTxDataSeq)
   ActData_ExtTransactionEngine::GetRedoData(const Standard_Integer theDepth) const
 {
+  const Standard_Integer nbRedo  = this->NbRedoData();
+  const Standard_Integer nbFirst = m_iNbItems - nbRedo;
+
   Handle(ActAPI_HTxDataSeq) aResult = new ActAPI_HTxDataSeq();
-  for ( Standard_Integer i = 1; i <= theDepth; ++i )
-    aResult->Append( m_redoData.Value(i) );
+  for ( Standard_Integer i = 0; i < Min(nbRedo, theDepth); ++i )
+    aResult->Append( this->historyItem(nbFirst + i) );
 
   return aResult;
 }
+
+//-----------------------------------------------------------------------------
+// History ring buffer
+//-----------------------------------------------------------------------------
+
+//! Returns the history item by its 0-based index counted from the oldest one.
+//! \param theIndex [in] index of the item.
+//! \return history item.
+const ActAPI_TxData&
+  ActData_ExtTransactionEngine::historyItem(const Standard_Integer theIndex) const
+{
+  return m_history[(m_iHead + theIndex) % m_history.size()];
+}
+
+//! Returns the number of the oldest history items whose deltas are not in
+//! the Document anymore. Such items appear if the Undo Limit of the Document
+//! is reduced directly. They are skipped until the next commit drops them.
+//! \return number of stale items.
+Standard_Integer ActData_ExtTransactionEngine::nbStaleHistory() const
+{
+  return m_iNbItems - this->NbRedoData() - this->NbUndoData();
+}
+
+//! Appends the most recent Undo item. The ring buffer grows by doubling
+//! up to the Undo Limit, so that it normally never reallocates afterwards.
+//! \param theData [in] user data to append.
+void ActData_ExtTransactionEngine::pushHistory(const ActAPI_TxData& theData)
+{
+  const Standard_Integer capacity = (Standard_Integer) m_history.size();
+  //
+  if ( m_iNbItems == capacity )
+  {
+    const Standard_Integer newCapacity = Max( Min( 2*capacity, Max(m_doc->GetUndoLimit(), 1) ),
+                                              Max(capacity + 1, 16) );
+
+    // Unroll the ring into the new storage
+    std::vector<ActAPI_TxData> history(newCapacity);
+    for ( Standard_Integer i = 0; i < m_iNbItems; ++i )
+      history[i] = this->historyItem(i);
+
+    m_history.swap(history);
+    m_iHead = 0;
+  }
+
+  m_history[(m_iHead + m_iNbItems) % m_history.size()] = theData;
+  m_iNbItems++;
+}
+
+//! Discards the oldest history item.
+void ActData_ExtTransactionEngine::popOldestHistory()
+{
+  if ( !m_iNbItems )
+    return;
+
+  m_history[m_iHead] = ActAPI_TxData();
+  m_iHead = (m_iHead + 1) % (Standard_Integer) m_history.size();
+  m_iNbItems--;
+}
+
+//! Discards the given number of the most recent history items, i.e., the
+//! Redo ones.
+//! \param theNbRedo [in] number of Redo items to discard.
+void ActData_ExtTransactionEngine::clearRedoHistory(const Standard_Integer theNbRedo)
+{
+  for ( Standard_Integer i = 0; i < theNbRedo && m_iNbItems; ++i )
+  {
+    m_iNbItems--;
+    m_history[(m_iHead + m_iNbItems) % m_history.size()] = ActAPI_TxData();
+  }
+}
@@ -43,6 +43,9 @@
 #include <NCollection_Sequence.hxx>
 #include <TCollection_ExtendedString.hxx>
 
+// Standard includes
+#include <vector>
+
 DEFINE_STANDARD_HANDLE(ActData_ExtTransactionEngine, ActData_TransactionEngine)
 
 //! \ingroup AD_DF
@@ -64,11 +67,8 @@ public:
 // Kernel methods:
 public:
 
-  ActData_EXPORT virtual Handle(ActAPI_TxRes)
-    Undo(const Standard_Integer theNbUndoes);
-
-  ActData_EXPORT virtual Handle(ActAPI_TxRes)
-    Redo(const Standard_Integer theNbRedoes);
+  ActData_EXPORT virtual void
+    CommitCommand();
 
   ActData_EXPORT virtual void
     CommitCommandExt(const ActAPI_TxData& theData);
@@ -76,25 +76,11 @@ public:
 // Auxiliary methods:
 public:
 
-  //! Accessor for the sequence of user data associated with Undo Modification
-  //! Deltas. This collection is ordered from the most fresh transaction to
-  //! the most long-standing one from the left to the right.
-  //! \return collection of user data for Undo Modification Deltas.
-  const ActAPI_TxDataSeq& GetUndoData() const
-  {
-    return m_undoData;
-  }
-
-  //! Accessor for the sequence of user data associated with Redo Modification
-  //! Deltas. This collection is ordered from the most fresh transaction to
-  //! the most long-standing one from the left to the right.
-  //! \return collection of user data for Redo Modification Deltas.
-  const ActAPI_TxDataSeq& GetRedoData() const
-  {
-    return m_redoData;
-  }
+  ActData_EXPORT ActAPI_TxDataSeq
+    GetUndoData() const;
 
-public:
+  ActData_EXPORT ActAPI_TxDataSeq
+    GetRedoData() const;
 
   ActData_EXPORT Handle(ActAPI_HTxDataSeq)
     GetUndoData(const Standard_Integer theDepth) const;
@@ -102,15 +88,48 @@ public:
   ActData_EXPORT Handle(ActAPI_HTxDataSeq)
     GetRedoData(const Standard_Integer theDepth) const;
 
+  ActData_EXPORT Standard_Integer
+    NbUndoData() const;
+
+  ActData_EXPORT Standard_Integer
+    NbRedoData() const;
+
+protected:
+
+  ActData_EXPORT virtual void
+    trimOldestUndos(const Standard_Integer theNbTrimmed);
+
 private:
 
-  //! Collection of user data extending the managed Modification Deltas
-  //! for Undoes.
-  ActAPI_TxDataSeq m_undoData;
+  const ActAPI_TxData&
+    historyItem(const Standard_Integer theIndex) const;
+
+  void
+    pushHistory(const ActAPI_TxData& theData);
+
+  void
+    popOldestHistory();
+
+  Standard_Integer
+    nbStaleHistory() const;
+
+  void
+    clearRedoHistory(const Standard_Integer theNbRedo);
+
+private:
+
+  //! Ring buffer of user data extending the managed Modification Deltas.
+  //! The history runs from the oldest Undo item to the most recent one
+  //! and continues with Redo items from the next one to Redo. The boundary
+  //! between the two parts is not stored: it follows the number of deltas
+  //! actually stacked by the Document, so Undo and Redo need no care here.
+  std::vector<ActAPI_TxData> m_history;
+
+  //! Position of the oldest history item in the ring buffer.
+  Standard_Integer m_iHead;
 
-  //! Collection of user data extending the managed Modification Deltas
-  //! for Redoes.
-  ActAPI_TxDataSeq m_redoData;
+  //! Number of history items.
+  Standard_Integer m_iNbItems;
 
 };
 
@@ -277,10 +277,7 @@ Standard_Integer
 //! \param theParam [in] Nodal Parameter.
 void ActData_FuncExecutionCtx::Force(const Handle(ActData_TreeFunctionParameter)& theFuncParam)
 {
-  TDF_Label aLogBookSection =
-    theFuncParam->RootLabel().Root().FindChild(ActData_BaseModel::StructureTag_LogBook);
-
-  ActData_LogBook(aLogBookSection).Force(theFuncParam);
+  ActData_LogBook::Access( theFuncParam->RootLabel() ).Force(theFuncParam);
 }
 
 //-----------------------------------------------------------------------------
@@ -294,10 +291,7 @@ void ActData_FuncExecutionCtx::Deploy(const Handle(ActData_TreeFunctionParameter
   if ( !theFuncParam->IsHeavyFunction() )
     return;
 
-  TDF_Label aLogBookSection =
-    theFuncParam->RootLabel().Root().FindChild(ActData_BaseModel::StructureTag_LogBook);
-
-  ActData_LogBook(aLogBookSection).HeavyDeploy(theFuncParam);
+  ActData_LogBook::Access( theFuncParam->RootLabel() ).HeavyDeploy(theFuncParam);
 }
 
 //! Grants heavy deployment for sub-graphs starting from the passed roots.
@@ -58,6 +58,15 @@ static void RemoveAllOccurrences(const Handle(ActData_LogBookAttr)& attr,
   attr->ReleaseLogged(label);
 }
 
+//! Converts the structure tag of the LogBook section to the bit of the
+//! packed LogBook.
+//! \param[in] tag structure tag.
+//! \return packed flag.
+static Standard_Integer packedFlag(const ActData_LogBook::StructureTags tag)
+{
+  return 1 << (tag - 1);
+}
+
 //-----------------------------------------------------------------------------
 // Services
 //-----------------------------------------------------------------------------
@@ -68,11 +77,7 @@ static void RemoveAllOccurrences(const Handle(ActData_LogBookAttr)& attr,
 Standard_Boolean
   ActData_LogBook::IsModifiedCursor(const Handle(ActAPI_IDataCursor)& theDC)
 {
-  TDF_Label aLogBookSection =
-    theDC->RootLabel().Root().FindChild(ActData_BaseModel::StructureTag_LogBook);
-
-  ActData_LogBook LogBook(aLogBookSection);
-  return LogBook.IsModified( theDC->RootLabel() );
+  return Access( theDC->RootLabel() ).IsModified( theDC->RootLabel() );
 }
 
 //! Checks whether the passed Data Cursor is registered in HEAVY DEPLOYMENT
@@ -82,11 +87,22 @@ Standard_Boolean
 Standard_Boolean
   ActData_LogBook::IsPendingCursor(const Handle(ActAPI_IDataCursor)& theDC)
 {
-  TDF_Label aLogBookSection =
-    theDC->RootLabel().Root().FindChild(ActData_BaseModel::StructureTag_LogBook);
+  return Access( theDC->RootLabel() ).IsHeavyDeployment( theDC->RootLabel() );
+}
 
-  ActData_LogBook LogBook(aLogBookSection);
-  return LogBook.IsHeavyDeployment( theDC->RootLabel() );
+//! Prepares LogBook Data Cursor for the Document owning the passed Label.
+//! If the Document uses the packed LogBook, the cursor is bound to the
+//! packed storage directly, so the LogBook section is not even accessed.
+//! \param theLab [in] any Label of the Document.
+//! \return LogBook Data Cursor.
+ActData_LogBook ActData_LogBook::Access(const TDF_Label& theLab)
+{
+  Handle(ActData_PackedLogBook) packed = ActData_PackedLogBook::Find(theLab);
+  //
+  if ( !packed.IsNull() )
+    return ActData_LogBook(packed);
+
+  return ActData_LogBook( theLab.Root().FindChild(ActData_BaseModel::StructureTag_LogBook) );
 }
 
 //-----------------------------------------------------------------------------
@@ -97,7 +113,15 @@ Standard_Boolean
 //! \param theRootLab [in] root Label to set.
 ActData_LogBook::ActData_LogBook(const TDF_Label& theRootLab)
 {
-  m_root = theRootLab;
+  m_root   = theRootLab;
+  m_packed = ActData_PackedLogBook::Find(theRootLab);
+}
+
+//! Constructor accepting the packed storage of LogBook records.
+//! \param thePacked [in] packed LogBook.
+ActData_LogBook::ActData_LogBook(const Handle(ActData_PackedLogBook)& thePacked)
+{
+  m_packed = thePacked;
 }
 
 //-----------------------------------------------------------------------------
@@ -108,6 +132,15 @@ ActData_LogBook::ActData_LogBook(const TDF_Label& theRootLab)
 //! \param theLab [in] Label to remove the references for.
 void ActData_LogBook::ClearReferencesFor(const TDF_Label& theLab)
 {
+  if ( !m_packed.IsNull() )
+  {
+    m_packed->Release(theLab, ActData_PackedLogBook::Flag_All);
+    for ( TDF_ChildIterator it(theLab, Standard_True); it.More(); it.Next() )
+      m_packed->Release(it.Value(), ActData_PackedLogBook::Flag_All);
+
+    return;
+  }
+
   TDF_Label aLogTScope = m_root.FindChild(StructureTag_Touched),
             aLogIScope = m_root.FindChild(StructureTag_Impacted),
             aLogFScope = m_root.FindChild(StructureTag_Forced),
@@ -253,6 +286,9 @@ Standard_Boolean
 Standard_Boolean
   ActData_LogBook::IsModified(const TDF_Label& theLab) const
 {
+  if ( !m_packed.IsNull() )
+    return m_packed->IsLogged(theLab, ActData_PackedLogBook::Flag_Modified);
+
   return this->IsTouched(theLab) || this->IsImpacted(theLab);
 }
 
@@ -262,12 +298,18 @@ Standard_Boolean
 Standard_Boolean
   ActData_LogBook::IsModified(const Handle(ActAPI_IUserParameter)& theParam) const
 {
-  return this->IsTouched(theParam) || this->IsImpacted(theParam);
+  return this->IsModified( theParam->RootLabel() );
 }
 
 //! Cleans up the collection of Labels marked as TOUCHED or IMPACTED.
 void ActData_LogBook::ReleaseModified()
 {
+  if ( !m_packed.IsNull() )
+  {
+    m_packed->Release(ActData_PackedLogBook::Flag_Modified);
+    return;
+  }
+
   this->clearReferences(StructureTag_Touched);
   this->clearReferences(StructureTag_Impacted);
 }
@@ -358,6 +400,12 @@ void ActData_LogBook::ReleaseHeavyDeployment()
 void ActData_LogBook::addToReferenceMap(const TDF_Label& theLab,
                                         const StructureTags theTag)
 {
+  if ( !m_packed.IsNull() )
+  {
+    m_packed->Log( theLab, packedFlag(theTag) );
+    return;
+  }
+
   TDF_Label aLogScope = m_root.FindChild(theTag);
   Handle(ActData_LogBookAttr) refMap = ActData_LogBookAttr::Set(aLogScope);
   refMap->LogLabel(theLab);
@@ -381,6 +429,9 @@ void ActData_LogBook::addToReferenceMap(const Handle(ActAPI_IUserParameter)& the
 Standard_Boolean ActData_LogBook::isReferenced(const TDF_Label& theLab,
                                                const StructureTags theTag) const
 {
+  if ( !m_packed.IsNull() )
+    return m_packed->IsLogged( theLab, packedFlag(theTag) );
+
   TDF_Label aLogScope = m_root.FindChild(theTag);
   Handle(ActData_LogBookAttr) refMap = ActData_LogBookAttr::Set(aLogScope);
   //
@@ -401,6 +452,12 @@ Standard_Boolean ActData_LogBook::isReferenced(const Handle(ActAPI_IUserParamete
 //! \param theTag [in] tag determining the LogBook's destination scope.
 void ActData_LogBook::clearReferences(const StructureTags theTag)
 {
+  if ( !m_packed.IsNull() )
+  {
+    m_packed->Release( packedFlag(theTag) );
+    return;
+  }
+
   TDF_Label aLogScope = m_root.FindChild(theTag);
   Handle(ActData_LogBookAttr) refMap = ActData_LogBookAttr::Set(aLogScope);
   refMap->ReleaseLogged();
@@ -414,6 +471,15 @@ void ActData_LogBook::clearReferences(const StructureTags theTag)
 void ActData_LogBook::clearReferences(const TDF_Label& theLabel,
                                       const StructureTags theTag)
 {
+  if ( !m_packed.IsNull() )
+  {
+    m_packed->Release( theLabel, packedFlag(theTag) );
+    for ( TDF_ChildIterator it(theLabel, Standard_True); it.More(); it.Next() )
+      m_packed->Release( it.Value(), packedFlag(theTag) );
+
+    return;
+  }
+
   TDF_Label aLogScope = m_root.FindChild(theTag);
   Handle(ActData_LogBookAttr) refMap = ActData_LogBookAttr::Set(aLogScope);
 
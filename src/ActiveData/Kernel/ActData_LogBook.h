@@ -35,6 +35,7 @@
 
 // Active Data includes
 #include <ActData_Common.h>
+#include <ActData_PackedLogBook.h>
 #include <ActData_TreeFunctionParameter.h>
 
 //! \ingroup AD_DF
@@ -82,6 +83,11 @@
 //! PENDING status for each involved OUTPUT Parameter. This process is similar
 //! to propagating of invalidation wave, however, it concerns only HEAVY
 //! Tree Functions (while VALIDATION statuses are used in a common way).
+//!
+//! If the Data Model is switched to the packed LogBook mode (see
+//! ActData_BaseModel::SetPackedLogBook()), all records are redirected to
+//! the transient ActData_PackedLogBook storage kept by the Document.
+//! The Data Cursor interface remains the same in both modes.
 class ActData_LogBook
 {
 public:
@@ -104,12 +110,18 @@ public:
   ActData_EXPORT static Standard_Boolean
     IsPendingCursor(const Handle(ActAPI_IDataCursor)& theDC);
 
+  ActData_EXPORT static ActData_LogBook
+    Access(const TDF_Label& theLab);
+
 // Construction:
 public:
 
   ActData_EXPORT
     ActData_LogBook(const TDF_Label& theRootLab);
 
+  ActData_EXPORT
+    ActData_LogBook(const Handle(ActData_PackedLogBook)& thePacked);
+
 public:
 
   ActData_EXPORT void
@@ -117,13 +129,20 @@ public:
 
 public:
 
-  //! Accessor for the root Label.
+  //! Accessor for the root Label. The root Label is null for the LogBook
+  //! cursors created over the packed storage by Access() method.
   //! \return root Label.
   const TDF_Label& Label() const
   {
     return m_root;
   }
 
+  //! \return true if the LogBook records are kept in the packed storage.
+  Standard_Boolean IsPacked() const
+  {
+    return !m_packed.IsNull();
+  }
+
 // Normal execution:
 public:
 
@@ -215,6 +234,9 @@ private:
   //! Root Label of LogBook section.
   TDF_Label m_root;
 
+  //! Packed storage for the records (null for the attribute-based LogBook).
+  Handle(ActData_PackedLogBook) m_packed;
+
 };
 
 #endif
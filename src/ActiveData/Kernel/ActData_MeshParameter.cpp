@@ -83,6 +83,48 @@ void ActData_MeshParameter::DeltaModeOff()
   aMeshAttr->DeltaModeOff();
 }
 
+//! Sets the tolerance of the lossy compression applied to the mesh when
+//! the Document is saved (see ActData_MeshAttr::SetCompressionTolerance()).
+//! \param theTolerance [in] tolerance to set (zero disables compression).
+//! \param theModType [in] Modification Type.
+//! \param doResetValidity [in] indicates whether to reset validity flag.
+//! \param doResetPending [in] indicates whether this Parameter must lose its
+//!        PENDING (or out-dated) property.
+void ActData_MeshParameter::SetCompressionTolerance(const Standard_Real theTolerance,
+                                                    const ActAPI_ModificationType theModType,
+                                                    const Standard_Boolean doResetValidity,
+                                                    const Standard_Boolean doResetPending)
+{
+  if ( this->IsDetached() )
+    Standard_ProgramError::Raise("Cannot access detached data");
+
+  Handle(ActData_MeshAttr) aMeshAttr = ActData_Utils::AccessMeshAttr(m_label, DS_Mesh);
+  if ( aMeshAttr.IsNull() )
+    Standard_ProgramError::Raise("Cannot access NULL Mesh DS");
+
+  aMeshAttr->SetCompressionTolerance(theTolerance);
+
+  // Mark root label of the Parameter as modified (Touched, Impacted or Silent)
+  SPRING_INTO_FUNCTION(theModType)
+  // Reset Parameter's validity flag if requested
+  RESET_VALIDITY(doResetValidity)
+  // Reset Parameter's PENDING property
+  RESET_PENDING(doResetPending);
+}
+
+//! \return tolerance of the lossy compression applied to the mesh.
+Standard_Real ActData_MeshParameter::GetCompressionTolerance()
+{
+  if ( this->IsDetached() )
+    Standard_ProgramError::Raise("Cannot access detached data");
+
+  Handle(ActData_MeshAttr) aMeshAttr = ActData_Utils::AccessMeshAttr(m_label, DS_Mesh);
+  if ( aMeshAttr.IsNull() )
+    Standard_ProgramError::Raise("Cannot access NULL Mesh DS");
+
+  return aMeshAttr->GetCompressionTolerance();
+}
+
 //! Sets Mesh data for the Parameter.
 //! \param theMesh [in] Mesh data to set.
 //! \param theModType [in] Modification Type.
@@ -177,6 +219,171 @@ Standard_Integer
   return aResID;
 }
 
+//! Adds mesh nodes in bulk. The nodes get consecutive IDs.
+//! \param theCoords [in] X, Y, Z co-ordinates of each node.
+//! \param theNbNodes [in] number of nodes.
+//! \param theModType [in] Modification Type.
+//! \param doResetValidity [in] indicates whether to reset validity flag.
+//! \param doResetPending [in] indicates whether this Parameter must lose its
+//!        PENDING (or out-dated) property.
+//! \return ID of the first created mesh node.
+Standard_Integer
+  ActData_MeshParameter::AddNodes(const Standard_Real* theCoords,
+                                  const Standard_Integer theNbNodes,
+                                  const ActAPI_ModificationType theModType,
+                                  const Standard_Boolean doResetValidity,
+                                  const Standard_Boolean doResetPending)
+{
+  if ( !this->IsWellFormed() )
+    Standard_ProgramError::Raise("Cannot access BAD-FORMED data");
+
+  Handle(ActData_MeshAttr) aMeshAttr = ActData_Utils::AccessMeshAttr(m_label, DS_Mesh);
+  if ( aMeshAttr.IsNull() )
+    Standard_ProgramError::Raise("Cannot access NULL Mesh DS");
+
+  Standard_Integer aResID = aMeshAttr->AddNodes(theCoords, theNbNodes);
+
+  // Mark root label of the Parameter as modified (Touched, Impacted or Silent)
+  SPRING_INTO_FUNCTION(theModType)
+  // Reset Parameter's validity flag if requested
+  RESET_VALIDITY(doResetValidity)
+  // Reset Parameter's PENDING property
+  RESET_PENDING(doResetPending);
+
+  return aResID;
+}
+
+//! Moves mesh nodes in bulk. Undo of such deformation restores the old
+//! positions of the moved nodes only.
+//! \param theIDs [in] IDs of the nodes to move.
+//! \param theCoords [in] new X, Y, Z co-ordinates of each node.
+//! \param theNbNodes [in] number of nodes.
+//! \param theModType [in] Modification Type.
+//! \param doResetValidity [in] indicates whether to reset validity flag.
+//! \param doResetPending [in] indicates whether this Parameter must lose its
+//!        PENDING (or out-dated) property.
+//! \return true in case of success, false -- otherwise.
+Standard_Boolean
+  ActData_MeshParameter::SetNodeCoords(const Standard_Integer* theIDs,
+                                       const Standard_Real* theCoords,
+                                       const Standard_Integer theNbNodes,
+                                       const ActAPI_ModificationType theModType,
+                                       const Standard_Boolean doResetValidity,
+                                       const Standard_Boolean doResetPending)
+{
+  if ( !this->IsWellFormed() )
+    Standard_ProgramError::Raise("Cannot access BAD-FORMED data");
+
+  Handle(ActData_MeshAttr) aMeshAttr = ActData_Utils::AccessMeshAttr(m_label, DS_Mesh);
+  if ( aMeshAttr.IsNull() )
+    Standard_ProgramError::Raise("Cannot access NULL Mesh DS");
+
+  if ( !aMeshAttr->SetNodeCoords(theIDs, theCoords, theNbNodes) )
+    return Standard_False;
+
+  // Mark root label of the Parameter as modified (Touched, Impacted or Silent)
+  SPRING_INTO_FUNCTION(theModType)
+  // Reset Parameter's validity flag if requested
+  RESET_VALIDITY(doResetValidity)
+  // Reset Parameter's PENDING property
+  RESET_PENDING(doResetPending);
+
+  return Standard_True;
+}
+
+//! Adds mesh elements of the same number of nodes in bulk. The elements get
+//! consecutive IDs. Elements referring to missing nodes or duplicating the
+//! existing ones are skipped.
+//! \param theNodes [in] nodal IDs of each element.
+//! \param theNbElements [in] number of elements.
+//! \param theNbNodesPerElement [in] number of nodes in each element (3 or 4).
+//! \param theModType [in] Modification Type.
+//! \param doResetValidity [in] indicates whether to reset validity flag.
+//! \param doResetPending [in] indicates whether this Parameter must lose its
+//!        PENDING (or out-dated) property.
+//! \return ID of the first created mesh element.
+Standard_Integer
+  ActData_MeshParameter::AddElements(const Standard_Integer* theNodes,
+                                     const Standard_Integer theNbElements,
+                                     const Standard_Integer theNbNodesPerElement,
+                                     const ActAPI_ModificationType theModType,
+                                     const Standard_Boolean doResetValidity,
+                                     const Standard_Boolean doResetPending)
+{
+  if ( !this->IsWellFormed() )
+    Standard_ProgramError::Raise("Cannot access BAD-FORMED data");
+
+  Handle(ActData_MeshAttr) aMeshAttr = ActData_Utils::AccessMeshAttr(m_label, DS_Mesh);
+  if ( aMeshAttr.IsNull() )
+    Standard_ProgramError::Raise("Cannot access NULL Mesh DS");
+
+  Standard_Integer aResID = aMeshAttr->AddElements(theNodes, theNbElements, theNbNodesPerElement);
+
+  // Mark root label of the Parameter as modified (Touched, Impacted or Silent)
+  SPRING_INTO_FUNCTION(theModType)
+  // Reset Parameter's validity flag if requested
+  RESET_VALIDITY(doResetValidity)
+  // Reset Parameter's PENDING property
+  RESET_PENDING(doResetPending);
+
+  return aResID;
+}
+
+//! Renumbers mesh nodes and elements to the dense ranges starting from 1.
+//! Undo of compaction restores the original IDs.
+//! \param theNodeMap [out] old-to-new node IDs.
+//! \param theElemMap [out] old-to-new element IDs.
+//! \param theModType [in] Modification Type.
+//! \param doResetValidity [in] indicates whether to reset validity flag.
+//! \param doResetPending [in] indicates whether this Parameter must lose its
+//!        PENDING (or out-dated) property.
+//! \return true if the IDs were changed, false if they were dense already.
+Standard_Boolean
+  ActData_MeshParameter::Compact(TColStd_DataMapOfIntegerInteger& theNodeMap,
+                                 TColStd_DataMapOfIntegerInteger& theElemMap,
+                                 const ActAPI_ModificationType theModType,
+                                 const Standard_Boolean doResetValidity,
+                                 const Standard_Boolean doResetPending)
+{
+  if ( !this->IsWellFormed() )
+    Standard_ProgramError::Raise("Cannot access BAD-FORMED data");
+
+  Handle(ActData_MeshAttr) aMeshAttr = ActData_Utils::AccessMeshAttr(m_label, DS_Mesh);
+  if ( aMeshAttr.IsNull() )
+    Standard_ProgramError::Raise("Cannot access NULL Mesh DS");
+
+  if ( !aMeshAttr->Compact(theNodeMap, theElemMap) )
+    return Standard_False;
+
+  // Mark root label of the Parameter as modified (Touched, Impacted or Silent)
+  SPRING_INTO_FUNCTION(theModType)
+  // Reset Parameter's validity flag if requested
+  RESET_VALIDITY(doResetValidity)
+  // Reset Parameter's PENDING property
+  RESET_PENDING(doResetPending);
+
+  return Standard_True;
+}
+
+//! Sets Mesh data built from the passed triangulation. The mesh is
+//! constructed in bulk, so the node IDs are the node indices of the
+//! triangulation.
+//! \param theTriangulation [in] triangulation to convert.
+//! \param theModType [in] Modification Type.
+//! \param doResetValidity [in] indicates whether to reset validity flag.
+//! \param doResetPending [in] indicates whether this Parameter must lose its
+//!        PENDING (or out-dated) property.
+void ActData_MeshParameter::SetTriangulation(const Handle(Poly_Triangulation)& theTriangulation,
+                                             const ActAPI_ModificationType theModType,
+                                             const Standard_Boolean doResetValidity,
+                                             const Standard_Boolean doResetPending)
+{
+  if ( theTriangulation.IsNull() )
+    Standard_ProgramError::Raise("Cannot set NULL triangulation");
+
+  this->SetMesh(new ActData_Mesh(theTriangulation), theModType, doResetValidity, doResetPending);
+}
+
 //! Accessor for the stored Mesh DS.
 //! \return Mesh DS.
 Handle(ActData_Mesh) ActData_MeshParameter::GetMesh()
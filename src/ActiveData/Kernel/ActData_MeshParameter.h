@@ -98,6 +98,15 @@ public:
   ActData_EXPORT void
     DeltaModeOff();
 
+  ActData_EXPORT void
+    SetCompressionTolerance(const Standard_Real theTolerance,
+                            const ActAPI_ModificationType theModType = MT_Touched,
+                            const Standard_Boolean doResetValidity = Standard_True,
+                            const Standard_Boolean doResetPending = Standard_True);
+
+  ActData_EXPORT Standard_Real
+    GetCompressionTolerance();
+
   ActData_EXPORT void
     SetMesh(const Handle(ActData_Mesh)& theMesh,
             const ActAPI_ModificationType theModType = MT_Touched,
@@ -119,6 +128,42 @@ public:
                const Standard_Boolean doResetValidity = Standard_True,
                const Standard_Boolean doResetPending = Standard_True);
 
+  ActData_EXPORT Standard_Integer
+    AddNodes(const Standard_Real* theCoords,
+             const Standard_Integer theNbNodes,
+             const ActAPI_ModificationType theModType = MT_Touched,
+             const Standard_Boolean doResetValidity = Standard_True,
+             const Standard_Boolean doResetPending = Standard_True);
+
+  ActData_EXPORT Standard_Boolean
+    SetNodeCoords(const Standard_Integer* theIDs,
+                  const Standard_Real* theCoords,
+                  const Standard_Integer theNbNodes,
+                  const ActAPI_ModificationType theModType = MT_Touched,
+                  const Standard_Boolean doResetValidity = Standard_True,
+                  const Standard_Boolean doResetPending = Standard_True);
+
+  ActData_EXPORT Standard_Integer
+    AddElements(const Standard_Integer* theNodes,
+                const Standard_Integer theNbElements,
+                const Standard_Integer theNbNodesPerElement,
+                const ActAPI_ModificationType theModType = MT_Touched,
+                const Standard_Boolean doResetValidity = Standard_True,
+                const Standard_Boolean doResetPending = Standard_True);
+
+  ActData_EXPORT Standard_Boolean
+    Compact(TColStd_DataMapOfIntegerInteger& theNodeMap,
+            TColStd_DataMapOfIntegerInteger& theElemMap,
+            const ActAPI_ModificationType theModType = MT_Touched,
+            const Standard_Boolean doResetValidity = Standard_True,
+            const Standard_Boolean doResetPending = Standard_True);
+
+  ActData_EXPORT void
+    SetTriangulation(const Handle(Poly_Triangulation)& theTriangulation,
+                     const ActAPI_ModificationType theModType = MT_Touched,
+                     const Standard_Boolean doResetValidity = Standard_True,
+                     const Standard_Boolean doResetPending = Standard_True);
+
   ActData_EXPORT Handle(ActData_Mesh)
     GetMesh();
 
@@ -0,0 +1,223 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <ActData_ModelDiff.h>
+
+// OCCT includes
+#include <NCollection_DataMap.hxx>
+#include <NCollection_Map.hxx>
+
+//-----------------------------------------------------------------------------
+
+//! Computes the difference between two states of the Data Model.
+//! \param[in] theEarlier digest of the earlier state.
+//! \param[in] theLater   digest of the later state.
+//! \return difference.
+Handle(ActData_ModelDiff)
+  ActData_ModelDiff::Compute(const Handle(ActData_ModelDigest)& theEarlier,
+                             const Handle(ActData_ModelDigest)& theLater)
+{
+  Handle(ActData_ModelDiff) diff = new ActData_ModelDiff;
+
+  // Nodes existing in the later state
+  for ( Standard_Integer n = 0; n < theLater->NbNodes(); ++n )
+  {
+    const ActData_ModelDigest::t_node& later = theLater->Node(n);
+    const Standard_Integer             idx   = theEarlier->FindNode(later.id);
+
+    if ( idx < 0 )
+    {
+      diff->m_added.Append(later.id);
+      continue;
+    }
+
+    const ActData_ModelDigest::t_node& earlier = theEarlier->Node(idx);
+
+    // Node of another type under the same ID replaces the earlier one
+    if ( !earlier.typeName.IsEqual(later.typeName) )
+    {
+      diff->m_removed.Append(later.id);
+      diff->m_added.Append(later.id);
+      continue;
+    }
+
+    if ( !earlier.name.IsEqual(later.name) )
+    {
+      t_renamedNode renamed;
+      renamed.id      = later.id;
+      renamed.oldName = earlier.name;
+      renamed.newName = later.name;
+      //
+      diff->m_renamed.Append(renamed);
+    }
+
+    // Equal hashes mean equal Parameters
+    if ( earlier.hash != later.hash )
+      diff->compareNodes(earlier, later);
+  }
+
+  // Nodes existing in the earlier state only
+  for ( Standard_Integer n = 0; n < theEarlier->NbNodes(); ++n )
+  {
+    const ActData_ModelDigest::t_node& earlier = theEarlier->Node(n);
+    //
+    if ( theLater->FindNode(earlier.id) < 0 )
+      diff->m_removed.Append(earlier.id);
+  }
+
+  return diff;
+}
+
+//-----------------------------------------------------------------------------
+
+//! Dumps the difference in a human-readable form.
+//! \param[out] theOut output stream.
+void ActData_ModelDiff::Dump(Standard_OStream& theOut) const
+{
+  for ( ActAPI_NodeIdList::Iterator it(m_added); it.More(); it.Next() )
+    theOut << "+ node " << it.Value() << "\n";
+
+  for ( ActAPI_NodeIdList::Iterator it(m_removed); it.More(); it.Next() )
+    theOut << "- node " << it.Value() << "\n";
+
+  for ( NCollection_Sequence<t_renamedNode>::Iterator it(m_renamed); it.More(); it.Next() )
+    theOut << "~ node " << it.Value().id << " renamed \""
+           << TCollection_AsciiString(it.Value().oldName) << "\" -> \""
+           << TCollection_AsciiString(it.Value().newName) << "\"\n";
+
+  for ( NCollection_Sequence<t_changedParameter>::Iterator it(m_params); it.More(); it.Next() )
+  {
+    const t_changedParameter& param = it.Value();
+    const char sign = (param.kind == ActAPI_ChangeFeed::Change_Added)   ? '+'
+                    : (param.kind == ActAPI_ChangeFeed::Change_Removed) ? '-' : '~';
+
+    theOut << sign << " parameter " << param.nodeId << ":" << param.key
+           << " (type " << param.type << ")\n";
+  }
+
+  for ( NCollection_Sequence<t_rewiredReference>::Iterator it(m_refs); it.More(); it.Next() )
+  {
+    const t_rewiredReference& ref = it.Value();
+    theOut << "~ reference " << ref.nodeId << ":" << ref.key;
+
+    for ( NCollection_Sequence<ActAPI_DataObjectId>::Iterator tit(ref.removed); tit.More(); tit.Next() )
+      theOut << " -" << tit.Value();
+
+    for ( NCollection_Sequence<ActAPI_DataObjectId>::Iterator tit(ref.added); tit.More(); tit.Next() )
+      theOut << " +" << tit.Value();
+
+    theOut << "\n";
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+//! Compares the Parameters of the Node existing in both states.
+//! \param[in] theEarlier Node in the earlier state.
+//! \param[in] theLater   Node in the later state.
+void ActData_ModelDiff::compareNodes(const ActData_ModelDigest::t_node& theEarlier,
+                                     const ActData_ModelDigest::t_node& theLater)
+{
+  NCollection_DataMap<Standard_Integer, size_t> earlierParams;
+  for ( size_t p = 0; p < theEarlier.params.size(); ++p )
+    earlierParams.Bind(theEarlier.params[p].key, p);
+
+  NCollection_Map<Standard_Integer> visited;
+
+  for ( size_t p = 0; p < theLater.params.size(); ++p )
+  {
+    const ActData_ModelDigest::t_parameter& later = theLater.params[p];
+    visited.Add(later.key);
+
+    t_changedParameter change;
+    change.nodeId = theLater.id;
+    change.key    = later.key;
+    change.type   = later.type;
+
+    const size_t* pIdx = earlierParams.Seek(later.key);
+    if ( !pIdx )
+    {
+      change.kind = ActAPI_ChangeFeed::Change_Added;
+      m_params.Append(change);
+      continue;
+    }
+
+    const ActData_ModelDigest::t_parameter& earlier = theEarlier.params[*pIdx];
+    if ( earlier.hash == later.hash )
+      continue;
+
+    change.kind = ActAPI_ChangeFeed::Change_Modified;
+    m_params.Append(change);
+
+    if ( !later.isRef )
+      continue;
+
+    // Compare reference targets as sets
+    t_rewiredReference rewired;
+    rewired.nodeId = theLater.id;
+    rewired.key    = later.key;
+
+    NCollection_Map<ActAPI_DataObjectId> earlierTargets, laterTargets;
+    for ( NCollection_Sequence<ActAPI_DataObjectId>::Iterator it(earlier.targets); it.More(); it.Next() )
+      earlierTargets.Add( it.Value() );
+    for ( NCollection_Sequence<ActAPI_DataObjectId>::Iterator it(later.targets); it.More(); it.Next() )
+      laterTargets.Add( it.Value() );
+
+    for ( NCollection_Sequence<ActAPI_DataObjectId>::Iterator it(earlier.targets); it.More(); it.Next() )
+      if ( !laterTargets.Contains( it.Value() ) )
+        rewired.removed.Append( it.Value() );
+
+    for ( NCollection_Sequence<ActAPI_DataObjectId>::Iterator it(later.targets); it.More(); it.Next() )
+      if ( !earlierTargets.Contains( it.Value() ) )
+        rewired.added.Append( it.Value() );
+
+    if ( !rewired.removed.IsEmpty() || !rewired.added.IsEmpty() )
+      m_refs.Append(rewired);
+  }
+
+  for ( size_t p = 0; p < theEarlier.params.size(); ++p )
+  {
+    const ActData_ModelDigest::t_parameter& earlier = theEarlier.params[p];
+    //
+    if ( visited.Contains(earlier.key) )
+      continue;
+
+    t_changedParameter change;
+    change.nodeId = theEarlier.id;
+    change.key    = earlier.key;
+    change.type   = earlier.type;
+    change.kind   = ActAPI_ChangeFeed::Change_Removed;
+    //
+    m_params.Append(change);
+  }
+}
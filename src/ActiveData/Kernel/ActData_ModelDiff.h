@@ -0,0 +1,163 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+#ifndef ActData_ModelDiff_HeaderFile
+#define ActData_ModelDiff_HeaderFile
+
+// Active Data includes
+#include <ActData_ModelDigest.h>
+
+// Active Data (API) includes
+#include <ActAPI_ChangeFeed.h>
+
+DEFINE_STANDARD_HANDLE(ActData_ModelDiff, Standard_Transient)
+
+//! \ingroup AD_DF
+//!
+//! Structured difference between two states of the Data Model: Nodes
+//! added, removed and renamed, Parameters added, removed or modified, and
+//! references rewired to other targets. The difference is computed by
+//! comparing the content hashes of two ActData_ModelDigest instances, so
+//! only the Nodes whose hashes differ are inspected Parameter by Parameter.
+//! A Node whose type has changed under the same ID is reported as both
+//! removed and added.
+class ActData_ModelDiff : public Standard_Transient
+{
+public:
+
+  // OCCT RTTI
+  DEFINE_STANDARD_RTTI_INLINE(ActData_ModelDiff, Standard_Transient)
+
+public:
+
+  //! Renamed Node.
+  struct t_renamedNode
+  {
+    ActAPI_NodeId              id;      //!< Node ID.
+    TCollection_ExtendedString oldName; //!< Name in the earlier state.
+    TCollection_ExtendedString newName; //!< Name in the later state.
+  };
+
+  //! Changed Parameter.
+  struct t_changedParameter
+  {
+    ActAPI_NodeId                 nodeId; //!< ID of the owning Node.
+    Standard_Integer              key;    //!< Parameter ID within the Node.
+    Standard_Integer              type;   //!< Parameter type.
+    ActAPI_ChangeFeed::ChangeKind kind;   //!< Kind of change.
+
+    t_changedParameter() : key(0), type(Parameter_UNDEFINED), kind(ActAPI_ChangeFeed::Change_Modified) {}
+  };
+
+  //! Rewired reference.
+  struct t_rewiredReference
+  {
+    ActAPI_NodeId                             nodeId;  //!< ID of the owning Node.
+    Standard_Integer                          key;     //!< Parameter ID within the Node.
+    NCollection_Sequence<ActAPI_DataObjectId> removed; //!< Targets not referenced anymore.
+    NCollection_Sequence<ActAPI_DataObjectId> added;   //!< Newly referenced targets.
+
+    t_rewiredReference() : key(0) {}
+  };
+
+public:
+
+  ActData_EXPORT static Handle(ActData_ModelDiff)
+    Compute(const Handle(ActData_ModelDigest)& theEarlier,
+            const Handle(ActData_ModelDigest)& theLater);
+
+public:
+
+  //! Default constructor.
+  ActData_ModelDiff() : Standard_Transient() {}
+
+public:
+
+  //! \return true if both states are equal.
+  Standard_Boolean IsEmpty() const
+  {
+    return m_added.IsEmpty()   && m_removed.IsEmpty() && m_renamed.IsEmpty()
+        && m_params.IsEmpty()  && m_refs.IsEmpty();
+  }
+
+  //! \return IDs of the added Nodes.
+  const ActAPI_NodeIdList& AddedNodes() const
+  {
+    return m_added;
+  }
+
+  //! \return IDs of the removed Nodes.
+  const ActAPI_NodeIdList& RemovedNodes() const
+  {
+    return m_removed;
+  }
+
+  //! \return renamed Nodes.
+  const NCollection_Sequence<t_renamedNode>& RenamedNodes() const
+  {
+    return m_renamed;
+  }
+
+  //! \return changed Parameters of the Nodes existing in both states.
+  const NCollection_Sequence<t_changedParameter>& ChangedParameters() const
+  {
+    return m_params;
+  }
+
+  //! \return rewired references of the Nodes existing in both states.
+  const NCollection_Sequence<t_rewiredReference>& RewiredReferences() const
+  {
+    return m_refs;
+  }
+
+public:
+
+  ActData_EXPORT void
+    Dump(Standard_OStream& theOut) const;
+
+protected:
+
+  void
+    compareNodes(const ActData_ModelDigest::t_node& theEarlier,
+                 const ActData_ModelDigest::t_node& theLater);
+
+protected:
+
+  ActAPI_NodeIdList                        m_added;   //!< Added Nodes.
+  ActAPI_NodeIdList                        m_removed; //!< Removed Nodes.
+  NCollection_Sequence<t_renamedNode>      m_renamed; //!< Renamed Nodes.
+  NCollection_Sequence<t_changedParameter> m_params;  //!< Changed Parameters.
+  NCollection_Sequence<t_rewiredReference> m_refs;    //!< Rewired references.
+
+};
+
+#endif
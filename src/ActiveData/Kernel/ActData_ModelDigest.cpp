@@ -0,0 +1,284 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <ActData_ModelDigest.h>
+
+// Active Data includes
+#include <ActData_BasePartition.h>
+#include <ActData_BinDrivers.h>
+#include <ActData_ParameterFactory.h>
+#include <ActData_ReferenceListParameter.h>
+#include <ActData_ReferenceParameter.h>
+#include <ActData_UserParameter.h>
+
+// OCCT includes
+#include <BinDrivers.hxx>
+#include <BinMDF_ADriver.hxx>
+#include <BinMDF_ADriverTable.hxx>
+#include <BinMNaming_NamedShapeDriver.hxx>
+#include <BinObjMgt_Persistent.hxx>
+#include <BinObjMgt_SRelocationTable.hxx>
+#include <Message.hxx>
+#include <TDF_AttributeIterator.hxx>
+#include <TDF_ChildIterator.hxx>
+#include <TDF_Tool.hxx>
+#include <TNaming_NamedShape.hxx>
+
+// Standard includes
+#include <cstring>
+#include <sstream>
+
+//-----------------------------------------------------------------------------
+
+//! Accumulates the passed bytes into FNV-1a hash.
+//! \param[in] theData bytes to hash.
+//! \param[in] theSize number of bytes.
+//! \param[in] theSeed hash accumulated so far.
+//! \return resulting hash.
+static Standard_Size HashBytes(const char*         theData,
+                               const size_t        theSize,
+                               const Standard_Size theSeed)
+{
+  Standard_Size hash = theSeed;
+  for ( size_t i = 0; i < theSize; ++i )
+  {
+    hash ^= (unsigned char) theData[i];
+    hash *= (Standard_Size) 1099511628211ULL;
+  }
+  return hash;
+}
+
+//! Accumulates the passed value into FNV-1a hash.
+//! \param[in] theValue value to hash.
+//! \param[in] theSeed  hash accumulated so far.
+//! \return resulting hash.
+template <typename T>
+static Standard_Size HashValue(const T& theValue, const Standard_Size theSeed)
+{
+  return HashBytes( (const char*) &theValue, sizeof(T), theSeed );
+}
+
+//! Initial value of FNV-1a hash.
+static const Standard_Size HashSeed = (Standard_Size) 14695981039346656037ULL;
+
+//-----------------------------------------------------------------------------
+
+//! Captures the content hashes of the Nodes stored in the passed Partitions.
+//! This constructor accesses OCAF, so it must not run concurrently with any
+//! modification of the Data Model.
+//! \param[in] thePartitions Partitions to capture.
+ActData_ModelDigest::ActData_ModelDigest(const t_partitions& thePartitions)
+: Standard_Transient()
+{
+  // The same drivers as for the full binary save
+  m_drivers = BinDrivers::AttributeDrivers( Message::DefaultMessenger() );
+  ActData_BinDrivers::AddDrivers( m_drivers, Message::DefaultMessenger() );
+
+  for ( t_partitions::Iterator pit(thePartitions); pit.More(); pit.Next() )
+  {
+    for ( ActData_BasePartition::Iterator nit( pit.Value() ); nit.More(); nit.Next() )
+    {
+      const Handle(ActAPI_INode)& node = nit.Value();
+      //
+      if ( node.IsNull() || !node->IsWellFormed() )
+        continue;
+
+      t_node nodeDigest;
+      nodeDigest.id       = node->GetId();
+      nodeDigest.name     = node->GetName();
+      nodeDigest.typeName = node->DynamicType()->Name();
+      nodeDigest.hash     = HashBytes( nodeDigest.typeName.ToCString(),
+                                       nodeDigest.typeName.Length(),
+                                       HashSeed );
+
+      for ( Handle(ActAPI_IParamIterator) it = node->GetParamIterator(); it->More(); it->Next() )
+      {
+        const Handle(ActAPI_IUserParameter)& param = it->Value();
+        //
+        if ( param.IsNull() || !param->IsWellFormed() )
+          continue;
+
+        t_parameter paramDigest;
+        paramDigest.key  = it->Key();
+        paramDigest.type = param->GetParamType();
+        paramDigest.hash = this->hashParameter(param);
+
+        // Reference targets are kept to report the rewired references
+        if ( paramDigest.type == Parameter_Reference )
+        {
+          paramDigest.isRef = Standard_True;
+
+          TDF_Label targetLab = ActParamTool::AsReference(param)->GetTargetLabel();
+          //
+          if ( !targetLab.IsNull() )
+          {
+            ActAPI_DataObjectId targetId;
+            TDF_Tool::Entry(targetLab, targetId);
+            paramDigest.targets.Append(targetId);
+          }
+        }
+        else if ( paramDigest.type == Parameter_ReferenceList )
+        {
+          paramDigest.isRef = Standard_True;
+
+          Handle(ActAPI_HDataCursorList) targets = ActParamTool::AsReferenceList(param)->GetTargets();
+          //
+          if ( !targets.IsNull() )
+            for ( ActAPI_DataCursorList::Iterator tit(*targets); tit.More(); tit.Next() )
+              if ( !tit.Value().IsNull() )
+                paramDigest.targets.Append( tit.Value()->GetId() );
+        }
+
+        nodeDigest.hash = HashValue(paramDigest.key,  nodeDigest.hash);
+        nodeDigest.hash = HashValue(paramDigest.hash, nodeDigest.hash);
+        nodeDigest.params.push_back(paramDigest);
+      }
+
+      m_nodeIndices.Bind( nodeDigest.id, (Standard_Integer) m_nodes.size() );
+      m_nodes.push_back(nodeDigest);
+    }
+  }
+
+  // Drivers are not needed anymore
+  m_drivers.Nullify();
+  m_typeNames.Clear();
+}
+
+//-----------------------------------------------------------------------------
+
+//! Finds the Node by its ID.
+//! \param[in] theNodeId ID of the Node to find.
+//! \return Node index or -1 if the Node is not captured in this digest.
+Standard_Integer
+  ActData_ModelDigest::FindNode(const ActAPI_NodeId& theNodeId) const
+{
+  const Standard_Integer* pIdx = m_nodeIndices.Seek(theNodeId);
+  //
+  return pIdx ? *pIdx : -1;
+}
+
+//-----------------------------------------------------------------------------
+
+//! Computes the content hash of the passed Parameter over all attributes
+//! of its Label and sub-Labels except the modification time and the
+//! validity and pending statuses. These are changed by the execution of
+//! functions rather than by the user.
+//! \param[in] theParam Parameter to hash.
+//! \return content hash.
+Standard_Size
+  ActData_ModelDigest::hashParameter(const Handle(ActAPI_IUserParameter)& theParam)
+{
+  const TDF_Label root = theParam->RootLabel();
+  Standard_Size   hash = this->hashAttributes(root, HashSeed);
+
+  for ( TDF_ChildIterator cit(root, Standard_True); cit.More(); cit.Next() )
+  {
+    const TDF_Label& lab = cit.Value();
+
+    // Datum the Label belongs to
+    TDF_Label datumLab = lab;
+    while ( datumLab.Father() != root )
+      datumLab = datumLab.Father();
+
+    if ( datumLab.Tag() == ActData_UserParameter::DS_MTime   ||
+         datumLab.Tag() == ActData_UserParameter::DS_IsValid ||
+         datumLab.Tag() == ActData_UserParameter::DS_IsPending )
+      continue;
+
+    hash = HashValue( lab.Tag(),   hash );
+    hash = HashValue( lab.Depth(), hash );
+    hash = this->hashAttributes(lab, hash);
+  }
+
+  return hash;
+}
+
+//! Accumulates the persistent form of the attributes of the given Label
+//! into the hash.
+//! \param[in] theLabel Label to hash the attributes of.
+//! \param[in] theSeed  hash accumulated so far.
+//! \return resulting hash.
+Standard_Size
+  ActData_ModelDigest::hashAttributes(const TDF_Label&    theLabel,
+                                      const Standard_Size theSeed)
+{
+  Standard_Size hash = theSeed;
+
+  for ( TDF_AttributeIterator ait(theLabel); ait.More(); ait.Next() )
+  {
+    const Handle(TDF_Attribute) attr     = ait.Value();
+    const Standard_CString      typeName = attr->DynamicType()->Name();
+    //
+    hash = HashBytes( typeName, strlen(typeName), hash );
+
+    // Type names are bound to drivers as they are met
+    Handle(BinMDF_ADriver) driver;
+    if ( m_drivers->GetDriver(attr->DynamicType(), driver) <= 0 )
+    {
+      m_typeNames.Append(typeName);
+      m_drivers->AssignIds(m_typeNames);
+
+      if ( m_drivers->GetDriver(attr->DynamicType(), driver) <= 0 )
+        continue; // Transient attribute
+    }
+
+    // Relocation table is local, so that references between attributes
+    // do not depend on the order of hashing
+    BinObjMgt_SRelocationTable reloc;
+    BinObjMgt_Persistent       pers;
+    pers.SetId( reloc.Add(attr) );
+    pers.SetTypeId(1); // Type is hashed by name
+    driver->Paste(attr, pers, reloc);
+
+    std::ostringstream out(std::ios::out | std::ios::binary);
+    pers.Write(out);
+
+    // Shapes are written to a dedicated section
+    if ( attr->IsKind( STANDARD_TYPE(TNaming_NamedShape) ) )
+    {
+      Handle(BinMNaming_NamedShapeDriver)
+        nsDriver = Handle(BinMNaming_NamedShapeDriver)::DownCast(driver);
+      //
+      if ( !nsDriver.IsNull() )
+      {
+        nsDriver->WriteShapeSection(out);
+        nsDriver->Clear();
+      }
+    }
+
+    const std::string bytes = out.str();
+    hash = HashBytes( bytes.data(), bytes.size(), hash );
+  }
+
+  return hash;
+}
@@ -0,0 +1,147 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+#ifndef ActData_ModelDigest_HeaderFile
+#define ActData_ModelDigest_HeaderFile
+
+// Active Data includes
+#include <ActData_Common.h>
+
+// Active Data (API) includes
+#include <ActAPI_IPartition.h>
+
+// OCCT includes
+#include <NCollection_DataMap.hxx>
+#include <TColStd_SequenceOfAsciiString.hxx>
+#include <TDF_Label.hxx>
+
+// Standard includes
+#include <vector>
+
+// OCCT forward declarations
+class BinMDF_ADriverTable;
+
+DEFINE_STANDARD_HANDLE(ActData_ModelDigest, Standard_Transient)
+
+//! \ingroup AD_DF
+//!
+//! Content hashes of the Nodes stored in the Data Model. For each Node,
+//! the digest keeps its ID, name and type together with a hash of every
+//! Parameter. Parameters are hashed over the persistent form of their
+//! OCAF attributes (the same drivers as for the binary save are used), so
+//! that any value change is detected regardless of the Parameter type.
+//! Modification time and the validity and pending statuses are excluded as
+//! they change without any change of the value. The Node type is hashed
+//! together with the Parameters. Targets of reference Parameters are kept explicitly, so that the
+//! rewired references can be reported.
+//!
+//! Two digests are compared with ActData_ModelDiff. The digest does not
+//! refer to OCAF once constructed, so it can outlive the Document state
+//! it was captured from.
+class ActData_ModelDigest : public Standard_Transient
+{
+public:
+
+  // OCCT RTTI
+  DEFINE_STANDARD_RTTI_INLINE(ActData_ModelDigest, Standard_Transient)
+
+public:
+
+  //! Digest of a Parameter.
+  struct t_parameter
+  {
+    Standard_Integer                           key;     //!< Parameter ID within the Node.
+    Standard_Integer                           type;    //!< Parameter type.
+    Standard_Size                              hash;    //!< Content hash.
+    Standard_Boolean                           isRef;   //!< Whether the Parameter is a reference.
+    NCollection_Sequence<ActAPI_DataObjectId> targets; //!< Reference targets.
+
+    t_parameter() : key(0), type(Parameter_UNDEFINED), hash(0), isRef(Standard_False) {}
+  };
+
+  //! Digest of a Node.
+  struct t_node
+  {
+    ActAPI_NodeId              id;       //!< Node ID.
+    TCollection_ExtendedString name;     //!< Node name.
+    TCollection_AsciiString    typeName; //!< Node type.
+    Standard_Size              hash;     //!< Combined hash of the type and Parameters.
+    std::vector<t_parameter>   params;   //!< Parameters in the iteration order.
+
+    t_node() : hash(0) {}
+  };
+
+  //! Short-cut for Partitions to capture.
+  typedef NCollection_Sequence<Handle(ActAPI_IPartition)> t_partitions;
+
+public:
+
+  ActData_EXPORT
+    ActData_ModelDigest(const t_partitions& thePartitions);
+
+public:
+
+  //! \return number of captured Nodes.
+  Standard_Integer NbNodes() const
+  {
+    return (Standard_Integer) m_nodes.size();
+  }
+
+  //! \param[in] theNode zero-based Node index.
+  //! \return Node digest.
+  const t_node& Node(const Standard_Integer theNode) const
+  {
+    return m_nodes[theNode];
+  }
+
+  ActData_EXPORT Standard_Integer
+    FindNode(const ActAPI_NodeId& theNodeId) const;
+
+protected:
+
+  Standard_Size
+    hashParameter(const Handle(ActAPI_IUserParameter)& theParam);
+
+  Standard_Size
+    hashAttributes(const TDF_Label&    theLabel,
+                   const Standard_Size theSeed);
+
+protected:
+
+  std::vector<t_node>                                  m_nodes;       //!< Captured Nodes.
+  NCollection_DataMap<ActAPI_NodeId, Standard_Integer> m_nodeIndices; //!< Node indices by IDs.
+  Handle(BinMDF_ADriverTable)                          m_drivers;     //!< Attribute drivers.
+  TColStd_SequenceOfAsciiString                        m_typeNames;   //!< Types bound to drivers.
+
+};
+
+#endif
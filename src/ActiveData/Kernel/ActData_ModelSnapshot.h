@@ -0,0 +1,118 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+#ifndef ActData_ModelSnapshot_HeaderFile
+#define ActData_ModelSnapshot_HeaderFile
+
+// Active Data includes
+#include <ActData_PartitionSnapshot.h>
+
+DEFINE_STANDARD_HANDLE(ActData_ModelSnapshot, Standard_Transient)
+
+//! \ingroup AD_DF
+//!
+//! Immutable snapshot of the selected Partitions of the Data Model. The
+//! snapshot is a set of ActData_PartitionSnapshot instances, so it is safe
+//! to query it from many threads. Partitions which were not modified since
+//! the previous snapshot are shared between the snapshots rather than
+//! copied (see ActData_SnapshotBuilder).
+class ActData_ModelSnapshot : public Standard_Transient
+{
+public:
+
+  // OCCT RTTI
+  DEFINE_STANDARD_RTTI_INLINE(ActData_ModelSnapshot, Standard_Transient)
+
+public:
+
+  //! Short-cut for captured Partitions by their IDs.
+  typedef NCollection_DataMap<Standard_Integer, Handle(ActData_PartitionSnapshot)> t_partitions;
+
+public:
+
+  //! Constructor.
+  //! \param[in] thePartitions captured Partitions.
+  ActData_ModelSnapshot(const t_partitions& thePartitions)
+  : Standard_Transient(), m_partitions(thePartitions) {}
+
+public:
+
+  //! \return captured Partitions.
+  const t_partitions& Partitions() const
+  {
+    return m_partitions;
+  }
+
+  //! Returns the captured Partition with the given ID.
+  //! \param[in] thePartitionId Partition ID.
+  //! \return Partition snapshot or null handle if the Partition was not
+  //!         captured.
+  Handle(ActData_PartitionSnapshot) Partition(const Standard_Integer thePartitionId) const
+  {
+    const Handle(ActData_PartitionSnapshot)* pPartition = m_partitions.Seek(thePartitionId);
+    //
+    if ( !pPartition )
+      return NULL;
+
+    return *pPartition;
+  }
+
+  //! Finds the Node by its ID in all captured Partitions.
+  //! \param[in]  theNodeId    ID of the Node to find.
+  //! \param[out] thePartition Partition snapshot containing the Node.
+  //! \param[out] theNode      index of the Node in the Partition snapshot.
+  //! \return true if the Node was found, false -- otherwise.
+  Standard_Boolean FindNode(const ActAPI_NodeId&               theNodeId,
+                            Handle(ActData_PartitionSnapshot)& thePartition,
+                            Standard_Integer&                  theNode) const
+  {
+    for ( t_partitions::Iterator it(m_partitions); it.More(); it.Next() )
+    {
+      theNode = it.Value()->FindNode(theNodeId);
+      //
+      if ( theNode >= 0 )
+      {
+        thePartition = it.Value();
+        return Standard_True;
+      }
+    }
+
+    return Standard_False;
+  }
+
+protected:
+
+  t_partitions m_partitions; //!< Captured Partitions.
+
+};
+
+#endif
@@ -0,0 +1,452 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <ActData_PackedLogBook.h>
+
+// Active Data includes
+#include <ActData_DocumentStateAttr.h>
+
+//-----------------------------------------------------------------------------
+// Lookup
+//-----------------------------------------------------------------------------
+
+//! Finds the packed LogBook of the OCAF Document owning the given Label.
+//! \param[in] theLab any Label of the OCAF Document.
+//! \return packed LogBook or null handle if the Document uses the
+//!         attribute-based LogBook.
+Handle(ActData_PackedLogBook) ActData_PackedLogBook::Find(const TDF_Label& theLab)
+{
+  Handle(ActData_DocumentStateAttr) state = ActData_DocumentStateAttr::Find(theLab);
+  //
+  if ( state.IsNull() )
+    return NULL;
+
+  return state->GetPackedLogBook();
+}
+
+//-----------------------------------------------------------------------------
+// Construction
+//-----------------------------------------------------------------------------
+
+//! Default constructor.
+ActData_PackedLogBook::ActData_PackedLogBook()
+: Standard_Transient (),
+  m_bIsJournaling    (Standard_False),
+  m_iTxIndex         (0),
+  m_iNbCompacted     (1)
+{
+  this->newOrdinal(-1, 0); // Root Label.
+}
+
+//-----------------------------------------------------------------------------
+// Records
+//-----------------------------------------------------------------------------
+
+//! Adds the given records for the passed Label.
+//! \param[in] theLab   Label to log.
+//! \param[in] theFlags bitwise mask of records to add.
+void ActData_PackedLogBook::Log(const TDF_Label&       theLab,
+                                const Standard_Integer theFlags)
+{
+  const Standard_Integer ordinal = this->bindOrdinal(theLab);
+  const Standard_Byte    before  = m_flags[ordinal];
+  //
+  if ( (before & theFlags) == theFlags )
+    return; // Nothing to change.
+
+  this->setFlags( ordinal, Standard_Byte(before | theFlags) );
+}
+
+//! Removes the given records for the passed Label.
+//! \param[in] theLab   Label to release.
+//! \param[in] theFlags bitwise mask of records to remove.
+void ActData_PackedLogBook::Release(const TDF_Label&       theLab,
+                                    const Standard_Integer theFlags)
+{
+  const Standard_Integer ordinal = this->findOrdinal(theLab);
+  //
+  if ( ordinal < 0 || !(m_flags[ordinal] & theFlags) )
+    return;
+
+  this->setFlags( ordinal, Standard_Byte(m_flags[ordinal] & ~theFlags) );
+}
+
+//! Removes the given records for all Labels. The ordinals left without
+//! records are compacted once they outnumber the ones kept by the last
+//! compaction, so that the ordinals of deleted Labels do not accumulate.
+//! If a command is open, the compaction is deferred to its commit.
+//! \param[in] theFlags bitwise mask of records to remove.
+void ActData_PackedLogBook::Release(const Standard_Integer theFlags)
+{
+  const Standard_Integer nbOrdinals = (Standard_Integer) m_flags.size();
+  //
+  for ( Standard_Integer ordinal = 0; ordinal < nbOrdinals; ++ordinal )
+  {
+    if ( m_flags[ordinal] & theFlags )
+      this->setFlags( ordinal, Standard_Byte(m_flags[ordinal] & ~theFlags) );
+  }
+
+  if ( !m_bIsJournaling )
+    this->compactIfSparse();
+}
+
+//-----------------------------------------------------------------------------
+// Transactions
+//-----------------------------------------------------------------------------
+
+//! Starts journaling of the records modified within a new command.
+void ActData_PackedLogBook::OpenCommand()
+{
+  m_journal.clear();
+  m_bIsJournaling = Standard_True;
+  m_iTxIndex++;
+}
+
+//! Rolls back the records modified within the currently open command.
+void ActData_PackedLogBook::AbortCommand()
+{
+  for ( t_delta::const_reverse_iterator it = m_journal.rbegin(); it != m_journal.rend(); ++it )
+    m_flags[it->ordinal] = it->before;
+
+  m_journal.clear();
+  m_bIsJournaling = Standard_False;
+}
+
+//! Marks a savepoint in the currently open command. The records modified
+//! after the savepoint are journaled anew, so that rollback to the savepoint
+//! restores them even if they have been journaled before.
+//! \return mark of the savepoint in the journal.
+Standard_Size ActData_PackedLogBook::MarkSavepoint()
+{
+  m_iTxIndex++;
+  return m_journal.size();
+}
+
+//! Rolls back the records modified after the given savepoint. The command
+//! remains open.
+//! \param[in] theMark mark of the savepoint returned by MarkSavepoint().
+void ActData_PackedLogBook::RollbackToSavepoint(const Standard_Size theMark)
+{
+  if ( theMark > m_journal.size() )
+    return;
+
+  for ( t_delta::const_reverse_iterator it = m_journal.rbegin();
+        it != t_delta::const_reverse_iterator(m_journal.begin() + theMark); ++it )
+    m_flags[it->ordinal] = it->before;
+
+  m_journal.resize(theMark);
+  m_iTxIndex++;
+}
+
+//! Finalizes the currently open command.
+//! \param[in] isStacked    indicates whether OCAF has stacked a new delta
+//!                         for the committed command.
+//! \param[in] theUndoLimit undo limit of the OCAF Document.
+void ActData_PackedLogBook::CommitCommand(const Standard_Boolean isStacked,
+                                          const Standard_Integer theUndoLimit)
+{
+  m_bIsJournaling = Standard_False;
+
+  // If OCAF did not produce any delta, there is nothing to align the journal
+  // with. The records are kept as-is, just like they would remain in the
+  // attribute-based LogBook modified out of any transaction.
+  if ( !isStacked )
+  {
+    m_journal.clear();
+    this->compactIfSparse();
+    return;
+  }
+
+  // Fix the resulting state of each journaled ordinal.
+  for ( t_delta::iterator it = m_journal.begin(); it != m_journal.end(); ++it )
+    it->after = m_flags[it->ordinal];
+
+  m_undos.push_back(t_delta());
+  m_undos.back().swap(m_journal);
+  m_redos.clear();
+
+  while ( (Standard_Integer) m_undos.size() > theUndoLimit )
+    m_undos.pop_front();
+
+  this->compactIfSparse();
+}
+
+//! Restores the records as they were before the last committed command.
+void ActData_PackedLogBook::Undo()
+{
+  if ( m_undos.empty() )
+    return;
+
+  const t_delta& delta = m_undos.back();
+  //
+  for ( t_delta::const_reverse_iterator it = delta.rbegin(); it != delta.rend(); ++it )
+    m_flags[it->ordinal] = it->before;
+
+  m_redos.push_back(t_delta());
+  m_redos.back().swap( m_undos.back() );
+  m_undos.pop_back();
+}
+
+//! Restores the records as they were after the last undone command.
+void ActData_PackedLogBook::Redo()
+{
+  if ( m_redos.empty() )
+    return;
+
+  const t_delta& delta = m_redos.back();
+  //
+  for ( t_delta::const_iterator it = delta.begin(); it != delta.end(); ++it )
+    m_flags[it->ordinal] = it->after;
+
+  m_undos.push_back(t_delta());
+  m_undos.back().swap( m_redos.back() );
+  m_redos.pop_back();
+}
+
+//! Cleans up Undo/Redo history of the records. The ordinals which were
+//! kept only for the history are dropped.
+void ActData_PackedLogBook::ReleaseHistory()
+{
+  m_undos.clear();
+  m_redos.clear();
+
+  this->compact();
+}
+
+//! Drops the oldest Undo records so that at most the given number of them
+//! is kept. This follows eviction of the oldest OCAF deltas.
+//! \param[in] theNbUndos number of Undo records to keep.
+void ActData_PackedLogBook::LimitHistory(const Standard_Integer theNbUndos)
+{
+  while ( (Standard_Integer) m_undos.size() > theNbUndos )
+    m_undos.pop_front();
+}
+
+//! Merges the two most recent Undo records into one. This follows
+//! coalescing of the two most recent OCAF deltas.
+void ActData_PackedLogBook::CoalesceLast()
+{
+  if ( m_undos.size() < 2 )
+    return;
+
+  // Undo replays the changes backwards, so the concatenation restores the
+  // flags as they were before the earlier command
+  t_delta& earlier = m_undos[m_undos.size() - 2];
+  earlier.insert( earlier.end(), m_undos.back().begin(), m_undos.back().end() );
+  m_undos.pop_back();
+}
+
+//-----------------------------------------------------------------------------
+// Internals
+//-----------------------------------------------------------------------------
+
+//! Sets new flags for the given ordinal journaling the previous value if
+//! a command is currently open.
+//! \param[in] theOrdinal ordinal to modify.
+//! \param[in] theFlags   flags to set.
+void ActData_PackedLogBook::setFlags(const Standard_Integer theOrdinal,
+                                     const Standard_Byte    theFlags)
+{
+  if ( m_bIsJournaling && m_journaledIn[theOrdinal] != m_iTxIndex )
+  {
+    t_change change;
+    change.ordinal = theOrdinal;
+    change.before  = m_flags[theOrdinal];
+    change.after   = theFlags;
+    //
+    m_journal.push_back(change);
+    m_journaledIn[theOrdinal] = m_iTxIndex;
+  }
+
+  m_flags[theOrdinal] = theFlags;
+}
+
+//! Finds the ordinal of the given Label.
+//! \param[in] theLab Label to find the ordinal for.
+//! \return ordinal or -1 if the Label is not bound.
+Standard_Integer ActData_PackedLogBook::findOrdinal(const TDF_Label& theLab) const
+{
+  if ( theLab.IsNull() )
+    return -1;
+
+  if ( theLab.IsRoot() )
+    return 0;
+
+  const Standard_Integer parent = this->findOrdinal( theLab.Father() );
+  if ( parent < 0 )
+    return -1;
+
+  const std::vector<Standard_Integer>& children = m_children[parent];
+  const Standard_Integer               tag      = theLab.Tag();
+  //
+  if ( tag < 0 || tag >= (Standard_Integer) children.size() )
+    return -1;
+
+  return children[tag] - 1;
+}
+
+//! Finds the ordinal of the given Label binding the missing ordinals for
+//! the Label and its ancestors.
+//! \param[in] theLab Label to bind.
+//! \return ordinal of the Label.
+Standard_Integer ActData_PackedLogBook::bindOrdinal(const TDF_Label& theLab)
+{
+  if ( theLab.IsRoot() )
+    return 0;
+
+  const Standard_Integer parent = this->bindOrdinal( theLab.Father() );
+  const Standard_Integer tag    = theLab.Tag();
+  //
+  if ( tag < (Standard_Integer) m_children[parent].size() && m_children[parent][tag] )
+    return m_children[parent][tag] - 1;
+
+  return this->newOrdinal(parent, tag);
+}
+
+//! Allocates a new ordinal for the child Label with the given tag.
+//! \param[in] theParent parent ordinal (-1 for the root Label).
+//! \param[in] theTag    tag of the child Label.
+//! \return new ordinal.
+Standard_Integer ActData_PackedLogBook::newOrdinal(const Standard_Integer theParent,
+                                                   const Standard_Integer theTag)
+{
+  const Standard_Integer ordinal = (Standard_Integer) m_flags.size();
+  //
+  m_children.push_back( std::vector<Standard_Integer>() );
+  m_parents.push_back(theParent);
+  m_tags.push_back(theTag);
+  m_flags.push_back(0);
+  m_journaledIn.push_back(0);
+
+  if ( theParent >= 0 )
+  {
+    std::vector<Standard_Integer>& siblings = m_children[theParent];
+    //
+    if ( theTag >= (Standard_Integer) siblings.size() )
+      siblings.resize(theTag + 1, 0);
+
+    siblings[theTag] = ordinal + 1;
+  }
+  return ordinal;
+}
+
+//! Drops the ordinals having no records and not referenced by the journal
+//! or the Undo/Redo history. The remaining ordinals are renumbered and the
+//! history is remapped accordingly.
+void ActData_PackedLogBook::compact()
+{
+  const Standard_Integer nbOrdinals = (Standard_Integer) m_flags.size();
+
+  // Mark the ordinals to keep
+  std::vector<char> isKept(nbOrdinals, 0);
+  isKept[0] = 1;
+  //
+  for ( Standard_Integer ordinal = 0; ordinal < nbOrdinals; ++ordinal )
+    if ( m_flags[ordinal] )
+      isKept[ordinal] = 1;
+  //
+  for ( t_delta::const_iterator it = m_journal.begin(); it != m_journal.end(); ++it )
+    isKept[it->ordinal] = 1;
+  //
+  for ( Standard_Size d = 0; d < m_undos.size(); ++d )
+    for ( t_delta::const_iterator it = m_undos[d].begin(); it != m_undos[d].end(); ++it )
+      isKept[it->ordinal] = 1;
+  //
+  for ( Standard_Size d = 0; d < m_redos.size(); ++d )
+    for ( t_delta::const_iterator it = m_redos[d].begin(); it != m_redos[d].end(); ++it )
+      isKept[it->ordinal] = 1;
+
+  // Parents are always allocated before their children, so a single
+  // backward pass keeps the ancestors of all kept ordinals
+  for ( Standard_Integer ordinal = nbOrdinals - 1; ordinal > 0; --ordinal )
+    if ( isKept[ordinal] )
+      isKept[m_parents[ordinal]] = 1;
+
+  // Renumber
+  std::vector<Standard_Integer> remap(nbOrdinals, -1);
+  Standard_Integer              nbKept = 0;
+  //
+  for ( Standard_Integer ordinal = 0; ordinal < nbOrdinals; ++ordinal )
+  {
+    if ( !isKept[ordinal] )
+      continue;
+
+    remap[ordinal] = nbKept;
+    //
+    m_parents[nbKept]     = ordinal ? remap[m_parents[ordinal]] : -1;
+    m_tags[nbKept]        = m_tags[ordinal];
+    m_flags[nbKept]       = m_flags[ordinal];
+    m_journaledIn[nbKept] = m_journaledIn[ordinal];
+    m_children[nbKept].clear();
+    nbKept++;
+  }
+  //
+  m_children.resize(nbKept);
+  m_parents.resize(nbKept);
+  m_tags.resize(nbKept);
+  m_flags.resize(nbKept);
+  m_journaledIn.resize(nbKept);
+
+  for ( Standard_Integer ordinal = 1; ordinal < nbKept; ++ordinal )
+  {
+    std::vector<Standard_Integer>& siblings = m_children[m_parents[ordinal]];
+    const Standard_Integer         tag      = m_tags[ordinal];
+    //
+    if ( tag >= (Standard_Integer) siblings.size() )
+      siblings.resize(tag + 1, 0);
+
+    siblings[tag] = ordinal + 1;
+  }
+
+  // Remap the history
+  for ( t_delta::iterator it = m_journal.begin(); it != m_journal.end(); ++it )
+    it->ordinal = remap[it->ordinal];
+  //
+  for ( Standard_Size d = 0; d < m_undos.size(); ++d )
+    for ( t_delta::iterator it = m_undos[d].begin(); it != m_undos[d].end(); ++it )
+      it->ordinal = remap[it->ordinal];
+  //
+  for ( Standard_Size d = 0; d < m_redos.size(); ++d )
+    for ( t_delta::iterator it = m_redos[d].begin(); it != m_redos[d].end(); ++it )
+      it->ordinal = remap[it->ordinal];
+
+  m_iNbCompacted = nbKept;
+}
+
+//! Compacts the ordinals once they outnumber the ones kept by the last
+//! compaction.
+void ActData_PackedLogBook::compactIfSparse()
+{
+  if ( (Standard_Integer) m_flags.size() > 2*m_iNbCompacted + 64 )
+    this->compact();
+}
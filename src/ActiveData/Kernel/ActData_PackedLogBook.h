@@ -0,0 +1,240 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+#ifndef ActData_PackedLogBook_HeaderFile
+#define ActData_PackedLogBook_HeaderFile
+
+// Active Data includes
+#include <ActData_Common.h>
+
+// OCCT includes
+#include <TDF_Label.hxx>
+
+// Standard includes
+#include <deque>
+#include <vector>
+
+DEFINE_STANDARD_HANDLE(ActData_PackedLogBook, Standard_Transient)
+
+//! \ingroup AD_DF
+//!
+//! Transient storage for the modification LogBook. Unlike the OCAF-based
+//! LogBook which keeps TOUCHED, IMPACTED, FORCED and HEAVY DEPLOYMENT records
+//! in four ActData_LogBookAttr attributes, this storage assigns a dense
+//! ordinal to each logged Label and keeps all four records as bits of a
+//! single byte per ordinal. Logging and lookup therefore do not take any
+//! OCAF backups and do not contribute to the undo deltas.
+//!
+//! Ordinals follow the tag path of a Label (partition, Node, Parameter):
+//! each ordinal keeps a table of its children indexed by tag, so a Label
+//! is resolved by a few array accesses without any hashing. Ordinals which
+//! have no records and are not referenced by the transaction history are
+//! dropped, and the rest is renumbered, on Release(), on commit and on
+//! ReleaseHistory().
+//!
+//! To preserve the transactional semantics of the OCAF LogBook, the packed
+//! LogBook keeps a journal of the flags changed within the currently open
+//! command. On abort, the journal is rolled back. On commit, the journal is
+//! stacked alongside the OCAF delta so that Undo/Redo can restore exactly
+//! the same records as the attribute-based LogBook would.
+//!
+//! The packed LogBook is kept by ActData_DocumentStateAttr of its Document,
+//! so that any Label of the Document can be used to find it without accessing
+//! the LogBook section of the Data Model.
+class ActData_PackedLogBook : public Standard_Transient
+{
+public:
+
+  // OCCT RTTI
+  DEFINE_STANDARD_RTTI_INLINE(ActData_PackedLogBook, Standard_Transient)
+
+public:
+
+  //! Bits representing the LogBook sections. The values correspond to
+  //! the structure tags of ActData_LogBook, i.e., flag = 1 << (tag - 1).
+  enum Flags
+  {
+    Flag_Touched     = 0x01, //!< TOUCHED record.
+    Flag_Impacted    = 0x02, //!< IMPACTED record.
+    Flag_Forced      = 0x04, //!< FORCED record.
+    Flag_HeavyDeploy = 0x08, //!< HEAVY DEPLOYMENT record.
+    //
+    Flag_Modified    = Flag_Touched | Flag_Impacted,
+    Flag_All         = Flag_Touched | Flag_Impacted | Flag_Forced | Flag_HeavyDeploy
+  };
+
+// Lookup:
+public:
+
+  ActData_EXPORT static Handle(ActData_PackedLogBook)
+    Find(const TDF_Label& theLab);
+
+// Construction:
+public:
+
+  ActData_EXPORT
+    ActData_PackedLogBook();
+
+// Records:
+public:
+
+  ActData_EXPORT void
+    Log(const TDF_Label&       theLab,
+        const Standard_Integer theFlags);
+
+  ActData_EXPORT void
+    Release(const TDF_Label&       theLab,
+            const Standard_Integer theFlags);
+
+  ActData_EXPORT void
+    Release(const Standard_Integer theFlags);
+
+  //! Checks whether the passed Label has any of the given records.
+  //! \param[in] theLab   Label to check.
+  //! \param[in] theFlags bitwise mask of records to check.
+  //! \return true/false.
+  Standard_Boolean IsLogged(const TDF_Label&       theLab,
+                            const Standard_Integer theFlags) const
+  {
+    const Standard_Integer ordinal = this->findOrdinal(theLab);
+    //
+    return ordinal >= 0 && (m_flags[ordinal] & theFlags) != 0;
+  }
+
+  //! \return number of ordinals currently allocated in this LogBook.
+  Standard_Integer NbOrdinals() const
+  {
+    return (Standard_Integer) m_flags.size();
+  }
+
+// Transactions:
+public:
+
+  ActData_EXPORT void
+    OpenCommand();
+
+  ActData_EXPORT void
+    AbortCommand();
+
+  ActData_EXPORT void
+    CommitCommand(const Standard_Boolean isStacked,
+                  const Standard_Integer theUndoLimit);
+
+  ActData_EXPORT void
+    Undo();
+
+  ActData_EXPORT void
+    Redo();
+
+  ActData_EXPORT void
+    ReleaseHistory();
+
+  ActData_EXPORT void
+    LimitHistory(const Standard_Integer theNbUndos);
+
+  ActData_EXPORT void
+    CoalesceLast();
+
+  ActData_EXPORT Standard_Size
+    MarkSavepoint();
+
+  ActData_EXPORT void
+    RollbackToSavepoint(const Standard_Size theMark);
+
+protected:
+
+  //! Change of flags for a single ordinal.
+  struct t_change
+  {
+    Standard_Integer ordinal; //!< Ordinal of the Label.
+    Standard_Byte    before;  //!< Flags before the change.
+    Standard_Byte    after;   //!< Flags after the change.
+  };
+
+  //! Changes recorded in a single transaction.
+  typedef std::vector<t_change> t_delta;
+
+protected:
+
+  void setFlags(const Standard_Integer theOrdinal,
+                const Standard_Byte    theFlags);
+
+  Standard_Integer findOrdinal(const TDF_Label& theLab) const;
+
+  Standard_Integer bindOrdinal(const TDF_Label& theLab);
+
+  Standard_Integer newOrdinal(const Standard_Integer theParent,
+                              const Standard_Integer theTag);
+
+  void compact();
+
+  void compactIfSparse();
+
+protected:
+
+  //! Ordinals of the child Labels indexed by tag (ordinal + 1, or zero if
+  //! the child is not bound). The ordinal 0 stands for the root Label.
+  std::vector< std::vector<Standard_Integer> > m_children;
+
+  //! Parent ordinal of each ordinal.
+  std::vector<Standard_Integer> m_parents;
+
+  //! Label tag of each ordinal.
+  std::vector<Standard_Integer> m_tags;
+
+  //! Records packed as bits per ordinal.
+  std::vector<Standard_Byte> m_flags;
+
+  //! Index of the transaction where each ordinal was last journaled.
+  std::vector<Standard_Integer> m_journaledIn;
+
+  //! Journal of the currently open command.
+  t_delta m_journal;
+
+  //! Indicates whether a command is currently open.
+  Standard_Boolean m_bIsJournaling;
+
+  //! Index of the current transaction.
+  Standard_Integer m_iTxIndex;
+
+  //! Changes for Undo (the most recent transaction is at the back).
+  std::deque<t_delta> m_undos;
+
+  //! Changes for Redo (the most recent undone transaction is at the back).
+  std::vector<t_delta> m_redos;
+
+  //! Number of ordinals left after the last compaction.
+  Standard_Integer m_iNbCompacted;
+
+};
+
+#endif
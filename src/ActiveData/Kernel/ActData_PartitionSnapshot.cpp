@@ -0,0 +1,195 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <ActData_PartitionSnapshot.h>
+
+// Active Data includes
+#include <ActData_BasePartition.h>
+#include <ActData_BoolArrayParameter.h>
+#include <ActData_BoolParameter.h>
+#include <ActData_IntArrayParameter.h>
+#include <ActData_IntParameter.h>
+#include <ActData_ParameterFactory.h>
+#include <ActData_RealArrayParameter.h>
+#include <ActData_RealParameter.h>
+
+// OCCT includes
+#include <TDF_Tool.hxx>
+
+//-----------------------------------------------------------------------------
+
+//! Appends the value of the passed Parameter to the flat array of values.
+//! \param[in]     param  Parameter to capture the value for.
+//! \param[in,out] values flat array of values.
+//! \return kind of the captured value.
+static ActData_PartitionSnapshot::ValueKind
+  CaptureValue(const Handle(ActAPI_IUserParameter)& param,
+               std::vector<Standard_Real>&          values)
+{
+  switch ( param->GetParamType() )
+  {
+    case Parameter_Int:
+      values.push_back( ActParamTool::AsInt(param)->GetValue() );
+      return ActData_PartitionSnapshot::Value_Scalar;
+
+    case Parameter_Real:
+      values.push_back( ActParamTool::AsReal(param)->GetValue() );
+      return ActData_PartitionSnapshot::Value_Scalar;
+
+    case Parameter_Bool:
+      values.push_back( ActParamTool::AsBool(param)->GetValue() ? 1.0 : 0.0 );
+      return ActData_PartitionSnapshot::Value_Scalar;
+
+    case Parameter_IntArray:
+    {
+      Handle(HIntArray) arr = ActParamTool::AsIntArray(param)->GetArray();
+      //
+      if ( !arr.IsNull() )
+        for ( Standard_Integer i = arr->Lower(); i <= arr->Upper(); ++i )
+          values.push_back( arr->Value(i) );
+
+      return ActData_PartitionSnapshot::Value_Array;
+    }
+
+    case Parameter_RealArray:
+    {
+      Handle(HRealArray) arr = ActParamTool::AsRealArray(param)->GetArray();
+      //
+      if ( !arr.IsNull() )
+        values.insert( values.end(), &arr->First(), &arr->First() + arr->Length() );
+
+      return ActData_PartitionSnapshot::Value_Array;
+    }
+
+    case Parameter_BoolArray:
+    {
+      Handle(HBoolArray) arr = ActParamTool::AsBoolArray(param)->GetArray();
+      //
+      if ( !arr.IsNull() )
+        for ( Standard_Integer i = arr->Lower(); i <= arr->Upper(); ++i )
+          values.push_back( arr->Value(i) ? 1.0 : 0.0 );
+
+      return ActData_PartitionSnapshot::Value_Array;
+    }
+
+    default: break;
+  }
+
+  return ActData_PartitionSnapshot::Value_None;
+}
+
+//-----------------------------------------------------------------------------
+
+//! Captures the Nodes of the passed Partition. This constructor accesses
+//! OCAF, so it must not run concurrently with any modification of the
+//! Data Model.
+//! \param[in] thePartition   Partition to capture.
+//! \param[in] thePartitionId ID of the Partition in the Data Model.
+ActData_PartitionSnapshot::ActData_PartitionSnapshot(const Handle(ActAPI_IPartition)& thePartition,
+                                                     const Standard_Integer           thePartitionId)
+: Standard_Transient (),
+  m_iPartitionId     (thePartitionId)
+{
+  m_childOffsets.push_back(0);
+  m_paramOffsets.push_back(0);
+  m_valueOffsets.push_back(0);
+
+  for ( ActData_BasePartition::Iterator nit(thePartition); nit.More(); nit.Next() )
+  {
+    const Handle(ActAPI_INode)& node = nit.Value();
+    //
+    if ( node.IsNull() || !node->IsWellFormed() )
+      continue;
+
+    // Node's own data
+    m_nodeIndices.Bind( node->GetId(), (Standard_Integer) m_nodeIds.size() );
+    m_nodeIds.push_back( node->GetId() );
+    m_nodeNames.push_back( node->GetName() );
+
+    // User tree
+    Handle(ActAPI_INode) parent = node->GetParentNode();
+    m_parentIds.push_back( parent.IsNull() ? ActAPI_NodeId() : parent->GetId() );
+    //
+    for ( Handle(ActAPI_IChildIterator) cit = node->GetChildIterator(); cit->More(); cit->Next() )
+    {
+      ActAPI_NodeId childId;
+      TDF_Tool::Entry(cit->ValueLabel(), childId);
+      //
+      m_childIds.push_back(childId);
+    }
+    m_childOffsets.push_back( (Standard_Integer) m_childIds.size() );
+
+    // Parameters
+    for ( Handle(ActAPI_IParamIterator) pit = node->GetParamIterator(); pit->More(); pit->Next() )
+    {
+      const Handle(ActAPI_IUserParameter)& param = pit->Value();
+      //
+      if ( param.IsNull() || !param->IsWellFormed() )
+        continue;
+
+      m_paramKeys.push_back( pit->Key() );
+      m_paramTypes.push_back( param->GetParamType() );
+      m_valueKinds.push_back( (Standard_Byte) CaptureValue(param, m_values) );
+      m_valueOffsets.push_back( (Standard_Integer) m_values.size() );
+    }
+    m_paramOffsets.push_back( (Standard_Integer) m_paramKeys.size() );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+//! Finds the Node by its ID.
+//! \param[in] theNodeId ID of the Node to find.
+//! \return Node index or -1 if the Node is not captured in this snapshot.
+Standard_Integer
+  ActData_PartitionSnapshot::FindNode(const ActAPI_NodeId& theNodeId) const
+{
+  const Standard_Integer* pIdx = m_nodeIndices.Seek(theNodeId);
+  //
+  return pIdx ? *pIdx : -1;
+}
+
+//! Finds the Parameter of the given Node by its ID within the Node.
+//! \param[in] theNode Node index.
+//! \param[in] theKey  Parameter ID within the Node.
+//! \return Parameter index or -1 if the Parameter is not captured.
+Standard_Integer
+  ActData_PartitionSnapshot::FindParameter(const Standard_Integer theNode,
+                                           const Standard_Integer theKey) const
+{
+  for ( Standard_Integer p = m_paramOffsets[theNode]; p < m_paramOffsets[theNode + 1]; ++p )
+    if ( m_paramKeys[p] == theKey )
+      return p - m_paramOffsets[theNode];
+
+  return -1;
+}
@@ -0,0 +1,222 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+#ifndef ActData_PartitionSnapshot_HeaderFile
+#define ActData_PartitionSnapshot_HeaderFile
+
+// Active Data includes
+#include <ActData_Common.h>
+
+// Active Data (API) includes
+#include <ActAPI_IPartition.h>
+
+// OCCT includes
+#include <NCollection_DataMap.hxx>
+
+// Standard includes
+#include <vector>
+
+DEFINE_STANDARD_HANDLE(ActData_PartitionSnapshot, Standard_Transient)
+
+//! \ingroup AD_DF
+//!
+//! Immutable copy of the Nodes stored in a single Partition. The snapshot
+//! keeps Node IDs, names, the structure of the user tree, and the values of
+//! scalar (integer, real and Boolean) and array Parameters in flat arrays.
+//! Once constructed, the snapshot is never modified and does not refer to
+//! OCAF anymore, so it can be queried from any number of threads at the
+//! same time.
+//!
+//! Nodes are addressed by zero-based indices in the order of the Partition.
+//! Parameters of a Node are addressed by zero-based indices in the order of
+//! the Parameter iterator. Integer and Boolean values are kept as reals.
+class ActData_PartitionSnapshot : public Standard_Transient
+{
+public:
+
+  // OCCT RTTI
+  DEFINE_STANDARD_RTTI_INLINE(ActData_PartitionSnapshot, Standard_Transient)
+
+public:
+
+  //! Kind of the captured Parameter value.
+  enum ValueKind
+  {
+    Value_None = 0, //!< Value is not captured for this type of Parameter.
+    Value_Scalar,   //!< Single value.
+    Value_Array     //!< Array of values.
+  };
+
+public:
+
+  ActData_EXPORT
+    ActData_PartitionSnapshot(const Handle(ActAPI_IPartition)& thePartition,
+                              const Standard_Integer           thePartitionId);
+
+// Nodes:
+public:
+
+  //! \return ID of the captured Partition.
+  Standard_Integer PartitionId() const
+  {
+    return m_iPartitionId;
+  }
+
+  //! \return number of captured Nodes.
+  Standard_Integer NbNodes() const
+  {
+    return (Standard_Integer) m_nodeIds.size();
+  }
+
+  //! \param[in] theNode Node index.
+  //! \return Node ID.
+  const ActAPI_NodeId& NodeId(const Standard_Integer theNode) const
+  {
+    return m_nodeIds[theNode];
+  }
+
+  //! \param[in] theNode Node index.
+  //! \return Node name.
+  const TCollection_ExtendedString& NodeName(const Standard_Integer theNode) const
+  {
+    return m_nodeNames[theNode];
+  }
+
+  //! \param[in] theNode Node index.
+  //! \return ID of the parent Node (empty string for root Nodes).
+  const ActAPI_NodeId& ParentId(const Standard_Integer theNode) const
+  {
+    return m_parentIds[theNode];
+  }
+
+  //! \param[in] theNode Node index.
+  //! \return number of child Nodes.
+  Standard_Integer NbChildren(const Standard_Integer theNode) const
+  {
+    return m_childOffsets[theNode + 1] - m_childOffsets[theNode];
+  }
+
+  //! \param[in] theNode  Node index.
+  //! \param[in] theChild zero-based index of the child.
+  //! \return ID of the child Node (the child can reside in another Partition).
+  const ActAPI_NodeId& ChildId(const Standard_Integer theNode,
+                               const Standard_Integer theChild) const
+  {
+    return m_childIds[m_childOffsets[theNode] + theChild];
+  }
+
+  ActData_EXPORT Standard_Integer
+    FindNode(const ActAPI_NodeId& theNodeId) const;
+
+// Parameters:
+public:
+
+  //! \param[in] theNode Node index.
+  //! \return number of captured Parameters.
+  Standard_Integer NbParameters(const Standard_Integer theNode) const
+  {
+    return m_paramOffsets[theNode + 1] - m_paramOffsets[theNode];
+  }
+
+  //! \param[in] theNode  Node index.
+  //! \param[in] theParam Parameter index.
+  //! \return ID of the Parameter within its Node (e.g., PID_Name).
+  Standard_Integer ParameterKey(const Standard_Integer theNode,
+                                const Standard_Integer theParam) const
+  {
+    return m_paramKeys[m_paramOffsets[theNode] + theParam];
+  }
+
+  //! \param[in] theNode  Node index.
+  //! \param[in] theParam Parameter index.
+  //! \return Parameter type.
+  Standard_Integer ParameterType(const Standard_Integer theNode,
+                                 const Standard_Integer theParam) const
+  {
+    return m_paramTypes[m_paramOffsets[theNode] + theParam];
+  }
+
+  //! \param[in] theNode  Node index.
+  //! \param[in] theParam Parameter index.
+  //! \return kind of the captured value.
+  ValueKind ParameterValueKind(const Standard_Integer theNode,
+                               const Standard_Integer theParam) const
+  {
+    return (ValueKind) m_valueKinds[m_paramOffsets[theNode] + theParam];
+  }
+
+  //! \param[in] theNode  Node index.
+  //! \param[in] theParam Parameter index.
+  //! \return number of captured values (1 for scalars).
+  Standard_Integer NbValues(const Standard_Integer theNode,
+                            const Standard_Integer theParam) const
+  {
+    const Standard_Integer p = m_paramOffsets[theNode] + theParam;
+    return m_valueOffsets[p + 1] - m_valueOffsets[p];
+  }
+
+  //! \param[in] theNode  Node index.
+  //! \param[in] theParam Parameter index.
+  //! \param[in] theIdx   zero-based index of the value.
+  //! \return captured value.
+  Standard_Real Value(const Standard_Integer theNode,
+                      const Standard_Integer theParam,
+                      const Standard_Integer theIdx = 0) const
+  {
+    return m_values[m_valueOffsets[m_paramOffsets[theNode] + theParam] + theIdx];
+  }
+
+  ActData_EXPORT Standard_Integer
+    FindParameter(const Standard_Integer theNode,
+                  const Standard_Integer theKey) const;
+
+protected:
+
+  Standard_Integer                        m_iPartitionId; //!< Partition ID.
+  std::vector<ActAPI_NodeId>              m_nodeIds;      //!< Node IDs.
+  std::vector<TCollection_ExtendedString> m_nodeNames;    //!< Node names.
+  std::vector<ActAPI_NodeId>              m_parentIds;    //!< Parent IDs.
+  std::vector<Standard_Integer>           m_childOffsets; //!< Offsets of children per Node.
+  std::vector<ActAPI_NodeId>              m_childIds;     //!< Child IDs.
+  std::vector<Standard_Integer>           m_paramOffsets; //!< Offsets of Parameters per Node.
+  std::vector<Standard_Integer>           m_paramKeys;    //!< Parameter IDs within Nodes.
+  std::vector<Standard_Integer>           m_paramTypes;   //!< Parameter types.
+  std::vector<Standard_Byte>              m_valueKinds;   //!< Kinds of values.
+  std::vector<Standard_Integer>           m_valueOffsets; //!< Offsets of values per Parameter.
+  std::vector<Standard_Real>              m_values;       //!< Values.
+
+  //! Node indices by IDs.
+  NCollection_DataMap<ActAPI_NodeId, Standard_Integer> m_nodeIndices;
+
+};
+
+#endif
@@ -0,0 +1,89 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <ActData_SnapshotBuilder.h>
+
+//-----------------------------------------------------------------------------
+
+//! Captures the passed Partitions. The Partitions which were not modified
+//! since their previous capture are taken from cache.
+//! \param[in] thePartitions Partitions to capture by their IDs.
+//! \return immutable snapshot.
+Handle(ActData_ModelSnapshot)
+  ActData_SnapshotBuilder::Capture(const t_partitions& thePartitions)
+{
+  ActData_ModelSnapshot::t_partitions captured;
+  //
+  for ( t_partitions::Iterator it(thePartitions); it.More(); it.Next() )
+  {
+    const Handle(ActData_PartitionSnapshot)* pCached = m_cache.Seek( it.Key() );
+    //
+    if ( pCached )
+    {
+      captured.Bind( it.Key(), *pCached );
+      continue;
+    }
+
+    Handle(ActData_PartitionSnapshot)
+      snapshot = new ActData_PartitionSnapshot( it.Value(), it.Key() );
+    //
+    m_cache.Bind( it.Key(), snapshot );
+    captured.Bind( it.Key(), snapshot );
+  }
+
+  return new ActData_ModelSnapshot(captured);
+}
+
+//! Forces all Partitions to be captured anew on the next request.
+void ActData_SnapshotBuilder::Invalidate()
+{
+  m_cache.Clear();
+}
+
+//! Invalidates the cached snapshots of the Partitions containing the
+//! changed Nodes.
+//! \param[in] theFeed changes of the Data Model.
+void ActData_SnapshotBuilder::OnChanges(const Handle(ActAPI_ChangeFeed)& theFeed)
+{
+  if ( m_cache.IsEmpty() )
+    return;
+
+  for ( ActAPI_ChangeFeed::t_nodeChanges::Iterator it( theFeed->Nodes() ); it.More(); it.Next() )
+  {
+    // Node ID is like 0:2:P:N where P is the ID of Partition
+    const TCollection_AsciiString partitionTag = it.Key().Token(":", ActData_NumTags_NodeId - 1);
+    //
+    if ( partitionTag.IsIntegerValue() )
+      m_cache.UnBind( partitionTag.IntegerValue() );
+  }
+}
@@ -0,0 +1,92 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+#ifndef ActData_SnapshotBuilder_HeaderFile
+#define ActData_SnapshotBuilder_HeaderFile
+
+// Active Data includes
+#include <ActData_ModelSnapshot.h>
+
+// Active Data (API) includes
+#include <ActAPI_IChangeObserver.h>
+
+// OCCT includes
+#include <TColStd_PackedMapOfInteger.hxx>
+
+DEFINE_STANDARD_HANDLE(ActData_SnapshotBuilder, ActAPI_IChangeObserver)
+
+//! \ingroup AD_DF
+//!
+//! Builder of immutable Data Model snapshots. The builder keeps the last
+//! captured snapshot of each Partition and listens to the change feed of
+//! the Data Model in order to know which Partitions are to be captured
+//! again. All other Partitions are shared with the previous snapshots.
+//!
+//! Modifications made out of transactions do not produce the change feed,
+//! so Invalidate() has to be called after them.
+class ActData_SnapshotBuilder : public ActAPI_IChangeObserver
+{
+public:
+
+  // OCCT RTTI
+  DEFINE_STANDARD_RTTI_INLINE(ActData_SnapshotBuilder, ActAPI_IChangeObserver)
+
+public:
+
+  //! Short-cut for Partitions by their IDs.
+  typedef NCollection_DataMap<Standard_Integer, Handle(ActAPI_IPartition)> t_partitions;
+
+public:
+
+  //! Default constructor.
+  ActData_SnapshotBuilder() : ActAPI_IChangeObserver() {}
+
+public:
+
+  ActData_EXPORT Handle(ActData_ModelSnapshot)
+    Capture(const t_partitions& thePartitions);
+
+  ActData_EXPORT void
+    Invalidate();
+
+  ActData_EXPORT virtual void
+    OnChanges(const Handle(ActAPI_ChangeFeed)& theFeed);
+
+protected:
+
+  //! Cached snapshots of the Partitions which were not modified since
+  //! they were captured.
+  ActData_ModelSnapshot::t_partitions m_cache;
+
+};
+
+#endif
@@ -36,10 +36,32 @@
 // Active Data includes
 #include <ActData_BaseModel.h>
 #include <ActData_BaseNode.h>
+#include <ActData_ChildIndex.h>
+#include <ActData_MeshMDelta.h>
 #include <ActData_ParameterFactory.h>
+#include <ActData_UserParameter.h>
 
 // OCCT includes
+#include <NCollection_Map.hxx>
+#include <TDataStd_AsciiString.hxx>
+#include <TDataStd_BooleanArray.hxx>
+#include <TDataStd_ByteArray.hxx>
+#include <TDataStd_ExtStringArray.hxx>
+#include <TDataStd_Integer.hxx>
+#include <TDataStd_IntegerArray.hxx>
+#include <TDataStd_IntPackedMap.hxx>
+#include <TDataStd_Name.hxx>
+#include <TDataStd_RealArray.hxx>
+#include <TDataStd_ReferenceArray.hxx>
+#include <TDataStd_ReferenceList.hxx>
+#include <TDF_Data.hxx>
 #include <TDF_Delta.hxx>
+#include <TDF_DeltaOnAddition.hxx>
+#include <TDF_DeltaOnForget.hxx>
+#include <TDF_DeltaOnModification.hxx>
+#include <TDF_DeltaOnRemoval.hxx>
+#include <TDF_DeltaOnResume.hxx>
+#include <TDF_LabelIndexedMap.hxx>
 #include <TDF_LabelList.hxx>
 #include <TDF_ListIteratorOfAttributeDeltaList.hxx>
 #include <TDF_ListIteratorOfDeltaList.hxx>
@@ -49,12 +71,212 @@
 #define ERR_TRANSACTION_DEPLOYMENT_OFF "Transactions are OFF"
 #define ERR_NULL_DOC "Document is NULL"
 #define ERR_TR_ALREADY_OPENED "Command is already opened"
+#define ERR_TR_NOT_OPENED "There is no opened command"
+#define ERR_SAVEPOINT_NOT_FOUND "Savepoint is not found"
 
 #undef COUT_DEBUG
 #if defined COUT_DEBUG
   #pragma message("===== warning: COUT_DEBUG is enabled")
 #endif
 
+//-----------------------------------------------------------------------------
+
+//! Returns the ancestor of the passed Label located at the given depth.
+//! \param[in] lab   Label to get the ancestor for.
+//! \param[in] depth depth of the ancestor.
+//! \return ancestor Label.
+static TDF_Label AncestorAt(const TDF_Label& lab, const Standard_Integer depth)
+{
+  TDF_Label res = lab;
+  for ( Standard_Integer d = lab.Depth(); d > depth; --d )
+    res = res.Father();
+
+  return res;
+}
+
+//! Returns the persistent ID of the passed Label caching it in the given map.
+//! \param[in]     lab   Label to get the ID for.
+//! \param[in,out] cache cached IDs.
+//! \return persistent ID.
+static const ActAPI_DataObjectId&
+  EntryOf(const TDF_Label&                                                        lab,
+          NCollection_DataMap<TDF_Label, ActAPI_DataObjectId, TDF_LabelMapHasher>& cache)
+{
+  const ActAPI_DataObjectId* pEntry = cache.Seek(lab);
+  //
+  if ( pEntry )
+    return *pEntry;
+
+  ActAPI_DataObjectId entry;
+  TDF_Tool::Entry(lab, entry);
+  //
+  return *cache.Bound(lab, entry);
+}
+
+//! Estimates the memory held by the passed attribute. The payload of the
+//! array-like and string attributes is counted by their lengths.
+//! \param[in] attr attribute to estimate.
+//! \return estimated size in bytes.
+static Standard_Size AttributeSize(const Handle(TDF_Attribute)& attr)
+{
+  if ( attr.IsNull() )
+    return 0;
+
+  Standard_Size size = attr->DynamicType()->Size();
+
+  if ( attr->IsKind( STANDARD_TYPE(TDataStd_IntegerArray) ) )
+    size += Handle(TDataStd_IntegerArray)::DownCast(attr)->Length() * sizeof(Standard_Integer);
+  else if ( attr->IsKind( STANDARD_TYPE(TDataStd_RealArray) ) )
+    size += Handle(TDataStd_RealArray)::DownCast(attr)->Length() * sizeof(Standard_Real);
+  else if ( attr->IsKind( STANDARD_TYPE(TDataStd_ByteArray) ) )
+    size += Handle(TDataStd_ByteArray)::DownCast(attr)->Length();
+  else if ( attr->IsKind( STANDARD_TYPE(TDataStd_BooleanArray) ) )
+    size += Handle(TDataStd_BooleanArray)::DownCast(attr)->Length() / 8 + 1;
+  else if ( attr->IsKind( STANDARD_TYPE(TDataStd_ReferenceArray) ) )
+    size += Handle(TDataStd_ReferenceArray)::DownCast(attr)->Length() * sizeof(TDF_Label);
+  else if ( attr->IsKind( STANDARD_TYPE(TDataStd_ReferenceList) ) )
+    size += Handle(TDataStd_ReferenceList)::DownCast(attr)->Extent() * sizeof(TDF_Label);
+  else if ( attr->IsKind( STANDARD_TYPE(TDataStd_IntPackedMap) ) )
+    size += Handle(TDataStd_IntPackedMap)::DownCast(attr)->Extent() * sizeof(Standard_Integer);
+  else if ( attr->IsKind( STANDARD_TYPE(TDataStd_AsciiString) ) )
+    size += Handle(TDataStd_AsciiString)::DownCast(attr)->Get().Length();
+  else if ( attr->IsKind( STANDARD_TYPE(TDataStd_Name) ) )
+    size += Handle(TDataStd_Name)::DownCast(attr)->Get().Length() * sizeof(Standard_ExtCharacter);
+  else if ( attr->IsKind( STANDARD_TYPE(TDataStd_ExtStringArray) ) )
+  {
+    Handle(TDataStd_ExtStringArray) arr = Handle(TDataStd_ExtStringArray)::DownCast(attr);
+    //
+    for ( Standard_Integer i = arr->Lower(); i <= arr->Upper(); ++i )
+      size += sizeof(TCollection_ExtendedString) + arr->Value(i).Length() * sizeof(Standard_ExtCharacter);
+  }
+
+  return size;
+}
+
+//! Formats persistent IDs for the passed Labels preserving their order.
+//! \param[in] labels Labels to format IDs for.
+//! \return collection of persistent IDs.
+static Handle(ActAPI_HDataObjectIdMap) EntriesOf(const TDF_LabelIndexedMap& labels)
+{
+  Handle(ActAPI_HDataObjectIdMap) res = new ActAPI_HDataObjectIdMap();
+
+  for ( Standard_Integer k = 1; k <= labels.Extent(); ++k )
+  {
+    ActAPI_DataObjectId entry;
+    TDF_Tool::Entry(labels(k), entry);
+
+#if defined COUT_DEBUG
+    std::cout << "\tEntry of affected label: " << entry.ToCString() << std::endl;
+#endif
+
+    res->Add(entry);
+  }
+
+  return res;
+}
+
+//! Checks whether the passed attribute delta restores the full backup of
+//! the attribute rather than applying an incremental difference.
+//! \param[in] attrDelta attribute delta to check.
+//! \return true/false.
+static Standard_Boolean IsFullBackup(const Handle(TDF_AttributeDelta)& attrDelta)
+{
+  return attrDelta->DynamicType() == STANDARD_TYPE(TDF_DeltaOnModification) ||
+         attrDelta->DynamicType() == STANDARD_TYPE(TDF_DeltaOnAddition);
+}
+
+//! Delta composed of two consecutive OCAF deltas. The attribute deltas of
+//! the newer one go first, so that applying the composed delta is the same
+//! as undoing both deltas one after another. If both deltas restore the
+//! full backups of the same attribute, only the older backup is kept.
+class ActData_CoalescedDelta : public TDF_Delta
+{
+public:
+
+  //! Composes the passed deltas.
+  //! \param[in] older older delta.
+  //! \param[in] newer newer delta.
+  ActData_CoalescedDelta(const Handle(TDF_Delta)& older,
+                         const Handle(TDF_Delta)& newer)
+  : TDF_Delta()
+  {
+    this->Validity( older->BeginTime(), newer->EndTime() );
+    this->SetName( older->Name() );
+
+    // Attributes whose older backups supersede the newer deltas
+    NCollection_Map<TCollection_AsciiString> superseded;
+    //
+    for ( TDF_ListIteratorOfAttributeDeltaList it( older->AttributeDeltas() ); it.More(); it.Next() )
+      if ( IsFullBackup( it.Value() ) )
+        superseded.Add( KeyOf( it.Value() ) );
+
+    for ( TDF_ListIteratorOfAttributeDeltaList it( newer->AttributeDeltas() ); it.More(); it.Next() )
+      if ( !IsFullBackup( it.Value() ) || !superseded.Contains( KeyOf( it.Value() ) ) )
+        this->AddAttributeDelta( it.Value() );
+
+    for ( TDF_ListIteratorOfAttributeDeltaList it( older->AttributeDeltas() ); it.More(); it.Next() )
+      this->AddAttributeDelta( it.Value() );
+  }
+
+private:
+
+  //! \return key of the attribute affected by the passed delta.
+  static TCollection_AsciiString KeyOf(const Handle(TDF_AttributeDelta)& attrDelta)
+  {
+    char buff[Standard_GUID_SIZE_ALLOC];
+    Standard_PCharacter pBuff = buff;
+    attrDelta->ID().ToCString(pBuff);
+
+    TCollection_AsciiString key;
+    TDF_Tool::Entry(attrDelta->Label(), key);
+    key += "|";
+    key += buff;
+    return key;
+  }
+
+};
+
+//! Gives access to the Undo stack of OCAF Document, so that the coalesced
+//! deltas can be replaced with the composed one.
+class ActData_UndoStackAccess : public TDocStd_Document
+{
+public:
+
+  //! \param[in] doc Document to access the Undo stack for.
+  //! \return Undo stack.
+  static TDF_DeltaList& Of(const Handle(TDocStd_Document)& doc)
+  {
+    return doc.get()->*( &ActData_UndoStackAccess::myUndos );
+  }
+
+};
+
+//! Classifies the passed attribute delta. If the delta is inverse, i.e., it
+//! is going to be applied by Undo/Redo, the opposite change is returned.
+//! \param[in] attrDelta attribute delta to classify.
+//! \param[in] isInverse whether to return the opposite change.
+//! \return change kind.
+static ActAPI_ChangeFeed::ChangeKind
+  ChangeKindOf(const Handle(TDF_AttributeDelta)& attrDelta,
+               const Standard_Boolean            isInverse)
+{
+  Standard_Boolean isAdded = Standard_False, isRemoved = Standard_False;
+  //
+  if ( attrDelta->IsKind( STANDARD_TYPE(TDF_DeltaOnAddition) ) ||
+       attrDelta->IsKind( STANDARD_TYPE(TDF_DeltaOnResume) ) )
+    isAdded = Standard_True;
+  else if ( attrDelta->IsKind( STANDARD_TYPE(TDF_DeltaOnForget) ) ||
+            attrDelta->IsKind( STANDARD_TYPE(TDF_DeltaOnRemoval) ) )
+    isRemoved = Standard_True;
+
+  if ( isAdded )
+    return isInverse ? ActAPI_ChangeFeed::Change_Removed : ActAPI_ChangeFeed::Change_Added;
+  if ( isRemoved )
+    return isInverse ? ActAPI_ChangeFeed::Change_Added : ActAPI_ChangeFeed::Change_Removed;
+
+  return ActAPI_ChangeFeed::Change_Modified;
+}
+
 //-----------------------------------------------------------------------------
 // Construction & initialization
 //-----------------------------------------------------------------------------
@@ -66,8 +288,12 @@ ActData_TransactionEngine::ActData_TransactionEngine(const Handle(TDocStd_Docume
                                                      const Standard_Integer UndoLimit)
 : Standard_Transient()
 {
-  m_iUndoLimit = UndoLimit;
+  m_iUndoLimit           = UndoLimit;
   m_bIsActiveTransaction = Standard_False;
+  m_undoMemLimit         = 0;
+  m_undoMemUsage         = 0;
+  m_fCoalesceWindow      = 0.0;
+  m_bCoalesced           = Standard_False;
   this->init(Doc);
 }
 
@@ -90,6 +316,19 @@ void ActData_TransactionEngine::Release()
   if ( !m_doc.IsNull() )
     m_doc.Nullify();
 
+  if ( !m_packedLogBook.IsNull() )
+    m_packedLogBook->ReleaseHistory();
+
+  m_undoSizes.clear();
+  m_redoSizes.clear();
+  m_undoMemUsage = 0;
+
+  m_coalesceHead.Nullify();
+  m_coalesceLabels.Clear();
+  m_bCoalesced = Standard_False;
+
+  m_savepoints.Clear();
+
   m_bIsActiveTransaction = Standard_False;
 }
 
@@ -125,6 +364,15 @@ void ActData_TransactionEngine::OpenCommand()
 
   m_doc->OpenCommand();
   m_bIsActiveTransaction = Standard_True;
+
+  if ( !m_packedLogBook.IsNull() )
+    m_packedLogBook->OpenCommand();
+
+  if ( !m_txStats.IsNull() )
+  {
+    m_commandTimer.Reset();
+    m_commandTimer.Start();
+  }
 }
 
 //! Commits current transaction.
@@ -136,8 +384,91 @@ void ActData_TransactionEngine::CommitCommand()
   if ( m_doc.IsNull() )
     Standard_ProgramError::Raise(ERR_NULL_DOC);
 
-  m_doc->CommitCommand();
+  OSD_Timer latencyTimer;
+  if ( !m_txStats.IsNull() )
+    latencyTimer.Start();
+
+  // OCAF can push the oldest delta out of the full history on commit, while
+  // a delta merged with the head of the coalescing run takes no extra place
+  Handle(TDF_Delta) oldest;
+  if ( !m_doc->GetUndos().IsEmpty() )
+    oldest = m_doc->GetUndos().First();
+
+  // Savepoints are committed together with the command
+  const Standard_Boolean isStacked = m_doc->CommitCommand();
   m_bIsActiveTransaction = Standard_False;
+  m_savepoints.Clear();
+
+  // Children could have been changed directly in OCAF
+  ActData_ChildIndex::Release( m_doc->Main() );
+
+  // Merge the just stacked delta with the previous one if both belong to
+  // the same coalescing run
+  Handle(TDF_Delta) committed;
+  m_bCoalesced = Standard_False;
+  //
+  if ( isStacked )
+  {
+    committed    = m_doc->GetUndos().Last();
+    m_bCoalesced = this->coalesceLast(oldest);
+  }
+
+  // Packed LogBook stacks its journal only if OCAF has stacked a delta,
+  // so that the Undo/Redo histories remain aligned. The journal merged
+  // with the previous one takes no extra place either
+  if ( !m_packedLogBook.IsNull() )
+  {
+    m_packedLogBook->CommitCommand( isStacked, m_doc->GetUndoLimit() + (m_bCoalesced ? 1 : 0) );
+    //
+    if ( m_bCoalesced )
+      m_packedLogBook->CoalesceLast();
+  }
+
+  // Compose the change feed from the just committed delta
+  if ( isStacked && !m_changeObservers.IsEmpty() )
+  {
+    Handle(ActAPI_ChangeFeed) feed = new ActAPI_ChangeFeed(ActAPI_ChangeFeed::Origin_Commit);
+    this->addChangesByDelta(committed, Standard_False, feed);
+    this->notifyChangeObservers(feed);
+  }
+
+  // Account the new delta and keep the history within the memory cap
+  if ( isStacked && m_undoMemLimit )
+  {
+    // Coalesced delta replaces the previous one
+    if ( m_bCoalesced && !m_undoSizes.empty() )
+    {
+      m_undoMemUsage -= m_undoSizes.back();
+      m_undoSizes.pop_back();
+    }
+
+    m_undoSizes.push_back( EstimatedSize( m_doc->GetUndos().Last() ) );
+    m_undoMemUsage += m_undoSizes.back();
+    m_redoSizes.clear();
+
+    this->capUndoMemory();
+  }
+
+  // Record statistics of the delta retained in the history, i.e., the merged
+  // one for a coalesced commit
+  if ( isStacked && !m_txStats.IsNull() )
+  {
+    latencyTimer.Stop();
+    m_commandTimer.Stop();
+    m_txStats->Add( m_doc->GetUndos().Last(),
+                    latencyTimer.ElapsedTime(),
+                    m_commandTimer.ElapsedTime(),
+                    m_bCoalesced );
+  }
+
+  // Journal the committed delta. The merged one is not journaled as the
+  // previous delta of the coalescing run has been journaled already
+  if ( isStacked )
+  {
+    TDF_DeltaList committedList;
+    committedList.Append(committed);
+    this->appendToJournal(committedList, 1, 1, Standard_False);
+  }
 }
 
 //! Returns true if any command is opened, false -- otherwise.
@@ -164,6 +495,13 @@ void ActData_TransactionEngine::AbortCommand()
 
   m_doc->AbortCommand();
   m_bIsActiveTransaction = Standard_False;
+  m_savepoints.Clear();
+
+  // Children could have been restored by the rollback
+  ActData_ChildIndex::Release( m_doc->Main() );
+
+  if ( !m_packedLogBook.IsNull() )
+    m_packedLogBook->AbortCommand();
 }
 
 //! Performs Undo operation.
@@ -172,6 +510,21 @@ void ActData_TransactionEngine::AbortCommand()
 Handle(ActAPI_TxRes)
   ActData_TransactionEngine::Undo(const Standard_Integer theNbUndoes)
 {
+  Standard_Integer nbDone;
+  return this->undo(theNbUndoes, nbDone);
+}
+
+//! Performs Undo operation step-by-step. The steps stop at the first
+//! Undo which OCAF fails to perform.
+//! \param[in]  theNbUndoes number of Undo operations to perform.
+//! \param[out] theNbDone number of Undo operations actually performed.
+//! \return affected Parameters (including META).
+Handle(ActAPI_TxRes)
+  ActData_TransactionEngine::undo(const Standard_Integer theNbUndoes,
+                                  Standard_Integer&      theNbDone)
+{
+  theNbDone = 0;
+
   if ( this->isTransactionModeOff() )
     return NULL;
 
@@ -183,12 +536,47 @@ Handle(ActAPI_TxRes)
   Handle(ActAPI_HDataObjectIdMap)
     anAffectedObjectIds = this->entriesToUndo(theNbUndoes);
 
+  // Prepare the change feed if anybody listens to it
+  Handle(ActAPI_ChangeFeed) feed;
+  if ( !m_changeObservers.IsEmpty() )
+    feed = new ActAPI_ChangeFeed(ActAPI_ChangeFeed::Origin_Undo);
+
   // Perform Undoes one-by-one
+  Standard_Integer nbUndone = 0;
   for ( Standard_Integer NbDone = 0; NbDone < theNbUndoes; NbDone++ )
   {
-    m_doc->Undo();
+    // The delta is inverted by Undo, so it is classified before. Its
+    // changes are reported only if Undo succeeds
+    Handle(ActAPI_ChangeFeed) stepFeed;
+    if ( !feed.IsNull() && m_doc->GetAvailableUndos() )
+    {
+      stepFeed = new ActAPI_ChangeFeed(ActAPI_ChangeFeed::Origin_Undo);
+      this->addChangesByDelta(m_doc->GetUndos().Last(), Standard_True, stepFeed);
+    }
+
+    if ( !m_doc->Undo() )
+      break;
+
+    nbUndone++;
+
+    if ( !stepFeed.IsNull() )
+      feed->Append(stepFeed);
+
+    if ( !m_packedLogBook.IsNull() )
+      m_packedLogBook->Undo();
+
+    // The undone delta is replaced by the one stacked for Redo
+    if ( m_undoMemLimit && !m_undoSizes.empty() )
+    {
+      m_undoMemUsage -= m_undoSizes.back();
+      m_undoSizes.pop_back();
+      m_redoSizes.push_back( EstimatedSize( m_doc->GetRedos().First() ) );
+    }
   }
 
+  // Children could have been restored by Undo
+  ActData_ChildIndex::Release( m_doc->Main() );
+
   // Get Parameters after Data Model modification by Undo()
   Handle(ActAPI_TxRes)
     aTxRes = this->extractTxRes(anAffectedObjectIds);
@@ -196,8 +584,17 @@ Handle(ActAPI_TxRes)
   // Now touch the affected Parameters so that actualizing their MTime
   this->touchAffectedParameters(aTxRes);
 
+  // The undone deltas are at the top of the Redo stack, the last undone
+  // one goes first
+  this->appendToJournal(m_doc->GetRedos(), 1, nbUndone, Standard_True);
+
+  theNbDone = nbUndone;
+
   m_bIsActiveTransaction = Standard_False;
 
+  if ( !feed.IsNull() && nbUndone )
+    this->notifyChangeObservers(feed);
+
   return aTxRes;
 }
 
@@ -220,6 +617,21 @@ Standard_Integer ActData_TransactionEngine::NbUndos() const
 Handle(ActAPI_TxRes)
   ActData_TransactionEngine::Redo(const Standard_Integer theNbRedoes)
 {
+  Standard_Integer nbDone;
+  return this->redo(theNbRedoes, nbDone);
+}
+
+//! Performs Redo operation step-by-step. The steps stop at the first
+//! Redo which OCAF fails to perform.
+//! \param[in]  theNbRedoes number of Redo operations to perform.
+//! \param[out] theNbDone number of Redo operations actually performed.
+//! \return affected Parameters (including META).
+Handle(ActAPI_TxRes)
+  ActData_TransactionEngine::redo(const Standard_Integer theNbRedoes,
+                                  Standard_Integer&      theNbDone)
+{
+  theNbDone = 0;
+
   if ( this->isTransactionModeOff() )
     return NULL;
 
@@ -231,12 +643,48 @@ Handle(ActAPI_TxRes)
   Handle(ActAPI_HDataObjectIdMap)
     anAffectedObjectIds = this->entriesToRedo(theNbRedoes);
 
+  // Prepare the change feed if anybody listens to it
+  Handle(ActAPI_ChangeFeed) feed;
+  if ( !m_changeObservers.IsEmpty() )
+    feed = new ActAPI_ChangeFeed(ActAPI_ChangeFeed::Origin_Redo);
+
   // Perform Redoes one-by-one
+  Standard_Integer nbRedone = 0;
   for ( Standard_Integer NbDone = 0; NbDone < theNbRedoes; NbDone++ )
   {
-    m_doc->Redo();
+    // Redo delta is the one recorded by Undo, so it describes the changes
+    // opposite to those which Redo is going to bring. Its changes are
+    // reported only if Redo succeeds
+    Handle(ActAPI_ChangeFeed) stepFeed;
+    if ( !feed.IsNull() && m_doc->GetAvailableRedos() )
+    {
+      stepFeed = new ActAPI_ChangeFeed(ActAPI_ChangeFeed::Origin_Redo);
+      this->addChangesByDelta(m_doc->GetRedos().First(), Standard_True, stepFeed);
+    }
+
+    if ( !m_doc->Redo() )
+      break;
+
+    nbRedone++;
+
+    if ( !stepFeed.IsNull() )
+      feed->Append(stepFeed);
+
+    if ( !m_packedLogBook.IsNull() )
+      m_packedLogBook->Redo();
+
+    // The redone delta is replaced by the one stacked for Undo
+    if ( m_undoMemLimit && !m_redoSizes.empty() )
+    {
+      m_redoSizes.pop_back();
+      m_undoSizes.push_back( EstimatedSize( m_doc->GetUndos().Last() ) );
+      m_undoMemUsage += m_undoSizes.back();
+    }
   }
 
+  // Children could have been restored by Redo
+  ActData_ChildIndex::Release( m_doc->Main() );
+
   // Get Parameters after Data Model modification by Redo()
   Handle(ActAPI_TxRes)
     aTxRes = this->extractTxRes(anAffectedObjectIds);
@@ -244,8 +692,17 @@ Handle(ActAPI_TxRes)
   // Now touch the affected Parameters so that actualizing their MTime
   this->touchAffectedParameters(aTxRes);
 
+  // The redone deltas are at the top of the Undo stack
+  const Standard_Integer nbUndos = m_doc->GetUndos().Extent();
+  this->appendToJournal(m_doc->GetUndos(), nbUndos - nbRedone + 1, nbRedone, Standard_False);
+
+  theNbDone = nbRedone;
+
   m_bIsActiveTransaction = Standard_False;
 
+  if ( !feed.IsNull() && nbRedone )
+    this->notifyChangeObservers(feed);
+
   return aTxRes;
 }
 
@@ -262,19 +719,491 @@ Standard_Integer ActData_TransactionEngine::NbRedos() const
   return m_doc->GetAvailableRedos();
 }
 
+//-----------------------------------------------------------------------------
+// Memory cap
+//-----------------------------------------------------------------------------
+
+//! Sets the memory cap for the Undo history. Once the estimated size of
+//! the Undo deltas exceeds the cap, the oldest deltas are discarded on
+//! commit, i.e., the operations they describe cannot be undone anymore.
+//! The deltas are not spilled to disk. The most recent delta is always kept,
+//! so that the last operation can be undone regardless of its size. The cap
+//! works together with the Undo limit, i.e., whatever is more restrictive
+//! takes effect.
+//! \param[in] theNbBytes memory cap in bytes (0 for unlimited).
+void ActData_TransactionEngine::SetUndoMemoryLimit(const Standard_Size theNbBytes)
+{
+  m_undoMemLimit = theNbBytes;
+
+  if ( !m_undoMemLimit )
+  {
+    m_undoSizes.clear();
+    m_redoSizes.clear();
+    m_undoMemUsage = 0;
+    return;
+  }
+
+  // Account the already stacked deltas
+  m_undoSizes.clear();
+  m_redoSizes.clear();
+  m_undoMemUsage = 0;
+  //
+  if ( m_doc.IsNull() )
+    return;
+
+  for ( TDF_ListIteratorOfDeltaList it( m_doc->GetUndos() ); it.More(); it.Next() )
+  {
+    m_undoSizes.push_back( EstimatedSize( it.Value() ) );
+    m_undoMemUsage += m_undoSizes.back();
+  }
+  //
+  for ( TDF_ListIteratorOfDeltaList it( m_doc->GetRedos() ); it.More(); it.Next() )
+    m_redoSizes.insert( m_redoSizes.begin(), EstimatedSize( it.Value() ) );
+
+  if ( !m_bIsActiveTransaction )
+    this->capUndoMemory();
+}
+
+//! Estimates the memory held by the passed OCAF delta. Each attribute delta
+//! is counted together with the backup attribute it keeps.
+//! \param[in] theDelta delta to estimate.
+//! \return estimated size in bytes.
+Standard_Size ActData_TransactionEngine::EstimatedSize(const Handle(TDF_Delta)& theDelta)
+{
+  if ( theDelta.IsNull() )
+    return 0;
+
+  Standard_Size size = sizeof(TDF_Delta);
+
+  for ( TDF_ListIteratorOfAttributeDeltaList it( theDelta->AttributeDeltas() ); it.More(); it.Next() )
+    size += EstimatedSize( it.Value() );
+
+  return size;
+}
+
+//! Estimates the memory held by the passed attribute delta. The payload of
+//! array-like attributes is counted by their lengths, and the mesh deltas
+//! are asked for their own estimation. Additions are counted without the
+//! added attributes as these are shared with the Document.
+//! \param[in] theAttrDelta attribute delta to estimate.
+//! \return estimated size in bytes.
+Standard_Size ActData_TransactionEngine::EstimatedSize(const Handle(TDF_AttributeDelta)& theAttrDelta)
+{
+  if ( theAttrDelta.IsNull() )
+    return 0;
+
+  Standard_Size size = 0;
+
+  Handle(ActData_MeshMDelta) meshDelta = Handle(ActData_MeshMDelta)::DownCast(theAttrDelta);
+  //
+  if ( !meshDelta.IsNull() )
+    size += meshDelta->EstimatedSize();
+  else
+    size += theAttrDelta->DynamicType()->Size();
+
+  if ( !theAttrDelta->IsKind( STANDARD_TYPE(TDF_DeltaOnAddition) ) )
+    size += AttributeSize( theAttrDelta->Attribute() );
+
+  return size;
+}
+
+//! Discards the oldest Undo deltas while their estimated size exceeds the
+//! memory cap. The most recent delta is never discarded.
+void ActData_TransactionEngine::capUndoMemory()
+{
+  // Keep in sync with the Undo limit of OCAF
+  while ( (Standard_Integer) m_undoSizes.size() > m_doc->GetAvailableUndos() )
+  {
+    m_undoMemUsage -= m_undoSizes.front();
+    m_undoSizes.pop_front();
+  }
+
+  Standard_Integer nbTrimmed = 0;
+  Standard_Size    usage     = m_undoMemUsage;
+  //
+  while ( usage > m_undoMemLimit && nbTrimmed < (Standard_Integer) m_undoSizes.size() - 1 )
+    usage -= m_undoSizes[nbTrimmed++];
+
+  if ( nbTrimmed )
+    this->trimOldestUndos(nbTrimmed);
+}
+
+//! Discards the given number of the oldest Undo deltas.
+//! \param[in] theNbTrimmed number of deltas to discard.
+void ActData_TransactionEngine::trimOldestUndos(const Standard_Integer theNbTrimmed)
+{
+  for ( Standard_Integer k = 0; k < theNbTrimmed && m_doc->GetAvailableUndos(); ++k )
+  {
+    m_doc->RemoveFirstUndo();
+
+    if ( !m_undoSizes.empty() )
+    {
+      m_undoMemUsage -= m_undoSizes.front();
+      m_undoSizes.pop_front();
+    }
+  }
+
+  if ( !m_packedLogBook.IsNull() )
+    m_packedLogBook->LimitHistory( m_doc->GetAvailableUndos() );
+}
+
+//-----------------------------------------------------------------------------
+// Coalescing
+//-----------------------------------------------------------------------------
+
+//! Sets the time window for coalescing. Once set, a commit made within the
+//! given number of seconds after the previous one is merged with it if both
+//! affect the same Parameters. This way, a series of high-frequency edits
+//! such as interactive dragging results in a single Undo step.
+//! \param[in] theSeconds time window in seconds (0 to disable).
+void ActData_TransactionEngine::SetCoalescingWindow(const Standard_Real theSeconds)
+{
+  m_fCoalesceWindow = Max(theSeconds, 0.0);
+}
+
+//! Starts a coalescing run under the given key. All subsequent commits
+//! affecting the same Parameters are merged into a single delta until the
+//! run is ended or the key is changed. The time window does not apply
+//! to the keyed runs.
+//! \param[in] theKey client-supplied key of the run.
+void ActData_TransactionEngine::BeginCoalescing(const TCollection_AsciiString& theKey)
+{
+  m_coalesceKey = theKey;
+}
+
+//! Ends the current coalescing run, so that the next commit produces a new
+//! delta whatever the key or the time window is.
+void ActData_TransactionEngine::EndCoalescing()
+{
+  m_coalesceKey.Clear();
+  m_coalesceHead.Nullify();
+  m_coalesceLabels.Clear();
+}
+
+//! Merges the just stacked delta with the previous one if the latter was
+//! committed in the same coalescing run and both affect the same Parameters.
+//! The attribute deltas of both are composed into one delta which replaces
+//! them in the Undo stack, so that a single Undo reverts the entire run.
+//! \param[in] theOldest oldest delta before the commit. If OCAF has pushed
+//!                      it out of the full history, it is brought back once
+//!                      the deltas are merged.
+//! \return true if the deltas have been merged, false -- otherwise.
+Standard_Boolean
+  ActData_TransactionEngine::coalesceLast(const Handle(TDF_Delta)& theOldest)
+{
+  if ( m_coalesceKey.IsEmpty() && m_fCoalesceWindow <= 0.0 )
+  {
+    m_coalesceHead.Nullify();
+    return Standard_False;
+  }
+
+  const TDF_DeltaList& undos = m_doc->GetUndos();
+  Handle(TDF_Delta)    last  = undos.Last();
+
+  TDF_LabelIndexedMap labels;
+  this->addLabelsByDelta(last, labels);
+
+  // Check whether the run is continued and the same Parameters are affected
+  Standard_Boolean isSameRun = undos.Extent() > 1 && this->continuesRun() &&
+                               labels.Extent() == m_coalesceLabels.Extent();
+  //
+  for ( Standard_Integer i = 1; i <= labels.Extent() && isSameRun; ++i )
+    isSameRun = m_coalesceLabels.Contains( labels(i) );
+
+  // Check whether the head of the run is just before the new delta, i.e.,
+  // it has not been undone or pushed out of the history
+  if ( isSameRun )
+  {
+    TDF_ListIteratorOfDeltaList prevIt(undos);
+    for ( Standard_Integer k = 2; k < undos.Extent(); ++k )
+      prevIt.Next();
+
+    isSameRun = ( prevIt.Value() == m_coalesceHead );
+  }
+
+  if ( isSameRun )
+  {
+    TDF_DeltaList& stack = ActData_UndoStackAccess::Of(m_doc);
+
+    // Replace the head and the new delta with the composed one
+    Handle(TDF_Delta) merged = new ActData_CoalescedDelta(m_coalesceHead, last);
+    //
+    for ( Standard_Integer k = 0; k < 2; ++k )
+    {
+      TDF_ListIteratorOfDeltaList lastIt(stack);
+      for ( Standard_Integer i = 1; i < stack.Extent(); ++i )
+        lastIt.Next();
+
+      stack.Remove(lastIt);
+    }
+    stack.Append(merged);
+
+    // Bring back the oldest delta pushed out by the commit
+    if ( !theOldest.IsNull() && stack.First() != theOldest && stack.Extent() < m_doc->GetUndoLimit() )
+      stack.Prepend(theOldest);
+
+    last = merged;
+  }
+
+  if ( !isSameRun )
+    m_coalesceLabels.Exchange(labels);
+
+  // The last delta heads the run from now on
+  m_coalesceHead    = last;
+  m_coalesceHeadKey = m_coalesceKey;
+  //
+  m_coalesceTimer.Reset();
+  m_coalesceTimer.Start();
+
+  return isSameRun;
+}
+
+//! Checks whether the next commit belongs to the current coalescing run as
+//! far as the key and the time window are concerned.
+//! \return true/false.
+Standard_Boolean ActData_TransactionEngine::continuesRun()
+{
+  if ( m_coalesceHead.IsNull() )
+    return Standard_False;
+
+  if ( !m_coalesceKey.IsEmpty() )
+    return m_coalesceKey.IsEqual(m_coalesceHeadKey);
+
+  return m_fCoalesceWindow > 0.0 &&
+         m_coalesceHeadKey.IsEmpty() &&
+         m_coalesceTimer.ElapsedTime() <= m_fCoalesceWindow;
+}
+
+//-----------------------------------------------------------------------------
+// Savepoints
+//-----------------------------------------------------------------------------
+
+//! Sets a named savepoint in the currently open command. The savepoint
+//! opens a nested OCAF transaction, so that the modifications made after
+//! it can be rolled back without discarding the whole command. Savepoints
+//! can be nested, and their names do not have to be unique. In the latter
+//! case, the most recent savepoint with the given name is addressed.
+//! \param[in] theName name of the savepoint.
+void ActData_TransactionEngine::SetSavepoint(const TCollection_AsciiString& theName)
+{
+  if ( this->isTransactionModeOff() )
+    return;
+
+  if ( m_doc.IsNull() )
+    Standard_ProgramError::Raise(ERR_NULL_DOC);
+
+  if ( !m_bIsActiveTransaction )
+    Standard_ProgramError::Raise(ERR_TR_NOT_OPENED);
+
+  t_savepoint savepoint;
+  savepoint.name    = theName;
+  savepoint.txLevel = m_doc->GetData()->OpenTransaction();
+  savepoint.logMark = m_packedLogBook.IsNull() ? 0 : m_packedLogBook->MarkSavepoint();
+  //
+  m_savepoints.Append(savepoint);
+}
+
+//! Rolls back all modifications made after the given savepoint. Only the
+//! changes recorded since the savepoint are reverted, while the command
+//! remains open. The savepoint itself is kept, so that it is possible to
+//! roll back to it again, while all the savepoints set after it are
+//! discarded.
+//! \param[in] theName name of the savepoint.
+void ActData_TransactionEngine::RollbackToSavepoint(const TCollection_AsciiString& theName)
+{
+  if ( this->isTransactionModeOff() )
+    return;
+
+  const Standard_Integer idx = this->findSavepoint(theName);
+  //
+  if ( !idx )
+    Standard_ProgramError::Raise(ERR_SAVEPOINT_NOT_FOUND);
+
+  t_savepoint& savepoint = m_savepoints.ChangeValue(idx);
+
+  // Abort the nested transactions of this and later savepoints, then
+  // reopen the transaction for this one
+  Handle(TDF_Data) data = m_doc->GetData();
+  //
+  data->AbortUntilTransaction(savepoint.txLevel);
+  savepoint.txLevel = data->OpenTransaction();
+
+  if ( !m_packedLogBook.IsNull() )
+    m_packedLogBook->RollbackToSavepoint(savepoint.logMark);
+
+  // Children could have been restored by the rollback
+  ActData_ChildIndex::Release( m_doc->Main() );
+
+  while ( m_savepoints.Length() > idx )
+    m_savepoints.Remove( m_savepoints.Length() );
+}
+
+//! Releases the given savepoint together with all the savepoints set after
+//! it. The modifications made after the savepoint are kept as a part of
+//! the enclosing scope.
+//! \param[in] theName name of the savepoint.
+void ActData_TransactionEngine::ReleaseSavepoint(const TCollection_AsciiString& theName)
+{
+  if ( this->isTransactionModeOff() )
+    return;
+
+  const Standard_Integer idx = this->findSavepoint(theName);
+  //
+  if ( !idx )
+    Standard_ProgramError::Raise(ERR_SAVEPOINT_NOT_FOUND);
+
+  // Nested transactions are merged into the enclosing one without deltas
+  m_doc->GetData()->CommitUntilTransaction(m_savepoints.Value(idx).txLevel, Standard_False);
+
+  while ( m_savepoints.Length() >= idx )
+    m_savepoints.Remove( m_savepoints.Length() );
+}
+
+//! Checks whether the open command has a savepoint with the given name.
+//! \param[in] theName name of the savepoint.
+//! \return true/false.
+Standard_Boolean
+  ActData_TransactionEngine::HasSavepoint(const TCollection_AsciiString& theName) const
+{
+  return this->findSavepoint(theName) > 0;
+}
+
+//! Looks for the most recent savepoint with the given name.
+//! \param[in] theName name of the savepoint.
+//! \return 1-based index of the savepoint or 0 if not found.
+Standard_Integer
+  ActData_TransactionEngine::findSavepoint(const TCollection_AsciiString& theName) const
+{
+  for ( Standard_Integer i = m_savepoints.Length(); i >= 1; --i )
+    if ( m_savepoints.Value(i).name.IsEqual(theName) )
+      return i;
+
+  return 0;
+}
+
+//! Rolls the Document back by the given number of Undo deltas without
+//! any side effect such as notification of observers, synchronization of
+//! the LogBook or touching of the modification time. The Document has to
+//! be brought back with forward() before any other operation.
+//! \param[in] theNbUndoes number of deltas to roll back.
+//! \return number of deltas actually rolled back.
+Standard_Integer ActData_TransactionEngine::rewind(const Standard_Integer theNbUndoes)
+{
+  if ( m_bIsActiveTransaction )
+    Standard_ProgramError::Raise(ERR_TR_ALREADY_OPENED);
+
+  Standard_Integer nbDone = 0;
+  while ( nbDone < theNbUndoes && m_doc->Undo() )
+    nbDone++;
+
+  ActData_ChildIndex::Release( m_doc->Main() );
+  return nbDone;
+}
+
+//! Brings the Document forward after rewind().
+//! \param[in] theNbRedoes number of deltas rolled back by rewind().
+void ActData_TransactionEngine::forward(const Standard_Integer theNbRedoes)
+{
+  Standard_Integer nbDone = 0;
+  while ( nbDone < theNbRedoes && m_doc->Redo() )
+    nbDone++;
+
+  ActData_ChildIndex::Release( m_doc->Main() );
+
+  // OCAF has re-created the deltas, so the last one cannot be coalesced
+  m_coalesceHead.Nullify();
+  m_coalesceLabels.Clear();
+}
+
+//-----------------------------------------------------------------------------
+// Journaling
+//-----------------------------------------------------------------------------
+
+//! Appends a journal record for the given range of deltas. The deltas are
+//! passed to the journal in the order they have been applied, as the mesh
+//! changes are journaled as deltas rather than as the resulting state.
+//! \param[in] theDeltas   list of deltas (Undo or Redo stack).
+//! \param[in] theFirst    1-based index of the first delta to record.
+//! \param[in] theNbDeltas number of deltas to record.
+//! \param[in] isReversed  true if the range lists the deltas from the last
+//!                        applied one to the first applied one.
+void ActData_TransactionEngine::appendToJournal(const TDF_DeltaList&   theDeltas,
+                                                const Standard_Integer theFirst,
+                                                const Standard_Integer theNbDeltas,
+                                                const Standard_Boolean isReversed)
+{
+  if ( m_journal.IsNull() || theNbDeltas <= 0 )
+    return;
+
+  NCollection_Sequence<Handle(TDF_Delta)> deltas;
+  Standard_Integer idx = 1;
+  //
+  for ( TDF_ListIteratorOfDeltaList it(theDeltas); it.More(); it.Next(), ++idx )
+  {
+    if ( idx < theFirst || idx >= theFirst + theNbDeltas )
+      continue;
+
+    if ( isReversed )
+      deltas.Prepend( it.Value() );
+    else
+      deltas.Append( it.Value() );
+  }
+
+  m_journal->Append(deltas);
+}
+
+//-----------------------------------------------------------------------------
+// Change feed
+//-----------------------------------------------------------------------------
+
+//! Subscribes the passed observer to the change feed. Once there is at
+//! least one observer, the Transaction Engine composes the change feed for
+//! each commit, undo and redo.
+//! \param[in] theObserver observer to add.
+void ActData_TransactionEngine::AddChangeObserver(const Handle(ActAPI_IChangeObserver)& theObserver)
+{
+  if ( theObserver.IsNull() )
+    return;
+
+  for ( NCollection_Sequence<Handle(ActAPI_IChangeObserver)>::Iterator it(m_changeObservers); it.More(); it.Next() )
+    if ( it.Value() == theObserver )
+      return;
+
+  m_changeObservers.Append(theObserver);
+}
+
+//! Unsubscribes the passed observer from the change feed.
+//! \param[in] theObserver observer to remove.
+void ActData_TransactionEngine::RemoveChangeObserver(const Handle(ActAPI_IChangeObserver)& theObserver)
+{
+  for ( Standard_Integer k = 1; k <= m_changeObservers.Length(); ++k )
+  {
+    if ( m_changeObservers(k) == theObserver )
+    {
+      m_changeObservers.Remove(k);
+      break;
+    }
+  }
+
+  if ( m_changeObservers.IsEmpty() )
+    m_lastChangeFeed.Nullify();
+}
+
 //-----------------------------------------------------------------------------
 // Services for internal & friend usage only
 //-----------------------------------------------------------------------------
 
 //! Collects IDs of the data objects which are going to affected by Undo
 //! operation with the given depth. This method must be invoked BEFORE
-//! actual Undo is launched.
+//! actual Undo is launched. The affected Labels are coalesced across all
+//! requested Deltas and trimmed to the Parameter level before their IDs
+//! are formatted, so each Parameter is reported once regardless of depth.
 //! \param theNbUndoes [in] Undo depth.
 //! \return collection of affected data object IDs.
 Handle(ActAPI_HDataObjectIdMap)
   ActData_TransactionEngine::entriesToUndo(const Standard_Integer theNbUndoes) const
 {
-  Handle(ActAPI_HDataObjectIdMap) aMap = new ActAPI_HDataObjectIdMap();
+  TDF_LabelIndexedMap aLabels;
 
   const TDF_DeltaList& aDeltaList       = m_doc->GetUndos();
   Standard_Integer     aNbDeltas        = aDeltaList.Extent();
@@ -291,21 +1220,22 @@ Handle(ActAPI_HDataObjectIdMap)
     if ( aDeltaIndex < aFirstDeltaIndex )
       continue; // Skip the oldest non-requested Deltas
 
-    this->addEntriesByDelta(it.Value(), aMap);
+    this->addLabelsByDelta(it.Value(), aLabels);
   }
 
-  return aMap;
+  return EntriesOf(aLabels);
 }
 
 //! Collects IDs of the data objects which are going to affected by Redo
 //! operation with the given depth. This method must be invoked BEFORE
-//! actual Redo is launched.
+//! actual Redo is launched. As for Undo, the affected Labels are coalesced
+//! across the Deltas before formatting their IDs.
 //! \param theNbRedoes [in] Redo depth.
 //! \return collection of affected data object IDs.
 Handle(ActAPI_HDataObjectIdMap)
   ActData_TransactionEngine::entriesToRedo(const Standard_Integer theNbRedoes) const
 {
-  Handle(ActAPI_HDataObjectIdMap) aMap = new ActAPI_HDataObjectIdMap();
+  TDF_LabelIndexedMap aLabels;
 
   const TDF_DeltaList& aDeltaList      = m_doc->GetRedos();
   Standard_Integer     aNbDeltas       = aDeltaList.Extent();
@@ -322,18 +1252,26 @@ Handle(ActAPI_HDataObjectIdMap)
     if ( aDeltaIndex > aLastDeltaIndex )
       break; // Skip the oldest non-requested Deltas
 
-    this->addEntriesByDelta(it.Value(), aMap);
+    this->addLabelsByDelta(it.Value(), aLabels);
   }
 
-  return aMap;
+  return EntriesOf(aLabels);
 }
 
 //! Iterates over the passed collection of Parameters attempting to touch
 //! those of them which are still WELL-FORMED, i.e. were not removed or
-//! damaged anyhow.
+//! damaged anyhow. All Parameters receive the same modification timestamp
+//! which is generated once for the whole collection.
 //! \param theParam [in] Parameters to touch.
 void ActData_TransactionEngine::touchAffectedParameters(const Handle(ActAPI_TxRes)& theRes)
 {
+  if ( !ActData_BaseModel::MTime_On )
+    return;
+
+  // One timestamp for all Parameters touched by this Undo/Redo
+  Handle(HIntArray)
+    aStamp = ActAux_TimeStampTool::AsChunked( ActAux_TimeStampTool::Generate() );
+
   // Now touch the affected Parameters so that actualizing their MTime
   this->DisableTransactions();
   for ( int k = 1; k <= theRes->parameterRefs.Extent(); ++k )
@@ -348,8 +1286,7 @@ void ActData_TransactionEngine::touchAffectedParameters(const Handle(ActAPI_TxRe
       TDF_Tool::Label( m_doc->GetData(), paramRef.id, paramLab);
 
       // Update MTime at low level.
-      if ( ActData_BaseModel::MTime_On )
-        ActData_Utils::SetTimeStampValue(paramLab, ActData_UserParameter::DS_MTime);
+      ActData_Utils::SetTimeStampValue(paramLab, ActData_UserParameter::DS_MTime, aStamp);
     }
     else
     {
@@ -367,7 +1304,7 @@ void ActData_TransactionEngine::touchAffectedParameters(const Handle(ActAPI_TxRe
 
       if ( aUserParam->IsWellFormed() )
       {
-        aUserParam->SetModified();
+        ActData_Utils::SetTimeStampValue(aUserParam->RootLabel(), ActData_UserParameter::DS_MTime, aStamp);
 
 #if defined COUT_DEBUG
         std::cout << "WELL-FORMED ["
@@ -384,14 +1321,19 @@ void ActData_TransactionEngine::touchAffectedParameters(const Handle(ActAPI_TxRe
   this->EnableTransactions();
 }
 
-//! Retrieves Nodal Parameters affected by the given Delta and pushes them
-//! into the passed collection. META Parameters are also added.
-//! \param theDelta [in]  Delta to get Parameters for.
-//! \param theMap   [out] resulting cumulative map of Parameters. It is not
-//!                       cleaned up before usage.
-void ActData_TransactionEngine::addEntriesByDelta(const Handle(TDF_Delta)&         theDelta,
-                                                  Handle(ActAPI_HDataObjectIdMap)& theMap) const
+//! Retrieves Labels of Nodal Parameters affected by the given Delta and
+//! pushes them into the passed collection. META Parameters are also added.
+//! The Labels nested into a Parameter are trimmed to the Parameter's root,
+//! while the Labels which cannot represent a Parameter are skipped.
+//! \param theDelta  [in]  Delta to get Parameters for.
+//! \param theLabels [out] resulting cumulative map of Labels. It is not
+//!                        cleaned up before usage.
+void ActData_TransactionEngine::addLabelsByDelta(const Handle(TDF_Delta)& theDelta,
+                                                 TDF_LabelIndexedMap&     theLabels) const
 {
+  const Standard_Integer minDepth = ActData_NumTags_MetaParameterId - 1;
+  const Standard_Integer maxDepth = ActData_NumTags_UserParameterId - 1;
+
   const TDF_AttributeDeltaList& attrDeltas = theDelta->AttributeDeltas();
   for ( TDF_ListIteratorOfAttributeDeltaList it(attrDeltas); it.More(); it.Next() )
   {
@@ -399,20 +1341,126 @@ void ActData_TransactionEngine::addEntriesByDelta(const Handle(TDF_Delta)&
     if ( attrDelta.IsNull() )
       continue;
 
-    TDF_Label aLab = attrDelta->Label();
+    const TDF_Label        aLab   = attrDelta->Label();
+    const Standard_Integer aDepth = aLab.Depth();
     //
-    TCollection_AsciiString entry;
-    TDF_Tool::Entry(aLab, entry);
+    if ( aDepth < minDepth )
+      continue; // Not enough capacity for a Parameter
 
-#if defined COUT_DEBUG
-    std::cout << "\tEntry of affected label: " << entry.ToCString() << std::endl;
-#endif
+    // Add Label trimmed to the Parameter level
+    theLabels.Add( aDepth > maxDepth ? AncestorAt(aLab, maxDepth) : aLab );
+  }
+}
+
+//! Classifies the attribute deltas of the passed OCAF delta and populates
+//! the change feed with the affected Nodes and Parameters. Only the Labels
+//! of the Partitions section are taken into account. The creation and
+//! deletion of a Node is recognized by its type name attribute on the META
+//! container, while the creation and deletion of a Parameter is recognized
+//! by its type attribute. All other attribute deltas are reported as
+//! modifications of the owning Node and Parameter.
+//! \param[in] theDelta  OCAF delta to classify.
+//! \param[in] isInverse true if the delta is going to be applied by
+//!                      Undo/Redo, i.e., the changes are opposite.
+//! \param[in] theFeed   change feed to populate.
+void ActData_TransactionEngine::addChangesByDelta(const Handle(TDF_Delta)&         theDelta,
+                                                  const Standard_Boolean           isInverse,
+                                                  const Handle(ActAPI_ChangeFeed)& theFeed) const
+{
+  const Standard_Integer nodeDepth    = ActData_NumTags_NodeId - 1;
+  const Standard_Integer metaDepth    = ActData_NumTags_MetaParameterId - 1;
+  const Standard_Integer paramDepth   = ActData_NumTags_UserParameterId - 1;
+  const Standard_Integer sectionDepth = 1;
+
+  NCollection_DataMap<TDF_Label, ActAPI_DataObjectId, TDF_LabelMapHasher> entries;
+
+  const TDF_AttributeDeltaList& attrDeltas = theDelta->AttributeDeltas();
+  for ( TDF_ListIteratorOfAttributeDeltaList it(attrDeltas); it.More(); it.Next() )
+  {
+    const Handle(TDF_AttributeDelta)& attrDelta = it.Value();
+    if ( attrDelta.IsNull() )
+      continue;
+
+    const TDF_Label        lab   = attrDelta->Label();
+    const Standard_Integer depth = lab.Depth();
+    //
+    if ( depth < nodeDepth )
+      continue; // Not a Node.
+
+    if ( AncestorAt(lab, sectionDepth).Tag() != ActData_BaseModel::StructureTag_Partitions )
+      continue; // Not in Partitions (e.g., LogBook or Copy/Paste buffer).
+
+    const TDF_Label                     nodeLab = AncestorAt(lab, nodeDepth);
+    const ActAPI_NodeId&                nodeId  = EntryOf(nodeLab, entries);
+    const ActAPI_ChangeFeed::ChangeKind kind    = ChangeKindOf(attrDelta, isInverse);
+
+    if ( depth == nodeDepth )
+    {
+      theFeed->AddNode(nodeId, ActAPI_ChangeFeed::Change_Modified);
+      continue;
+    }
 
-    // Add entry.
-    theMap->Add(entry);
+    const TDF_Label scopeLab = AncestorAt(lab, metaDepth);
+
+    // META Parameter: type name of the Node defines the Node's existence
+    if ( scopeLab.Tag() == ActData_BaseNode::TagInternal )
+    {
+      if ( lab == scopeLab && attrDelta->ID() == TDataStd_AsciiString::GetID() )
+      {
+        theFeed->AddNode(nodeId, kind);
+      }
+      else
+      {
+        theFeed->AddNode(nodeId, ActAPI_ChangeFeed::Change_Modified);
+        theFeed->AddParameter(EntryOf(scopeLab, entries), nodeId,
+                              Parameter_META, ActAPI_ChangeFeed::Change_Modified);
+      }
+    }
+
+    // USER Parameter: type attribute defines the Parameter's existence
+    else if ( scopeLab.Tag() == ActData_BaseNode::TagUser && depth > metaDepth )
+    {
+      const TDF_Label paramLab = AncestorAt(lab, paramDepth);
+      const TDF_Label typeLab  = paramLab.FindChild(ActData_UserParameter::DS_ParamType, Standard_False);
+
+      Standard_Integer              paramType = Parameter_UNDEFINED;
+      ActAPI_ChangeFeed::ChangeKind paramKind = ActAPI_ChangeFeed::Change_Modified;
+      //
+      if ( lab == typeLab && attrDelta->ID() == TDataStd_Integer::GetID() )
+      {
+        paramKind = kind;
+
+        // The attribute is kept by the delta even if it is not in the
+        // Document anymore
+        Handle(TDataStd_Integer)
+          typeAttr = Handle(TDataStd_Integer)::DownCast( attrDelta->Attribute() );
+        //
+        if ( !typeAttr.IsNull() )
+          paramType = typeAttr->Get();
+      }
+      else
+      {
+        Handle(TDataStd_Integer) typeAttr;
+        if ( !typeLab.IsNull() && typeLab.FindAttribute(TDataStd_Integer::GetID(), typeAttr) )
+          paramType = typeAttr->Get();
+      }
+
+      theFeed->AddNode(nodeId, ActAPI_ChangeFeed::Change_Modified);
+      theFeed->AddParameter(EntryOf(paramLab, entries), nodeId, paramType, paramKind);
+    }
   }
 }
 
+//! Notifies the subscribed observers on the passed changes.
+//! \param[in] theFeed change feed to pass to the observers.
+void ActData_TransactionEngine::notifyChangeObservers(const Handle(ActAPI_ChangeFeed)& theFeed)
+{
+  m_lastChangeFeed = theFeed;
+
+  for ( NCollection_Sequence<Handle(ActAPI_IChangeObserver)>::Iterator it(m_changeObservers); it.More(); it.Next() )
+    it.Value()->OnChanges(theFeed);
+}
+
 //! Checks whether the transaction deployment requirement is currently
 //! enabled.
 //! \return true/false.
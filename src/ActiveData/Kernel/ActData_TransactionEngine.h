@@ -34,14 +34,26 @@
 #define ActData_TransactionEngine_HeaderFile
 
 // Active Data includes
+#include <ActData_BinJournal.h>
 #include <ActData_Common.h>
+#include <ActData_PackedLogBook.h>
+#include <ActData_TxStatistics.h>
 
 // Active Data (API) includes
+#include <ActAPI_IChangeObserver.h>
 #include <ActAPI_TxRes.h>
 
 // OCCT includes
+#include <OSD_Timer.hxx>
+#include <TCollection_AsciiString.hxx>
+#include <TDF_DeltaList.hxx>
+#include <TDF_LabelIndexedMap.hxx>
 #include <TDocStd_Document.hxx>
 
+// Standard includes
+#include <deque>
+#include <vector>
+
 #define DEFAULT_UNDO_LIMIT 100
 
 //! \ingroup AD_DF
@@ -108,6 +120,149 @@ public:
   ActData_EXPORT virtual Standard_Integer
     NbRedos() const;
 
+public:
+
+  //! Sets the packed LogBook whose records have to follow the transactional
+  //! scopes managed by this Transaction Engine.
+  //! \param[in] theLogBook packed LogBook to set (null to disable).
+  void SetPackedLogBook(const Handle(ActData_PackedLogBook)& theLogBook)
+  {
+    m_packedLogBook = theLogBook;
+  }
+
+  //! \return packed LogBook synchronized with transactions.
+  const Handle(ActData_PackedLogBook)& GetPackedLogBook() const
+  {
+    return m_packedLogBook;
+  }
+
+// Memory cap:
+public:
+
+  ActData_EXPORT void
+    SetUndoMemoryLimit(const Standard_Size theNbBytes);
+
+  //! \return memory cap for the Undo history in bytes (0 for unlimited).
+  Standard_Size GetUndoMemoryLimit() const
+  {
+    return m_undoMemLimit;
+  }
+
+  //! \return estimated size of the Undo history in bytes. The size is
+  //!         tracked only if the memory cap is set.
+  Standard_Size GetUndoMemoryUsage() const
+  {
+    return m_undoMemUsage;
+  }
+
+  ActData_EXPORT static Standard_Size
+    EstimatedSize(const Handle(TDF_Delta)& theDelta);
+
+  ActData_EXPORT static Standard_Size
+    EstimatedSize(const Handle(TDF_AttributeDelta)& theAttrDelta);
+
+// Instrumentation:
+public:
+
+  //! Sets the collector of per-commit statistics.
+  //! \param[in] theStats statistics collector to set (null to disable).
+  void SetStatistics(const Handle(ActData_TxStatistics)& theStats)
+  {
+    m_txStats = theStats;
+  }
+
+  //! \return collector of per-commit statistics (null if disabled).
+  const Handle(ActData_TxStatistics)& GetStatistics() const
+  {
+    return m_txStats;
+  }
+
+// Journaling:
+public:
+
+  //! Sets the write-ahead journal which receives a record for each commit,
+  //! Undo and Redo.
+  //! \param[in] theJournal journal to set (null to disable).
+  void SetJournal(const Handle(ActData_BinJournal)& theJournal)
+  {
+    m_journal = theJournal;
+  }
+
+  //! \return write-ahead journal (null if disabled).
+  const Handle(ActData_BinJournal)& GetJournal() const
+  {
+    return m_journal;
+  }
+
+// Coalescing:
+public:
+
+  ActData_EXPORT void
+    SetCoalescingWindow(const Standard_Real theSeconds);
+
+  //! \return time window in seconds for the consecutive commits to be
+  //!         coalesced (0 if disabled).
+  Standard_Real GetCoalescingWindow() const
+  {
+    return m_fCoalesceWindow;
+  }
+
+  ActData_EXPORT void
+    BeginCoalescing(const TCollection_AsciiString& theKey);
+
+  ActData_EXPORT void
+    EndCoalescing();
+
+  //! \return key of the current coalescing run (empty if none).
+  const TCollection_AsciiString& GetCoalescingKey() const
+  {
+    return m_coalesceKey;
+  }
+
+  //! \return true if the last commit has been merged with the previous one.
+  Standard_Boolean IsLastCommitCoalesced() const
+  {
+    return m_bCoalesced;
+  }
+
+// Savepoints:
+public:
+
+  ActData_EXPORT void
+    SetSavepoint(const TCollection_AsciiString& theName);
+
+  ActData_EXPORT void
+    RollbackToSavepoint(const TCollection_AsciiString& theName);
+
+  ActData_EXPORT void
+    ReleaseSavepoint(const TCollection_AsciiString& theName);
+
+  ActData_EXPORT Standard_Boolean
+    HasSavepoint(const TCollection_AsciiString& theName) const;
+
+  //! \return number of savepoints in the currently open command.
+  Standard_Integer NbSavepoints() const
+  {
+    return m_savepoints.Length();
+  }
+
+// Change feed:
+public:
+
+  ActData_EXPORT void
+    AddChangeObserver(const Handle(ActAPI_IChangeObserver)& theObserver);
+
+  ActData_EXPORT void
+    RemoveChangeObserver(const Handle(ActAPI_IChangeObserver)& theObserver);
+
+  //! Returns the change feed of the last commit, undo or redo. The feed is
+  //! composed only if there is at least one subscribed observer.
+  //! \return last change feed or null handle.
+  const Handle(ActAPI_ChangeFeed)& LastChangeFeed() const
+  {
+    return m_lastChangeFeed;
+  }
+
 // Construction & initialization is hidden:
 protected:
 
@@ -126,8 +281,16 @@ private:
     touchAffectedParameters(const Handle(ActAPI_TxRes)& theParams);
 
   void
-    addEntriesByDelta(const Handle(TDF_Delta)&         theDelta,
-                      Handle(ActAPI_HDataObjectIdMap)& theMap) const;
+    addLabelsByDelta(const Handle(TDF_Delta)& theDelta,
+                     TDF_LabelIndexedMap&     theLabels) const;
+
+  void
+    addChangesByDelta(const Handle(TDF_Delta)&         theDelta,
+                      const Standard_Boolean           isInverse,
+                      const Handle(ActAPI_ChangeFeed)& theFeed) const;
+
+  void
+    notifyChangeObservers(const Handle(ActAPI_ChangeFeed)& theFeed);
 
   Standard_Boolean
     isTransactionModeOn() const;
@@ -143,6 +306,55 @@ private:
   Handle(ActAPI_TxRes)
     extractTxRes(const Handle(ActAPI_HDataObjectIdMap)& pids) const;
 
+protected:
+
+  ActData_EXPORT Handle(ActAPI_TxRes)
+    undo(const Standard_Integer theNbUndoes,
+         Standard_Integer&      theNbDone);
+
+  ActData_EXPORT Handle(ActAPI_TxRes)
+    redo(const Standard_Integer theNbRedoes,
+         Standard_Integer&      theNbDone);
+
+  ActData_EXPORT virtual void
+    trimOldestUndos(const Standard_Integer theNbTrimmed);
+
+private:
+
+  void
+    capUndoMemory();
+
+  Standard_Boolean
+    coalesceLast(const Handle(TDF_Delta)& theOldest);
+
+  Standard_Boolean
+    continuesRun();
+
+  Standard_Integer
+    findSavepoint(const TCollection_AsciiString& theName) const;
+
+  Standard_Integer
+    rewind(const Standard_Integer theNbUndoes);
+
+  void
+    forward(const Standard_Integer theNbRedoes);
+
+  void
+    appendToJournal(const TDF_DeltaList&   theDeltas,
+                    const Standard_Integer theFirst,
+                    const Standard_Integer theNbDeltas,
+                    const Standard_Boolean isReversed);
+
+protected:
+
+  //! Savepoint inside the open command.
+  struct t_savepoint
+  {
+    TCollection_AsciiString name;    //!< Name of the savepoint.
+    Standard_Integer        txLevel; //!< Nested OCAF transaction opened for the savepoint.
+    Standard_Size           logMark; //!< Length of the packed LogBook journal.
+  };
+
 protected:
 
   //! Undo Limit.
@@ -154,6 +366,60 @@ protected:
   //! Indicates whether some transaction is currently active.
   Standard_Boolean m_bIsActiveTransaction;
 
+  //! Packed LogBook (if any) journaling its records per transaction.
+  Handle(ActData_PackedLogBook) m_packedLogBook;
+
+  //! Subscribers to the change feed.
+  NCollection_Sequence<Handle(ActAPI_IChangeObserver)> m_changeObservers;
+
+  //! Change feed of the last transactional operation.
+  Handle(ActAPI_ChangeFeed) m_lastChangeFeed;
+
+  //! Memory cap for the Undo history in bytes (0 for unlimited).
+  Standard_Size m_undoMemLimit;
+
+  //! Estimated size of the Undo history in bytes.
+  Standard_Size m_undoMemUsage;
+
+  //! Estimated sizes of Undo deltas from the oldest to the most recent.
+  std::deque<Standard_Size> m_undoSizes;
+
+  //! Estimated sizes of Redo deltas, the next one to Redo is the last.
+  std::vector<Standard_Size> m_redoSizes;
+
+  //! Key of the current coalescing run.
+  TCollection_AsciiString m_coalesceKey;
+
+  //! Time window in seconds for the commits to be coalesced (0 to disable).
+  Standard_Real m_fCoalesceWindow;
+
+  //! Time elapsed since the last commit of the coalescing run.
+  OSD_Timer m_coalesceTimer;
+
+  //! Delta of the last commit which the next commit can be merged with.
+  Handle(TDF_Delta) m_coalesceHead;
+
+  //! Key the head delta was committed with.
+  TCollection_AsciiString m_coalesceHeadKey;
+
+  //! Parameters affected by the head delta.
+  TDF_LabelIndexedMap m_coalesceLabels;
+
+  //! Indicates whether the last commit has been merged with the previous one.
+  Standard_Boolean m_bCoalesced;
+
+  //! Savepoints of the open command from the outermost to the innermost.
+  NCollection_Sequence<t_savepoint> m_savepoints;
+
+  //! Collector of per-commit statistics (null if disabled).
+  Handle(ActData_TxStatistics) m_txStats;
+
+  //! Time elapsed since the current command was opened.
+  OSD_Timer m_commandTimer;
+
+  //! Write-ahead journal of the committed changes (null if disabled).
+  Handle(ActData_BinJournal) m_journal;
+
 };
 
 #endif
@@ -0,0 +1,245 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <ActData_TxStatistics.h>
+
+// Active Data includes
+#include <ActData_TransactionEngine.h>
+
+// OCCT includes
+#include <NCollection_DataMap.hxx>
+#include <TDF_LabelMapHasher.hxx>
+#include <TDF_ListIteratorOfAttributeDeltaList.hxx>
+#include <TDF_Tool.hxx>
+
+// Standard includes
+#include <algorithm>
+
+//-----------------------------------------------------------------------------
+
+//! Orders Labels by the retained bytes from the largest.
+static bool IsHotter(const ActData_TxStatistics::t_label& l1,
+                     const ActData_TxStatistics::t_label& l2)
+{
+  return l1.bytes > l2.bytes;
+}
+
+//-----------------------------------------------------------------------------
+
+//! Constructor.
+//! \param[in] theCapacity    maximal number of commits to keep.
+//! \param[in] theNbHotLabels number of the Labels with the largest backups
+//!                           to keep per commit.
+ActData_TxStatistics::ActData_TxStatistics(const Standard_Integer theCapacity,
+                                           const Standard_Integer theNbHotLabels)
+: Standard_Transient (),
+  m_iCapacity        (theCapacity),
+  m_iNbHotLabels     (theNbHotLabels),
+  m_iNextIndex       (1)
+{}
+
+//! Records statistics for the passed committed delta. A delta merged with
+//! the previous one replaces the record of the latter, so that the bytes
+//! retained by the merged delta are counted once. The times of the merged
+//! commits are summed up.
+//! \param[in] theDelta    delta stacked in the Undo history by the commit.
+//! \param[in] theLatency  time spent on committing, in seconds.
+//! \param[in] theDuration time since the command was opened, in seconds.
+//! \param[in] isCoalesced whether the delta has been merged with the
+//!                        previous one.
+void ActData_TxStatistics::Add(const Handle(TDF_Delta)& theDelta,
+                               const Standard_Real      theLatency,
+                               const Standard_Real      theDuration,
+                               const Standard_Boolean   isCoalesced)
+{
+  if ( theDelta.IsNull() || m_iCapacity <= 0 )
+    return;
+
+  t_commit commit;
+  commit.index     = m_iNextIndex++;
+  commit.latency   = theLatency;
+  commit.duration  = theDuration;
+  commit.nbDeltas  = 0;
+  commit.bytes     = sizeof(TDF_Delta);
+  commit.coalesced = isCoalesced;
+
+  if ( isCoalesced && !m_commits.empty() )
+  {
+    commit.latency  += m_commits.back().latency;
+    commit.duration += m_commits.back().duration;
+    m_commits.pop_back();
+  }
+
+  NCollection_DataMap<Handle(Standard_Type), Standard_Integer> typeIndices;
+  NCollection_DataMap<TDF_Label, Standard_Size, TDF_LabelMapHasher> labelBytes;
+
+  for ( TDF_ListIteratorOfAttributeDeltaList it( theDelta->AttributeDeltas() ); it.More(); it.Next() )
+  {
+    const Handle(TDF_AttributeDelta)& attrDelta = it.Value();
+    if ( attrDelta.IsNull() || attrDelta->Attribute().IsNull() )
+      continue;
+
+    const Standard_Size bytes = ActData_TransactionEngine::EstimatedSize(attrDelta);
+    commit.nbDeltas++;
+    commit.bytes += bytes;
+
+    // Group by attribute type
+    const Handle(Standard_Type)& type = attrDelta->Attribute()->DynamicType();
+    const Standard_Integer* pTypeIdx = typeIndices.Seek(type);
+    //
+    if ( !pTypeIdx )
+    {
+      t_type t;
+      t.name     = type->Name();
+      t.nbDeltas = 0;
+      t.bytes    = 0;
+      commit.types.push_back(t);
+      pTypeIdx = typeIndices.Bound( type, (Standard_Integer) commit.types.size() - 1 );
+    }
+    commit.types[*pTypeIdx].nbDeltas++;
+    commit.types[*pTypeIdx].bytes += bytes;
+
+    // Group by Label
+    Standard_Size* pLabelBytes = labelBytes.ChangeSeek( attrDelta->Label() );
+    //
+    if ( pLabelBytes )
+      *pLabelBytes += bytes;
+    else
+      labelBytes.Bind(attrDelta->Label(), bytes);
+  }
+
+  // Keep the hottest Labels only
+  std::vector<t_label> labels;
+  labels.reserve( labelBytes.Extent() );
+  //
+  for ( NCollection_DataMap<TDF_Label, Standard_Size, TDF_LabelMapHasher>::Iterator lit(labelBytes);
+        lit.More(); lit.Next() )
+  {
+    t_label l;
+    TDF_Tool::Entry(lit.Key(), l.entry);
+    l.bytes = lit.Value();
+    labels.push_back(l);
+  }
+  //
+  const size_t nbHot = std::min( labels.size(), (size_t) std::max(m_iNbHotLabels, 0) );
+  std::partial_sort(labels.begin(), labels.begin() + nbHot, labels.end(), IsHotter);
+  commit.hotLabels.assign(labels.begin(), labels.begin() + nbHot);
+
+  m_commits.push_back(commit);
+  //
+  while ( (Standard_Integer) m_commits.size() > m_iCapacity )
+    m_commits.pop_front();
+}
+
+//! Cleans up the recorded statistics.
+void ActData_TxStatistics::Clear()
+{
+  m_commits.clear();
+}
+
+//! \return estimated bytes retained by all recorded commits.
+Standard_Size ActData_TxStatistics::TotalBytes() const
+{
+  Standard_Size bytes = 0;
+  for ( size_t k = 0; k < m_commits.size(); ++k )
+    bytes += m_commits[k].bytes;
+
+  return bytes;
+}
+
+//! Dumps the recorded statistics as CSV with one row per commit. The
+//! attribute types and the hot Labels are packed into single columns as
+//! semicolon-separated "name=count" and "entry=bytes" pairs.
+//! \param[in,out] theOut output stream.
+void ActData_TxStatistics::DumpCSV(Standard_OStream& theOut) const
+{
+  theOut << "index,latency_s,duration_s,deltas,bytes,coalesced,types,hot_labels\n";
+
+  for ( size_t k = 0; k < m_commits.size(); ++k )
+  {
+    const t_commit& c = m_commits[k];
+
+    theOut << c.index     << ","
+           << c.latency   << ","
+           << c.duration  << ","
+           << c.nbDeltas  << ","
+           << c.bytes     << ","
+           << (c.coalesced ? 1 : 0) << ",";
+
+    for ( size_t t = 0; t < c.types.size(); ++t )
+      theOut << (t ? ";" : "") << c.types[t].name << "=" << c.types[t].nbDeltas;
+
+    theOut << ",";
+
+    for ( size_t l = 0; l < c.hotLabels.size(); ++l )
+      theOut << (l ? ";" : "") << c.hotLabels[l].entry << "=" << c.hotLabels[l].bytes;
+
+    theOut << "\n";
+  }
+}
+
+//! Dumps the recorded statistics as JSON array of commits. Type names and
+//! Label entries never contain characters to escape.
+//! \param[in,out] theOut output stream.
+void ActData_TxStatistics::DumpJSON(Standard_OStream& theOut) const
+{
+  theOut << "[";
+
+  for ( size_t k = 0; k < m_commits.size(); ++k )
+  {
+    const t_commit& c = m_commits[k];
+
+    theOut << (k ? ",\n " : "\n ")
+           << "{\"index\": "     << c.index
+           << ", \"latency\": "  << c.latency
+           << ", \"duration\": " << c.duration
+           << ", \"deltas\": "   << c.nbDeltas
+           << ", \"bytes\": "    << c.bytes
+           << ", \"coalesced\": " << (c.coalesced ? "true" : "false")
+           << ", \"types\": {";
+
+    for ( size_t t = 0; t < c.types.size(); ++t )
+      theOut << (t ? ", " : "") << "\"" << c.types[t].name << "\": {\"deltas\": "
+             << c.types[t].nbDeltas << ", \"bytes\": " << c.types[t].bytes << "}";
+
+    theOut << "}, \"hot_labels\": [";
+
+    for ( size_t l = 0; l < c.hotLabels.size(); ++l )
+      theOut << (l ? ", " : "") << "{\"entry\": \"" << c.hotLabels[l].entry
+             << "\", \"bytes\": " << c.hotLabels[l].bytes << "}";
+
+    theOut << "]}";
+  }
+
+  theOut << "\n]\n";
+}
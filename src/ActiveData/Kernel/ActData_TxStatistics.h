@@ -0,0 +1,158 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+#ifndef ActData_TxStatistics_HeaderFile
+#define ActData_TxStatistics_HeaderFile
+
+// Active Data includes
+#include <ActData_Common.h>
+
+// OCCT includes
+#include <Standard_OStream.hxx>
+#include <TCollection_AsciiString.hxx>
+#include <TDF_Delta.hxx>
+
+// Standard includes
+#include <deque>
+#include <vector>
+
+DEFINE_STANDARD_HANDLE(ActData_TxStatistics, Standard_Transient)
+
+//! \ingroup AD_DF
+//!
+//! Collector of per-commit statistics for Transaction Engine. For each
+//! committed transaction, it keeps the number of attribute deltas by
+//! attribute type, the estimated number of bytes retained in the Undo
+//! history, the commit latency and the Labels holding the largest backups.
+//! Only the most recent commits are kept as limited by the capacity.
+class ActData_TxStatistics : public Standard_Transient
+{
+public:
+
+  // OCCT RTTI
+  DEFINE_STANDARD_RTTI_INLINE(ActData_TxStatistics, Standard_Transient)
+
+public:
+
+  //! Attribute deltas of a single attribute type.
+  struct t_type
+  {
+    TCollection_AsciiString name;     //!< Name of the attribute type.
+    Standard_Integer        nbDeltas; //!< Number of attribute deltas.
+    Standard_Size           bytes;    //!< Estimated bytes retained.
+  };
+
+  //! Attribute deltas of a single Label.
+  struct t_label
+  {
+    TCollection_AsciiString entry; //!< Entry of the Label.
+    Standard_Size           bytes; //!< Estimated bytes retained.
+  };
+
+  //! Statistics of a single commit.
+  struct t_commit
+  {
+    Standard_Integer     index;     //!< Sequential number of the commit.
+    Standard_Real        latency;   //!< Time spent on committing, in seconds.
+    Standard_Real        duration;  //!< Time since the command was opened, in seconds.
+    Standard_Integer     nbDeltas;  //!< Number of attribute deltas.
+    Standard_Size        bytes;     //!< Estimated bytes retained.
+    Standard_Boolean     coalesced; //!< Whether merged with the previous commits.
+    std::vector<t_type>  types;     //!< Deltas by attribute type.
+    std::vector<t_label> hotLabels; //!< Labels with the largest backups.
+  };
+
+public:
+
+  ActData_EXPORT
+    ActData_TxStatistics(const Standard_Integer theCapacity    = 1000,
+                         const Standard_Integer theNbHotLabels = 5);
+
+public:
+
+  ActData_EXPORT void
+    Add(const Handle(TDF_Delta)& theDelta,
+        const Standard_Real      theLatency,
+        const Standard_Real      theDuration,
+        const Standard_Boolean   isCoalesced);
+
+  ActData_EXPORT void
+    Clear();
+
+  ActData_EXPORT Standard_Size
+    TotalBytes() const;
+
+  ActData_EXPORT void
+    DumpCSV(Standard_OStream& theOut) const;
+
+  ActData_EXPORT void
+    DumpJSON(Standard_OStream& theOut) const;
+
+public:
+
+  //! \return number of the recorded commits.
+  Standard_Integer NbCommits() const
+  {
+    return (Standard_Integer) m_commits.size();
+  }
+
+  //! Returns statistics of the commit with the given index, where 0 is the
+  //! oldest of the recorded commits.
+  //! \param[in] theIndex index of the commit.
+  //! \return commit statistics.
+  const t_commit& Commit(const Standard_Integer theIndex) const
+  {
+    return m_commits[theIndex];
+  }
+
+  //! \return maximal number of the recorded commits.
+  Standard_Integer GetCapacity() const
+  {
+    return m_iCapacity;
+  }
+
+  //! \return number of the Labels with the largest backups per commit.
+  Standard_Integer GetNbHotLabels() const
+  {
+    return m_iNbHotLabels;
+  }
+
+protected:
+
+  std::deque<t_commit> m_commits;      //!< Recorded commits from the oldest one.
+  Standard_Integer     m_iCapacity;    //!< Maximal number of the recorded commits.
+  Standard_Integer     m_iNbHotLabels; //!< Number of hot Labels per commit.
+  Standard_Integer     m_iNextIndex;   //!< Sequential number of the next commit.
+
+};
+
+#endif
@@ -463,22 +463,14 @@ TDF_Label ActData_UserParameter::RootLabel() const
 //! modification LogBook.
 void ActData_UserParameter::SetTouched()
 {
-  // Prepare LogBook Data Cursor
-  TDF_Label aLogBookSection =
-    m_label.Root().FindChild(ActData_BaseModel::StructureTag_LogBook);
-
-  ActData_LogBook(aLogBookSection).Touch(m_label);
+  ActData_LogBook::Access(m_label).Touch(m_label);
 }
 
 //! Marks this Parameter as IMPACTED (affected by Tree Function mechanism) in
 //! the global modification LogBook.
 void ActData_UserParameter::SetImpacted()
 {
-  // Prepare LogBook Data Cursor
-  TDF_Label aLogBookSection =
-    m_label.Root().FindChild(ActData_BaseModel::StructureTag_LogBook);
-
-  ActData_LogBook(aLogBookSection).Impact(m_label);
+  ActData_LogBook::Access(m_label).Impact(m_label);
 }
 
 //-----------------------------------------------------------------------------
@@ -501,21 +493,39 @@ void ActData_UserParameter::attach(const TDF_Label& theLabel)
 //! Expands the Parameter Cursor on the passed TDF Label.
 //! \param theLabel [in] root TDF Label for the Parameter to expand on.
 void ActData_UserParameter::expandOn(const TDF_Label& theLabel)
+{
+  Handle(HIntArray) aMTime;
+  if ( ActData_BaseModel::MTime_On )
+    aMTime = ActAux_TimeStampTool::AsChunked( ActAux_TimeStampTool::Generate() );
+
+  this->expandOn(theLabel, aMTime);
+}
+
+//! Expands the Parameter Cursor on the passed TDF Label stamping it with
+//! the given modification time. The default data chunks are created in
+//! one pass in ascending order of their tags, so that each new sub-Label
+//! is appended after the previous one. Passing the same timestamp to many
+//! Parameters expanded at once saves generating it for each of them.
+//! \param theLabel [in] root TDF Label for the Parameter to expand on.
+//! \param theMTime [in] chunked modification time (null for none).
+void ActData_UserParameter::expandOn(const TDF_Label&         theLabel,
+                                     const Handle(HIntArray)& theMTime)
 {
   // Attach transient Cursor properties to the CAF Label
   this->attach(theLabel);
 
   // Set Parameter type
-  ActData_Utils::SetIntegerValue( m_label, DS_ParamType, this->parameterType() );
+  TDataStd_Integer::Set( m_label.FindChild(DS_ParamType), this->parameterType() );
+
+  // Start Parameter's modification time history
+  if ( !theMTime.IsNull() )
+    ActData_Utils::SetTimeStampValue(m_label, DS_MTime, theMTime);
 
   // Set initial validity as TRUE
-  ActData_Utils::SetIntegerValue( m_label, DS_IsValid, 1 );
+  TDataStd_Integer::Set( m_label.FindChild(DS_IsValid), 1 );
 
   // Set initial pending as FALSE
-  ActData_Utils::SetIntegerValue( m_label, DS_IsPending, 0 );
-
-  // Start Parameter's modification time history
-  this->SetModified();
+  TDataStd_Integer::Set( m_label.FindChild(DS_IsPending), 0 );
 }
 
 //! Settles the Parameter Cursor on the passed TDF Label.
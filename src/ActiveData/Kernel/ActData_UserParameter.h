@@ -228,6 +228,9 @@ protected:
   ActData_EXPORT virtual void expandOn (const TDF_Label& theLabel);
   ActData_EXPORT virtual void settleOn (const TDF_Label& theLabel);
 
+  ActData_EXPORT void expandOn(const TDF_Label&         theLabel,
+                               const Handle(HIntArray)& theMTime);
+
 protected:
 
   //! Stores a number of reserved tags for future extensions.
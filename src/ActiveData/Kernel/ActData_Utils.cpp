@@ -35,6 +35,7 @@
 
 // Active Data includes
 #include <ActData_BaseModel.h>
+#include <ActData_ChildIndex.h>
 #include <ActData_LogBook.h>
 #include <ActData_ParameterFactory.h>
 
@@ -229,9 +230,7 @@ void ActData_Utils::RemoveWithReferences(const TDF_Label&       theLabel,
     aFuncScope->RemoveFunction(theLabel);
 
   // Clean up records from LogBook
-  TDF_Label aLogBookSection =
-    theLabel.Root().FindChild(ActData_BaseModel::StructureTag_LogBook);
-  ActData_LogBook(aLogBookSection).ClearReferencesFor(theLabel);
+  ActData_LogBook::Access(theLabel).ClearReferencesFor(theLabel);
 
   // Clean up direct attributes
   theLabel.ForgetAllAttributes(doAffectChildren);
@@ -269,6 +268,18 @@ void ActData_Utils::SetTimeStampValue(const TDF_Label&       theLab,
   InitIntegerArray(theLab, theSubTag, aTSChunked);
 }
 
+//! Stores the already generated timestamp in its chunked form. This allows
+//! sharing one timestamp between many Labels stamped at once.
+//! \param theLab     [in] root Label.
+//! \param theSubTag  [in] sub-tag for the timestamp.
+//! \param theChunked [in] chunked timestamp.
+void ActData_Utils::SetTimeStampValue(const TDF_Label&         theLab,
+                                      const Standard_Integer   theSubTag,
+                                      const Handle(HIntArray)& theChunked)
+{
+  InitIntegerArray(theLab, theSubTag, theChunked);
+}
+
 Handle(ActAux_TimeStamp)
   ActData_Utils::GetTimeStampValue(const TDF_Label&       theLab,
                                    const Standard_Integer theSubTag)
@@ -1165,14 +1176,19 @@ Handle(TDataStd_TreeNode)
   return aTreeNodeAttr;
 }
 
-//! Appends one Tree Node attribute as a child to another.
+//! Appends one Tree Node attribute as a child to another. The cached child
+//! indices of the old and new parent Nodes are dropped.
 //! \param theParent [in] parent Tree Node.
 //! \param theChild  [in] child Tree Node.
 void ActData_Utils::AppendChild(const Handle(TDataStd_TreeNode)& theParent,
                                 const Handle(TDataStd_TreeNode)& theChild)
 {
   if ( theChild->HasFather() )
+  {
+    ActData_ChildIndex::Invalidate( theChild->Father()->Label().Father() );
     theChild->Remove();
+  }
+  ActData_ChildIndex::Invalidate( theParent->Label().Father() );
 
   theParent->Append(theChild);
 }
@@ -1189,6 +1205,7 @@ Standard_Boolean ActData_Utils::RemoveChild(const Handle(TDataStd_TreeNode)& the
                            // for this one, so lets return false
 
   // Remove the child Tree Node from this one
+  ActData_ChildIndex::Invalidate( theParent->Label().Father() );
   return theChild->Remove();
 }
 
@@ -111,6 +111,11 @@ public:
     SetTimeStampValue(const TDF_Label&       theLab,
                       const Standard_Integer theSubTag);
 
+  ActData_EXPORT static void
+    SetTimeStampValue(const TDF_Label&         theLab,
+                      const Standard_Integer   theSubTag,
+                      const Handle(HIntArray)& theChunked);
+
   ActData_EXPORT static Handle(ActAux_TimeStamp)
     GetTimeStampValue(const TDF_Label&       theLab,
                       const Standard_Integer theSubTag);
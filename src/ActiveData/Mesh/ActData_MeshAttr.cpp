@@ -39,6 +39,9 @@
 #include <Standard_ProgramError.hxx>
 #include <TDF_Data.hxx>
 
+// STL includes
+#include <vector>
+
 // Mesh includes
 #include <ActData_Mesh_ElementsIterator.h>
 #include <ActData_Mesh_Node.h>
@@ -74,11 +77,11 @@
     m_delta->AddedNode(ID, X, Y, Z); \
   }
 // ------------------------------------------------------------------------- //
-#define MDELTA_REMOVED_NODE(ID) \
+#define MDELTA_REMOVED_NODE(ID, X, Y, Z) \
   if ( m_bDeltaEnabled ) \
   { \
     MDELTA_ACCESS \
-    m_delta->RemovedNode(ID); \
+    m_delta->RemovedNode(ID, X, Y, Z); \
   }
 // ------------------------------------------------------------------------- //
 #define MDELTA_ADDED_TRI(ID, NODES) \
@@ -88,11 +91,11 @@
     m_delta->AddedTriangle(ID, NODES); \
   }
 // ------------------------------------------------------------------------- //
-#define MDELTA_REMOVED_TRI(ID) \
+#define MDELTA_REMOVED_TRI(ID, NODES) \
   if ( m_bDeltaEnabled ) \
   { \
     MDELTA_ACCESS \
-    m_delta->RemovedTriangle(ID); \
+    m_delta->RemovedTriangle(ID, NODES); \
   }
 // ------------------------------------------------------------------------- //
 #define MDELTA_ADDED_QUAD(ID, NODES) \
@@ -102,11 +105,25 @@
     m_delta->AddedQuadrangle(ID, NODES); \
   }
 // ------------------------------------------------------------------------- //
-#define MDELTA_REMOVED_QUAD(ID) \
+#define MDELTA_REMOVED_QUAD(ID, NODES) \
   if ( m_bDeltaEnabled ) \
   { \
     MDELTA_ACCESS \
-    m_delta->RemovedQuadrangle(ID); \
+    m_delta->RemovedQuadrangle(ID, NODES); \
+  }
+// ------------------------------------------------------------------------- //
+#define MDELTA_MOVED_NODE(ID, OLDP, NEWP) \
+  if ( m_bDeltaEnabled ) \
+  { \
+    MDELTA_ACCESS \
+    m_delta->MovedNode(ID, OLDP, NEWP); \
+  }
+// ------------------------------------------------------------------------- //
+#define MDELTA_CHANGED_TOL(OLDT, NEWT) \
+  if ( m_bDeltaEnabled ) \
+  { \
+    MDELTA_ACCESS \
+    m_delta->ChangedTolerance(OLDT, NEWT); \
   }
 // ------------------------------------------------------------------------- //
 
@@ -119,6 +136,8 @@ ActData_MeshAttr::ActData_MeshAttr() : TDF_Attribute()
 {
   MDELTA = new ActData_MeshMDelta(this);
   m_bDeltaEnabled = Standard_True;
+  m_fCompressionTol = 0.0;
+  m_bBVHRefit = Standard_False;
 }
 
 //! Settles down new Mesh Attribute to the given CAF Label.
@@ -242,6 +261,16 @@ void ActData_MeshAttr::Paste(const Handle(TDF_Attribute)& Into,
                              const Handle(TDF_RelocationTable)&) const
 {
   Handle(ActData_MeshAttr) IntoMesh = Handle(ActData_MeshAttr)::DownCast(Into);
+
+  IntoMesh->SetCompressionTolerance(m_fCompressionTol, Standard_False);
+
+  // Not yet materialized mesh is shared by its payload
+  if ( m_mesh.IsNull() && !m_payload.IsNull() )
+  {
+    IntoMesh->SetPayload(m_payload);
+    return;
+  }
+
   Handle(ActData_Mesh) IntoMeshDS = new ActData_Mesh();
 
   /* ==================
@@ -346,6 +375,35 @@ void ActData_MeshAttr::DeltaModeOff()
   m_bDeltaEnabled = Standard_False;
 }
 
+//! Enables lossy compression of the stored mesh. The node coordinates are
+//! snapped to the grid of the given step, so they deviate by half of the
+//! tolerance at most, and the connectivity is delta-coded. The Mesh DS in
+//! memory is not affected until it is restored from the Document. Still
+//! the change is recorded to Modification Delta, so it can be undone.
+//! \param Tolerance [in] grid step (zero or negative value disables the
+//!                       compression).
+//! \param doDelta   [in] indicates whether to record the change.
+void ActData_MeshAttr::SetCompressionTolerance(const Standard_Real    Tolerance,
+                                               const Standard_Boolean doDelta)
+{
+  const Standard_Real aTolerance = (Tolerance > 0.0) ? Tolerance : 0.0;
+  if ( aTolerance == m_fCompressionTol )
+    return;
+
+  if ( doDelta )
+  {
+    BACKUP;
+    MDELTA_CHANGED_TOL(m_fCompressionTol, aTolerance); // Deltalize change
+  }
+  m_fCompressionTol = aTolerance;
+}
+
+//! \return tolerance of the lossy compression (zero if disabled).
+Standard_Real ActData_MeshAttr::GetCompressionTolerance() const
+{
+  return m_fCompressionTol;
+}
+
 //-----------------------------------------------------------------------------
 // Accessors for domain-specific data
 //-----------------------------------------------------------------------------
@@ -354,6 +412,7 @@ void ActData_MeshAttr::DeltaModeOff()
 void ActData_MeshAttr::NewEmptyMesh()
 {
   m_mesh = new ActData_Mesh();
+  this->InvalidateCaches();
 }
 
 //! Sets Mesh DS to store.
@@ -364,18 +423,158 @@ void ActData_MeshAttr::SetMesh(const Handle(ActData_Mesh)& Mesh,
 {
   if ( doDelta )
   {
-    MDELTA_REPLACED_MESH(m_mesh, Mesh); // Deltalize replacement
+    MDELTA_REPLACED_MESH(this->GetMesh(), Mesh); // Deltalize replacement
   }
   m_mesh = Mesh;
+  m_payload.Nullify();
+  this->InvalidateCaches();
 }
 
-//! Returns the stored Mesh DS.
+//! Returns the stored Mesh DS. If the mesh is kept in an external payload,
+//! it is materialized here on first access.
 //! \return stored mesh.
 Handle(ActData_Mesh)& ActData_MeshAttr::GetMesh()
 {
+  if ( m_mesh.IsNull() && !m_payload.IsNull() )
+  {
+    m_mesh = m_payload->Materialize(m_fCompressionTol);
+    if ( m_mesh.IsNull() )
+      Standard_ProgramError::Raise("Cannot materialize mesh payload");
+
+    m_payload.Nullify();
+  }
   return m_mesh;
 }
 
+//-----------------------------------------------------------------------------
+// External payload
+//-----------------------------------------------------------------------------
+
+//! Binds the Attribute to the external payload. The current Mesh DS is
+//! released and the mesh is restored from the payload on the next call to
+//! GetMesh(). This is not a modification of the mesh, so no Delta is
+//! recorded.
+//! \param Payload [in] external payload.
+void ActData_MeshAttr::SetPayload(const Handle(ActData_MeshPayload)& Payload)
+{
+  m_payload = Payload;
+  m_mesh.Nullify();
+  this->InvalidateCaches();
+}
+
+//! \return external payload which is not yet materialized (null if the
+//!         Mesh DS is in memory).
+const Handle(ActData_MeshPayload)& ActData_MeshAttr::GetPayload() const
+{
+  return m_payload;
+}
+
+//! \return true if the Mesh DS is in memory, false if it is still kept
+//!         in the external payload only.
+Standard_Boolean ActData_MeshAttr::IsMaterialized() const
+{
+  return !m_mesh.IsNull() || m_payload.IsNull();
+}
+
+//-----------------------------------------------------------------------------
+// Derived structures
+//-----------------------------------------------------------------------------
+
+//! Returns the spatial index over the stored Mesh DS. The index is built
+//! on first request and kept until the mesh is changed. If the nodes were
+//! only moved, the index is refitted to their new positions instead of
+//! being rebuilt. The index is also rebuilt if the Mesh DS was changed
+//! directly, bypassing the Attribute, so that the numbers of its nodes or
+//! faces do not match anymore.
+//! \return spatial index (null if there is no Mesh DS).
+const Handle(ActData_MeshBVH)& ActData_MeshAttr::GetBVH()
+{
+  const Handle(ActData_Mesh)& aMesh = this->GetMesh();
+  if ( aMesh.IsNull() )
+  {
+    m_bvh.Nullify();
+    return m_bvh;
+  }
+
+  if ( m_bvh.IsNull() || !m_bvh->IsConsistent(aMesh) )
+    m_bvh = new ActData_MeshBVH(aMesh);
+  else if ( m_bBVHRefit )
+    m_bvh->Refit();
+
+  m_bBVHRefit = Standard_False;
+  return m_bvh;
+}
+
+//! Returns the edge topology of the stored Mesh DS. The topology is built
+//! on first request and kept until mesh entities are added or removed.
+//! As it does not depend on the nodal positions, moving the nodes keeps
+//! it valid. The topology is also rebuilt if the Mesh DS was changed
+//! directly, bypassing the Attribute.
+//! \return edge topology (null if there is no Mesh DS).
+const Handle(ActData_MeshTopology)& ActData_MeshAttr::GetTopology()
+{
+  const Handle(ActData_Mesh)& aMesh = this->GetMesh();
+  if ( aMesh.IsNull() )
+  {
+    m_topology.Nullify();
+    return m_topology;
+  }
+
+  if ( m_topology.IsNull() || !m_topology->IsConsistent(aMesh) )
+    m_topology = new ActData_MeshTopology(aMesh);
+
+  return m_topology;
+}
+
+//! Returns the packed copy of the stored Mesh DS in the struct-of-arrays
+//! layout, e.g., to compute ActData_Mesh_Metrics or to run other passes
+//! over the nodal co-ordinates and connectivity without touching the mesh
+//! objects. The copy is built on first request and kept until the mesh is
+//! changed, including the moves of the nodes. It is also rebuilt if the
+//! Mesh DS was changed directly, bypassing the Attribute, so that the
+//! numbers of its nodes or faces do not match anymore. The copy is not
+//! connected to the Mesh DS, so it must not be modified.
+//! \return packed mesh (null if there is no Mesh DS).
+const Handle(ActData_Mesh_Storage)& ActData_MeshAttr::GetStorage()
+{
+  const Handle(ActData_Mesh)& aMesh = this->GetMesh();
+  if ( aMesh.IsNull() )
+  {
+    m_storage.Nullify();
+    return m_storage;
+  }
+
+  if ( m_storage.IsNull() ||
+       m_storage->NbNodes() != aMesh->NbNodes() ||
+       m_storage->NbFaces() != aMesh->NbFaces() )
+    m_storage = new ActData_Mesh_Storage(aMesh);
+
+  return m_storage;
+}
+
+//! Marks the derived structures as outdated. They are not recomputed
+//! here, but on the next request.
+//! \param isGeometryOnly [in] indicates whether the nodes were only moved,
+//!                            so that refitting the spatial index is enough
+//!                            and the topology stays valid.
+void ActData_MeshAttr::InvalidateCaches(const Standard_Boolean isGeometryOnly)
+{
+  // Packed copy keeps the co-ordinates as well
+  m_storage.Nullify();
+
+  if ( isGeometryOnly )
+  {
+    if ( !m_bvh.IsNull() )
+      m_bBVHRefit = Standard_True;
+
+    return;
+  }
+
+  m_bvh.Nullify();
+  m_topology.Nullify();
+  m_bBVHRefit = Standard_False;
+}
+
 //-----------------------------------------------------------------------------
 // Manipulations with mesh
 //-----------------------------------------------------------------------------
@@ -394,6 +593,7 @@ Standard_Integer ActData_MeshAttr::AddNode(const Standard_Real X,
 
   // Add node to Mesh DS
   Standard_Integer aResID = m_mesh->AddNode(X, Y, Z);
+  this->InvalidateCaches();
 
   MDELTA_ADDED_NODE(aResID, X, Y, Z); // Deltalize modification
 
@@ -417,29 +617,104 @@ Standard_Boolean ActData_MeshAttr::AddNodeWithID(const Standard_Real X,
 
   // Add node to Mesh DS
   Standard_Boolean aRes = m_mesh->AddNodeWithID(X, Y, Z, ID);
+  this->InvalidateCaches();
 
   MDELTA_ADDED_NODE(ID, X, Y, Z); // Deltalize modification
 
   return aRes;
 }
 
+//! Creates mesh nodes in bulk. The nodes get consecutive IDs.
+//! \param Coords  [in] X, Y, Z co-ordinates of each node.
+//! \param NbNodes [in] number of nodes.
+//! \return ID of the first node.
+Standard_Integer ActData_MeshAttr::AddNodes(const Standard_Real*   Coords,
+                                            const Standard_Integer NbNodes)
+{
+  // Check pre-conditions
+  this->assertModificationAllowed();
+
+  // Add nodes to Mesh DS
+  const Standard_Integer aFirstID = m_mesh->AddNodes(Coords, NbNodes);
+  this->InvalidateCaches();
+
+  // Deltalize modification
+  for ( Standard_Integer i = 0; i < NbNodes; ++i )
+  {
+    MDELTA_ADDED_NODE(aFirstID + i, Coords[3*i], Coords[3*i + 1], Coords[3*i + 2]);
+  }
+
+  return aFirstID;
+}
+
 //! Removes mesh node with the given ID.
 //! \param ID [in] ID of the mesh node to remove.
 //! \return true in case of success, false -- otherwise.
 Standard_Boolean ActData_MeshAttr::RemoveNode(const Standard_Integer ID)
 {
+  // Keep the co-ordinates of the node to restore it on Undo
+  Handle(ActData_Mesh_Node) aNode = this->GetMesh()->FindNode(ID);
+  if ( aNode.IsNull() )
+    return Standard_False;
+
+  const gp_Pnt aPnt = aNode->Pnt();
+
   // Attempt to remove the mesh node
   Standard_Boolean isOk = m_mesh->RemoveNode(ID);
 
   // Deltalize removal if it has been done successfully
   if ( isOk )
   {
-    MDELTA_REMOVED_NODE(ID);
+    this->InvalidateCaches();
+    MDELTA_REMOVED_NODE( ID, aPnt.X(), aPnt.Y(), aPnt.Z() );
   }
 
   return isOk;
 }
 
+//! Moves the mesh nodes with the given IDs to the new positions. This is
+//! the batched deformation (morphing, smoothing, applying displacements)
+//! which keeps the connectivity and IDs, so only the moved nodes go to
+//! the Modification Delta. Nothing is moved if any of the IDs is unknown.
+//! \param IDs     [in] IDs of the nodes to move.
+//! \param Coords  [in] new X, Y, Z co-ordinates of each node.
+//! \param NbNodes [in] number of nodes.
+//! \return true in case of success, false -- otherwise.
+Standard_Boolean ActData_MeshAttr::SetNodeCoords(const Standard_Integer* IDs,
+                                                 const Standard_Real*    Coords,
+                                                 const Standard_Integer  NbNodes)
+{
+  // Check pre-conditions
+  this->assertModificationAllowed();
+
+  // Resolve all nodes before moving any
+  std::vector<Handle(ActData_Mesh_Node)> aNodes(NbNodes);
+  for ( Standard_Integer i = 0; i < NbNodes; ++i )
+  {
+    aNodes[i] = m_mesh->FindNode(IDs[i]);
+    if ( aNodes[i].IsNull() )
+      return Standard_False;
+  }
+
+  for ( Standard_Integer i = 0; i < NbNodes; ++i )
+  {
+    const gp_Pnt anOld = aNodes[i]->Pnt();
+    const gp_Pnt aNew(Coords[3*i], Coords[3*i + 1], Coords[3*i + 2]);
+
+    // Nodes staying in place are not recorded
+    if ( anOld.X() == aNew.X() && anOld.Y() == aNew.Y() && anOld.Z() == aNew.Z() )
+      continue;
+
+    // Deltalize modification
+    MDELTA_MOVED_NODE(IDs[i], anOld, aNew);
+
+    aNodes[i]->SetPnt(aNew, Standard_True);
+    this->InvalidateCaches(Standard_True);
+  }
+
+  return Standard_True;
+}
+
 //! Creates new mesh element by the given mesh nodes.
 //! \param Nodes [in] collection of nodal IDs comprising the mesh element.
 //! \param NbNodes [in] number of Nodes.
@@ -452,6 +727,7 @@ Standard_Integer ActData_MeshAttr::AddElement(Standard_Address Nodes,
 
   // Add element to the underlying Mesh DS
   Standard_Integer aResID = m_mesh->AddFace(Nodes, NbNodes);
+  this->InvalidateCaches();
   
   // Deltalize modification
   if ( NbNodes == 3 )
@@ -484,6 +760,7 @@ Standard_Boolean
 
   // Add element to the underlying Mesh DS
   Standard_Boolean aRes = m_mesh->AddFaceWithID(Nodes, NbNodes, ID);
+  this->InvalidateCaches();
   
   // Deltalize modification
   if ( NbNodes == 3 )
@@ -500,27 +777,76 @@ Standard_Boolean
   return aRes;
 }
 
+//! Creates mesh elements of the same number of nodes in bulk. The elements
+//! get consecutive IDs. Elements referring to missing nodes or duplicating
+//! the existing ones are skipped, and their IDs remain free.
+//! \param Nodes             [in] nodal IDs of each element.
+//! \param NbElements        [in] number of elements.
+//! \param NbNodesPerElement [in] number of nodes in each element (3 or 4).
+//! \return ID of the first element.
+Standard_Integer
+  ActData_MeshAttr::AddElements(const Standard_Integer* Nodes,
+                                const Standard_Integer  NbElements,
+                                const Standard_Integer  NbNodesPerElement)
+{
+  // Check pre-conditions
+  this->assertModificationAllowed();
+
+  if ( NbNodesPerElement != 3 && NbNodesPerElement != 4 )
+    Standard_ProgramError::Raise("Unexpected number of nodes for delta");
+
+  // Add elements to the underlying Mesh DS
+  const Standard_Integer aFirstID = m_mesh->AddFaces(Nodes, NbElements, NbNodesPerElement);
+  this->InvalidateCaches();
+
+  // Deltalize modification
+  for ( Standard_Integer i = 0; i < NbElements; ++i )
+  {
+    const Standard_Integer ID = aFirstID + i;
+    if ( m_mesh->FindElement(ID).IsNull() )
+      continue; // Skipped
+
+    Standard_Address aNodes = (Standard_Address) (Nodes + NbNodesPerElement*i);
+    if ( NbNodesPerElement == 3 )
+    {
+      MDELTA_ADDED_TRI(ID, aNodes);
+    }
+    else
+    {
+      MDELTA_ADDED_QUAD(ID, aNodes);
+    }
+  }
+
+  return aFirstID;
+}
+
 //! Removes mesh element with the given ID.
 //! \param ID [in] ID of the mesh element to remove.
 //! \return true in case of success, false -- otherwise.
 Standard_Boolean ActData_MeshAttr::RemoveElement(const Standard_Integer ID)
 {
   // Check if the requested element exists in Mesh DS
-  Handle(ActData_Mesh_Element) anElem = m_mesh->FindElement(ID);
+  Handle(ActData_Mesh_Element) anElem = this->GetMesh()->FindElement(ID);
   if ( anElem.IsNull() )
     return Standard_False;
 
+  // Keep the nodes of the element to restore it on Undo
+  Standard_Integer aNodes[4] = {0, 0, 0, 0};
+  for ( Standard_Integer r = 1; r <= anElem->NbNodes() && r <= 4; ++r )
+    aNodes[r - 1] = anElem->GetConnection(r);
+
   // Remove element
   m_mesh->RemoveElement(anElem);
+  this->InvalidateCaches();
 
   // Deltalize removal
   if ( anElem->IsInstance( STANDARD_TYPE(ActData_Mesh_Triangle) ) )
   {
-    MDELTA_REMOVED_TRI(ID);
+    MDELTA_REMOVED_TRI(ID, aNodes);
   }
   else if ( anElem->IsInstance( STANDARD_TYPE(ActData_Mesh_Quadrangle) ) )
   {
-    MDELTA_REMOVED_QUAD(ID);
+    MDELTA_REMOVED_QUAD(ID, aNodes);
   }
   else
     Standard_ProgramError::Raise("Unexpected type of element for delta");
@@ -528,6 +854,30 @@ Standard_Boolean ActData_MeshAttr::RemoveElement(const Standard_Integer ID)
   return Standard_True;
 }
 
+//! Renumbers the mesh nodes and elements to the dense ranges starting from
+//! 1 (see ActData_Mesh::Compacted()). The compacted Mesh DS replaces the
+//! stored one, so that Undo brings the original IDs back. Nothing is done
+//! if there are no free IDs.
+//! \param NodeMap [out] old-to-new node IDs (empty if nothing is done).
+//! \param ElemMap [out] old-to-new element IDs (empty if nothing is done).
+//! \return true if the IDs were changed, false -- otherwise.
+Standard_Boolean ActData_MeshAttr::Compact(TColStd_DataMapOfIntegerInteger& NodeMap,
+                                           TColStd_DataMapOfIntegerInteger& ElemMap)
+{
+  // Check pre-conditions
+  this->assertModificationAllowed();
+
+  if ( m_mesh->IsCompact() )
+  {
+    NodeMap.Clear();
+    ElemMap.Clear();
+    return Standard_False;
+  }
+
+  this->SetMesh( m_mesh->Compacted(NodeMap, ElemMap) );
+  return Standard_True;
+}
+
 //-----------------------------------------------------------------------------
 // Internal kernel methods
 //-----------------------------------------------------------------------------
@@ -539,6 +889,6 @@ void ActData_MeshAttr::assertModificationAllowed()
   if ( !Label().Data()->IsModificationAllowed() )
     Standard_ImmutableObject::Raise("ActData_MeshAttr changed outside transaction");
 
-  if ( m_mesh.IsNull() )
+  if ( this->GetMesh().IsNull() )
     Standard_ProgramError::Raise("Mesh DS is NULL");
 }
@@ -35,7 +35,10 @@
 
 // Active Data includes
 #include <ActData_Common.h>
+#include <ActData_MeshBVH.h>
 #include <ActData_MeshMDelta.h>
+#include <ActData_MeshPayload.h>
+#include <ActData_MeshTopology.h>
 
 // OCCT includes
 #include <TDF_Attribute.hxx>
@@ -43,6 +46,7 @@
 
 // Mesh includes
 #include <ActData_Mesh.h>
+#include <ActData_Mesh_Storage.h>
 
 DEFINE_STANDARD_HANDLE(ActData_MeshAttr, TDF_Attribute)
 
@@ -109,6 +113,13 @@ public:
   ActData_EXPORT void
     DeltaModeOff();
 
+  ActData_EXPORT void
+    SetCompressionTolerance(const Standard_Real Tolerance,
+                            const Standard_Boolean doDelta = Standard_True);
+
+  ActData_EXPORT Standard_Real
+    GetCompressionTolerance() const;
+
 // Accessors for domain-specific data:
 public:
 
@@ -122,6 +133,33 @@ public:
   ActData_EXPORT Handle(ActData_Mesh)&
     GetMesh();
 
+// External payload:
+public:
+
+  ActData_EXPORT void
+    SetPayload(const Handle(ActData_MeshPayload)& Payload);
+
+  ActData_EXPORT const Handle(ActData_MeshPayload)&
+    GetPayload() const;
+
+  ActData_EXPORT Standard_Boolean
+    IsMaterialized() const;
+
+// Derived structures:
+public:
+
+  ActData_EXPORT const Handle(ActData_MeshBVH)&
+    GetBVH();
+
+  ActData_EXPORT const Handle(ActData_MeshTopology)&
+    GetTopology();
+
+  ActData_EXPORT const Handle(ActData_Mesh_Storage)&
+    GetStorage();
+
+  ActData_EXPORT void
+    InvalidateCaches(const Standard_Boolean isGeometryOnly = Standard_False);
+
 // Manipulations with mesh:
 public:
 
@@ -134,9 +172,17 @@ public:
                   const Standard_Real Z,
                   const Standard_Integer ID);
 
+  ActData_EXPORT Standard_Integer
+    AddNodes(const Standard_Real* Coords, const Standard_Integer NbNodes);
+
   ActData_EXPORT Standard_Boolean
     RemoveNode(const Standard_Integer ID);
 
+  ActData_EXPORT Standard_Boolean
+    SetNodeCoords(const Standard_Integer* IDs,
+                  const Standard_Real*    Coords,
+                  const Standard_Integer  NbNodes);
+
   ActData_EXPORT Standard_Integer
     AddElement(Standard_Address Nodes, const Standard_Integer NbNodes);
 
@@ -145,9 +191,18 @@ public:
                      const Standard_Integer NbNodes,
                      const Standard_Integer ID);
 
+  ActData_EXPORT Standard_Integer
+    AddElements(const Standard_Integer* Nodes,
+                const Standard_Integer NbElements,
+                const Standard_Integer NbNodesPerElement);
+
   ActData_EXPORT Standard_Boolean
     RemoveElement(const Standard_Integer ID);
 
+  ActData_EXPORT Standard_Boolean
+    Compact(TColStd_DataMapOfIntegerInteger& NodeMap,
+            TColStd_DataMapOfIntegerInteger& ElemMap);
+
 // Internal kernel methods:
 private:
 
@@ -159,6 +214,10 @@ private:
   //! Stored Mesh DS.
   Handle(ActData_Mesh) m_mesh;
 
+  //! External payload the Mesh DS is restored from on first access. It is
+  //! released once the Mesh DS is materialized.
+  Handle(ActData_MeshPayload) m_payload;
+
   //! Transient Modification Delta being passed from the beginning
   //! of each transaction (it is empty in the beginning) till its
   //! end (it is populated with Modification Requests at the end).
@@ -167,6 +226,23 @@ private:
   //! Indicates whether DELTALIZATION is enabled or not.
   Standard_Boolean m_bDeltaEnabled;
 
+  //! Tolerance of the lossy compression applied on storing the Mesh DS
+  //! (zero if the mesh is stored as is).
+  Standard_Real m_fCompressionTol;
+
+  //! Spatial index over the Mesh DS built on first request.
+  Handle(ActData_MeshBVH) m_bvh;
+
+  //! Indicates whether the nodes were moved since the spatial index was
+  //! built or refitted last time.
+  Standard_Boolean m_bBVHRefit;
+
+  //! Edge topology of the Mesh DS built on first request.
+  Handle(ActData_MeshTopology) m_topology;
+
+  //! Packed copy of the Mesh DS built on first request.
+  Handle(ActData_Mesh_Storage) m_storage;
+
 };
 
 #endif
@@ -0,0 +1,927 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <ActData_MeshBVH.h>
+
+// Mesh includes
+#include <ActData_Mesh_ElementsIterator.h>
+
+// OCCT includes
+#include <NCollection_DataMap.hxx>
+
+// STL includes
+#include <algorithm>
+#include <cmath>
+
+#undef COUT_DEBUG
+
+namespace
+{
+  //! Maximal number of primitives in a leaf.
+  const Standard_Integer LeafSize = 4;
+
+  //! Compares primitives by their centers along the given axis.
+  struct CenterLess
+  {
+    CenterLess(const std::vector<Standard_Real>& centers, const Standard_Integer axis)
+    : Centers(centers), Axis(axis) {}
+
+    bool operator()(const Standard_Integer a, const Standard_Integer b) const
+    {
+      return Centers[3*a + Axis] < Centers[3*b + Axis];
+    }
+
+    const std::vector<Standard_Real>& Centers;
+    Standard_Integer                  Axis;
+  };
+
+  inline Standard_Real dot(const Standard_Real* a, const Standard_Real* b)
+  {
+    return a[0]*b[0] + a[1]*b[1] + a[2]*b[2];
+  }
+
+  inline void sub(const Standard_Real* a, const Standard_Real* b, Standard_Real* r)
+  {
+    r[0] = a[0] - b[0]; r[1] = a[1] - b[1]; r[2] = a[2] - b[2];
+  }
+
+  inline void cross(const Standard_Real* a, const Standard_Real* b, Standard_Real* r)
+  {
+    r[0] = a[1]*b[2] - a[2]*b[1];
+    r[1] = a[2]*b[0] - a[0]*b[2];
+    r[2] = a[0]*b[1] - a[1]*b[0];
+  }
+
+  inline Standard_Real sqDist(const Standard_Real* a, const Standard_Real* b)
+  {
+    Standard_Real d[3];
+    sub(a, b, d);
+    return dot(d, d);
+  }
+
+  //! Makes the box of the hierarchy node empty.
+  inline void resetBox(ActData_MeshBVH::t_node& node)
+  {
+    for ( Standard_Integer k = 0; k < 3; ++k )
+    {
+      node.Min[k] =  RealLast();
+      node.Max[k] = -RealLast();
+    }
+  }
+
+  //! Enlarges the box of the hierarchy node to contain the point.
+  inline void addPoint(ActData_MeshBVH::t_node& node, const Standard_Real* p)
+  {
+    for ( Standard_Integer k = 0; k < 3; ++k )
+    {
+      if ( p[k] < node.Min[k] ) node.Min[k] = p[k];
+      if ( p[k] > node.Max[k] ) node.Max[k] = p[k];
+    }
+  }
+
+  //! Sets the box of the inner node to the union of its children.
+  inline void uniteChildren(std::vector<ActData_MeshBVH::t_node>& nodes,
+                            ActData_MeshBVH::t_node&              node)
+  {
+    const ActData_MeshBVH::t_node& a = nodes[node.Child];
+    const ActData_MeshBVH::t_node& b = nodes[node.Child + 1];
+    for ( Standard_Integer k = 0; k < 3; ++k )
+    {
+      node.Min[k] = std::min(a.Min[k], b.Min[k]);
+      node.Max[k] = std::max(a.Max[k], b.Max[k]);
+    }
+  }
+
+  //! \return squared distance from the point to the box of the node.
+  inline Standard_Real sqDistToBox(const Standard_Real* p, const ActData_MeshBVH::t_node& node)
+  {
+    Standard_Real d = 0.0;
+    for ( Standard_Integer k = 0; k < 3; ++k )
+    {
+      if ( p[k] < node.Min[k] )
+        d += (node.Min[k] - p[k])*(node.Min[k] - p[k]);
+      else if ( p[k] > node.Max[k] )
+        d += (p[k] - node.Max[k])*(p[k] - node.Max[k]);
+    }
+    return d;
+  }
+
+  //! \return true if the box of the node overlaps the given box.
+  inline bool overlaps(const ActData_MeshBVH::t_node& node,
+                       const Standard_Real*           bmin,
+                       const Standard_Real*           bmax)
+  {
+    for ( Standard_Integer k = 0; k < 3; ++k )
+      if ( node.Max[k] < bmin[k] || node.Min[k] > bmax[k] )
+        return false;
+    return true;
+  }
+
+  //! Slab test of the ray against the box of the node within [0, tmax].
+  inline bool rayHitsBox(const Standard_Real*           o,
+                         const Standard_Real*           invD,
+                         const ActData_MeshBVH::t_node& node,
+                         const Standard_Real            tmax)
+  {
+    Standard_Real t0 = 0.0, t1 = tmax;
+    for ( Standard_Integer k = 0; k < 3; ++k )
+    {
+      Standard_Real tn = (node.Min[k] - o[k])*invD[k];
+      Standard_Real tf = (node.Max[k] - o[k])*invD[k];
+      if ( tn > tf )
+        std::swap(tn, tf);
+
+      t0 = std::max(t0, tn);
+      t1 = std::min(t1, tf);
+      if ( t0 > t1 )
+        return false;
+    }
+    return true;
+  }
+
+  //! Moller-Trumbore intersection of the ray with the triangle.
+  bool rayHitsTriangle(const Standard_Real* o,
+                       const Standard_Real* d,
+                       const Standard_Real* a,
+                       const Standard_Real* b,
+                       const Standard_Real* c,
+                       Standard_Real&       t)
+  {
+    Standard_Real e1[3], e2[3], p[3], s[3], q[3];
+    sub(b, a, e1);
+    sub(c, a, e2);
+    cross(d, e2, p);
+
+    const Standard_Real det = dot(e1, p);
+    if ( det == 0.0 )
+      return false;
+
+    const Standard_Real invDet = 1.0 / det;
+    sub(o, a, s);
+
+    const Standard_Real u = dot(s, p)*invDet;
+    if ( u < 0.0 || u > 1.0 )
+      return false;
+
+    cross(s, e1, q);
+    const Standard_Real v = dot(d, q)*invDet;
+    if ( v < 0.0 || u + v > 1.0 )
+      return false;
+
+    t = dot(e2, q)*invDet;
+    return t >= 0.0;
+  }
+
+  //! Closest point of the triangle to the given point (see C. Ericson,
+  //! Real-Time Collision Detection, 5.1.5).
+  void closestOnTriangle(const Standard_Real* p,
+                         const Standard_Real* a,
+                         const Standard_Real* b,
+                         const Standard_Real* c,
+                         Standard_Real*       r)
+  {
+    Standard_Real ab[3], ac[3], ap[3], bp[3], cp[3];
+    sub(b, a, ab);
+    sub(c, a, ac);
+    sub(p, a, ap);
+
+    const Standard_Real d1 = dot(ab, ap), d2 = dot(ac, ap);
+    if ( d1 <= 0.0 && d2 <= 0.0 )
+    {
+      r[0] = a[0]; r[1] = a[1]; r[2] = a[2];
+      return;
+    }
+
+    sub(p, b, bp);
+    const Standard_Real d3 = dot(ab, bp), d4 = dot(ac, bp);
+    if ( d3 >= 0.0 && d4 <= d3 )
+    {
+      r[0] = b[0]; r[1] = b[1]; r[2] = b[2];
+      return;
+    }
+
+    const Standard_Real vc = d1*d4 - d3*d2;
+    if ( vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0 )
+    {
+      const Standard_Real v = d1 / (d1 - d3);
+      for ( Standard_Integer k = 0; k < 3; ++k ) r[k] = a[k] + v*ab[k];
+      return;
+    }
+
+    sub(p, c, cp);
+    const Standard_Real d5 = dot(ab, cp), d6 = dot(ac, cp);
+    if ( d6 >= 0.0 && d5 <= d6 )
+    {
+      r[0] = c[0]; r[1] = c[1]; r[2] = c[2];
+      return;
+    }
+
+    const Standard_Real vb = d5*d2 - d1*d6;
+    if ( vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0 )
+    {
+      const Standard_Real w = d2 / (d2 - d6);
+      for ( Standard_Integer k = 0; k < 3; ++k ) r[k] = a[k] + w*ac[k];
+      return;
+    }
+
+    const Standard_Real va = d3*d6 - d5*d4;
+    if ( va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0 )
+    {
+      const Standard_Real w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+      for ( Standard_Integer k = 0; k < 3; ++k ) r[k] = b[k] + w*(c[k] - b[k]);
+      return;
+    }
+
+    const Standard_Real denom = 1.0 / (va + vb + vc);
+    const Standard_Real v     = vb*denom;
+    const Standard_Real w     = vc*denom;
+    for ( Standard_Integer k = 0; k < 3; ++k ) r[k] = a[k] + ab[k]*v + ac[k]*w;
+  }
+
+  //! \return true if the axis separates the triangle (given relative to
+  //!         the box center) from the box of the given half-sizes.
+  inline bool separates(const Standard_Real  v[3][3],
+                        const Standard_Real* h,
+                        const Standard_Real* axis)
+  {
+    const Standard_Real p0 = dot(v[0], axis), p1 = dot(v[1], axis), p2 = dot(v[2], axis);
+    const Standard_Real r  = h[0]*std::fabs(axis[0]) + h[1]*std::fabs(axis[1]) + h[2]*std::fabs(axis[2]);
+    return std::min(p0, std::min(p1, p2)) > r || std::max(p0, std::max(p1, p2)) < -r;
+  }
+
+  //! Separating axis test of the triangle against the box.
+  bool triangleOverlapsBox(const Standard_Real* center,
+                           const Standard_Real* h,
+                           const Standard_Real* a,
+                           const Standard_Real* b,
+                           const Standard_Real* c)
+  {
+    Standard_Real v[3][3], e[3][3], axis[3];
+    sub(a, center, v[0]);
+    sub(b, center, v[1]);
+    sub(c, center, v[2]);
+    sub(v[1], v[0], e[0]);
+    sub(v[2], v[1], e[1]);
+    sub(v[0], v[2], e[2]);
+
+    // Normals of the box
+    for ( Standard_Integer k = 0; k < 3; ++k )
+    {
+      axis[0] = axis[1] = axis[2] = 0.0;
+      axis[k] = 1.0;
+      if ( separates(v, h, axis) )
+        return false;
+    }
+
+    // Normal of the triangle
+    cross(e[0], e[1], axis);
+    if ( separates(v, h, axis) )
+      return false;
+
+    // Edges of the triangle crossed with the box normals
+    for ( Standard_Integer i = 0; i < 3; ++i )
+      for ( Standard_Integer k = 0; k < 3; ++k )
+      {
+        Standard_Real n[3] = {0.0, 0.0, 0.0};
+        n[k] = 1.0;
+        cross(e[i], n, axis);
+        if ( separates(v, h, axis) )
+          return false;
+      }
+
+    return true;
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Construction
+//-----------------------------------------------------------------------------
+
+//! Builds the hierarchies for the passed mesh. Only triangles and
+//! quadrangles are indexed as faces.
+//! \param Mesh [in] Mesh DS to index.
+ActData_MeshBVH::ActData_MeshBVH(const Handle(ActData_Mesh)& Mesh)
+: Standard_Transient (),
+  m_pMesh            ( Mesh.get() ),
+  m_iNbMeshNodes     ( Mesh->NbNodes() ),
+  m_iNbMeshFaces     ( Mesh->NbFaces() )
+{
+  /* ========================
+   *  Gather nodes and faces
+   * ======================== */
+
+  m_nodes.reserve(m_iNbMeshNodes);
+  m_nodeIDs.reserve(m_iNbMeshNodes);
+  m_coords.reserve(3*m_iNbMeshNodes);
+
+  NCollection_DataMap<Standard_Integer, Standard_Integer> anIndexByID;
+
+  ActData_Mesh_ElementsIterator aNodesIt(Mesh, ActData_Mesh_ET_Node);
+  for ( ; aNodesIt.More(); aNodesIt.Next() )
+  {
+    Handle(ActData_Mesh_Node) aNode = Handle(ActData_Mesh_Node)::DownCast( aNodesIt.GetValue() );
+
+    anIndexByID.Bind( aNode->GetID(), (Standard_Integer) m_nodes.size() );
+    m_nodes.push_back(aNode);
+    m_nodeIDs.push_back( aNode->GetID() );
+    m_coords.push_back( aNode->X() );
+    m_coords.push_back( aNode->Y() );
+    m_coords.push_back( aNode->Z() );
+  }
+
+  m_faceIDs.reserve(m_iNbMeshFaces);
+  m_faceNodes.reserve(4*m_iNbMeshFaces);
+
+  ActData_Mesh_ElementsIterator aFacesIt(Mesh, ActData_Mesh_ET_Face);
+  for ( ; aFacesIt.More(); aFacesIt.Next() )
+  {
+    const Handle(ActData_Mesh_Element)& aFace = aFacesIt.GetValue();
+
+    const Standard_Integer aNbNodes = aFace->NbNodes();
+    if ( aNbNodes != 3 && aNbNodes != 4 )
+      continue;
+
+    Standard_Integer aNodes[4] = {-1, -1, -1, -1};
+    Standard_Boolean isOk      = Standard_True;
+    for ( Standard_Integer k = 0; k < aNbNodes && isOk; ++k )
+    {
+      const Standard_Integer* pIndex = anIndexByID.Seek( aFace->GetConnection(k + 1) );
+      if ( pIndex )
+        aNodes[k] = *pIndex;
+      else
+        isOk = Standard_False;
+    }
+
+    if ( !isOk )
+      continue;
+
+    m_faceIDs.push_back( aFace->GetID() );
+    m_faceNodes.insert(m_faceNodes.end(), aNodes, aNodes + 4);
+  }
+
+  /* ========================
+   *  Build the hierarchies
+   * ======================== */
+
+  this->build(m_nodeTree, m_coords, this->NbNodes());
+
+  std::vector<Standard_Real> aCenters( 3*this->NbFaces() );
+  for ( Standard_Integer f = 0; f < this->NbFaces(); ++f )
+  {
+    const Standard_Integer nbc = this->nbCorners(f);
+    for ( Standard_Integer k = 0; k < 3; ++k )
+    {
+      Standard_Real c = 0.0;
+      for ( Standard_Integer j = 0; j < nbc; ++j )
+        c += this->corner(f, j)[k];
+
+      aCenters[3*f + k] = c / nbc;
+    }
+  }
+  this->build(m_faceTree, aCenters, this->NbFaces());
+
+  this->refitNodeTree();
+  this->refitFaceTree();
+}
+
+//-----------------------------------------------------------------------------
+// Maintenance
+//-----------------------------------------------------------------------------
+
+//! Takes the current positions of the nodes from the Mesh DS and updates
+//! the bounding boxes bottom-up. The structure of the hierarchies is kept,
+//! so this is linear in the size of the mesh. It is valid only if nodes
+//! were moved, and neither added nor removed.
+void ActData_MeshBVH::Refit()
+{
+  for ( Standard_Size i = 0; i < m_nodes.size(); ++i )
+  {
+    const gp_Pnt& aPnt = m_nodes[i]->Pnt();
+    m_coords[3*i]     = aPnt.X();
+    m_coords[3*i + 1] = aPnt.Y();
+    m_coords[3*i + 2] = aPnt.Z();
+  }
+
+  this->refitNodeTree();
+  this->refitFaceTree();
+}
+
+//! Checks whether the hierarchies were built for the passed Mesh DS and
+//! the numbers of its nodes and faces have not changed since then.
+//! \param Mesh [in] Mesh DS to check.
+//! \return true if the hierarchies can be used (possibly after refitting).
+Standard_Boolean ActData_MeshBVH::IsConsistent(const Handle(ActData_Mesh)& Mesh) const
+{
+  return Mesh.get() == m_pMesh &&
+         Mesh->NbNodes() == m_iNbMeshNodes &&
+         Mesh->NbFaces() == m_iNbMeshFaces;
+}
+
+//-----------------------------------------------------------------------------
+// Queries
+//-----------------------------------------------------------------------------
+
+//! Finds the node closest to the given point.
+//! \param P        [in]  point.
+//! \param Distance [out] distance to the found node.
+//! \return ID of the found node or zero if there are no nodes.
+Standard_Integer ActData_MeshBVH::NearestNode(const gp_Pnt&  P,
+                                              Standard_Real& Distance) const
+{
+  Distance = RealLast();
+  if ( m_nodeTree.Nodes.empty() )
+    return 0;
+
+  const Standard_Real p[3] = { P.X(), P.Y(), P.Z() };
+
+  Standard_Real    aBestSq = RealLast();
+  Standard_Integer aBest   = -1;
+
+  std::vector<Standard_Integer> aStack(1, 0);
+  while ( !aStack.empty() )
+  {
+    const t_node& aNode = m_nodeTree.Nodes[aStack.back()];
+    aStack.pop_back();
+
+    if ( sqDistToBox(p, aNode) >= aBestSq )
+      continue;
+
+    if ( aNode.Count )
+    {
+      for ( Standard_Integer i = aNode.First; i < aNode.First + aNode.Count; ++i )
+      {
+        const Standard_Integer n  = m_nodeTree.Prims[i];
+        const Standard_Real    d2 = sqDist(p, &m_coords[3*n]);
+        if ( d2 < aBestSq )
+        {
+          aBestSq = d2;
+          aBest   = n;
+        }
+      }
+      continue;
+    }
+
+    // The nearer child goes on top of the stack
+    const Standard_Real d0 = sqDistToBox(p, m_nodeTree.Nodes[aNode.Child]);
+    const Standard_Real d1 = sqDistToBox(p, m_nodeTree.Nodes[aNode.Child + 1]);
+    aStack.push_back( d0 < d1 ? aNode.Child + 1 : aNode.Child );
+    aStack.push_back( d0 < d1 ? aNode.Child : aNode.Child + 1 );
+  }
+
+  Distance = std::sqrt(aBestSq);
+  return m_nodeIDs[aBest];
+}
+
+//! Finds the point on the faces closest to the given point.
+//! \param P       [in]  point.
+//! \param Closest [out] found point.
+//! \return ID of the face containing the found point or zero if there
+//!         are no faces.
+Standard_Integer ActData_MeshBVH::NearestPoint(const gp_Pnt& P,
+                                               gp_Pnt&       Closest) const
+{
+  if ( m_faceTree.Nodes.empty() )
+    return 0;
+
+  const Standard_Real p[3] = { P.X(), P.Y(), P.Z() };
+
+  Standard_Real    aBestSq = RealLast();
+  Standard_Integer aBest   = -1;
+  Standard_Real    aBestPnt[3] = {0.0, 0.0, 0.0};
+
+  std::vector<Standard_Integer> aStack(1, 0);
+  while ( !aStack.empty() )
+  {
+    const t_node& aNode = m_faceTree.Nodes[aStack.back()];
+    aStack.pop_back();
+
+    if ( sqDistToBox(p, aNode) >= aBestSq )
+      continue;
+
+    if ( aNode.Count )
+    {
+      for ( Standard_Integer i = aNode.First; i < aNode.First + aNode.Count; ++i )
+      {
+        const Standard_Integer f = m_faceTree.Prims[i];
+
+        // Quadrangle is split by its first diagonal
+        for ( Standard_Integer j = 2; j < this->nbCorners(f); ++j )
+        {
+          Standard_Real r[3];
+          closestOnTriangle(p, this->corner(f, 0), this->corner(f, j - 1), this->corner(f, j), r);
+
+          const Standard_Real d2 = sqDist(p, r);
+          if ( d2 < aBestSq )
+          {
+            aBestSq = d2;
+            aBest   = f;
+            aBestPnt[0] = r[0]; aBestPnt[1] = r[1]; aBestPnt[2] = r[2];
+          }
+        }
+      }
+      continue;
+    }
+
+    const Standard_Real d0 = sqDistToBox(p, m_faceTree.Nodes[aNode.Child]);
+    const Standard_Real d1 = sqDistToBox(p, m_faceTree.Nodes[aNode.Child + 1]);
+    aStack.push_back( d0 < d1 ? aNode.Child + 1 : aNode.Child );
+    aStack.push_back( d0 < d1 ? aNode.Child : aNode.Child + 1 );
+  }
+
+  Closest.SetCoord(aBestPnt[0], aBestPnt[1], aBestPnt[2]);
+  return m_faceIDs[aBest];
+}
+
+//! Finds the first intersection of the ray with the faces.
+//! \param Ray   [in]  ray to cast.
+//! \param Param [out] distance from the origin of the ray to the hit.
+//! \return ID of the hit face or zero if nothing is hit.
+Standard_Integer ActData_MeshBVH::Intersect(const gp_Ax1&  Ray,
+                                            Standard_Real& Param) const
+{
+  Param = RealLast();
+  if ( m_faceTree.Nodes.empty() )
+    return 0;
+
+  const Standard_Real o[3]    = { Ray.Location().X(), Ray.Location().Y(), Ray.Location().Z() };
+  const Standard_Real d[3]    = { Ray.Direction().X(), Ray.Direction().Y(), Ray.Direction().Z() };
+  const Standard_Real invD[3] = { 1.0 / d[0], 1.0 / d[1], 1.0 / d[2] };
+
+  Standard_Integer aBest = -1;
+
+  std::vector<Standard_Integer> aStack(1, 0);
+  while ( !aStack.empty() )
+  {
+    const t_node& aNode = m_faceTree.Nodes[aStack.back()];
+    aStack.pop_back();
+
+    if ( !rayHitsBox(o, invD, aNode, Param) )
+      continue;
+
+    if ( aNode.Count )
+    {
+      for ( Standard_Integer i = aNode.First; i < aNode.First + aNode.Count; ++i )
+      {
+        const Standard_Integer f = m_faceTree.Prims[i];
+        for ( Standard_Integer j = 2; j < this->nbCorners(f); ++j )
+        {
+          Standard_Real t;
+          if ( rayHitsTriangle(o, d, this->corner(f, 0), this->corner(f, j - 1), this->corner(f, j), t) && t < Param )
+          {
+            Param = t;
+            aBest = f;
+          }
+        }
+      }
+      continue;
+    }
+
+    aStack.push_back(aNode.Child);
+    aStack.push_back(aNode.Child + 1);
+  }
+
+  return aBest < 0 ? 0 : m_faceIDs[aBest];
+}
+
+//! Collects the nodes lying in the given box.
+//! \param Box [in]  box.
+//! \param IDs [out] IDs of the found nodes.
+void ActData_MeshBVH::NodesInBox(const Bnd_Box&              Box,
+                                 TColStd_PackedMapOfInteger& IDs) const
+{
+  IDs.Clear();
+  if ( Box.IsVoid() || m_nodeTree.Nodes.empty() )
+    return;
+
+  Standard_Real bmin[3], bmax[3];
+  Box.Get(bmin[0], bmin[1], bmin[2], bmax[0], bmax[1], bmax[2]);
+
+  std::vector<Standard_Integer> aStack(1, 0);
+  while ( !aStack.empty() )
+  {
+    const t_node& aNode = m_nodeTree.Nodes[aStack.back()];
+    aStack.pop_back();
+
+    if ( !overlaps(aNode, bmin, bmax) )
+      continue;
+
+    if ( aNode.Count )
+    {
+      for ( Standard_Integer i = aNode.First; i < aNode.First + aNode.Count; ++i )
+      {
+        const Standard_Integer n = m_nodeTree.Prims[i];
+        const Standard_Real*   p = &m_coords[3*n];
+        if ( p[0] >= bmin[0] && p[0] <= bmax[0] &&
+             p[1] >= bmin[1] && p[1] <= bmax[1] &&
+             p[2] >= bmin[2] && p[2] <= bmax[2] )
+          IDs.Add(m_nodeIDs[n]);
+      }
+      continue;
+    }
+
+    aStack.push_back(aNode.Child);
+    aStack.push_back(aNode.Child + 1);
+  }
+}
+
+//! Collects the faces touching the given box.
+//! \param Box [in]  box.
+//! \param IDs [out] IDs of the found faces.
+void ActData_MeshBVH::FacesInBox(const Bnd_Box&              Box,
+                                 TColStd_PackedMapOfInteger& IDs) const
+{
+  IDs.Clear();
+  if ( Box.IsVoid() || m_faceTree.Nodes.empty() )
+    return;
+
+  Standard_Real bmin[3], bmax[3], center[3], half[3];
+  Box.Get(bmin[0], bmin[1], bmin[2], bmax[0], bmax[1], bmax[2]);
+  for ( Standard_Integer k = 0; k < 3; ++k )
+  {
+    center[k] = 0.5*(bmin[k] + bmax[k]);
+    half[k]   = 0.5*(bmax[k] - bmin[k]);
+  }
+
+  std::vector<Standard_Integer> aStack(1, 0);
+  while ( !aStack.empty() )
+  {
+    const t_node& aNode = m_faceTree.Nodes[aStack.back()];
+    aStack.pop_back();
+
+    if ( !overlaps(aNode, bmin, bmax) )
+      continue;
+
+    if ( aNode.Count )
+    {
+      for ( Standard_Integer i = aNode.First; i < aNode.First + aNode.Count; ++i )
+      {
+        const Standard_Integer f = m_faceTree.Prims[i];
+        for ( Standard_Integer j = 2; j < this->nbCorners(f); ++j )
+          if ( triangleOverlapsBox(center, half, this->corner(f, 0), this->corner(f, j - 1), this->corner(f, j)) )
+          {
+            IDs.Add(m_faceIDs[f]);
+            break;
+          }
+      }
+      continue;
+    }
+
+    aStack.push_back(aNode.Child);
+    aStack.push_back(aNode.Child + 1);
+  }
+}
+
+//! Collects the nodes lying in the given sphere.
+//! \param Center [in]  center of the sphere.
+//! \param Radius [in]  radius of the sphere.
+//! \param IDs    [out] IDs of the found nodes.
+void ActData_MeshBVH::NodesInSphere(const gp_Pnt&               Center,
+                                    const Standard_Real         Radius,
+                                    TColStd_PackedMapOfInteger& IDs) const
+{
+  IDs.Clear();
+  if ( Radius < 0.0 || m_nodeTree.Nodes.empty() )
+    return;
+
+  const Standard_Real p[3] = { Center.X(), Center.Y(), Center.Z() };
+  const Standard_Real r2   = Radius*Radius;
+
+  std::vector<Standard_Integer> aStack(1, 0);
+  while ( !aStack.empty() )
+  {
+    const t_node& aNode = m_nodeTree.Nodes[aStack.back()];
+    aStack.pop_back();
+
+    if ( sqDistToBox(p, aNode) > r2 )
+      continue;
+
+    if ( aNode.Count )
+    {
+      for ( Standard_Integer i = aNode.First; i < aNode.First + aNode.Count; ++i )
+      {
+        const Standard_Integer n = m_nodeTree.Prims[i];
+        if ( sqDist(p, &m_coords[3*n]) <= r2 )
+          IDs.Add(m_nodeIDs[n]);
+      }
+      continue;
+    }
+
+    aStack.push_back(aNode.Child);
+    aStack.push_back(aNode.Child + 1);
+  }
+}
+
+//! Collects the faces touching the given sphere.
+//! \param Center [in]  center of the sphere.
+//! \param Radius [in]  radius of the sphere.
+//! \param IDs    [out] IDs of the found faces.
+void ActData_MeshBVH::FacesInSphere(const gp_Pnt&               Center,
+                                    const Standard_Real         Radius,
+                                    TColStd_PackedMapOfInteger& IDs) const
+{
+  IDs.Clear();
+  if ( Radius < 0.0 || m_faceTree.Nodes.empty() )
+    return;
+
+  const Standard_Real p[3] = { Center.X(), Center.Y(), Center.Z() };
+  const Standard_Real r2   = Radius*Radius;
+
+  std::vector<Standard_Integer> aStack(1, 0);
+  while ( !aStack.empty() )
+  {
+    const t_node& aNode = m_faceTree.Nodes[aStack.back()];
+    aStack.pop_back();
+
+    if ( sqDistToBox(p, aNode) > r2 )
+      continue;
+
+    if ( aNode.Count )
+    {
+      for ( Standard_Integer i = aNode.First; i < aNode.First + aNode.Count; ++i )
+      {
+        const Standard_Integer f = m_faceTree.Prims[i];
+        for ( Standard_Integer j = 2; j < this->nbCorners(f); ++j )
+        {
+          Standard_Real r[3];
+          closestOnTriangle(p, this->corner(f, 0), this->corner(f, j - 1), this->corner(f, j), r);
+          if ( sqDist(p, r) <= r2 )
+          {
+            IDs.Add(m_faceIDs[f]);
+            break;
+          }
+        }
+      }
+      continue;
+    }
+
+    aStack.push_back(aNode.Child);
+    aStack.push_back(aNode.Child + 1);
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Internal methods
+//-----------------------------------------------------------------------------
+
+//! Builds the hierarchy by splitting the primitives at the median of their
+//! centers along the longest extent until the leaves are small enough.
+//! The children are always stored after their parents. The bounding boxes
+//! are not computed here (see refitNodeTree() and refitFaceTree()).
+//! \param tree    [out] hierarchy to build.
+//! \param centers [in]  X, Y, Z of the center of each primitive.
+//! \param nbPrims [in]  number of primitives.
+void ActData_MeshBVH::build(t_tree&                           tree,
+                            const std::vector<Standard_Real>& centers,
+                            const Standard_Integer            nbPrims)
+{
+  tree.Nodes.clear();
+  tree.Prims.resize(nbPrims);
+  for ( Standard_Integer i = 0; i < nbPrims; ++i )
+    tree.Prims[i] = i;
+
+  if ( !nbPrims )
+    return;
+
+  tree.Nodes.reserve(2*(nbPrims / LeafSize) + 1);
+
+  t_node aRoot;
+  aRoot.Child = -1;
+  aRoot.First = 0;
+  aRoot.Count = nbPrims;
+  tree.Nodes.push_back(aRoot);
+
+  std::vector<Standard_Integer> aStack(1, 0);
+  while ( !aStack.empty() )
+  {
+    const Standard_Integer idx = aStack.back();
+    aStack.pop_back();
+
+    const Standard_Integer first = tree.Nodes[idx].First;
+    const Standard_Integer count = tree.Nodes[idx].Count;
+    if ( count <= LeafSize )
+      continue;
+
+    // Longest extent of the centers
+    t_node aBox;
+    resetBox(aBox);
+    for ( Standard_Integer i = first; i < first + count; ++i )
+      addPoint(aBox, &centers[3*tree.Prims[i]]);
+
+    Standard_Integer axis = 0;
+    for ( Standard_Integer k = 1; k < 3; ++k )
+      if ( aBox.Max[k] - aBox.Min[k] > aBox.Max[axis] - aBox.Min[axis] )
+        axis = k;
+
+    // Coincident centers are not split any further
+    if ( aBox.Max[axis] <= aBox.Min[axis] )
+      continue;
+
+    const Standard_Integer mid = first + count/2;
+    std::nth_element( tree.Prims.begin() + first,
+                      tree.Prims.begin() + mid,
+                      tree.Prims.begin() + first + count,
+                      CenterLess(centers, axis) );
+
+    const Standard_Integer child = (Standard_Integer) tree.Nodes.size();
+    tree.Nodes[idx].Child = child;
+    tree.Nodes[idx].Count = 0;
+
+    t_node aLeft, aRight;
+    aLeft.Child  = aRight.Child = -1;
+    aLeft.First  = first;
+    aLeft.Count  = mid - first;
+    aRight.First = mid;
+    aRight.Count = first + count - mid;
+    tree.Nodes.push_back(aLeft);
+    tree.Nodes.push_back(aRight);
+
+    aStack.push_back(child);
+    aStack.push_back(child + 1);
+  }
+}
+
+//! Updates the bounding boxes of the hierarchy over nodes bottom-up.
+void ActData_MeshBVH::refitNodeTree()
+{
+  for ( Standard_Integer k = (Standard_Integer) m_nodeTree.Nodes.size() - 1; k >= 0; --k )
+  {
+    t_node& aNode = m_nodeTree.Nodes[k];
+    if ( !aNode.Count )
+    {
+      uniteChildren(m_nodeTree.Nodes, aNode);
+      continue;
+    }
+
+    resetBox(aNode);
+    for ( Standard_Integer i = aNode.First; i < aNode.First + aNode.Count; ++i )
+      addPoint(aNode, &m_coords[3*m_nodeTree.Prims[i]]);
+  }
+}
+
+//! Updates the bounding boxes of the hierarchy over faces bottom-up.
+void ActData_MeshBVH::refitFaceTree()
+{
+  for ( Standard_Integer k = (Standard_Integer) m_faceTree.Nodes.size() - 1; k >= 0; --k )
+  {
+    t_node& aNode = m_faceTree.Nodes[k];
+    if ( !aNode.Count )
+    {
+      uniteChildren(m_faceTree.Nodes, aNode);
+      continue;
+    }
+
+    resetBox(aNode);
+    for ( Standard_Integer i = aNode.First; i < aNode.First + aNode.Count; ++i )
+    {
+      const Standard_Integer f = m_faceTree.Prims[i];
+      for ( Standard_Integer j = 0; j < this->nbCorners(f); ++j )
+        addPoint( aNode, this->corner(f, j) );
+    }
+  }
+}
+
+//! \param face [in] index of the face.
+//! \return number of nodes of the face.
+Standard_Integer ActData_MeshBVH::nbCorners(const Standard_Integer face) const
+{
+  return m_faceNodes[4*face + 3] < 0 ? 3 : 4;
+}
+
+//! \param face [in] index of the face.
+//! \param k    [in] 0-based index of the node in the face.
+//! \return co-ordinates of the node of the face.
+const Standard_Real* ActData_MeshBVH::corner(const Standard_Integer face,
+                                             const Standard_Integer k) const
+{
+  return &m_coords[3*m_faceNodes[4*face + k]];
+}
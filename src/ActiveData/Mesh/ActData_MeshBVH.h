@@ -0,0 +1,183 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+#ifndef ActData_MeshBVH_HeaderFile
+#define ActData_MeshBVH_HeaderFile
+
+// Active Data includes
+#include <ActData_Common.h>
+
+// Mesh includes
+#include <ActData_Mesh.h>
+#include <ActData_Mesh_Node.h>
+
+// OCCT includes
+#include <Bnd_Box.hxx>
+#include <gp_Ax1.hxx>
+#include <gp_Pnt.hxx>
+#include <TColStd_PackedMapOfInteger.hxx>
+
+// STL includes
+#include <vector>
+
+DEFINE_STANDARD_HANDLE(ActData_MeshBVH, Standard_Transient)
+
+//! \ingroup AD_DF
+//!
+//! Bounding volume hierarchies over the nodes and the faces (triangles and
+//! quadrangles) of a mesh. Positions of the nodes are copied into flat
+//! arrays, so the queries do not touch the Mesh DS. If the nodes are only
+//! moved, the hierarchies are refitted to the new positions keeping their
+//! structure. Otherwise the instance should be built again.
+class ActData_MeshBVH : public Standard_Transient
+{
+public:
+
+  // OCCT RTTI
+  DEFINE_STANDARD_RTTI_INLINE(ActData_MeshBVH, Standard_Transient)
+
+public:
+
+  //! Node of a hierarchy. Leaves refer to the range [First, First + Count)
+  //! of primitives, inner nodes have their children at Child and Child + 1.
+  struct t_node
+  {
+    Standard_Real    Min[3]; //!< Minimal corner of the bounding box.
+    Standard_Real    Max[3]; //!< Maximal corner of the bounding box.
+    Standard_Integer Child;  //!< Index of the first child (inner nodes).
+    Standard_Integer First;  //!< Index of the first primitive (leaves).
+    Standard_Integer Count;  //!< Number of primitives (zero for inner nodes).
+  };
+
+  //! Hierarchy with the primitives sorted by the leaves.
+  struct t_tree
+  {
+    std::vector<t_node>           Nodes; //!< Nodes, the root goes first.
+    std::vector<Standard_Integer> Prims; //!< Indices of primitives.
+  };
+
+public:
+
+  ActData_EXPORT
+    ActData_MeshBVH(const Handle(ActData_Mesh)& Mesh);
+
+public:
+
+  ActData_EXPORT void
+    Refit();
+
+  ActData_EXPORT Standard_Boolean
+    IsConsistent(const Handle(ActData_Mesh)& Mesh) const;
+
+public:
+
+  ActData_EXPORT Standard_Integer
+    NearestNode(const gp_Pnt&  P,
+                Standard_Real& Distance) const;
+
+  ActData_EXPORT Standard_Integer
+    NearestPoint(const gp_Pnt& P,
+                 gp_Pnt&       Closest) const;
+
+  ActData_EXPORT Standard_Integer
+    Intersect(const gp_Ax1&  Ray,
+              Standard_Real& Param) const;
+
+  ActData_EXPORT void
+    NodesInBox(const Bnd_Box&              Box,
+               TColStd_PackedMapOfInteger& IDs) const;
+
+  ActData_EXPORT void
+    FacesInBox(const Bnd_Box&              Box,
+               TColStd_PackedMapOfInteger& IDs) const;
+
+  ActData_EXPORT void
+    NodesInSphere(const gp_Pnt&               Center,
+                  const Standard_Real         Radius,
+                  TColStd_PackedMapOfInteger& IDs) const;
+
+  ActData_EXPORT void
+    FacesInSphere(const gp_Pnt&               Center,
+                  const Standard_Real         Radius,
+                  TColStd_PackedMapOfInteger& IDs) const;
+
+public:
+
+  //! \return number of indexed nodes.
+  Standard_Integer NbNodes() const
+  {
+    return (Standard_Integer) m_nodeIDs.size();
+  }
+
+  //! \return number of indexed faces.
+  Standard_Integer NbFaces() const
+  {
+    return (Standard_Integer) m_faceIDs.size();
+  }
+
+protected:
+
+  void build(t_tree&                           tree,
+             const std::vector<Standard_Real>& centers,
+             const Standard_Integer            nbPrims);
+
+  void refitNodeTree();
+
+  void refitFaceTree();
+
+  Standard_Integer nbCorners(const Standard_Integer face) const;
+
+  const Standard_Real* corner(const Standard_Integer face,
+                              const Standard_Integer k) const;
+
+protected:
+
+  //! Mesh DS the hierarchies are built for (not retained).
+  const ActData_Mesh* m_pMesh;
+
+  //! Numbers of nodes and faces in the Mesh DS at the moment of building.
+  Standard_Integer m_iNbMeshNodes, m_iNbMeshFaces;
+
+  //! Nodes of the Mesh DS to take the positions from on refitting.
+  std::vector<Handle(ActData_Mesh_Node)> m_nodes;
+
+  std::vector<Standard_Integer> m_nodeIDs;   //!< IDs of nodes.
+  std::vector<Standard_Real>    m_coords;    //!< X, Y, Z per node.
+  std::vector<Standard_Integer> m_faceIDs;   //!< IDs of faces.
+  std::vector<Standard_Integer> m_faceNodes; //!< Four node indices per face (-1 for triangles).
+
+  t_tree m_nodeTree; //!< Hierarchy over nodes.
+  t_tree m_faceTree; //!< Hierarchy over faces.
+
+};
+
+#endif
@@ -0,0 +1,381 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <ActData_MeshCodec.h>
+
+// OCCT includes
+#include <NCollection_DataMap.hxx>
+
+// Standard includes
+#include <cmath>
+
+#undef COUT_DEBUG
+
+namespace
+{
+  typedef unsigned int t_uint;
+
+  //! Largest grid coordinate, so that the differences of grid coordinates
+  //! fit into 32-bit integers.
+  const Standard_Real MaxGridCoord = 1073741823.0;
+
+  //! Maps signed values to unsigned ones, so that small magnitudes of both
+  //! signs get short codes.
+  inline t_uint zigzag(const int v)
+  {
+    return ( (t_uint) v << 1 ) ^ (t_uint) (v >> 31);
+  }
+
+  //! Inverse of zigzag().
+  inline int unzigzag(const t_uint v)
+  {
+    return (int) (v >> 1) ^ -(int) (v & 1);
+  }
+
+  //! Appends the value in 7-bit groups, lower group first. The high bit of
+  //! each byte indicates that one more group follows.
+  inline void putVarint(std::vector<Standard_Byte>& bytes, t_uint v)
+  {
+    while ( v >= 0x80 )
+    {
+      bytes.push_back( (Standard_Byte) (v | 0x80) );
+      v >>= 7;
+    }
+    bytes.push_back( (Standard_Byte) v );
+  }
+
+  //! Appends the IDs as differences to the previous ID. Differences are
+  //! taken modulo 2^32, so any IDs are encoded.
+  void putIDs(std::vector<Standard_Byte>&          bytes,
+              const std::vector<Standard_Integer>& IDs)
+  {
+    t_uint prev = 0;
+    for ( Standard_Size i = 0; i < IDs.size(); ++i )
+    {
+      putVarint( bytes, zigzag( (int) ( (t_uint) IDs[i] - prev ) ) );
+      prev = (t_uint) IDs[i];
+    }
+  }
+
+  //! Sequential reader of the variable-length integers. Reading past the
+  //! end or a malformed value are reported by IsOK().
+  class VarintReader
+  {
+  public:
+
+    VarintReader(const Standard_Byte* data, const Standard_Size size)
+    : m_pCur(data), m_pEnd(data + size), m_bOk(true) {}
+
+    t_uint Get()
+    {
+      t_uint v = 0;
+      for ( int shift = 0; shift < 35; shift += 7 )
+      {
+        if ( m_pCur == m_pEnd )
+          break;
+
+        const Standard_Byte b = *m_pCur++;
+        v |= (t_uint) (b & 0x7F) << shift;
+        if ( !(b & 0x80) )
+          return v;
+      }
+      m_bOk = false;
+      return 0;
+    }
+
+    //! Decodes the next values into the passed array in a single pass.
+    void Get(std::vector<t_uint>& codes)
+    {
+      for ( Standard_Size i = 0; i < codes.size() && m_bOk; ++i )
+        codes[i] = this->Get();
+    }
+
+    bool IsOK()  const { return m_bOk; }
+    bool AtEnd() const { return m_pCur == m_pEnd; }
+
+  private:
+
+    const Standard_Byte* m_pCur;
+    const Standard_Byte* m_pEnd;
+    bool                 m_bOk;
+  };
+
+  //! Reads the IDs written by putIDs().
+  void getIDs(VarintReader&                  in,
+              std::vector<Standard_Integer>& IDs)
+  {
+    t_uint prev = 0;
+    for ( Standard_Size i = 0; i < IDs.size(); ++i )
+    {
+      prev  += (t_uint) unzigzag( in.Get() );
+      IDs[i] = (Standard_Integer) prev;
+    }
+  }
+
+  //! Checks that the sizes of the blocks agree with each other.
+  bool isConsistent(const ActData_MeshBlocks& blocks)
+  {
+    return blocks.Coords.size()    == 3*blocks.NodeIDs.size() &&
+           blocks.EdgeNodes.size() == 2*blocks.EdgeIDs.size() &&
+           blocks.TriNodes.size()  == 3*blocks.TriIDs.size()  &&
+           blocks.QuadNodes.size() == 4*blocks.QuadIDs.size();
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Encoding
+//-----------------------------------------------------------------------------
+
+//! Encodes the passed mesh blocks. The nodes are snapped to the grid with
+//! the origin in the minimal corner of the bounding box and the step equal
+//! to the tolerance, so each coordinate deviates by half of the tolerance
+//! at most.
+//! \param Blocks    [in]  mesh blocks to encode.
+//! \param Tolerance [in]  grid step (must be positive).
+//! \param Origin    [out] grid origin.
+//! \param Bytes     [out] encoded stream.
+//! \return false if the blocks are inconsistent, an element refers to a
+//!         missing node or the mesh is too large for the tolerance.
+Standard_Boolean ActData_MeshCodec::Encode(const ActData_MeshBlocks&   Blocks,
+                                           const Standard_Real         Tolerance,
+                                           gp_XYZ&                     Origin,
+                                           std::vector<Standard_Byte>& Bytes)
+{
+  Bytes.clear();
+  Origin.SetCoord(0.0, 0.0, 0.0);
+
+  if ( !(Tolerance > 0.0) || !isConsistent(Blocks) )
+    return Standard_False;
+
+  const Standard_Integer nbNodes = (Standard_Integer) Blocks.NodeIDs.size();
+
+  /* ======================
+   *  Choose the grid
+   * ====================== */
+
+  if ( nbNodes )
+  {
+    Standard_Real aMin[3] = { Blocks.Coords[0], Blocks.Coords[1], Blocks.Coords[2] };
+    Standard_Real aMax[3] = { aMin[0], aMin[1], aMin[2] };
+    //
+    for ( Standard_Integer i = 1; i < nbNodes; ++i )
+      for ( Standard_Integer k = 0; k < 3; ++k )
+      {
+        const Standard_Real c = Blocks.Coords[3*i + k];
+        if ( c < aMin[k] ) aMin[k] = c;
+        if ( c > aMax[k] ) aMax[k] = c;
+      }
+
+    for ( Standard_Integer k = 0; k < 3; ++k )
+      if ( !( (aMax[k] - aMin[k]) / Tolerance <= MaxGridCoord ) )
+        return Standard_False;
+
+    Origin.SetCoord(aMin[0], aMin[1], aMin[2]);
+  }
+
+  /* ==================================
+   *  Reorder nodes by their first use
+   * ================================== */
+
+  NCollection_DataMap<Standard_Integer, Standard_Integer> aSlotByID;
+  for ( Standard_Integer i = 0; i < nbNodes; ++i )
+    if ( !aSlotByID.Bind(Blocks.NodeIDs[i], i) )
+      return Standard_False; // Duplicated ID
+
+  const std::vector<Standard_Integer>* aConn[3] = { &Blocks.EdgeNodes,
+                                                    &Blocks.TriNodes,
+                                                    &Blocks.QuadNodes };
+
+  std::vector<Standard_Integer> aNewIndex(nbNodes, -1), anOrder, aRefs;
+  anOrder.reserve(nbNodes);
+  aRefs.reserve( aConn[0]->size() + aConn[1]->size() + aConn[2]->size() );
+
+  for ( Standard_Integer c = 0; c < 3; ++c )
+    for ( Standard_Size j = 0; j < aConn[c]->size(); ++j )
+    {
+      const Standard_Integer* pSlot = aSlotByID.Seek( (*aConn[c])[j] );
+      if ( !pSlot )
+        return Standard_False; // Dangling reference
+
+      Standard_Integer& idx = aNewIndex[*pSlot];
+      if ( idx < 0 )
+      {
+        idx = (Standard_Integer) anOrder.size();
+        anOrder.push_back(*pSlot);
+      }
+      aRefs.push_back(idx);
+    }
+
+  // Free nodes go last
+  for ( Standard_Integer i = 0; i < nbNodes; ++i )
+    if ( aNewIndex[i] < 0 )
+    {
+      aNewIndex[i] = (Standard_Integer) anOrder.size();
+      anOrder.push_back(i);
+    }
+
+  /* =======================
+   *  Write the byte stream
+   * ======================= */
+
+  Bytes.reserve( 4*nbNodes + aRefs.size() + Blocks.EdgeIDs.size()
+                                          + Blocks.TriIDs.size()
+                                          + Blocks.QuadIDs.size() );
+
+  // Node IDs in the storage order
+  t_uint prevID = 0;
+  for ( Standard_Integer i = 0; i < nbNodes; ++i )
+  {
+    const t_uint id = (t_uint) Blocks.NodeIDs[anOrder[i]];
+    putVarint( Bytes, zigzag( (int) (id - prevID) ) );
+    prevID = id;
+  }
+
+  // Grid coordinates as differences to the previous node
+  int prevQ[3] = {0, 0, 0};
+  for ( Standard_Integer i = 0; i < nbNodes; ++i )
+  {
+    const Standard_Real* aCoords = &Blocks.Coords[3*anOrder[i]];
+    for ( Standard_Integer k = 0; k < 3; ++k )
+    {
+      const int q = (int) std::floor( (aCoords[k] - Origin.Coord(k + 1)) / Tolerance + 0.5 );
+      putVarint( Bytes, zigzag(q - prevQ[k]) );
+      prevQ[k] = q;
+    }
+  }
+
+  // Element IDs
+  putIDs(Bytes, Blocks.EdgeIDs);
+  putIDs(Bytes, Blocks.TriIDs);
+  putIDs(Bytes, Blocks.QuadIDs);
+
+  // Element nodes. As the nodes are ordered by the first use, a node which
+  // is not referenced yet is always the next one
+  Standard_Integer aNbIntroduced = 0;
+  for ( Standard_Size j = 0; j < aRefs.size(); ++j )
+  {
+    if ( aRefs[j] == aNbIntroduced )
+    {
+      putVarint(Bytes, 0);
+      ++aNbIntroduced;
+    }
+    else
+      putVarint( Bytes, (t_uint) (aNbIntroduced - aRefs[j]) );
+  }
+
+  return Standard_True;
+}
+
+//-----------------------------------------------------------------------------
+// Decoding
+//-----------------------------------------------------------------------------
+
+//! Decodes the mesh blocks. The blocks should be already allocated for
+//! the numbers of entities which were encoded. The nodes come in the
+//! storage order of the stream, not in the original one.
+//! \param Data      [in]     encoded stream.
+//! \param Size      [in]     size of the stream in bytes.
+//! \param Tolerance [in]     grid step.
+//! \param Origin    [in]     grid origin.
+//! \param Blocks    [in/out] mesh blocks to fill.
+//! \return false if the stream is corrupted.
+Standard_Boolean ActData_MeshCodec::Decode(const Standard_Byte* Data,
+                                           const Standard_Size  Size,
+                                           const Standard_Real  Tolerance,
+                                           const gp_XYZ&        Origin,
+                                           ActData_MeshBlocks&  Blocks)
+{
+  if ( !(Tolerance > 0.0) || !isConsistent(Blocks) )
+    return Standard_False;
+
+  const Standard_Integer nbNodes = (Standard_Integer) Blocks.NodeIDs.size();
+  VarintReader in(Data, Size);
+
+  getIDs(in, Blocks.NodeIDs);
+
+  // Grid coordinates: decode the stream in one pass, then accumulate
+  std::vector<t_uint> aCodes(3*nbNodes);
+  in.Get(aCodes);
+
+  std::vector<Standard_Integer> aGrid(3*nbNodes);
+  int q[3] = {0, 0, 0};
+  for ( Standard_Integer i = 0; i < nbNodes; ++i )
+  {
+    q[0] += unzigzag(aCodes[3*i]);
+    q[1] += unzigzag(aCodes[3*i + 1]);
+    q[2] += unzigzag(aCodes[3*i + 2]);
+    //
+    aGrid[3*i]     = q[0];
+    aGrid[3*i + 1] = q[1];
+    aGrid[3*i + 2] = q[2];
+  }
+
+  // Dequantization has no dependencies between the iterations
+  const Standard_Real ox = Origin.X(), oy = Origin.Y(), oz = Origin.Z();
+  for ( Standard_Integer i = 0; i < nbNodes; ++i )
+  {
+    Blocks.Coords[3*i]     = ox + aGrid[3*i]     * Tolerance;
+    Blocks.Coords[3*i + 1] = oy + aGrid[3*i + 1] * Tolerance;
+    Blocks.Coords[3*i + 2] = oz + aGrid[3*i + 2] * Tolerance;
+  }
+
+  getIDs(in, Blocks.EdgeIDs);
+  getIDs(in, Blocks.TriIDs);
+  getIDs(in, Blocks.QuadIDs);
+
+  // Element nodes
+  std::vector<Standard_Integer>* aConn[3] = { &Blocks.EdgeNodes,
+                                              &Blocks.TriNodes,
+                                              &Blocks.QuadNodes };
+
+  aCodes.resize( aConn[0]->size() + aConn[1]->size() + aConn[2]->size() );
+  in.Get(aCodes);
+
+  if ( !in.IsOK() || !in.AtEnd() )
+    return Standard_False;
+
+  Standard_Integer aNbIntroduced = 0;
+  Standard_Size    r             = 0;
+  for ( Standard_Integer c = 0; c < 3; ++c )
+    for ( Standard_Size j = 0; j < aConn[c]->size(); ++j, ++r )
+    {
+      const Standard_Integer idx = aCodes[r] ? aNbIntroduced - (Standard_Integer) aCodes[r]
+                                             : aNbIntroduced++;
+      if ( idx < 0 || idx >= nbNodes )
+        return Standard_False;
+
+      (*aConn[c])[j] = Blocks.NodeIDs[idx];
+    }
+
+  return Standard_True;
+}
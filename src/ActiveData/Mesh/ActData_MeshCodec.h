@@ -0,0 +1,111 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+#ifndef ActData_MeshCodec_HeaderFile
+#define ActData_MeshCodec_HeaderFile
+
+// Active Data includes
+#include <ActData_Common.h>
+
+// OCCT includes
+#include <gp_XYZ.hxx>
+
+// STL includes
+#include <vector>
+
+//! \ingroup AD_DF
+//!
+//! Mesh entities laid out in flat blocks per entity kind. Elements refer
+//! to their nodes by node IDs.
+struct ActData_MeshBlocks
+{
+  std::vector<Standard_Integer> NodeIDs;   //!< IDs of nodes.
+  std::vector<Standard_Real>    Coords;    //!< X, Y, Z per node.
+  std::vector<Standard_Integer> EdgeIDs;   //!< IDs of edges.
+  std::vector<Standard_Integer> EdgeNodes; //!< Two nodes per edge.
+  std::vector<Standard_Integer> TriIDs;    //!< IDs of triangles.
+  std::vector<Standard_Integer> TriNodes;  //!< Three nodes per triangle.
+  std::vector<Standard_Integer> QuadIDs;   //!< IDs of quadrangles.
+  std::vector<Standard_Integer> QuadNodes; //!< Four nodes per quadrangle.
+
+  //! Allocates the blocks for the given numbers of entities.
+  void Resize(const Standard_Integer nbNodes,
+              const Standard_Integer nbEdges,
+              const Standard_Integer nbTris,
+              const Standard_Integer nbQuads)
+  {
+    NodeIDs   .resize(nbNodes);
+    Coords    .resize(3*nbNodes);
+    EdgeIDs   .resize(nbEdges);
+    EdgeNodes .resize(2*nbEdges);
+    TriIDs    .resize(nbTris);
+    TriNodes  .resize(3*nbTris);
+    QuadIDs   .resize(nbQuads);
+    QuadNodes .resize(4*nbQuads);
+  }
+};
+
+//! \ingroup AD_DF
+//!
+//! Compact lossy encoding of mesh blocks. Node coordinates are snapped to
+//! a grid whose step is the user-specified tolerance, and the nodes are
+//! reordered by their first use in the elements, so that the spatially
+//! coherent neighbours are stored next to each other. The following values
+//! are then written as variable-length integers:
+//! - IDs as differences to the previous ID of the same block;
+//! - grid coordinates as differences to the previous node;
+//! - element nodes as the distance back from the most recently introduced
+//!   node (zero stands for the next new node).
+//!
+//! Decoding is split into a single pass over the byte stream and flat
+//! loops over contiguous arrays, so the dequantization is vectorized by
+//! the compiler.
+class ActData_MeshCodec
+{
+public:
+
+  ActData_EXPORT static Standard_Boolean
+    Encode(const ActData_MeshBlocks&   Blocks,
+           const Standard_Real         Tolerance,
+           gp_XYZ&                     Origin,
+           std::vector<Standard_Byte>& Bytes);
+
+  ActData_EXPORT static Standard_Boolean
+    Decode(const Standard_Byte* Data,
+           const Standard_Size  Size,
+           const Standard_Real  Tolerance,
+           const gp_XYZ&        Origin,
+           ActData_MeshBlocks&  Blocks);
+
+};
+
+#endif
@@ -36,84 +36,127 @@
 // Active Data includes
 #include <ActData_Common.h>
 
+// Mesh includes
+#include <ActData_Mesh_Node.h>
+
 //-----------------------------------------------------------------------------
-// Class: ActData_DeltaMNode
+// Class: ActData_DeltaMBuffers
 //-----------------------------------------------------------------------------
 
-//! Adds the entity represented by Modification Delta Object to the
-//! passed Mesh DS.
-//! \param theMesh [in] mesh to apply modifications on.
-void ActData_DeltaMNode::AddTo(Handle(ActData_Mesh)& theMesh)
+//! Returns the number of records stored for the given kind of entities.
+//! Moved nodes are kept apart from the added and removed ones.
+//! \param theType   [in] modification type.
+//! \param theEntity [in] kind of entities.
+//! \return number of records.
+Standard_Integer
+  ActData_DeltaMBuffers::NbRecords(const ActData_DeltaMType   theType,
+                                   const ActData_DeltaMEntity theEntity) const
 {
-  theMesh->AddNode(X, Y, Z);
-}
+  if ( theType == DeltaMType_Moved )
+    return (Standard_Integer) MovedNodeIDs.size();
 
-//! Removes the entity represented by Modification Delta Object from the
-//! passed Mesh DS.
-//! \param theMesh [in] mesh to apply modifications on.
-void ActData_DeltaMNode::RemoveFrom(Handle(ActData_Mesh)& theMesh)
-{
-  theMesh->RemoveNode(ID);
+  switch ( theEntity )
+  {
+    case DeltaMEntity_Node:       return (Standard_Integer) NodeIDs.size();
+    case DeltaMEntity_Triangle:   return (Standard_Integer) TriangleIDs.size();
+    case DeltaMEntity_Quadrangle: return (Standard_Integer) QuadrangleIDs.size();
+  }
+  return 0;
 }
 
-//-----------------------------------------------------------------------------
-// Class: ActData_DeltaMTriangle
-//-----------------------------------------------------------------------------
-
-//! Adds the entity represented by Modification Delta Object to the
-//! passed Mesh DS.
-//! \param theMesh [in] mesh to apply modifications on.
-void ActData_DeltaMTriangle::AddTo(Handle(ActData_Mesh)& theMesh)
+//! Returns the number of bytes reserved by the buffers.
+//! \return reserved memory in bytes.
+Standard_Size ActData_DeltaMBuffers::Capacity() const
 {
-  theMesh->AddFace(Nodes, 3);
+  return sizeof(ActData_DeltaMBuffers)
+       + NodeIDs.capacity()         * sizeof(Standard_Integer)
+       + NodeCoords.capacity()      * sizeof(Standard_Real)
+       + TriangleIDs.capacity()     * sizeof(Standard_Integer)
+       + TriangleNodes.capacity()   * sizeof(Standard_Integer)
+       + QuadrangleIDs.capacity()   * sizeof(Standard_Integer)
+       + QuadrangleNodes.capacity() * sizeof(Standard_Integer)
+       + MovedNodeIDs.capacity()    * sizeof(Standard_Integer)
+       + MovedNodeCoords.capacity() * sizeof(Standard_Real);
 }
 
-//! Removes the entity represented by Modification Delta Object from the
-//! passed Mesh DS.
-//! \param theMesh [in] mesh to apply modifications on.
-void ActData_DeltaMTriangle::RemoveFrom(Handle(ActData_Mesh)& theMesh)
+//! Adds the entities of the given run to the passed Mesh DS. The original
+//! IDs of the entities are preserved.
+//! \param theRun     [in]     run of records to add.
+//! \param isReversed [in]     whether to iterate the records backwards.
+//! \param theMesh    [in/out] mesh to apply modifications on.
+void ActData_DeltaMBuffers::AddTo(const ActData_DeltaMRun& theRun,
+                                  const Standard_Boolean   isReversed,
+                                  Handle(ActData_Mesh)&    theMesh) const
 {
-  Handle(ActData_Mesh_Element) anElem = theMesh->FindElement(ID);
-  theMesh->RemoveElement(ID);
-}
-
-//-----------------------------------------------------------------------------
-// Class: ActData_DeltaMQuadrangle
-//-----------------------------------------------------------------------------
+  const Standard_Integer step = isReversed ? -1 : 1;
+  Standard_Integer       i    = isReversed ? theRun.First + theRun.Count - 1 : theRun.First;
 
-//! Adds the entity represented by Modification Delta Object to the
-//! passed Mesh DS.
-//! \param theMesh [in] mesh to apply modifications on.
-void ActData_DeltaMQuadrangle::AddTo(Handle(ActData_Mesh)& theMesh)
-{
-  theMesh->AddFace(Nodes, 4);
+  switch ( theRun.Entity )
+  {
+    case DeltaMEntity_Node:
+      for ( Standard_Integer k = 0; k < theRun.Count; ++k, i += step )
+        theMesh->AddNodeWithID(NodeCoords[3*i], NodeCoords[3*i + 1], NodeCoords[3*i + 2], NodeIDs[i]);
+      break;
+    case DeltaMEntity_Triangle:
+      for ( Standard_Integer k = 0; k < theRun.Count; ++k, i += step )
+        theMesh->AddFaceWithID( (Standard_Address) &TriangleNodes[3*i], 3, TriangleIDs[i] );
+      break;
+    case DeltaMEntity_Quadrangle:
+      for ( Standard_Integer k = 0; k < theRun.Count; ++k, i += step )
+        theMesh->AddFaceWithID( (Standard_Address) &QuadrangleNodes[4*i], 4, QuadrangleIDs[i] );
+      break;
+  }
 }
 
-//! Removes the entity represented by Modification Delta Object from the
-//! passed Mesh DS.
-//! \param theMesh [in] mesh to apply modifications on.
-void ActData_DeltaMQuadrangle::RemoveFrom(Handle(ActData_Mesh)& theMesh)
+//! Removes the entities of the given run from the passed Mesh DS.
+//! \param theRun     [in]     run of records to remove.
+//! \param isReversed [in]     whether to iterate the records backwards.
+//! \param theMesh    [in/out] mesh to apply modifications on.
+void ActData_DeltaMBuffers::RemoveFrom(const ActData_DeltaMRun& theRun,
+                                       const Standard_Boolean   isReversed,
+                                       Handle(ActData_Mesh)&    theMesh) const
 {
-  Handle(ActData_Mesh_Element) anElem = theMesh->FindElement(ID);
-  theMesh->RemoveElement(ID);
-}
+  const Standard_Integer step = isReversed ? -1 : 1;
+  Standard_Integer       i    = isReversed ? theRun.First + theRun.Count - 1 : theRun.First;
 
-//-----------------------------------------------------------------------------
-// Class: ActData_DeltaMMesh
-//-----------------------------------------------------------------------------
-
-//! Adds the entity represented by Modification Delta Object to the
-//! passed Mesh DS.
-//! \param theMesh [in] mesh to apply modifications on.
-void ActData_DeltaMMesh::AddTo(Handle(ActData_Mesh)& theMesh)
-{
-  theMesh = this->NewMesh;
+  switch ( theRun.Entity )
+  {
+    case DeltaMEntity_Node:
+      for ( Standard_Integer k = 0; k < theRun.Count; ++k, i += step )
+        theMesh->RemoveNode(NodeIDs[i]);
+      break;
+    case DeltaMEntity_Triangle:
+      for ( Standard_Integer k = 0; k < theRun.Count; ++k, i += step )
+        theMesh->RemoveElement(TriangleIDs[i]);
+      break;
+    case DeltaMEntity_Quadrangle:
+      for ( Standard_Integer k = 0; k < theRun.Count; ++k, i += step )
+        theMesh->RemoveElement(QuadrangleIDs[i]);
+      break;
+  }
 }
 
-//! Removes the entity represented by Modification Delta Object from the
-//! passed Mesh DS.
-//! \param theMesh [in] mesh to apply modifications on.
-void ActData_DeltaMMesh::RemoveFrom(Handle(ActData_Mesh)& theMesh)
+//! Moves the nodes of the given run in the passed Mesh DS. The nodes get
+//! their new co-ordinates, or the old ones if the run is reversed.
+//! \param theRun     [in]     run of records to apply.
+//! \param isReversed [in]     whether to iterate the records backwards
+//!                            restoring the old co-ordinates.
+//! \param theMesh    [in/out] mesh to apply modifications on.
+void ActData_DeltaMBuffers::MoveIn(const ActData_DeltaMRun& theRun,
+                                   const Standard_Boolean   isReversed,
+                                   Handle(ActData_Mesh)&    theMesh) const
 {
-  theMesh = this->OldMesh;
+  const Standard_Integer step = isReversed ? -1 : 1;
+  const Standard_Integer from = isReversed ? 0 : 3;
+  Standard_Integer       i    = isReversed ? theRun.First + theRun.Count - 1 : theRun.First;
+
+  for ( Standard_Integer k = 0; k < theRun.Count; ++k, i += step )
+  {
+    Handle(ActData_Mesh_Node) aNode = theMesh->FindNode(MovedNodeIDs[i]);
+    if ( aNode.IsNull() )
+      continue;
+
+    const Standard_Real* aCoords = &MovedNodeCoords[6*i + from];
+    aNode->SetPnt( gp_Pnt(aCoords[0], aCoords[1], aCoords[2]), Standard_True );
+  }
 }
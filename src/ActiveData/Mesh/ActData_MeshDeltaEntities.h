@@ -34,218 +34,132 @@
 #define ActData_MeshDeltaEntities_HeaderFile
 
 // OCCT includes
-#include <NCollection_Handle.hxx>
-#include <NCollection_Sequence.hxx>
 #include <Standard_Type.hxx>
 
 // Mesh includes
 #include <ActData_Mesh.h>
 
+// STL includes
+#include <vector>
+
 //-----------------------------------------------------------------------------
-// Class: ActData_DeltaMObject
+// Data types used to form a queue of modification requests
 //-----------------------------------------------------------------------------
 
-DEFINE_STANDARD_HANDLE(ActData_DeltaMObject, Standard_Transient)
-
 //! \ingroup AD_DF
 //!
-//! Modification entity.
-class ActData_DeltaMObject : public Standard_Transient
+//! Modification types.
+enum ActData_DeltaMType
 {
-public:
-
-  // OCCT RTTI
-  DEFINE_STANDARD_RTTI_INLINE(ActData_DeltaMObject, Standard_Transient)
-
-public:
-
-  Standard_Integer ID; //!< ID of the object in the mesh structure.
-
-  //! Default constructor.
-  ActData_DeltaMObject() : ID(-1) {}
-
-  //! Adds Delta entity the passed Mesh DS.
-  //! \param theMesh [in] Mesh DS to add the entity into.
-  virtual void AddTo(Handle(ActData_Mesh)& theMesh) = 0;
-
-  //! Removes Delta entity from the passed Mesh DS.
-  //! \param theMesh [in] Mesh DS to remove the entity from.
-  virtual void RemoveFrom(Handle(ActData_Mesh)& theMesh) = 0;
+  DeltaMType_Undef = 1, //!< Undefined type.
+  DeltaMType_Added,     //!< Something has been added.
+  DeltaMType_Removed,   //!< Something has been removed.
+  DeltaMType_Moved      //!< Nodes have been moved (self-dual).
 };
 
-//-----------------------------------------------------------------------------
-// Class: ActData_DeltaMNode
-//-----------------------------------------------------------------------------
-
-DEFINE_STANDARD_HANDLE(ActData_DeltaMNode, ActData_DeltaMObject)
-
 //! \ingroup AD_DF
 //!
-//! Node playing as a modification entity.
-class ActData_DeltaMNode : public ActData_DeltaMObject
+//! Kinds of mesh entities which can be modified.
+enum ActData_DeltaMEntity
 {
-public:
-
-  // OCCT RTTI
-  DEFINE_STANDARD_RTTI_INLINE(ActData_DeltaMNode, ActData_DeltaMObject)
-
-public:
-
-  Standard_Real X; //!< X coordinate.
-  Standard_Real Y; //!< Y coordinate.
-  Standard_Real Z; //!< Z coordinate.
-  
-  //! Default constructor.
-  ActData_DeltaMNode() : ActData_DeltaMObject(), X(0.0), Y(0.0), Z(0.0) {}
-
-  virtual void AddTo(Handle(ActData_Mesh)& theMesh);
-  virtual void RemoveFrom(Handle(ActData_Mesh)& theMesh);
+  DeltaMEntity_Node = 0,  //!< Mesh node.
+  DeltaMEntity_Triangle,  //!< Triangle face.
+  DeltaMEntity_Quadrangle //!< Quadrangle face.
 };
 
-//-----------------------------------------------------------------------------
-// Class: ActData_DeltaMTriangle
-//-----------------------------------------------------------------------------
-
-DEFINE_STANDARD_HANDLE(ActData_DeltaMTriangle, ActData_DeltaMObject)
-
 //! \ingroup AD_DF
 //!
-//! Triangle face playing as a modification entity.
-class ActData_DeltaMTriangle : public ActData_DeltaMObject
+//! Run of modification requests having the same type and entity kind which
+//! were recorded one after another. The entities of a run occupy a contiguous
+//! range of records in the buffer of their kind.
+struct ActData_DeltaMRun
 {
-public:
-
-  // OCCT RTTI
-  DEFINE_STANDARD_RTTI_INLINE(ActData_DeltaMTriangle, ActData_DeltaMObject)
-
-public:
-
-  Standard_Integer Nodes[3]; //!< Triangle nodes.
+  ActData_DeltaMType   Type;   //!< Modification type.
+  ActData_DeltaMEntity Entity; //!< Kind of the modified entities.
+  Standard_Boolean     OnCopy; //!< Whether the run is a part of mesh replacement.
+  Standard_Integer     First;  //!< Index of the first record in the buffer.
+  Standard_Integer     Count;  //!< Number of records.
 
   //! Default constructor.
-  ActData_DeltaMTriangle() : ActData_DeltaMObject()
-  {
-    Nodes[0] = Nodes[1] = Nodes[2] = 0;
-  }
+  ActData_DeltaMRun()
+  : Type(DeltaMType_Undef), Entity(DeltaMEntity_Node), OnCopy(Standard_False), First(0), Count(0)
+  {}
 
-  virtual void AddTo(Handle(ActData_Mesh)& theMesh);
-  virtual void RemoveFrom(Handle(ActData_Mesh)& theMesh);
+  //! Complete constructor.
+  //! \param theType   [in] modification type.
+  //! \param theEntity [in] kind of the modified entities.
+  //! \param isOnCopy  [in] whether the run is a part of mesh replacement.
+  //! \param theFirst  [in] index of the first record in the buffer.
+  ActData_DeltaMRun(const ActData_DeltaMType   theType,
+                    const ActData_DeltaMEntity theEntity,
+                    const Standard_Boolean     isOnCopy,
+                    const Standard_Integer     theFirst)
+  : Type(theType), Entity(theEntity), OnCopy(isOnCopy), First(theFirst), Count(1)
+  {}
 };
 
-//-----------------------------------------------------------------------------
-// Class: ActData_DeltaMQuadrangle
-//-----------------------------------------------------------------------------
-
-DEFINE_STANDARD_HANDLE(ActData_DeltaMQuadrangle, ActData_DeltaMObject)
-
 //! \ingroup AD_DF
 //!
-//! Quadrangle face playing as a modification entity.
-class ActData_DeltaMQuadrangle : public ActData_DeltaMObject
-{
-public:
-
-  // OCCT RTTI
-  DEFINE_STANDARD_RTTI_INLINE(ActData_DeltaMQuadrangle, ActData_DeltaMObject)
-
-public:
-
-  Standard_Integer Nodes[4]; //!< Quadrangle nodes
-
-  //! Default constructor.
-  ActData_DeltaMQuadrangle() : ActData_DeltaMObject()
-  {
-    Nodes[0] = Nodes[1] = Nodes[2] = Nodes[3] = 0;
-  }
-
-  virtual void AddTo(Handle(ActData_Mesh)& theMesh);
-  virtual void RemoveFrom(Handle(ActData_Mesh)& theMesh);
-};
+//! Ordered collection of modification runs. Run recorded first must be
+//! applied first. Thus we can record and replay the sequence of user
+//! actions in their actual order.
+typedef std::vector<ActData_DeltaMRun> ActData_DeltaMQueue;
 
 //-----------------------------------------------------------------------------
-// Class: ActData_DeltaMMesh
+// Class: ActData_DeltaMBuffers
 //-----------------------------------------------------------------------------
 
-DEFINE_STANDARD_HANDLE(ActData_DeltaMMesh, ActData_DeltaMObject)
+DEFINE_STANDARD_HANDLE(ActData_DeltaMBuffers, Standard_Transient)
 
 //! \ingroup AD_DF
 //!
-//! Entire mesh playing as a modification entity.
-class ActData_DeltaMMesh : public ActData_DeltaMObject
+//! Packed storage for the entities recorded by Modification Delta. Each kind
+//! of entity has its own arrays of IDs and payload (node co-ordinates or
+//! element connectivity), so that a run of requests is replayed as a plain
+//! loop over contiguous memory. Records are only appended, therefore the
+//! buffers can be safely shared between copies of a Delta.
+class ActData_DeltaMBuffers : public Standard_Transient
 {
 public:
 
   // OCCT RTTI
-  DEFINE_STANDARD_RTTI_INLINE(ActData_DeltaMMesh, ActData_DeltaMObject)
+  DEFINE_STANDARD_RTTI_INLINE(ActData_DeltaMBuffers, Standard_Transient)
 
 public:
 
-  Handle(ActData_Mesh) OldMesh; //!< Old Mesh DS.
-  Handle(ActData_Mesh) NewMesh; //!< New Mesh DS.
+  std::vector<Standard_Integer> NodeIDs;         //!< IDs of nodes.
+  std::vector<Standard_Real>    NodeCoords;      //!< X, Y, Z per node.
+  std::vector<Standard_Integer> TriangleIDs;     //!< IDs of triangles.
+  std::vector<Standard_Integer> TriangleNodes;   //!< Three nodes per triangle.
+  std::vector<Standard_Integer> QuadrangleIDs;   //!< IDs of quadrangles.
+  std::vector<Standard_Integer> QuadrangleNodes; //!< Four nodes per quadrangle.
+  std::vector<Standard_Integer> MovedNodeIDs;    //!< IDs of moved nodes.
+  std::vector<Standard_Real>    MovedNodeCoords; //!< Old X, Y, Z and new X, Y, Z per moved node.
 
-  //! Default constructor.
-  ActData_DeltaMMesh() : ActData_DeltaMObject() {}
+public:
 
-  virtual void AddTo(Handle(ActData_Mesh)& theMesh);
-  virtual void RemoveFrom(Handle(ActData_Mesh)& theMesh);
-};
+  ActData_EXPORT Standard_Integer
+    NbRecords(const ActData_DeltaMType   theType,
+              const ActData_DeltaMEntity theEntity) const;
 
-//-----------------------------------------------------------------------------
-// Data types used to form a queue of modification requests
-//-----------------------------------------------------------------------------
-
-//! \ingroup AD_DF
-//!
-//! Modification types.
-enum ActData_DeltaMType
-{
-  DeltaMType_Undef = 1, //!< Undefined type.
-  DeltaMType_Added,     //!< Something has been added.
-  DeltaMType_Removed    //!< Something has been removed.
-};
+  ActData_EXPORT Standard_Size
+    Capacity() const;
 
-//! \ingroup AD_DF
-//!
-//! Structure representing a single modification request.
-struct ActData_DeltaMRequest
-{
-  ActData_DeltaMType Type;             //!< Modification type.
-  Handle(ActData_DeltaMObject) Entity; //!< Modified entity.
+  ActData_EXPORT void
+    AddTo(const ActData_DeltaMRun& theRun,
+          const Standard_Boolean   isReversed,
+          Handle(ActData_Mesh)&    theMesh) const;
 
-  //! Default constructor.
-  ActData_DeltaMRequest() : Type(DeltaMType_Undef), Entity(NULL) {}
+  ActData_EXPORT void
+    RemoveFrom(const ActData_DeltaMRun& theRun,
+               const Standard_Boolean   isReversed,
+               Handle(ActData_Mesh)&    theMesh) const;
 
-  //! Complete constructor.
-  //! \param theType [in] modification type.
-  //! \param theEntity [in] modification entity.
-  ActData_DeltaMRequest(const ActData_DeltaMType theType,
-                        const Handle(ActData_DeltaMObject)& theEntity)
-  : Type(theType), Entity(theEntity)
-  {}
+  ActData_EXPORT void
+    MoveIn(const ActData_DeltaMRun& theRun,
+           const Standard_Boolean   isReversed,
+           Handle(ActData_Mesh)&    theMesh) const;
 
-  //! Assignment constructor.
-  //! \param theRequest [in] other request.
-  ActData_DeltaMRequest(const ActData_DeltaMRequest& theRequest)
-  {
-    this->operator=(theRequest);
-  }
-
-  //! Assignment operator.
-  //! \param theRequest [in] other Modification Request object.
-  //! \return this one.
-  ActData_DeltaMRequest& operator=(const ActData_DeltaMRequest& theRequest)
-  {
-    Type = theRequest.Type;
-    Entity = theRequest.Entity;
-    return *this;
-  }
 };
 
-//! \ingroup AD_DF
-//!
-//! Ordered collection of modification requests. Request recorded first must
-//! be applied first. Thus we can record and replay the sequence of user
-//! actions in their actual order.
-typedef NCollection_Sequence<ActData_DeltaMRequest> ActData_DeltaMQueue;
-
 #endif
@@ -35,6 +35,112 @@
 
 // Active Data includes
 #include <ActData_MeshAttr.h>
+#include <ActData_Mesh_ElementsIterator.h>
+#include <ActData_Mesh_Quadrangle.h>
+#include <ActData_Mesh_Triangle.h>
+
+// OCCT includes
+#include <TColStd_PackedMapOfInteger.hxx>
+
+//-----------------------------------------------------------------------------
+// Auxiliary functions
+//-----------------------------------------------------------------------------
+
+//! Creates a full copy of the passed mesh preserving the IDs of its nodes
+//! and elements.
+//! \param theMesh [in] mesh to copy (can be NULL).
+//! \return copy of the mesh.
+static Handle(ActData_Mesh) copyMesh(const Handle(ActData_Mesh)& theMesh)
+{
+  Handle(ActData_Mesh) aCopy = new ActData_Mesh();
+  if ( theMesh.IsNull() )
+    return aCopy;
+
+  ActData_Mesh_ElementsIterator aNodesIt(theMesh, ActData_Mesh_ET_Node);
+  for ( ; aNodesIt.More(); aNodesIt.Next() )
+  {
+    Handle(ActData_Mesh_Node) aNode = Handle(ActData_Mesh_Node)::DownCast( aNodesIt.GetValue() );
+    aCopy->AddNodeWithID( aNode->X(), aNode->Y(), aNode->Z(), aNode->GetID() );
+  }
+
+  ActData_Mesh_ElementsIterator anElemsIt(theMesh, ActData_Mesh_ET_Face);
+  for ( ; anElemsIt.More(); anElemsIt.Next() )
+  {
+    const Handle(ActData_Mesh_Element)& anElem = anElemsIt.GetValue();
+    aCopy->AddElementWithID( anElem, anElem->GetID() );
+  }
+
+  return aCopy;
+}
+
+//! Checks whether two nodes have the same co-ordinates.
+//! \param theN1 [in] first node.
+//! \param theN2 [in] second node.
+//! \return true if the nodes coincide exactly, false -- otherwise.
+static Standard_Boolean isSameNode(const Handle(ActData_Mesh_Node)& theN1,
+                                   const Handle(ActData_Mesh_Node)& theN2)
+{
+  return theN1->X() == theN2->X() && theN1->Y() == theN2->Y() && theN1->Z() == theN2->Z();
+}
+
+//! Checks whether the given face of one mesh is kept as-is in the other mesh.
+//! The face is kept if the other mesh contains a face with the same ID and
+//! the same nodes, and none of these nodes has been changed.
+//! \param theElem         [in] face to check.
+//! \param theOther        [in] other mesh (can be NULL).
+//! \param theChangedNodes [in] IDs of the nodes changed between the meshes.
+//! \return true if the face is kept, false -- otherwise.
+static Standard_Boolean isKeptFace(const Handle(ActData_Mesh_Element)& theElem,
+                                   const Handle(ActData_Mesh)&         theOther,
+                                   const TColStd_PackedMapOfInteger&   theChangedNodes)
+{
+  if ( theOther.IsNull() )
+    return Standard_False;
+
+  Handle(ActData_Mesh_Element) anOther = theOther->FindElement( theElem->GetID() );
+  if ( anOther.IsNull() || anOther->NbNodes() != theElem->NbNodes() )
+    return Standard_False;
+
+  for ( Standard_Integer r = 1; r <= theElem->NbNodes(); ++r )
+  {
+    const Standard_Integer aNodeID = theElem->GetConnection(r);
+    if ( anOther->GetConnection(r) != aNodeID || theChangedNodes.Contains(aNodeID) )
+      return Standard_False;
+  }
+  return Standard_True;
+}
+
+//! Writes the passed array to the binary stream as its size followed by
+//! the raw items.
+//! \param theOut [in/out] output stream.
+//! \param theVec [in] array to write.
+template<typename T>
+static void writeVector(Standard_OStream& theOut, const std::vector<T>& theVec)
+{
+  const Standard_Integer aSize = (Standard_Integer) theVec.size();
+  theOut.write( (const char*) &aSize, sizeof(Standard_Integer) );
+  if ( aSize )
+    theOut.write( (const char*) &theVec[0], aSize*sizeof(T) );
+}
+
+//! Reads the array written by writeVector() from the binary stream.
+//! \param theIn  [in/out] input stream.
+//! \param theVec [out] array to read.
+//! \return true in case of success, false -- otherwise.
+template<typename T>
+static Standard_Boolean readVector(Standard_IStream& theIn, std::vector<T>& theVec)
+{
+  Standard_Integer aSize = 0;
+  theIn.read( (char*) &aSize, sizeof(Standard_Integer) );
+  if ( !theIn.good() || aSize < 0 )
+    return Standard_False;
+
+  theVec.resize(aSize);
+  if ( aSize )
+    theIn.read( (char*) &theVec[0], aSize*sizeof(T) );
+
+  return theIn.good();
+}
 
 //-----------------------------------------------------------------------------
 // Construction routines
@@ -44,7 +150,11 @@
 //! for modification requests.
 //! \param ActualAttr [in] modification ground data.
 ActData_MeshMDelta::ActData_MeshMDelta(const Handle(ActData_MeshAttr)& ActualAttr)
-: TDF_DeltaOnModification(ActualAttr)
+: TDF_DeltaOnModification(ActualAttr),
+  m_bInverted(Standard_False),
+  m_bTolChanged(Standard_False),
+  m_fOldTol(0.0),
+  m_fNewTol(0.0)
 {
 }
 
@@ -52,49 +162,86 @@ ActData_MeshMDelta::ActData_MeshMDelta(const Handle(ActData_MeshAttr)& ActualAtt
 // Kernel routines
 //-----------------------------------------------------------------------------
 
-//! Applies recorded modifications to ground data.
+//! Applies recorded modifications to ground data. The runs recorded for
+//! mesh replacement are applied to a copy of the current mesh which is
+//! then settled down to the Attribute if the mesh is still referenced from
+//! outside, e.g. by the client which has passed it to SetMesh(). This way
+//! such mesh instances remain untouched. A mesh owned by the Attribute
+//! alone is modified in place, so the copy is made at most once.
 void ActData_MeshMDelta::Apply()
 {
   Handle(ActData_MeshAttr) aMeshAttr = Handle(ActData_MeshAttr)::DownCast( this->Attribute() );
+
+  // The tolerance is set without recording as this Delta is being played
+  if ( m_bTolChanged )
+    aMeshAttr->SetCompressionTolerance(m_bInverted ? m_fOldTol : m_fNewTol, Standard_False);
+
+  if ( m_queue.empty() )
+    return;
+
   Handle(ActData_Mesh)& aMesh = aMeshAttr->GetMesh();
 
-  // Iterate over the chain of requests to apply them
-  ActData_DeltaMQueue::Iterator anIt(m_queue);
-  for ( ; anIt.More(); anIt.Next() )
+  const Standard_Integer aNbRuns     = (Standard_Integer) m_queue.size();
+  Standard_Boolean       isCopy      = Standard_False;
+  Standard_Boolean       isMovedOnly = Standard_True;
+
+  // Iterate over the chain of runs to apply them
+  for ( Standard_Integer k = 0; k < aNbRuns; ++k )
   {
-    const ActData_DeltaMRequest& aNextReq = anIt.Value();
-    if ( aNextReq.Type == DeltaMType_Added )
-    {
-      aNextReq.Entity->AddTo(aMesh);
-    }
-    else if ( aNextReq.Type == DeltaMType_Removed )
+    const ActData_DeltaMRun& aRun = m_queue[m_bInverted ? aNbRuns - 1 - k : k];
+    //
+    if ( aRun.OnCopy && !isCopy && ( aMesh.IsNull() || aMesh->GetRefCount() > 1 ) )
     {
-      aNextReq.Entity->RemoveFrom(aMesh);
+      aMesh  = copyMesh(aMesh);
+      isCopy = Standard_True;
     }
+
+    ActData_DeltaMType aType = aRun.Type;
+    if ( m_bInverted && aType != DeltaMType_Moved )
+      aType = ( aType == DeltaMType_Added ? DeltaMType_Removed : DeltaMType_Added );
+
+    if ( aType != DeltaMType_Moved )
+      isMovedOnly = Standard_False;
+
+    if ( aType == DeltaMType_Moved )
+      m_buffers->MoveIn(aRun, m_bInverted, aMesh);
+    else if ( aType == DeltaMType_Added )
+      m_buffers->AddTo(aRun, m_bInverted, aMesh);
+    else if ( aType == DeltaMType_Removed )
+      m_buffers->RemoveFrom(aRun, m_bInverted, aMesh);
   }
+
+  // Derived structures survive if the nodes were just moved
+  aMeshAttr->InvalidateCaches(isMovedOnly && !isCopy);
 }
 
-//! Cleans up the modification delta.
+//! Cleans up the modification delta. The buffers possibly shared with the
+//! copies are released rather than cleared.
 void ActData_MeshMDelta::Clean()
 {
-  m_queue.Clear();
+  m_queue.clear();
+  m_buffers.Nullify();
+  m_bInverted   = Standard_False;
+  m_bTolChanged = Standard_False;
+  m_fOldTol     = 0.0;
+  m_fNewTol     = 0.0;
 }
 
-//! Creates a full copy of Modification Delta.
-//! \return full copy.
+//! Creates a copy of Modification Delta. The packed entities are shared
+//! with the copy as they are never modified once recorded.
+//! \return copy.
 Handle(ActData_MeshMDelta) ActData_MeshMDelta::DeepCopy() const
 {
   Handle(ActData_MeshMDelta) aCopy =
     new ActData_MeshMDelta( Handle(ActData_MeshAttr)::DownCast( this->Attribute() ) );
 
-  // Copy the queue of modification requests
-  ActData_DeltaMQueue::Iterator anIt(m_queue);
-  for ( ; anIt.More(); anIt.Next() )
-  {
-    const ActData_DeltaMRequest& aNextReq = anIt.Value();
-    aCopy->m_queue.Append(aNextReq);
-  }
-  
+  aCopy->m_queue       = m_queue;
+  aCopy->m_buffers     = m_buffers;
+  aCopy->m_bInverted   = m_bInverted;
+  aCopy->m_bTolChanged = m_bTolChanged;
+  aCopy->m_fOldTol     = m_fOldTol;
+  aCopy->m_fNewTol     = m_fNewTol;
+
   return aCopy;
 }
 
@@ -115,42 +262,103 @@ Handle(ActData_MeshMDelta) ActData_MeshMDelta::DeepCopy() const
 //!
 //! Therefore, this method is used to apply the Modification Delta to the
 //! actual Attribute with conceptual negation sign. Think of this method
-//! as a basis for UNDO functionality.
+//! as a basis for UNDO functionality. Nothing is moved in memory: the
+//! queue is simply marked to be played backwards.
 void ActData_MeshMDelta::Invert()
 {
-  // Reverse order
-  m_queue.Reverse();
+  m_bInverted = !m_bInverted;
+}
 
-  // Reverse modifications
-  ActData_DeltaMQueue::Iterator anIt(m_queue);
-  for ( ; anIt.More(); anIt.Next() )
-  {
-    ActData_DeltaMRequest& aNextReq = anIt.ChangeValue();
-    if ( aNextReq.Type == DeltaMType_Added )
-      aNextReq.Type = DeltaMType_Removed;
-    else if ( aNextReq.Type == DeltaMType_Removed )
-      aNextReq.Type = DeltaMType_Added;
-  }
+//! Estimates the memory held by this Modification Delta, i.e. its runs and
+//! the packed entities. The estimation is used to keep the Undo history
+//! within a memory budget.
+//! \return estimated size in bytes.
+Standard_Size ActData_MeshMDelta::EstimatedSize() const
+{
+  Standard_Size aSize = sizeof(ActData_MeshMDelta)
+                      + m_queue.capacity() * sizeof(ActData_DeltaMRun);
+
+  if ( !m_buffers.IsNull() )
+    aSize += m_buffers->Capacity();
+
+  return aSize;
 }
 
 //-----------------------------------------------------------------------------
 // Recording modification requests
 //-----------------------------------------------------------------------------
 
-//! Informs Delta that the entire mesh has been exchanged with a new one. In
-//! such case all previous modification requests are erased as they are
-//! redundant in the current transactional scope.
+//! Informs Delta that the entire mesh has been exchanged with a new one.
+//! Only the difference between the meshes is recorded: the faces and nodes
+//! which disappear or change are removed, and then the new or changed ones
+//! are added. The data shared by both meshes is not stored at all, and none
+//! of the meshes is retained by the Delta.
 //! \param OldMesh [in] old mesh DS.
 //! \param NewMesh [in] new mesh DS.
 void ActData_MeshMDelta::ReplacedMesh(const Handle(ActData_Mesh)& OldMesh,
                                       const Handle(ActData_Mesh)& NewMesh)
 {
-  Handle(ActData_DeltaMMesh) aMMesh = new ActData_DeltaMMesh();
-  aMMesh->OldMesh = OldMesh;
-  aMMesh->NewMesh = NewMesh;
+  if ( OldMesh == NewMesh )
+    return;
 
-  this->Clean();
-  m_queue.Append( ActData_DeltaMRequest(DeltaMType_Added, aMMesh) );
+  // Collect the nodes which are absent or moved in the new mesh
+  TColStd_PackedMapOfInteger aChangedNodes;
+  if ( !OldMesh.IsNull() )
+  {
+    ActData_Mesh_ElementsIterator aNodesIt(OldMesh, ActData_Mesh_ET_Node);
+    for ( ; aNodesIt.More(); aNodesIt.Next() )
+    {
+      Handle(ActData_Mesh_Node) aNode = Handle(ActData_Mesh_Node)::DownCast( aNodesIt.GetValue() );
+      Handle(ActData_Mesh_Node) aNewNode;
+      if ( !NewMesh.IsNull() )
+        aNewNode = NewMesh->FindNode( aNode->GetID() );
+      //
+      if ( aNewNode.IsNull() || !isSameNode(aNode, aNewNode) )
+        aChangedNodes.Add( aNode->GetID() );
+    }
+
+    // Faces go first as the nodes cannot be removed while being referenced
+    ActData_Mesh_ElementsIterator anElemsIt(OldMesh, ActData_Mesh_ET_Face);
+    for ( ; anElemsIt.More(); anElemsIt.Next() )
+    {
+      const Handle(ActData_Mesh_Element)& anElem = anElemsIt.GetValue();
+      if ( !isKeptFace(anElem, NewMesh, aChangedNodes) )
+        this->recordElement(DeltaMType_Removed, Standard_True, anElem);
+    }
+
+    for ( aNodesIt.Initialize(OldMesh, ActData_Mesh_ET_Node); aNodesIt.More(); aNodesIt.Next() )
+    {
+      Handle(ActData_Mesh_Node) aNode = Handle(ActData_Mesh_Node)::DownCast( aNodesIt.GetValue() );
+      if ( aChangedNodes.Contains( aNode->GetID() ) )
+        this->recordNode( DeltaMType_Removed, Standard_True,
+                          aNode->GetID(), aNode->X(), aNode->Y(), aNode->Z() );
+    }
+  }
+
+  if ( NewMesh.IsNull() )
+    return;
+
+  // Nodes go first as the faces cannot be added without them
+  ActData_Mesh_ElementsIterator aNodesIt(NewMesh, ActData_Mesh_ET_Node);
+  for ( ; aNodesIt.More(); aNodesIt.Next() )
+  {
+    Handle(ActData_Mesh_Node) aNode = Handle(ActData_Mesh_Node)::DownCast( aNodesIt.GetValue() );
+    Handle(ActData_Mesh_Node) anOldNode;
+    if ( !OldMesh.IsNull() )
+      anOldNode = OldMesh->FindNode( aNode->GetID() );
+    //
+    if ( anOldNode.IsNull() || aChangedNodes.Contains( aNode->GetID() ) )
+      this->recordNode( DeltaMType_Added, Standard_True,
+                        aNode->GetID(), aNode->X(), aNode->Y(), aNode->Z() );
+  }
+
+  ActData_Mesh_ElementsIterator anElemsIt(NewMesh, ActData_Mesh_ET_Face);
+  for ( ; anElemsIt.More(); anElemsIt.Next() )
+  {
+    const Handle(ActData_Mesh_Element)& anElem = anElemsIt.GetValue();
+    if ( !isKeptFace(anElem, OldMesh, aChangedNodes) )
+      this->recordElement(DeltaMType_Added, Standard_True, anElem);
+  }
 }
 
 //! Adds the modification request to the internal queue. This request informs
@@ -165,13 +373,7 @@ void ActData_MeshMDelta::AddedNode(const Standard_Integer ID,
                                    const Standard_Real Y,
                                    const Standard_Real Z)
 {
-  Handle(ActData_DeltaMNode) aMNode = new ActData_DeltaMNode();
-  aMNode->ID = ID;
-  aMNode->X = X;
-  aMNode->Y = Y;
-  aMNode->Z = Z;
-
-  m_queue.Append( ActData_DeltaMRequest(DeltaMType_Added, aMNode) );
+  this->recordNode(DeltaMType_Added, Standard_False, ID, X, Y, Z);
 }
 
 //! Adds the modification request to the internal queue. This request informs
@@ -182,14 +384,7 @@ void ActData_MeshMDelta::AddedNode(const Standard_Integer ID,
 void ActData_MeshMDelta::AddedTriangle(const Standard_Integer ID,
                                        Standard_Address Nodes)
 {
-  Standard_Integer* aNodeArr = (Standard_Integer*) Nodes;
-  Handle(ActData_DeltaMTriangle) aMTri = new ActData_DeltaMTriangle();
-  aMTri->ID = ID;
-  aMTri->Nodes[0] = aNodeArr[0];
-  aMTri->Nodes[1] = aNodeArr[1];
-  aMTri->Nodes[2] = aNodeArr[2];
-
-  m_queue.Append( ActData_DeltaMRequest(DeltaMType_Added, aMTri) );
+  this->recordElement(DeltaMType_Added, Standard_False, ID, (Standard_Integer*) Nodes, 3);
 }
 
 //! Adds the modification request to the internal queue. This request informs
@@ -200,51 +395,315 @@ void ActData_MeshMDelta::AddedTriangle(const Standard_Integer ID,
 void ActData_MeshMDelta::AddedQuadrangle(const Standard_Integer ID,
                                          Standard_Address Nodes)
 {
-  Standard_Integer* aNodeArr = (Standard_Integer*) Nodes;
-  Handle(ActData_DeltaMQuadrangle) aMQuad = new ActData_DeltaMQuadrangle();
-  aMQuad->ID = ID;
-  aMQuad->Nodes[0] = aNodeArr[0];
-  aMQuad->Nodes[1] = aNodeArr[1];
-  aMQuad->Nodes[2] = aNodeArr[2];
-  aMQuad->Nodes[3] = aNodeArr[3];
-
-  m_queue.Append( ActData_DeltaMRequest(DeltaMType_Added, aMQuad) );
+  this->recordElement(DeltaMType_Added, Standard_False, ID, (Standard_Integer*) Nodes, 4);
 }
 
 //! Adds the modification request to the internal queue. This request informs
-//! Delta that mesh node with the given ID has been removed from the mesh
-//! data set.
+//! Delta that mesh node with the given ID and co-ordinates has been removed
+//! from the mesh data set.
 //! \param ID [in] node ID.
-void ActData_MeshMDelta::RemovedNode(const Standard_Integer ID)
+//! \param X [in] node X co-ordinate.
+//! \param Y [in] node Y co-ordinate.
+//! \param Z [in] node Z co-ordinate.
+void ActData_MeshMDelta::RemovedNode(const Standard_Integer ID,
+                                     const Standard_Real X,
+                                     const Standard_Real Y,
+                                     const Standard_Real Z)
 {
-  Handle(ActData_DeltaMNode) aMNode = new ActData_DeltaMNode();
-  aMNode->ID = ID;
-
-  m_queue.Append( ActData_DeltaMRequest(DeltaMType_Removed, aMNode) );
+  this->recordNode(DeltaMType_Removed, Standard_False, ID, X, Y, Z);
 }
 
 //! Adds the modification request to the internal queue. This request informs
-//! Delta that mesh triangle element with the given ID has been removed from
-//! the mesh data set.
+//! Delta that mesh triangle element with the given ID and underlying nodes
+//! has been removed from the mesh data set.
 //! \param ID [in] element ID.
-void ActData_MeshMDelta::RemovedTriangle(const Standard_Integer ID)
+//! \param Nodes [in] triple of node IDs.
+void ActData_MeshMDelta::RemovedTriangle(const Standard_Integer ID,
+                                         Standard_Address Nodes)
 {
-  Handle(ActData_DeltaMTriangle) aMTri = new ActData_DeltaMTriangle();
-  aMTri->ID = ID;
+  this->recordElement(DeltaMType_Removed, Standard_False, ID, (Standard_Integer*) Nodes, 3);
+}
 
-  m_queue.Append( ActData_DeltaMRequest(DeltaMType_Removed, aMTri) );
+//! Adds the modification request to the internal queue. This request informs
+//! Delta that mesh quadrangle element with the given ID and underlying nodes
+//! has been removed from the mesh data set.
+//! \param ID [in] element ID.
+//! \param Nodes [in] tetrad of node IDs.
+void ActData_MeshMDelta::RemovedQuadrangle(const Standard_Integer ID,
+                                           Standard_Address Nodes)
+{
+  this->recordElement(DeltaMType_Removed, Standard_False, ID, (Standard_Integer*) Nodes, 4);
 }
 
 //! Adds the modification request to the internal queue. This request informs
-//! Delta that mesh quadrangle element with the given ID has been removed from
-//! the mesh data set.
+//! Delta that mesh node with the given ID has been moved. Both positions are
+//! kept, so the request is replayed backwards without any computations.
+//! \param ID [in] node ID.
+//! \param OldPnt [in] node position before the move.
+//! \param NewPnt [in] node position after the move.
+void ActData_MeshMDelta::MovedNode(const Standard_Integer ID,
+                                   const gp_Pnt& OldPnt,
+                                   const gp_Pnt& NewPnt)
+{
+  this->appendRun(DeltaMType_Moved, DeltaMEntity_Node, Standard_False);
+
+  m_buffers->MovedNodeIDs.push_back(ID);
+  m_buffers->MovedNodeCoords.push_back( OldPnt.X() );
+  m_buffers->MovedNodeCoords.push_back( OldPnt.Y() );
+  m_buffers->MovedNodeCoords.push_back( OldPnt.Z() );
+  m_buffers->MovedNodeCoords.push_back( NewPnt.X() );
+  m_buffers->MovedNodeCoords.push_back( NewPnt.Y() );
+  m_buffers->MovedNodeCoords.push_back( NewPnt.Z() );
+}
+
+//! Informs Delta that the compression tolerance of the Attribute has been
+//! changed. The tolerance before the first change and after the last one
+//! are kept, so the request is dual to itself like the moved nodes.
+//! \param OldTol [in] tolerance before the change.
+//! \param NewTol [in] tolerance after the change.
+void ActData_MeshMDelta::ChangedTolerance(const Standard_Real OldTol,
+                                          const Standard_Real NewTol)
+{
+  if ( !m_bTolChanged )
+  {
+    m_fOldTol     = OldTol;
+    m_bTolChanged = Standard_True;
+  }
+  m_fNewTol = NewTol;
+}
+
+//-----------------------------------------------------------------------------
+// Internal methods
+//-----------------------------------------------------------------------------
+
+//! Records the given node to the packed buffers.
+//! \param type [in] modification type.
+//! \param onCopy [in] whether the request is a part of mesh replacement.
+//! \param ID [in] node ID.
+//! \param X [in] node X co-ordinate.
+//! \param Y [in] node Y co-ordinate.
+//! \param Z [in] node Z co-ordinate.
+void ActData_MeshMDelta::recordNode(const ActData_DeltaMType type,
+                                    const Standard_Boolean onCopy,
+                                    const Standard_Integer ID,
+                                    const Standard_Real X,
+                                    const Standard_Real Y,
+                                    const Standard_Real Z)
+{
+  this->appendRun(type, DeltaMEntity_Node, onCopy);
+
+  m_buffers->NodeIDs.push_back(ID);
+  m_buffers->NodeCoords.push_back(X);
+  m_buffers->NodeCoords.push_back(Y);
+  m_buffers->NodeCoords.push_back(Z);
+}
+
+//! Records the given mesh element to the packed buffers. Only triangles
+//! and quadrangles are recorded.
+//! \param type [in] modification type.
+//! \param onCopy [in] whether the request is a part of mesh replacement.
+//! \param elem [in] mesh element.
+void ActData_MeshMDelta::recordElement(const ActData_DeltaMType type,
+                                       const Standard_Boolean onCopy,
+                                       const Handle(ActData_Mesh_Element)& elem)
+{
+  const Standard_Integer nbNodes = elem->NbNodes();
+  if ( nbNodes != 3 && nbNodes != 4 )
+    return;
+
+  Standard_Integer nodes[4];
+  for ( Standard_Integer r = 0; r < nbNodes; ++r )
+    nodes[r] = elem->GetConnection(r + 1);
+
+  this->recordElement(type, onCopy, elem->GetID(), nodes, nbNodes);
+}
+
+//! Records the given mesh element to the packed buffers.
+//! \param type [in] modification type.
+//! \param onCopy [in] whether the request is a part of mesh replacement.
 //! \param ID [in] element ID.
-void ActData_MeshMDelta::RemovedQuadrangle(const Standard_Integer ID)
+//! \param nodes [in] node IDs.
+//! \param nbNodes [in] number of nodes: 3 for triangle, 4 for quadrangle.
+void ActData_MeshMDelta::recordElement(const ActData_DeltaMType type,
+                                       const Standard_Boolean onCopy,
+                                       const Standard_Integer ID,
+                                       const Standard_Integer* nodes,
+                                       const Standard_Integer nbNodes)
 {
-  Handle(ActData_DeltaMQuadrangle) aMQuad = new ActData_DeltaMQuadrangle();
-  aMQuad->ID = ID;
+  if ( nbNodes == 3 )
+  {
+    this->appendRun(type, DeltaMEntity_Triangle, onCopy);
+    m_buffers->TriangleIDs.push_back(ID);
+    m_buffers->TriangleNodes.insert(m_buffers->TriangleNodes.end(), nodes, nodes + 3);
+  }
+  else
+  {
+    this->appendRun(type, DeltaMEntity_Quadrangle, onCopy);
+    m_buffers->QuadrangleIDs.push_back(ID);
+    m_buffers->QuadrangleNodes.insert(m_buffers->QuadrangleNodes.end(), nodes, nodes + 4);
+  }
+}
+
+//! Accounts for one more record of the given kind which is about to be
+//! appended to the buffers. The record extends the last run if it has
+//! the same type and kind, otherwise a new run is started.
+//! \param type [in] modification type.
+//! \param entity [in] kind of entity.
+//! \param onCopy [in] whether the request is a part of mesh replacement.
+void ActData_MeshMDelta::appendRun(const ActData_DeltaMType type,
+                                   const ActData_DeltaMEntity entity,
+                                   const Standard_Boolean onCopy)
+{
+  if ( m_buffers.IsNull() )
+    m_buffers = new ActData_DeltaMBuffers;
+
+  const Standard_Integer next = m_buffers->NbRecords(type, entity);
+
+  if ( !m_queue.empty() )
+  {
+    ActData_DeltaMRun& last = m_queue.back();
+    if ( last.Type == type && last.Entity == entity && last.OnCopy == onCopy &&
+         last.First + last.Count == next )
+    {
+      ++last.Count;
+      return;
+    }
+  }
 
-  m_queue.Append( ActData_DeltaMRequest(DeltaMType_Removed, aMQuad) );
+  m_queue.push_back( ActData_DeltaMRun(type, entity, onCopy, next) );
+}
+
+//-----------------------------------------------------------------------------
+// Persistence
+//-----------------------------------------------------------------------------
+
+//! Writes the Modification Delta to the passed binary stream. The runs are
+//! written together with the packed entities, the inversion flag and the
+//! changed tolerance (if any), so the Delta read back is applied exactly as
+//! this one. This allows journaling the mesh changes instead of the entire
+//! mesh.
+//! \param theOut [in/out] output stream.
+void ActData_MeshMDelta::Write(Standard_OStream& theOut) const
+{
+  const Standard_Integer aFlags  = (m_bInverted ? 1 : 0) | (m_bTolChanged ? 2 : 0);
+  const Standard_Integer aNbRuns = (Standard_Integer) m_queue.size();
+  theOut.write( (const char*) &aFlags,  sizeof(Standard_Integer) );
+  theOut.write( (const char*) &aNbRuns, sizeof(Standard_Integer) );
+
+  if ( m_bTolChanged )
+  {
+    theOut.write( (const char*) &m_fOldTol, sizeof(Standard_Real) );
+    theOut.write( (const char*) &m_fNewTol, sizeof(Standard_Real) );
+  }
+
+  for ( Standard_Integer k = 0; k < aNbRuns; ++k )
+  {
+    const ActData_DeltaMRun& aRun = m_queue[k];
+    const Standard_Integer aRec[5] = { (Standard_Integer) aRun.Type,
+                                       (Standard_Integer) aRun.Entity,
+                                       aRun.OnCopy ? 1 : 0,
+                                       aRun.First,
+                                       aRun.Count };
+    theOut.write( (const char*) aRec, sizeof(aRec) );
+  }
+
+  if ( !aNbRuns )
+    return;
+
+  writeVector(theOut, m_buffers->NodeIDs);
+  writeVector(theOut, m_buffers->NodeCoords);
+  writeVector(theOut, m_buffers->TriangleIDs);
+  writeVector(theOut, m_buffers->TriangleNodes);
+  writeVector(theOut, m_buffers->QuadrangleIDs);
+  writeVector(theOut, m_buffers->QuadrangleNodes);
+  writeVector(theOut, m_buffers->MovedNodeIDs);
+  writeVector(theOut, m_buffers->MovedNodeCoords);
+}
+
+//! Reads the Modification Delta written by Write() method. The runs which
+//! refer outside the packed entities are rejected.
+//! \param theIn [in/out] input stream.
+//! \return true in case of success, false -- otherwise.
+Standard_Boolean ActData_MeshMDelta::Read(Standard_IStream& theIn)
+{
+  this->Clean();
+
+  Standard_Integer aFlags = 0, aNbRuns = 0;
+  theIn.read( (char*) &aFlags,  sizeof(Standard_Integer) );
+  theIn.read( (char*) &aNbRuns, sizeof(Standard_Integer) );
+  if ( !theIn.good() || aNbRuns < 0 )
+    return Standard_False;
+
+  m_bInverted = (aFlags & 1) != 0;
+
+  if ( aFlags & 2 )
+  {
+    theIn.read( (char*) &m_fOldTol, sizeof(Standard_Real) );
+    theIn.read( (char*) &m_fNewTol, sizeof(Standard_Real) );
+    if ( !theIn.good() )
+    {
+      this->Clean();
+      return Standard_False;
+    }
+    m_bTolChanged = Standard_True;
+  }
+
+  for ( Standard_Integer k = 0; k < aNbRuns; ++k )
+  {
+    Standard_Integer aRec[5];
+    theIn.read( (char*) aRec, sizeof(aRec) );
+    if ( !theIn.good() )
+      return Standard_False;
+
+    if ( aRec[0] < DeltaMType_Added || aRec[0] > DeltaMType_Moved ||
+         aRec[1] < DeltaMEntity_Node || aRec[1] > DeltaMEntity_Quadrangle )
+      return Standard_False;
+
+    ActData_DeltaMRun aRun( (ActData_DeltaMType) aRec[0],
+                            (ActData_DeltaMEntity) aRec[1],
+                            aRec[2] != 0,
+                            aRec[3] );
+    aRun.Count = aRec[4];
+    m_queue.push_back(aRun);
+  }
+
+  if ( !aNbRuns )
+    return Standard_True;
+
+  m_buffers = new ActData_DeltaMBuffers;
+  //
+  if ( !readVector(theIn, m_buffers->NodeIDs)         ||
+       !readVector(theIn, m_buffers->NodeCoords)      ||
+       !readVector(theIn, m_buffers->TriangleIDs)     ||
+       !readVector(theIn, m_buffers->TriangleNodes)   ||
+       !readVector(theIn, m_buffers->QuadrangleIDs)   ||
+       !readVector(theIn, m_buffers->QuadrangleNodes) ||
+       !readVector(theIn, m_buffers->MovedNodeIDs)    ||
+       !readVector(theIn, m_buffers->MovedNodeCoords) )
+  {
+    this->Clean();
+    return Standard_False;
+  }
+
+  // Payload arrays must be consistent with the IDs
+  const Standard_Boolean isConsistent =
+    m_buffers->NodeCoords.size()      == 3*m_buffers->NodeIDs.size()       &&
+    m_buffers->TriangleNodes.size()   == 3*m_buffers->TriangleIDs.size()   &&
+    m_buffers->QuadrangleNodes.size() == 4*m_buffers->QuadrangleIDs.size() &&
+    m_buffers->MovedNodeCoords.size() == 6*m_buffers->MovedNodeIDs.size();
+
+  Standard_Boolean isOk = isConsistent;
+  for ( size_t k = 0; k < m_queue.size() && isOk; ++k )
+  {
+    const ActData_DeltaMRun& aRun = m_queue[k];
+    isOk = aRun.First >= 0 && aRun.Count > 0 &&
+           aRun.First + aRun.Count <= m_buffers->NbRecords(aRun.Type, aRun.Entity);
+  }
+
+  if ( !isOk )
+    this->Clean();
+
+  return isOk;
 }
 
 //-----------------------------------------------------------------------------
@@ -257,14 +716,21 @@ void ActData_MeshMDelta::RemovedQuadrangle(const Standard_Integer ID)
 //! \return affected output stream (just for convenience).
 Standard_OStream& ActData_MeshMDelta::Dump(Standard_OStream& theOut) const
 {
-  theOut << "Iterating in default order: from HEAD to TAIL...\n";
+  theOut << "Iterating in " << (m_bInverted ? "inverted" : "default")
+         << " order: from HEAD to TAIL...\n";
 
-  ActData_DeltaMQueue::Iterator anIt(m_queue);
-  for ( ; anIt.More(); anIt.Next() )
+  const Standard_Integer aNbRuns = (Standard_Integer) m_queue.size();
+  for ( Standard_Integer k = 0; k < aNbRuns; ++k )
   {
-    const ActData_DeltaMRequest& aNextReq = anIt.Value();
-    theOut << " ---> " << aNextReq.Entity->ID;
+    const ActData_DeltaMRun& aRun = m_queue[m_bInverted ? aNbRuns - 1 - k : k];
+    theOut << " ---> " << (aRun.Type == DeltaMType_Added ? "+" : aRun.Type == DeltaMType_Moved ? "~" : "-")
+           << aRun.Count << (aRun.Entity == DeltaMEntity_Node ? " node(s)"
+                           : aRun.Entity == DeltaMEntity_Triangle ? " triangle(s)" : " quadrangle(s)");
   }
+  if ( m_bTolChanged )
+    theOut << " ---> tolerance " << (m_bInverted ? m_fNewTol : m_fOldTol)
+           << " ~ " << (m_bInverted ? m_fOldTol : m_fNewTol);
+
   theOut << "\n\n";
 
   return theOut;
@@ -38,6 +38,8 @@
 #include <ActData_MeshDeltaEntities.h>
 
 // OCCT includes
+#include <gp_Pnt.hxx>
+#include <Standard_IStream.hxx>
 #include <Standard_OStream.hxx>
 #include <TDF_DeltaOnModification.hxx>
 
@@ -49,10 +51,13 @@ DEFINE_STANDARD_HANDLE(ActData_MeshMDelta, TDF_DeltaOnModification)
 //! \ingroup AD_DF
 //!
 //! Modification Delta for Mesh Attribute. Each Modification Delta manages
-//! so called Modification Queue represented internally by simple OCCT
-//! sequence. Modification Queue in-turn stores Modification Requests, all
-//! having dual nature. E.g. Addition Request is dual for Removal Request
-//! and vice versa.
+//! so called Modification Queue of Modification Requests, all having dual
+//! nature. E.g. Addition Request is dual for Removal Request and vice versa.
+//! Consecutive requests of the same kind are packed into runs whose entities
+//! are stored contiguously in typed buffers (see ActData_DeltaMBuffers).
+//! Moved nodes keep both old and new co-ordinates, so such requests are
+//! dual to themselves. The same holds for the change of the compression
+//! tolerance which is kept aside from the runs.
 //!
 //! Conceptually Modification Delta represents an atomic portion of changes
 //! which are to be applied on the actual Mesh DS currently stored in the
@@ -86,6 +91,9 @@ public:
   ActData_EXPORT void
     Invert();
 
+  ActData_EXPORT Standard_Size
+    EstimatedSize() const;
+
 // Modification requests:
 public:
 
@@ -108,13 +116,36 @@ public:
                     Standard_Address Nodes);
 
   ActData_EXPORT void
-    RemovedNode(const Standard_Integer ID);
+    RemovedNode(const Standard_Integer ID,
+                const Standard_Real X,
+                const Standard_Real Y,
+                const Standard_Real Z);
+
+  ActData_EXPORT void
+    RemovedTriangle(const Standard_Integer ID,
+                    Standard_Address Nodes);
+
+  ActData_EXPORT void
+    RemovedQuadrangle(const Standard_Integer ID,
+                      Standard_Address Nodes);
 
   ActData_EXPORT void
-    RemovedTriangle(const Standard_Integer ID);
+    MovedNode(const Standard_Integer ID,
+              const gp_Pnt& OldPnt,
+              const gp_Pnt& NewPnt);
 
   ActData_EXPORT void
-    RemovedQuadrangle(const Standard_Integer ID);
+    ChangedTolerance(const Standard_Real OldTol,
+                     const Standard_Real NewTol);
+
+// Persistence:
+public:
+
+  ActData_EXPORT void
+    Write(Standard_OStream& theOut) const;
+
+  ActData_EXPORT Standard_Boolean
+    Read(Standard_IStream& theIn);
 
 // Debugging:
 public:
@@ -124,9 +155,47 @@ public:
 
 private:
 
-  //! Ordered collection of Modification Requests.
+  void recordNode(const ActData_DeltaMType type,
+                  const Standard_Boolean onCopy,
+                  const Standard_Integer ID,
+                  const Standard_Real X,
+                  const Standard_Real Y,
+                  const Standard_Real Z);
+
+  void recordElement(const ActData_DeltaMType type,
+                     const Standard_Boolean onCopy,
+                     const Handle(ActData_Mesh_Element)& elem);
+
+  void recordElement(const ActData_DeltaMType type,
+                     const Standard_Boolean onCopy,
+                     const Standard_Integer ID,
+                     const Standard_Integer* nodes,
+                     const Standard_Integer nbNodes);
+
+  void appendRun(const ActData_DeltaMType type,
+                 const ActData_DeltaMEntity entity,
+                 const Standard_Boolean onCopy);
+
+private:
+
+  //! Ordered collection of Modification Runs.
   ActData_DeltaMQueue m_queue;
 
+  //! Packed entities referenced by the runs. Shared with the copies.
+  Handle(ActData_DeltaMBuffers) m_buffers;
+
+  //! Indicates whether the queue is to be played backwards with dual requests.
+  Standard_Boolean m_bInverted;
+
+  //! Indicates whether the compression tolerance has been changed.
+  Standard_Boolean m_bTolChanged;
+
+  //! Compression tolerance before the change.
+  Standard_Real m_fOldTol;
+
+  //! Compression tolerance after the change.
+  Standard_Real m_fNewTol;
+
 };
 
 #endif
@@ -0,0 +1,274 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <ActData_MeshPayload.h>
+
+// Active Data includes
+#include <ActData_MeshDriver.h>
+
+// Standard includes
+#include <cstring>
+
+#undef COUT_DEBUG
+
+namespace
+{
+  //! Output stream accumulating the block record of a mesh in memory.
+  class PayloadWriter
+  {
+  public:
+
+    PayloadWriter(std::string& theBytes) : m_bytes(theBytes) {}
+
+    PayloadWriter& operator<<(const Standard_Integer theVal)
+    {
+      m_bytes.append( (const char*) &theVal, sizeof(Standard_Integer) );
+      return *this;
+    }
+
+    PayloadWriter& operator<<(const Standard_Real theVal)
+    {
+      m_bytes.append( (const char*) &theVal, sizeof(Standard_Real) );
+      return *this;
+    }
+
+    void PutByteArray(const Standard_Byte* theArr, const Standard_Integer theLen)
+    {
+      m_bytes.append( (const char*) theArr, theLen );
+    }
+
+    void PutIntArray(const Standard_Integer* theArr, const Standard_Integer theLen)
+    {
+      m_bytes.append( (const char*) theArr, theLen*sizeof(Standard_Integer) );
+    }
+
+    void PutRealArray(const Standard_Real* theArr, const Standard_Integer theLen)
+    {
+      m_bytes.append( (const char*) theArr, theLen*sizeof(Standard_Real) );
+    }
+
+  private:
+
+    std::string& m_bytes;
+  };
+
+  //! Input stream reading the block record of a mesh from memory (e.g. a
+  //! mapped region of the sidecar file). Reading past the end is reported
+  //! by IsOK() like BinObjMgt_Persistent does.
+  class PayloadReader
+  {
+  public:
+
+    PayloadReader(const char* theData, const Standard_Size theSize)
+    : m_pData(theData), m_iSize(theSize), m_iPos(0), m_bOk(Standard_True) {}
+
+    const PayloadReader& operator>>(Standard_Integer& theVal) const
+    {
+      this->get(&theVal, sizeof(Standard_Integer));
+      return *this;
+    }
+
+    const PayloadReader& operator>>(Standard_Real& theVal) const
+    {
+      this->get(&theVal, sizeof(Standard_Real));
+      return *this;
+    }
+
+    void GetByteArray(Standard_Byte* theArr, const Standard_Integer theLen) const
+    {
+      this->get(theArr, theLen);
+    }
+
+    void GetIntArray(Standard_Integer* theArr, const Standard_Integer theLen) const
+    {
+      this->get(theArr, theLen*sizeof(Standard_Integer));
+    }
+
+    void GetRealArray(Standard_Real* theArr, const Standard_Integer theLen) const
+    {
+      this->get(theArr, theLen*sizeof(Standard_Real));
+    }
+
+    Standard_Boolean IsOK() const
+    {
+      return m_bOk;
+    }
+
+  private:
+
+    void get(void* theDst, const Standard_Size theNbBytes) const
+    {
+      if ( !m_bOk || m_iPos + theNbBytes > m_iSize )
+      {
+        m_bOk = Standard_False;
+        memset(theDst, 0, theNbBytes);
+        return;
+      }
+      memcpy(theDst, m_pData + m_iPos, theNbBytes);
+      m_iPos += theNbBytes;
+    }
+
+  private:
+
+    const char*              m_pData;
+    Standard_Size            m_iSize;
+    mutable Standard_Size    m_iPos;
+    mutable Standard_Boolean m_bOk;
+  };
+}
+
+//-----------------------------------------------------------------------------
+// Encoding
+//-----------------------------------------------------------------------------
+
+//! Encodes the passed mesh into the record of ActData_MeshDriver.
+//! \param Mesh      [in]  mesh to encode.
+//! \param Tolerance [in]  compression tolerance (zero for lossless record).
+//! \param Bytes     [out] encoded payload.
+//! \return true in case of success, false -- otherwise.
+Standard_Boolean ActData_MeshPayload::Encode(const Handle(ActData_Mesh)& Mesh,
+                                             const Standard_Real         Tolerance,
+                                             std::string&                Bytes)
+{
+  Bytes.clear();
+  if ( Mesh.IsNull() )
+    return Standard_False;
+
+  Handle(ActData_MeshAttr) aMeshAttr = new ActData_MeshAttr();
+  aMeshAttr->SetMesh(Mesh, Standard_False);
+  aMeshAttr->SetCompressionTolerance(Tolerance, Standard_False);
+
+  PayloadWriter aWriter(Bytes);
+  return ActData_MeshDriver::Write(aMeshAttr, aWriter);
+}
+
+//! Decodes the mesh from the passed payload.
+//! \param Data      [in]     payload bytes.
+//! \param Size      [in]     payload size.
+//! \param Tolerance [in/out] compression tolerance which is replaced by the
+//!                           tolerance of the payload if it is compressed.
+//! \return decoded mesh or null handle if the payload is corrupted.
+Handle(ActData_Mesh) ActData_MeshPayload::Decode(const char*         Data,
+                                                 const Standard_Size Size,
+                                                 Standard_Real&      Tolerance)
+{
+  Handle(ActData_MeshAttr) aMeshAttr = new ActData_MeshAttr();
+  aMeshAttr->DeltaModeOff();
+  aMeshAttr->NewEmptyMesh();
+  aMeshAttr->SetCompressionTolerance(Tolerance, Standard_False);
+
+  PayloadReader aReader(Data, Size);
+  if ( !ActData_MeshDriver::Read(aReader, aMeshAttr) || !aReader.IsOK() )
+    return nullptr;
+
+  Tolerance = aMeshAttr->GetCompressionTolerance();
+  return aMeshAttr->GetMesh();
+}
+
+//-----------------------------------------------------------------------------
+// Construction
+//-----------------------------------------------------------------------------
+
+//! Constructor.
+//! \param Store  [in] sidecar store holding the payload.
+//! \param Offset [in] offset of the payload in the sidecar file.
+//! \param Size   [in] size of the payload in bytes.
+//! \param Hash   [in] content hash of the payload.
+ActData_MeshPayload::ActData_MeshPayload(const Handle(ActData_MeshPayloadStore)& Store,
+                                         const Standard_Size                     Offset,
+                                         const Standard_Size                     Size,
+                                         const Standard_Size                     Hash)
+: Standard_Transient (),
+  m_store            (Store),
+  m_iOffset          (Offset),
+  m_iSize            (Size),
+  m_iHash            (Hash)
+{}
+
+//! Constructs the unresolved reference to the payload kept in the sidecar
+//! file with the given name.
+//! \param Name   [in] name of the sidecar file (see ActData_MeshPayloadStore::Name()).
+//! \param Offset [in] offset of the payload in the sidecar file.
+//! \param Size   [in] size of the payload in bytes.
+//! \param Hash   [in] content hash of the payload.
+ActData_MeshPayload::ActData_MeshPayload(const TCollection_AsciiString& Name,
+                                         const Standard_Size            Offset,
+                                         const Standard_Size            Size,
+                                         const Standard_Size            Hash)
+: Standard_Transient (),
+  m_name             (Name),
+  m_iOffset          (Offset),
+  m_iSize            (Size),
+  m_iHash            (Hash)
+{}
+
+//-----------------------------------------------------------------------------
+// Resolution
+//-----------------------------------------------------------------------------
+
+//! Binds the unresolved reference to the passed store of the Document, or
+//! to its sibling if the payload was saved to another sidecar file.
+//! \param Store [in] sidecar store of the Document.
+//! \return resolved payload or null handle if there is no such payload.
+Handle(ActData_MeshPayload)
+  ActData_MeshPayload::Resolve(const Handle(ActData_MeshPayloadStore)& Store) const
+{
+  if ( Store.IsNull() )
+    return nullptr;
+
+  return Store->Sibling(m_name)->Get(m_iOffset, m_iSize, m_iHash);
+}
+
+//-----------------------------------------------------------------------------
+// Materialization
+//-----------------------------------------------------------------------------
+
+//! Reads the payload from the mapped sidecar file and restores the mesh.
+//! The content hash is verified, so that a sidecar file which does not
+//! match the Document is not silently accepted.
+//! \param Tolerance [in/out] compression tolerance (see Decode()).
+//! \return restored mesh or null handle in case of failure.
+Handle(ActData_Mesh) ActData_MeshPayload::Materialize(Standard_Real& Tolerance) const
+{
+  if ( m_store.IsNull() )
+    return nullptr;
+
+  const char* aData = m_store->Data(m_iOffset, m_iSize);
+  if ( !aData )
+    return nullptr;
+
+  if ( ActData_MeshPayloadStore::Hash(aData, m_iSize) != m_iHash )
+    return nullptr;
+
+  return Decode(aData, m_iSize, Tolerance);
+}
@@ -0,0 +1,137 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+#ifndef ActData_MeshPayload_HeaderFile
+#define ActData_MeshPayload_HeaderFile
+
+// Active Data includes
+#include <ActData_MeshPayloadStore.h>
+
+// Mesh includes
+#include <ActData_Mesh.h>
+
+DEFINE_STANDARD_HANDLE(ActData_MeshPayload, Standard_Transient)
+
+//! \ingroup AD_DF
+//!
+//! Reference to a mesh payload kept in a sidecar file. The payload is the
+//! mesh record of ActData_MeshDriver, so a mesh is restored from it with
+//! the same bulk construction as from the Document.
+//!
+//! A reference read from the Document only knows the name of its sidecar
+//! file. It is bound to the store of the Document by Resolve() once the
+//! Document is opened.
+class ActData_MeshPayload : public Standard_Transient
+{
+public:
+
+  // OCCT RTTI
+  DEFINE_STANDARD_RTTI_INLINE(ActData_MeshPayload, Standard_Transient)
+
+public:
+
+  ActData_EXPORT static Standard_Boolean
+    Encode(const Handle(ActData_Mesh)& Mesh,
+           const Standard_Real         Tolerance,
+           std::string&                Bytes);
+
+  ActData_EXPORT static Handle(ActData_Mesh)
+    Decode(const char*         Data,
+           const Standard_Size Size,
+           Standard_Real&      Tolerance);
+
+public:
+
+  ActData_EXPORT
+    ActData_MeshPayload(const Handle(ActData_MeshPayloadStore)& Store,
+                        const Standard_Size                     Offset,
+                        const Standard_Size                     Size,
+                        const Standard_Size                     Hash);
+
+  ActData_EXPORT
+    ActData_MeshPayload(const TCollection_AsciiString& Name,
+                        const Standard_Size            Offset,
+                        const Standard_Size            Size,
+                        const Standard_Size            Hash);
+
+public:
+
+  ActData_EXPORT Handle(ActData_MeshPayload)
+    Resolve(const Handle(ActData_MeshPayloadStore)& Store) const;
+
+  ActData_EXPORT Handle(ActData_Mesh)
+    Materialize(Standard_Real& Tolerance) const;
+
+public:
+
+  //! \return sidecar store holding the payload (null if the payload is
+  //!         not resolved yet).
+  const Handle(ActData_MeshPayloadStore)& Store() const
+  {
+    return m_store;
+  }
+
+  //! \return true if the payload is bound to its sidecar store.
+  Standard_Boolean IsResolved() const
+  {
+    return !m_store.IsNull();
+  }
+
+  //! \return offset of the payload in the sidecar file.
+  Standard_Size Offset() const
+  {
+    return m_iOffset;
+  }
+
+  //! \return size of the payload in bytes.
+  Standard_Size Size() const
+  {
+    return m_iSize;
+  }
+
+  //! \return content hash of the payload.
+  Standard_Size Hash() const
+  {
+    return m_iHash;
+  }
+
+protected:
+
+  Handle(ActData_MeshPayloadStore) m_store;   //!< Sidecar store.
+  TCollection_AsciiString          m_name;    //!< Name of the sidecar file to resolve against.
+  Standard_Size                    m_iOffset; //!< Offset in the sidecar file.
+  Standard_Size                    m_iSize;   //!< Size in bytes.
+  Standard_Size                    m_iHash;   //!< Content hash.
+
+};
+
+#endif
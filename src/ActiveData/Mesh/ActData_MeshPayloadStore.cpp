@@ -0,0 +1,459 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <ActData_MeshPayloadStore.h>
+
+// Active Data includes
+#include <ActData_MeshPayload.h>
+
+// Standard includes
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#undef COUT_DEBUG
+
+//-----------------------------------------------------------------------------
+// Binary format
+//-----------------------------------------------------------------------------
+
+//! Signature of the sidecar file. The last character is the format version.
+#define PAYLOAD_SIGNATURE "ADP1"
+#define PAYLOAD_SIGNATURE_SIZE 4
+
+//! Marker of the byte order the sidecar file was written with.
+#define PAYLOAD_BYTE_ORDER 0x01020304
+
+//! Size of the file header: signature and byte order marker.
+#define PAYLOAD_FILE_HEADER_SIZE 8
+
+//! Tag opening each blob.
+#define PAYLOAD_BLOB_TAG 0x42504441
+
+//! Size of the blob header: tag, reserved field, size and hash.
+#define PAYLOAD_BLOB_HEADER_SIZE 24
+
+namespace
+{
+  //! Header preceding every blob in the sidecar file.
+  struct t_blobHeader
+  {
+    int                tag;      //!< PAYLOAD_BLOB_TAG.
+    int                reserved; //!< Not used.
+    unsigned long long size;     //!< Size of the blob data.
+    unsigned long long hash;     //!< Content hash of the blob data.
+  };
+
+  //! \return size of the given file or 0 if the file does not exist.
+  Standard_Size fileSize(const TCollection_AsciiString& theFilename)
+  {
+    std::ifstream FILE( theFilename.ToCString(), std::ios::in | std::ios::binary | std::ios::ate );
+    if ( !FILE.is_open() )
+      return 0;
+
+    return (Standard_Size) FILE.tellg();
+  }
+
+  //! Writes an empty sidecar file.
+  Standard_Boolean writeHeader(const TCollection_AsciiString& theFilename)
+  {
+    std::ofstream FILE( theFilename.ToCString(), std::ios::out | std::ios::binary | std::ios::trunc );
+    if ( !FILE.is_open() )
+      return Standard_False;
+
+    const int byteOrder = PAYLOAD_BYTE_ORDER;
+    FILE.write(PAYLOAD_SIGNATURE, PAYLOAD_SIGNATURE_SIZE);
+    FILE.write( (const char*) &byteOrder, sizeof(int) );
+    return FILE.good();
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Static services
+//-----------------------------------------------------------------------------
+
+//! FNV-1a content hash.
+//! \param Data [in] bytes to hash.
+//! \param Size [in] number of bytes.
+//! \return hash value.
+Standard_Size ActData_MeshPayloadStore::Hash(const char*         Data,
+                                             const Standard_Size Size)
+{
+  unsigned long long hash = 14695981039346656037ull;
+  for ( Standard_Size i = 0; i < Size; ++i )
+  {
+    hash ^= (unsigned char) Data[i];
+    hash *= 1099511628211ull;
+  }
+  return (Standard_Size) hash;
+}
+
+//-----------------------------------------------------------------------------
+// Construction & destruction
+//-----------------------------------------------------------------------------
+
+//! Constructor.
+//! \param Filename [in] name of the sidecar file.
+ActData_MeshPayloadStore::ActData_MeshPayloadStore(const TCollection_AsciiString& Filename)
+: Standard_Transient (),
+  m_filename         (Filename),
+  m_bOpen            (Standard_False),
+  m_iSize            (0),
+  m_pMapped          (NULL),
+  m_iMapped          (0),
+  m_hMapping         (NULL)
+{}
+
+//! Destructor.
+ActData_MeshPayloadStore::~ActData_MeshPayloadStore()
+{
+  this->Close();
+  this->unmap();
+}
+
+//-----------------------------------------------------------------------------
+// File management
+//-----------------------------------------------------------------------------
+
+//! Opens the sidecar file for appending. The blobs which are already in
+//! the file are indexed by their hashes, so that they are not written once
+//! again. Indexing stops at a torn blob (if any): the blobs appended after
+//! it are still readable but are not reused.
+//! \param toTruncate [in] true to start the file over. Do not truncate a file
+//!                       which is mapped by another store.
+//! \return true in case of success, false -- otherwise.
+Standard_Boolean ActData_MeshPayloadStore::Open(const Standard_Boolean toTruncate)
+{
+  this->Close();
+  this->unmap();
+  m_index.clear();
+
+  Standard_Boolean isValid = Standard_False;
+  if ( !toTruncate )
+  {
+    std::ifstream FILE( m_filename.ToCString(), std::ios::in | std::ios::binary );
+    if ( FILE.is_open() )
+    {
+      char signature[PAYLOAD_SIGNATURE_SIZE];
+      int  byteOrder = 0;
+      FILE.read(signature, PAYLOAD_SIGNATURE_SIZE);
+      FILE.read( (char*) &byteOrder, sizeof(int) );
+
+      isValid = FILE.good()
+             && memcmp(signature, PAYLOAD_SIGNATURE, PAYLOAD_SIGNATURE_SIZE) == 0
+             && byteOrder == PAYLOAD_BYTE_ORDER;
+    }
+
+    if ( isValid )
+    {
+      m_iSize = fileSize(m_filename);
+
+      // Only the headers are read here
+      Standard_Size pos = PAYLOAD_FILE_HEADER_SIZE;
+      while ( pos + PAYLOAD_BLOB_HEADER_SIZE <= m_iSize )
+      {
+        t_blobHeader header;
+        FILE.seekg(pos);
+        FILE.read( (char*) &header, PAYLOAD_BLOB_HEADER_SIZE );
+
+        const Standard_Size data = pos + PAYLOAD_BLOB_HEADER_SIZE;
+        if ( !FILE.good() || header.tag != PAYLOAD_BLOB_TAG || data + header.size > m_iSize )
+          break; // Torn blob
+
+        t_blob blob;
+        blob.offset = data;
+        blob.size   = (Standard_Size) header.size;
+        m_index.insert( std::make_pair( (Standard_Size) header.hash, blob ) );
+
+        pos = data + blob.size;
+      }
+    }
+  }
+
+  if ( !isValid )
+  {
+    if ( !writeHeader(m_filename) )
+      return Standard_False;
+
+    m_iSize = PAYLOAD_FILE_HEADER_SIZE;
+  }
+
+  m_out.open( m_filename.ToCString(), std::ios::out | std::ios::binary | std::ios::app );
+  if ( !m_out.is_open() )
+    return Standard_False;
+
+  m_bOpen = Standard_True;
+  return Standard_True;
+}
+
+//! Closes the sidecar file for appending. The payloads remain readable.
+void ActData_MeshPayloadStore::Close()
+{
+  if ( m_out.is_open() )
+    m_out.close();
+
+  m_bOpen = Standard_False;
+}
+
+//-----------------------------------------------------------------------------
+// Payloads
+//-----------------------------------------------------------------------------
+
+//! Puts the passed bytes to the store unless a blob with the same content
+//! is already there.
+//! \param Bytes [in] payload to put.
+//! \return reference to the stored payload or null handle in case of failure.
+Handle(ActData_MeshPayload) ActData_MeshPayloadStore::Put(const std::string& Bytes)
+{
+  if ( !m_bOpen )
+    return nullptr;
+
+  const Standard_Size aSize = Bytes.size();
+  const Standard_Size aHash = Hash(Bytes.data(), aSize);
+
+  // Reuse the blob with the same content
+  typedef std::multimap<Standard_Size, t_blob>::const_iterator t_it;
+  std::pair<t_it, t_it> aRange = m_index.equal_range(aHash);
+  for ( t_it it = aRange.first; it != aRange.second; ++it )
+  {
+    if ( it->second.size != aSize )
+      continue;
+
+    const char* aData = this->Data(it->second.offset, aSize);
+    if ( aData && memcmp(aData, Bytes.data(), aSize) == 0 )
+      return new ActData_MeshPayload(this, it->second.offset, aSize, aHash);
+  }
+
+  // Append a new blob
+  t_blobHeader header;
+  header.tag      = PAYLOAD_BLOB_TAG;
+  header.reserved = 0;
+  header.size     = aSize;
+  header.hash     = aHash;
+
+  m_out.write( (const char*) &header, PAYLOAD_BLOB_HEADER_SIZE );
+  m_out.write( Bytes.data(), aSize );
+  m_out.flush();
+  //
+  if ( !m_out.good() )
+    return nullptr;
+
+  t_blob blob;
+  blob.offset = m_iSize + PAYLOAD_BLOB_HEADER_SIZE;
+  blob.size   = aSize;
+  m_index.insert( std::make_pair(aHash, blob) );
+  m_iSize = blob.offset + aSize;
+
+  return new ActData_MeshPayload(this, blob.offset, aSize, aHash);
+}
+
+//! Puts the payload residing in another store to this one. The payload is
+//! copied as is without decoding the mesh.
+//! \param Payload [in] payload to put.
+//! \return reference to the stored payload or null handle in case of failure.
+Handle(ActData_MeshPayload)
+  ActData_MeshPayloadStore::Put(const Handle(ActData_MeshPayload)& Payload)
+{
+  if ( Payload->Store().operator->() == this )
+    return Payload;
+
+  const char* aData = Payload->Store()->Data( Payload->Offset(), Payload->Size() );
+  if ( !aData )
+    return nullptr;
+
+  return this->Put( std::string( aData, Payload->Size() ) );
+}
+
+//! Returns the reference to the payload stored at the given location. The
+//! location is checked against the blob header, so that a reference which
+//! does not fit the sidecar file is rejected early.
+//! \param Offset [in] offset of the payload.
+//! \param Size   [in] size of the payload.
+//! \param Hash   [in] content hash of the payload.
+//! \return reference to the payload or null handle if the blob is not found.
+Handle(ActData_MeshPayload) ActData_MeshPayloadStore::Get(const Standard_Size Offset,
+                                                          const Standard_Size Size,
+                                                          const Standard_Size Hash)
+{
+  if ( Offset < PAYLOAD_FILE_HEADER_SIZE + PAYLOAD_BLOB_HEADER_SIZE )
+    return nullptr;
+
+  const char* aHeader = this->Data(Offset - PAYLOAD_BLOB_HEADER_SIZE, PAYLOAD_BLOB_HEADER_SIZE + Size);
+  if ( !aHeader )
+    return nullptr;
+
+  t_blobHeader header;
+  memcpy(&header, aHeader, PAYLOAD_BLOB_HEADER_SIZE);
+  //
+  if ( header.tag != PAYLOAD_BLOB_TAG || header.size != Size || (Standard_Size) header.hash != Hash )
+    return nullptr;
+
+  return new ActData_MeshPayload(this, Offset, Size, Hash);
+}
+
+//! Returns the store of another sidecar file residing in the same
+//! directory. If there is no such file, this store is returned, so that
+//! a Document renamed together with its sidecar file is still readable.
+//! \param Name [in] name of the sidecar file without directory.
+//! \return sidecar store.
+Handle(ActData_MeshPayloadStore)
+  ActData_MeshPayloadStore::Sibling(const TCollection_AsciiString& Name)
+{
+  if ( Name.IsEmpty() || Name == this->Name() )
+    return this;
+
+  std::map<std::string, Handle(ActData_MeshPayloadStore)>::iterator
+    it = m_siblings.find( Name.ToCString() );
+  //
+  if ( it != m_siblings.end() )
+    return it->second;
+
+  TCollection_AsciiString aFilename = m_filename;
+  aFilename.Trunc( m_filename.Length() - this->Name().Length() );
+  aFilename += Name;
+
+  if ( !fileSize(aFilename) )
+    return this;
+
+  Handle(ActData_MeshPayloadStore) aSibling = new ActData_MeshPayloadStore(aFilename);
+  m_siblings.insert( std::make_pair( std::string( Name.ToCString() ), aSibling ) );
+  return aSibling;
+}
+
+//! Returns the pointer to the mapped contents of the sidecar file. The
+//! file is (re)mapped on demand, so the returned pointer is valid until
+//! the next call.
+//! \param Offset [in] offset of the requested region.
+//! \param Size   [in] size of the requested region.
+//! \return pointer to the region or null if it is out of the file.
+const char* ActData_MeshPayloadStore::Data(const Standard_Size Offset,
+                                           const Standard_Size Size)
+{
+  if ( Offset + Size > m_iMapped )
+  {
+    if ( m_out.is_open() )
+      m_out.flush();
+
+    if ( !this->map( fileSize(m_filename) ) )
+      return NULL;
+  }
+
+  if ( Offset + Size > m_iMapped )
+    return NULL;
+
+  return m_pMapped + Offset;
+}
+
+//! \return name of the sidecar file without directory.
+TCollection_AsciiString ActData_MeshPayloadStore::Name() const
+{
+  Standard_Integer aSlash = Max( m_filename.SearchFromEnd("/"), m_filename.SearchFromEnd("\\") );
+  if ( aSlash < 0 )
+    return m_filename;
+
+  return m_filename.SubString( aSlash + 1, m_filename.Length() );
+}
+
+//-----------------------------------------------------------------------------
+// Mapping
+//-----------------------------------------------------------------------------
+
+//! Maps the first bytes of the sidecar file for reading.
+//! \param Size [in] number of bytes to map.
+//! \return true in case of success, false -- otherwise.
+Standard_Boolean ActData_MeshPayloadStore::map(const Standard_Size Size)
+{
+  this->unmap();
+
+  if ( !Size )
+    return Standard_False;
+
+#ifdef _WIN32
+  HANDLE hFile = CreateFileA( m_filename.ToCString(), GENERIC_READ,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+  if ( hFile == INVALID_HANDLE_VALUE )
+    return Standard_False;
+
+  HANDLE hMapping = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+  CloseHandle(hFile);
+  if ( !hMapping )
+    return Standard_False;
+
+  void* pData = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, Size);
+  if ( !pData )
+  {
+    CloseHandle(hMapping);
+    return Standard_False;
+  }
+  m_hMapping = hMapping;
+#else
+  const int fd = open(m_filename.ToCString(), O_RDONLY);
+  if ( fd < 0 )
+    return Standard_False;
+
+  void* pData = mmap(NULL, Size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if ( pData == MAP_FAILED )
+    return Standard_False;
+#endif
+
+  m_pMapped = (const char*) pData;
+  m_iMapped = Size;
+  return Standard_True;
+}
+
+//! Unmaps the sidecar file.
+void ActData_MeshPayloadStore::unmap()
+{
+  if ( !m_pMapped )
+    return;
+
+#ifdef _WIN32
+  UnmapViewOfFile(m_pMapped);
+  CloseHandle( (HANDLE) m_hMapping );
+  m_hMapping = NULL;
+#else
+  munmap( (void*) m_pMapped, m_iMapped );
+#endif
+
+  m_pMapped = NULL;
+  m_iMapped = 0;
+}
@@ -0,0 +1,171 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+#ifndef ActData_MeshPayloadStore_HeaderFile
+#define ActData_MeshPayloadStore_HeaderFile
+
+// Active Data includes
+#include <ActData_Common.h>
+
+// OCCT includes
+#include <TCollection_AsciiString.hxx>
+
+// Standard includes
+#include <fstream>
+#include <map>
+#include <string>
+
+DEFINE_STANDARD_HANDLE(ActData_MeshPayloadStore, Standard_Transient)
+
+class ActData_MeshPayload;
+
+//! \ingroup AD_DF
+//!
+//! Sidecar file keeping mesh payloads out of the Document. The file is a
+//! sequence of blobs, each prefixed with its size and content hash. Blobs
+//! are only appended, so the payloads referenced from the previous saves
+//! remain valid, and a blob with the same content is never written twice.
+//!
+//! The file is memory-mapped for reading, so opening a Document costs
+//! nothing for its meshes: a payload is decoded only when its mesh is
+//! requested for the first time (see ActData_MeshAttr::GetMesh()).
+//!
+//! The store belongs to a single Document. While the Document is being
+//! saved, the store is found by the Mesh Attribute driver on the Document's
+//! state (see ActData_DocumentStateAttr). If the Document has no store,
+//! meshes are embedded into it. On opening, the driver reads unresolved
+//! payload references, which the Data Model then binds to its store (see
+//! ActData_MeshPayload::Resolve()).
+class ActData_MeshPayloadStore : public Standard_Transient
+{
+public:
+
+  // OCCT RTTI
+  DEFINE_STANDARD_RTTI_INLINE(ActData_MeshPayloadStore, Standard_Transient)
+
+public:
+
+  ActData_EXPORT static Standard_Size
+    Hash(const char* Data, const Standard_Size Size);
+
+public:
+
+  ActData_EXPORT
+    ActData_MeshPayloadStore(const TCollection_AsciiString& Filename);
+
+  ActData_EXPORT
+    ~ActData_MeshPayloadStore();
+
+public:
+
+  ActData_EXPORT Standard_Boolean
+    Open(const Standard_Boolean toTruncate);
+
+  ActData_EXPORT void
+    Close();
+
+  ActData_EXPORT Handle(ActData_MeshPayload)
+    Put(const std::string& Bytes);
+
+  ActData_EXPORT Handle(ActData_MeshPayload)
+    Put(const Handle(ActData_MeshPayload)& Payload);
+
+  ActData_EXPORT Handle(ActData_MeshPayload)
+    Get(const Standard_Size Offset,
+        const Standard_Size Size,
+        const Standard_Size Hash);
+
+  ActData_EXPORT Handle(ActData_MeshPayloadStore)
+    Sibling(const TCollection_AsciiString& Name);
+
+  ActData_EXPORT const char*
+    Data(const Standard_Size Offset,
+         const Standard_Size Size);
+
+  ActData_EXPORT TCollection_AsciiString
+    Name() const;
+
+public:
+
+  //! \return name of the sidecar file.
+  const TCollection_AsciiString& GetFilename() const
+  {
+    return m_filename;
+  }
+
+  //! \return true if the store is open.
+  Standard_Boolean IsOpen() const
+  {
+    return m_bOpen;
+  }
+
+  //! \return number of distinct payloads in the store.
+  Standard_Integer NbPayloads() const
+  {
+    return (Standard_Integer) m_index.size();
+  }
+
+  //! \return size of the sidecar file in bytes.
+  Standard_Size Size() const
+  {
+    return m_iSize;
+  }
+
+protected:
+
+  Standard_Boolean map(const Standard_Size Size);
+  void             unmap();
+
+protected:
+
+  //! Location of a blob in the sidecar file.
+  struct t_blob
+  {
+    Standard_Size offset; //!< Offset of the blob data.
+    Standard_Size size;   //!< Size of the blob data.
+  };
+
+  TCollection_AsciiString               m_filename; //!< Sidecar file.
+  Standard_Boolean                      m_bOpen;    //!< Whether the store is open.
+  Standard_Size                         m_iSize;    //!< Size of the file.
+  std::ofstream                         m_out;      //!< Stream for appending.
+  std::multimap<Standard_Size, t_blob>  m_index;    //!< Blobs by content hash.
+  const char*                           m_pMapped;  //!< Mapped file contents.
+  Standard_Size                         m_iMapped;  //!< Size of the mapped region.
+  void*                                 m_hMapping; //!< Platform mapping handle.
+
+  //! Stores of the other sidecar files in the same directory.
+  std::map<std::string, Handle(ActData_MeshPayloadStore)> m_siblings;
+
+};
+
+#endif
@@ -0,0 +1,474 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <ActData_MeshTopology.h>
+
+// Mesh includes
+#include <ActData_Mesh_ElementsIterator.h>
+#include <ActData_Mesh_Parallel.h>
+
+// OCCT includes
+#include <gp_XYZ.hxx>
+#include <NCollection_DataMap.hxx>
+
+// STL includes
+#include <cmath>
+#include <functional>
+
+namespace
+{
+  //! Side of a face. The key packs the IDs of both nodes, the lesser
+  //! one in the high half, so that the sides of different faces lying on
+  //! the same edge get equal keys.
+  struct t_halfEdge
+  {
+    unsigned long long Key;  //!< Packed IDs of nodes.
+    Standard_Integer   Face; //!< Index of the face (-1 for unused slots).
+    Standard_Integer   Side; //!< 0-based index of the side in the face.
+
+    bool operator<(const t_halfEdge& other) const
+    {
+      if ( Key != other.Key )
+        return Key < other.Key;
+      if ( Face != other.Face )
+        return Face < other.Face;
+      return Side < other.Side;
+    }
+  };
+
+  //! Unused slot of the fourth side of a triangle. Such slots go last
+  //! after sorting.
+  const unsigned long long NoKey = ~0ULL;
+
+  //! Loop body generating the sides of a face.
+  struct GenerateHalfEdges
+  {
+    const Standard_Integer* FaceNodes; //!< Four node indices per face.
+    const Standard_Integer* NodeIDs;   //!< Node IDs by index.
+    t_halfEdge*             Result;    //!< Four slots per face.
+
+    void operator()(const Standard_Integer f) const
+    {
+      const Standard_Integer* c  = FaceNodes + 4*f;
+      const Standard_Integer  nb = (c[3] < 0) ? 3 : 4;
+
+      for ( Standard_Integer k = 0; k < 4; ++k )
+      {
+        t_halfEdge& he = Result[4*f + k];
+        he.Face = f;
+        he.Side = k;
+
+        if ( k >= nb )
+        {
+          he.Key = NoKey;
+          continue;
+        }
+
+        const unsigned long long a = (unsigned int) NodeIDs[c[k]];
+        const unsigned long long b = (unsigned int) NodeIDs[c[(k + 1) % nb]];
+        he.Key = (a < b) ? ( (a << 32) | b ) : ( (b << 32) | a );
+      }
+    }
+  };
+
+  //! Loop body marking the edges whose dihedral angle exceeds the
+  //! threshold.
+  struct MarkFeatures
+  {
+    const ActData_MeshTopology* Topology; //!< Edge table.
+    Standard_Real               Angle;    //!< Threshold.
+    std::vector<char>*          Flags;    //!< One flag per edge.
+
+    void operator()(const Standard_Integer e) const
+    {
+      (*Flags)[e] = ( Topology->NbEdgeFaces(e) == 2 && Topology->DihedralAngle(e) > Angle ) ? 1 : 0;
+    }
+  };
+}
+
+//-----------------------------------------------------------------------------
+// Construction
+//-----------------------------------------------------------------------------
+
+//! Builds the edge table for the passed mesh. Only triangles and
+//! quadrangles are taken into account.
+//! \param Mesh [in] Mesh DS to build the table for.
+ActData_MeshTopology::ActData_MeshTopology(const Handle(ActData_Mesh)& Mesh)
+: Standard_Transient (),
+  m_pMesh            ( Mesh.get() ),
+  m_iNbMeshNodes     ( Mesh->NbNodes() ),
+  m_iNbMeshFaces     ( Mesh->NbFaces() )
+{
+  /* ========================
+   *  Gather nodes and faces
+   * ======================== */
+
+  std::vector<Standard_Integer> aNodeIDs;
+  aNodeIDs.reserve(m_iNbMeshNodes);
+  m_nodes.reserve(m_iNbMeshNodes);
+
+  NCollection_DataMap<Standard_Integer, Standard_Integer> anIndexByID;
+
+  ActData_Mesh_ElementsIterator aNodesIt(Mesh, ActData_Mesh_ET_Node);
+  for ( ; aNodesIt.More(); aNodesIt.Next() )
+  {
+    Handle(ActData_Mesh_Node) aNode = Handle(ActData_Mesh_Node)::DownCast( aNodesIt.GetValue() );
+
+    anIndexByID.Bind( aNode->GetID(), (Standard_Integer) m_nodes.size() );
+    m_nodes.push_back(aNode);
+    aNodeIDs.push_back( aNode->GetID() );
+  }
+
+  m_faceIDs.reserve(m_iNbMeshFaces);
+  m_faceNodes.reserve(4*m_iNbMeshFaces);
+
+  ActData_Mesh_ElementsIterator aFacesIt(Mesh, ActData_Mesh_ET_Face);
+  for ( ; aFacesIt.More(); aFacesIt.Next() )
+  {
+    const Handle(ActData_Mesh_Element)& aFace = aFacesIt.GetValue();
+
+    const Standard_Integer aNbNodes = aFace->NbNodes();
+    if ( aNbNodes != 3 && aNbNodes != 4 )
+      continue;
+
+    Standard_Integer aNodes[4] = {-1, -1, -1, -1};
+    Standard_Boolean isOk      = Standard_True;
+    for ( Standard_Integer k = 0; k < aNbNodes && isOk; ++k )
+    {
+      const Standard_Integer* pIndex = anIndexByID.Seek( aFace->GetConnection(k + 1) );
+      if ( pIndex )
+        aNodes[k] = *pIndex;
+      else
+        isOk = Standard_False;
+    }
+
+    if ( !isOk )
+      continue;
+
+    m_faceIDs.push_back( aFace->GetID() );
+    m_faceNodes.insert(m_faceNodes.end(), aNodes, aNodes + 4);
+  }
+
+  const Standard_Integer aNbFaces = (Standard_Integer) m_faceIDs.size();
+
+  m_edgeOffsets.push_back(0);
+  m_loopOffsets.push_back(0);
+  if ( !aNbFaces )
+    return;
+
+  /* ==================================
+   *  Sort half-edges to find the twins
+   * ================================== */
+
+  std::vector<t_halfEdge> aHalfEdges(4*aNbFaces);
+  GenerateHalfEdges aGenerate = { &m_faceNodes[0], &aNodeIDs[0], &aHalfEdges[0] };
+  ActData_Mesh_ParallelFor(0, aNbFaces, aGenerate);
+  ActData_Mesh_ParallelSort( aHalfEdges.begin(), aHalfEdges.end(), std::less<t_halfEdge>() );
+
+  /* ==========================
+   *  Collapse twins into edges
+   * ========================== */
+
+  for ( Standard_Size i = 0; i < aHalfEdges.size() && aHalfEdges[i].Key != NoKey; )
+  {
+    const unsigned long long aKey = aHalfEdges[i].Key;
+    const Standard_Integer   E    = this->NbEdges();
+
+    const Standard_Integer n1 = (Standard_Integer) (aKey >> 32);
+    const Standard_Integer n2 = (Standard_Integer) (aKey & 0xffffffffULL);
+    m_edgeNodes.push_back(n1);
+    m_edgeNodes.push_back(n2);
+
+    for ( ; i < aHalfEdges.size() && aHalfEdges[i].Key == aKey; ++i )
+    {
+      const t_halfEdge&       he = aHalfEdges[i];
+      const Standard_Integer* c  = &m_faceNodes[4*he.Face];
+      const Standard_Integer  nb = (c[3] < 0) ? 3 : 4;
+
+      m_edgeFaces.push_back(he.Face);
+      m_edgeForward.push_back( aNodeIDs[c[he.Side]] == n1 && aNodeIDs[c[(he.Side + 1) % nb]] == n2 );
+    }
+    m_edgeOffsets.push_back( (Standard_Integer) m_edgeFaces.size() );
+
+    const Standard_Integer aNbEdgeFaces = this->NbEdgeFaces(E);
+    if ( aNbEdgeFaces == 1 )
+      m_boundary.push_back(E);
+    else if ( aNbEdgeFaces > 2 )
+      m_nonManifold.push_back(E);
+  }
+
+  this->buildLoops();
+}
+
+//-----------------------------------------------------------------------------
+// Queries
+//-----------------------------------------------------------------------------
+
+//! Checks whether the table was built for the passed Mesh DS and the
+//! numbers of its nodes and faces have not changed since then.
+//! \param Mesh [in] Mesh DS to check.
+//! \return true if the table can be used.
+Standard_Boolean ActData_MeshTopology::IsConsistent(const Handle(ActData_Mesh)& Mesh) const
+{
+  return Mesh.get() == m_pMesh &&
+         Mesh->NbNodes() == m_iNbMeshNodes &&
+         Mesh->NbFaces() == m_iNbMeshFaces;
+}
+
+//! Finds the edge connecting the given nodes.
+//! \param N1 [in] ID of the first node.
+//! \param N2 [in] ID of the second node.
+//! \return 0-based index of the edge or -1 if there is no such edge.
+Standard_Integer ActData_MeshTopology::FindEdge(const Standard_Integer N1,
+                                                const Standard_Integer N2) const
+{
+  const Standard_Integer a = Min(N1, N2);
+  const Standard_Integer b = Max(N1, N2);
+
+  // Edges are sorted by the first node, then by the second one
+  Standard_Integer lo = 0, hi = this->NbEdges();
+  while ( lo < hi )
+  {
+    const Standard_Integer mid = (lo + hi) / 2;
+    const Standard_Integer ma  = m_edgeNodes[2*mid];
+    const Standard_Integer mb  = m_edgeNodes[2*mid + 1];
+
+    if ( ma < a || (ma == a && mb < b) )
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  if ( lo < this->NbEdges() && m_edgeNodes[2*lo] == a && m_edgeNodes[2*lo + 1] == b )
+    return lo;
+
+  return -1;
+}
+
+//! Computes the angle between the normals of two faces sharing the edge.
+//! The normal of the second face is reversed if the faces are oriented
+//! inconsistently. Current positions of the nodes are used.
+//! \param E [in] 0-based index of the edge.
+//! \return angle in radians, or zero if the edge is not shared by exactly
+//!         two faces or any of them is degenerate.
+Standard_Real ActData_MeshTopology::DihedralAngle(const Standard_Integer E) const
+{
+  if ( this->NbEdgeFaces(E) != 2 )
+    return 0.0;
+
+  const Standard_Integer k = m_edgeOffsets[E];
+
+  Standard_Real n1[3], n2[3];
+  this->faceNormal(m_edgeFaces[k],     n1);
+  this->faceNormal(m_edgeFaces[k + 1], n2);
+
+  const Standard_Real l1 = std::sqrt(n1[0]*n1[0] + n1[1]*n1[1] + n1[2]*n1[2]);
+  const Standard_Real l2 = std::sqrt(n2[0]*n2[0] + n2[1]*n2[1] + n2[2]*n2[2]);
+  if ( l1 == 0.0 || l2 == 0.0 )
+    return 0.0;
+
+  // Consistently oriented faces pass the edge in opposite directions
+  const Standard_Real sign = (m_edgeForward[k] != m_edgeForward[k + 1]) ? 1.0 : -1.0;
+
+  Standard_Real cosa = sign*(n1[0]*n2[0] + n1[1]*n2[1] + n1[2]*n2[2]) / (l1*l2);
+  cosa = Max( -1.0, Min(1.0, cosa) );
+  return std::acos(cosa);
+}
+
+//! Collects the edges shared by two faces whose dihedral angle exceeds the
+//! given threshold. The angles are computed in parallel.
+//! \param Angle [in]  threshold in radians.
+//! \param Edges [out] indices of the feature edges in ascending order.
+void ActData_MeshTopology::FeatureEdges(const Standard_Real            Angle,
+                                        std::vector<Standard_Integer>& Edges) const
+{
+  Edges.clear();
+
+  std::vector<char> aFlags( this->NbEdges(), 0 );
+  MarkFeatures aMark = { this, Angle, &aFlags };
+  ActData_Mesh_ParallelFor(0, this->NbEdges(), aMark);
+
+  for ( Standard_Integer e = 0; e < this->NbEdges(); ++e )
+    if ( aFlags[e] )
+      Edges.push_back(e);
+}
+
+//! Returns the chain of boundary edges as a sequence of nodes. For a closed
+//! loop, the first node is not repeated at the end. A chain remains open if
+//! it cannot be continued, e.g. if the adjacent faces are oriented
+//! inconsistently.
+//! \param L       [in]  0-based index of the loop.
+//! \param NodeIDs [out] IDs of nodes in the order of traversal.
+//! \return true if the loop is closed, false -- otherwise.
+Standard_Boolean
+  ActData_MeshTopology::GetBoundaryLoop(const Standard_Integer         L,
+                                        std::vector<Standard_Integer>& NodeIDs) const
+{
+  NodeIDs.assign( m_loopNodes.begin() + m_loopOffsets[L],
+                  m_loopNodes.begin() + m_loopOffsets[L + 1] );
+
+  return m_loopClosed[L];
+}
+
+//-----------------------------------------------------------------------------
+// Internal methods
+//-----------------------------------------------------------------------------
+
+//! Computes the non-normalized normal of the face. Quadrangle normal is
+//! the cross product of its diagonals.
+//! \param face [in]  index of the face.
+//! \param n    [out] normal.
+void ActData_MeshTopology::faceNormal(const Standard_Integer face,
+                                      Standard_Real*         n) const
+{
+  const Standard_Integer* c  = &m_faceNodes[4*face];
+  const Standard_Integer  nb = (c[3] < 0) ? 3 : 4;
+
+  const gp_Pnt& p0 = m_nodes[c[0]]->Pnt();
+  const gp_Pnt& p1 = m_nodes[c[1]]->Pnt();
+  const gp_Pnt& p2 = m_nodes[c[2]]->Pnt();
+  const gp_Pnt& pl = m_nodes[c[nb - 1]]->Pnt();
+
+  const gp_XYZ d1 = (nb == 3) ? p1.XYZ() - p0.XYZ() : p2.XYZ() - p0.XYZ();
+  const gp_XYZ d2 = (nb == 3) ? p2.XYZ() - p0.XYZ() : pl.XYZ() - p1.XYZ();
+  const gp_XYZ nn = d1 ^ d2;
+
+  n[0] = nn.X();
+  n[1] = nn.Y();
+  n[2] = nn.Z();
+}
+
+//! Chains the boundary edges in the direction of their faces.
+void ActData_MeshTopology::buildLoops()
+{
+  const Standard_Integer aNbBoundary = (Standard_Integer) m_boundary.size();
+  if ( !aNbBoundary )
+    return;
+
+  // Boundary sides directed as in their faces
+  std::vector<Standard_Integer> aFrom(aNbBoundary), aTo(aNbBoundary);
+  for ( Standard_Integer i = 0; i < aNbBoundary; ++i )
+  {
+    const Standard_Integer E   = m_boundary[i];
+    const Standard_Integer k   = m_edgeOffsets[E];
+    const Standard_Boolean fwd = m_edgeForward[k];
+
+    aFrom[i] = fwd ? m_edgeNodes[2*E]     : m_edgeNodes[2*E + 1];
+    aTo[i]   = fwd ? m_edgeNodes[2*E + 1] : m_edgeNodes[2*E];
+  }
+
+  // Outgoing boundary sides by nodes
+  NCollection_DataMap< Standard_Integer, std::vector<Standard_Integer> > anOutgoing;
+  for ( Standard_Integer i = 0; i < aNbBoundary; ++i )
+  {
+    if ( !anOutgoing.IsBound(aFrom[i]) )
+      anOutgoing.Bind( aFrom[i], std::vector<Standard_Integer>() );
+
+    anOutgoing.ChangeFind(aFrom[i]).push_back(i);
+  }
+
+  // Walk along unused sides
+  std::vector< std::vector<Standard_Integer> > aChains;
+  std::vector<char>                            isClosed;
+  std::vector<char>                            isUsed(aNbBoundary, 0);
+
+  for ( Standard_Integer i = 0; i < aNbBoundary; ++i )
+  {
+    if ( isUsed[i] )
+      continue;
+
+    const Standard_Integer aStart = aFrom[i];
+    Standard_Integer       cur    = i;
+
+    aChains.push_back( std::vector<Standard_Integer>(1, aStart) );
+    isClosed.push_back(0);
+
+    std::vector<Standard_Integer>& aChain = aChains.back();
+    for ( ;; )
+    {
+      isUsed[cur] = 1;
+      if ( aTo[cur] == aStart )
+      {
+        isClosed.back() = 1;
+        break;
+      }
+      aChain.push_back(aTo[cur]);
+
+      // Next unused side leaving the reached node
+      Standard_Integer next = -1;
+      const std::vector<Standard_Integer>* pNext = anOutgoing.Seek(aTo[cur]);
+      if ( pNext )
+        for ( Standard_Size j = 0; j < pNext->size() && next < 0; ++j )
+          if ( !isUsed[(*pNext)[j]] )
+            next = (*pNext)[j];
+
+      if ( next < 0 )
+        break;
+
+      cur = next;
+    }
+  }
+
+  // An open chain might have been started in the middle of another one,
+  // so the chains meeting at their ends are joined
+  const Standard_Size aNbChains = aChains.size();
+  for ( Standard_Boolean isJoined = Standard_True; isJoined; )
+  {
+    isJoined = Standard_False;
+    for ( Standard_Size a = 0; a < aNbChains; ++a )
+    {
+      if ( isClosed[a] || aChains[a].empty() )
+        continue;
+
+      for ( Standard_Size b = 0; b < aNbChains; ++b )
+      {
+        if ( b == a || isClosed[b] || aChains[b].empty() || aChains[a].back() != aChains[b].front() )
+          continue;
+
+        aChains[a].insert( aChains[a].end(), aChains[b].begin() + 1, aChains[b].end() );
+        aChains[b].clear();
+        isJoined = Standard_True;
+      }
+    }
+  }
+
+  for ( Standard_Size c = 0; c < aNbChains; ++c )
+  {
+    if ( aChains[c].empty() )
+      continue;
+
+    m_loopNodes.insert( m_loopNodes.end(), aChains[c].begin(), aChains[c].end() );
+    m_loopOffsets.push_back( (Standard_Integer) m_loopNodes.size() );
+    m_loopClosed.push_back(isClosed[c] != 0);
+  }
+}
@@ -0,0 +1,177 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+#ifndef ActData_MeshTopology_HeaderFile
+#define ActData_MeshTopology_HeaderFile
+
+// Active Data includes
+#include <ActData_Common.h>
+
+// Mesh includes
+#include <ActData_Mesh.h>
+#include <ActData_Mesh_Node.h>
+
+// STL includes
+#include <vector>
+
+DEFINE_STANDARD_HANDLE(ActData_MeshTopology, Standard_Transient)
+
+//! \ingroup AD_DF
+//!
+//! Table of unique edges of the faces (triangles and quadrangles) of a
+//! mesh with the faces sharing each edge. The half-edges of all faces are
+//! generated in parallel and sorted by the packed IDs of their nodes, so
+//! that the duplicates become neighbors. On top of this table, boundary
+//! edges with their loops and non-manifold edges are collected. Feature
+//! edges are found by the dihedral angle computed from the current
+//! positions of the nodes, so the table stays valid while the nodes are
+//! only moved. If nodes or faces are added or removed, the instance should
+//! be built again.
+class ActData_MeshTopology : public Standard_Transient
+{
+public:
+
+  // OCCT RTTI
+  DEFINE_STANDARD_RTTI_INLINE(ActData_MeshTopology, Standard_Transient)
+
+public:
+
+  ActData_EXPORT
+    ActData_MeshTopology(const Handle(ActData_Mesh)& Mesh);
+
+public:
+
+  ActData_EXPORT Standard_Boolean
+    IsConsistent(const Handle(ActData_Mesh)& Mesh) const;
+
+  ActData_EXPORT Standard_Integer
+    FindEdge(const Standard_Integer N1,
+             const Standard_Integer N2) const;
+
+  ActData_EXPORT Standard_Real
+    DihedralAngle(const Standard_Integer E) const;
+
+  ActData_EXPORT void
+    FeatureEdges(const Standard_Real            Angle,
+                 std::vector<Standard_Integer>& Edges) const;
+
+  ActData_EXPORT Standard_Boolean
+    GetBoundaryLoop(const Standard_Integer         L,
+                    std::vector<Standard_Integer>& NodeIDs) const;
+
+public:
+
+  //! \return number of unique edges.
+  Standard_Integer NbEdges() const
+  {
+    return (Standard_Integer) m_edgeNodes.size() / 2;
+  }
+
+  //! Returns the nodes of the edge.
+  //! \param E  [in]  0-based index of the edge.
+  //! \param N1 [out] ID of the first node (the lesser one).
+  //! \param N2 [out] ID of the second node.
+  void GetEdge(const Standard_Integer E,
+               Standard_Integer&      N1,
+               Standard_Integer&      N2) const
+  {
+    N1 = m_edgeNodes[2*E];
+    N2 = m_edgeNodes[2*E + 1];
+  }
+
+  //! \param E [in] 0-based index of the edge.
+  //! \return number of faces sharing the edge.
+  Standard_Integer NbEdgeFaces(const Standard_Integer E) const
+  {
+    return m_edgeOffsets[E + 1] - m_edgeOffsets[E];
+  }
+
+  //! \param E [in] 0-based index of the edge.
+  //! \param K [in] 0-based index of the face among the faces of the edge.
+  //! \return ID of the face.
+  Standard_Integer EdgeFace(const Standard_Integer E,
+                            const Standard_Integer K) const
+  {
+    return m_faceIDs[m_edgeFaces[m_edgeOffsets[E] + K]];
+  }
+
+  //! \return indices of the edges owned by a single face.
+  const std::vector<Standard_Integer>& BoundaryEdges() const
+  {
+    return m_boundary;
+  }
+
+  //! \return indices of the edges shared by more than two faces.
+  const std::vector<Standard_Integer>& NonManifoldEdges() const
+  {
+    return m_nonManifold;
+  }
+
+  //! \return number of chains of boundary edges.
+  Standard_Integer NbBoundaryLoops() const
+  {
+    return (Standard_Integer) m_loopOffsets.size() - 1;
+  }
+
+protected:
+
+  void faceNormal(const Standard_Integer face,
+                  Standard_Real*         n) const;
+
+  void buildLoops();
+
+protected:
+
+  //! Mesh DS the table is built for (not retained).
+  const ActData_Mesh* m_pMesh;
+
+  //! Numbers of nodes and faces in the Mesh DS at the moment of building.
+  Standard_Integer m_iNbMeshNodes, m_iNbMeshFaces;
+
+  //! Nodes of the Mesh DS to take the positions from.
+  std::vector<Handle(ActData_Mesh_Node)> m_nodes;
+
+  std::vector<Standard_Integer> m_faceIDs;     //!< IDs of faces.
+  std::vector<Standard_Integer> m_faceNodes;   //!< Four node indices per face (-1 for triangles).
+  std::vector<Standard_Integer> m_edgeNodes;   //!< Two node IDs per edge, sorted by edges.
+  std::vector<Standard_Integer> m_edgeOffsets; //!< Offsets of faces by edges (NbEdges() + 1 values).
+  std::vector<Standard_Integer> m_edgeFaces;   //!< Indices of faces.
+  std::vector<Standard_Boolean> m_edgeForward; //!< Whether the face passes the edge from N1 to N2.
+  std::vector<Standard_Integer> m_boundary;    //!< Boundary edges.
+  std::vector<Standard_Integer> m_nonManifold; //!< Non-manifold edges.
+  std::vector<Standard_Integer> m_loopOffsets; //!< Offsets of loops (NbBoundaryLoops() + 1 values).
+  std::vector<Standard_Integer> m_loopNodes;   //!< Node IDs of loops.
+  std::vector<Standard_Boolean> m_loopClosed;  //!< Whether the loop is closed.
+
+};
+
+#endif
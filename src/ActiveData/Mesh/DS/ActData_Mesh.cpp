@@ -43,28 +43,136 @@
 #include <ActData_Mesh_IDFactory.h>
 #include <ActData_Mesh_Node.h>
 #include <ActData_Mesh_NodesIterator.h>
+#include <ActData_Mesh_Parallel.h>
 #include <ActData_Mesh_Quadrangle.h>
 #include <ActData_Mesh_Triangle.h>
 
 // OCCT includes
 #include <gp_XYZ.hxx>
+#include <TColStd_MapIteratorOfPackedMapOfInteger.hxx>
 
+// Standard includes
+#include <algorithm>
+
+namespace
+{
+  //! Orders the elements by their IDs for Compacted().
+  struct ElemIDLess
+  {
+    bool operator()(const std::pair<Standard_Integer, Handle(ActData_Mesh_Element)>& a,
+                    const std::pair<Standard_Integer, Handle(ActData_Mesh_Element)>& b) const
+    {
+      return a.first < b.first;
+    }
+  };
+
+  //! Loop body allocating mesh nodes for AddNodes().
+  struct CreateNodes
+  {
+    const Standard_Real*                       Coords;  //!< X, Y, Z per node.
+    Standard_Integer                           FirstID; //!< ID of the first node.
+    std::vector<Handle(ActData_Mesh_Element)>* Nodes;   //!< Created nodes.
+
+    void operator()(const Standard_Integer i) const
+    {
+      (*Nodes)[i] = new ActData_Mesh_Node(FirstID + i, Coords[3*i], Coords[3*i + 1], Coords[3*i + 2]);
+    }
+  };
+
+  //! Loop body allocating mesh faces for AddFaces(). Faces referring to
+  //! missing nodes are left null.
+  struct CreateFaces
+  {
+    const ActData_Mesh*                        Mesh;     //!< Owning mesh.
+    const TColStd_PackedMapOfInteger*          NodeIDs;  //!< Existing nodes.
+    const Standard_Integer*                    IDnodes;  //!< Connectivity.
+    Standard_Integer                           NbNodes;  //!< Nodes per face.
+    Standard_Integer                           FirstID;  //!< ID of the first face.
+    std::vector<Handle(ActData_Mesh_Element)>* Faces;    //!< Created faces.
+
+    void operator()(const Standard_Integer i) const
+    {
+      const Standard_Integer* n = IDnodes + NbNodes*i;
+      for ( Standard_Integer k = 0; k < NbNodes; ++k )
+        if ( !NodeIDs->Contains(n[k]) )
+          return;
+
+      if ( NbNodes == 3 )
+        (*Faces)[i] = Mesh->CreateFace(FirstID + i, n[0], n[1], n[2]);
+      else
+        (*Faces)[i] = Mesh->CreateFace(FirstID + i, n[0], n[1], n[2], n[3]);
+    }
+  };
+
+  //! Loop body filling inverse connections of a single node, so that
+  //! every node is processed by one thread only.
+  struct FillInverse
+  {
+    const ActData_Mesh*                              Mesh;    //!< Owning mesh.
+    const std::vector<Handle(ActData_Mesh_Element)>* Elems;   //!< Elements.
+    const std::vector<Standard_Integer>*             Offsets; //!< Row offsets by node ID.
+    const std::vector<Standard_Integer>*             Rows;    //!< Element indices.
+
+    void operator()(const Standard_Integer idnode) const
+    {
+      const Standard_Integer first = (*Offsets)[idnode];
+      const Standard_Integer last  = (*Offsets)[idnode + 1];
+      if ( first == last )
+        return;
+
+      Handle(ActData_Mesh_Node) aNode = Mesh->FindNode(idnode);
+      if ( aNode.IsNull() )
+        return;
+
+      for ( Standard_Integer k = first; k < last; ++k )
+        aNode->AddInverseElement( (*Elems)[(*Rows)[k]] );
+    }
+  };
+}
+
+//=======================================================================
+//function : Mesh
+//purpose  : creation of a new mesh from triangulation
+//=======================================================================
 ActData_Mesh::ActData_Mesh(const Handle(Poly_Triangulation)& tri)
   : myNodeIDFactory     (new ActData_Mesh_IDFactory),
-    myElementIDFactory  (new ActData_Mesh_IDFactory)
+    myElementIDFactory  (new ActData_Mesh_IDFactory),
+    myNodes             (tri->NbNodes()),
+    myEdges             (1),
+    myFaces             (tri->NbTriangles()),
+    myHasInverse        (Standard_False)
 {
-  for ( int node_idx = 1; node_idx <= tri->Nodes().Length(); ++node_idx )
+  const Standard_Integer nbNodes = tri->NbNodes();
+  const Standard_Integer nbTris  = tri->NbTriangles();
+  if ( nbNodes == 0 )
+    return;
+
+  const TColgp_Array1OfPnt& nodes = tri->Nodes();
+  std::vector<Standard_Real> coords(3*nbNodes);
+  for ( int node_idx = 0; node_idx < nbNodes; ++node_idx )
   {
-    this->AddNode( tri->Nodes()(node_idx).X(), tri->Nodes()(node_idx).Y(), tri->Nodes()(node_idx).Z() );
+    const gp_Pnt& P = nodes(nodes.Lower() + node_idx);
+    coords[3*node_idx]     = P.X();
+    coords[3*node_idx + 1] = P.Y();
+    coords[3*node_idx + 2] = P.Z();
   }
+  const Standard_Integer firstNode = this->AddNodes(&coords[0], nbNodes);
 
-  for ( int tri_idx = 1; tri_idx <= tri->Triangles().Length(); ++tri_idx )
+  if ( nbTris == 0 )
+    return;
+
+  // Triangulation refers to nodes by their 1-based indices
+  const Poly_Array1OfTriangle& tris = tri->Triangles();
+  std::vector<Standard_Integer> conn(3*nbTris);
+  for ( int tri_idx = 0; tri_idx < nbTris; ++tri_idx )
   {
-    int nodes[3] = {0, 0, 0};
-    tri->Triangles()(tri_idx).Get(nodes[0], nodes[1], nodes[2]);
+    int n[3] = {0, 0, 0};
+    tris(tris.Lower() + tri_idx).Get(n[0], n[1], n[2]);
 
-    this->AddFace(nodes, 3);
+    for ( int k = 0; k < 3; ++k )
+      conn[3*tri_idx + k] = firstNode + n[k] - 1;
   }
+  this->AddFaces(&conn[0], nbTris, 3);
 }
 
 //=======================================================================
@@ -356,6 +464,154 @@ Standard_Boolean ActData_Mesh::AddFaceWithID(const Standard_Address theIDnodes,
   return ok;
 }
 
+//=======================================================================
+//function : AddNodes
+//purpose  : creates nodes in bulk and returns the first ID
+//=======================================================================
+
+Standard_Integer ActData_Mesh::AddNodes(const Standard_Real*   theCoords,
+                                        const Standard_Integer theNbNodes)
+{
+  const Standard_Integer aFirstID = myNodeIDFactory->ReserveIDs(theNbNodes);
+  if (theNbNodes <= 0)
+    return aFirstID;
+
+  std::vector<Handle(ActData_Mesh_Element)> aNodes(theNbNodes);
+  CreateNodes aBody = { theCoords, aFirstID, &aNodes };
+  ActData_Mesh_ParallelFor(0, theNbNodes, aBody);
+
+  for (Standard_Integer i = 0; i < theNbNodes; ++i)
+    AddNode(aNodes[i]);
+
+  return aFirstID;
+}
+
+//=======================================================================
+//function : AddFaces
+//purpose  : creates faces in bulk and returns the first ID
+//=======================================================================
+
+Standard_Integer ActData_Mesh::AddFaces(const Standard_Integer* theIDnodes,
+                                        const Standard_Integer  theNbFaces,
+                                        const Standard_Integer  theNbNodesPerFace)
+{
+  if (theNbNodesPerFace != 3 && theNbNodesPerFace != 4)
+    return 0;
+
+  const Standard_Integer aFirstID = myElementIDFactory->ReserveIDs(theNbFaces);
+  if (theNbFaces <= 0)
+    return aFirstID;
+
+  std::vector<Handle(ActData_Mesh_Element)> aFaces(theNbFaces);
+  CreateFaces aBody = { this, &myNodes, theIDnodes, theNbNodesPerFace, aFirstID, &aFaces };
+  ActData_Mesh_ParallelFor(0, theNbFaces, aBody);
+
+  // Registration in the maps is sequential. The faces rejected by the map
+  // are duplicates
+  myFaces.ReSize(myFaces.Extent() + theNbFaces);
+  for (Standard_Integer i = 0; i < theNbFaces; ++i) {
+    Handle(ActData_Mesh_Element)& aFace = aFaces[i];
+    if (!aFace.IsNull() && myFaces.Add(aFace))
+      myElementIDFactory->BindID(aFirstID + i, aFace);
+    else
+      aFace.Nullify();
+  }
+
+  // Release IDs of the skipped faces. The trailing ones go first, so that
+  // the reserved range shrinks back
+  for (Standard_Integer i = theNbFaces - 1; i >= 0; --i)
+    if (aFaces[i].IsNull())
+      myElementIDFactory->ReleaseID(aFirstID + i);
+
+  if (myHasInverse)
+    addInverseElements(aFaces);
+
+  return aFirstID;
+}
+
+//=======================================================================
+//function : Compacted
+//purpose  : creates a copy with dense node and element IDs
+//=======================================================================
+
+Handle(ActData_Mesh) ActData_Mesh::Compacted
+                        (TColStd_DataMapOfIntegerInteger& theNodeMap,
+                         TColStd_DataMapOfIntegerInteger& theElemMap) const
+{
+  theNodeMap.Clear();
+  theElemMap.Clear();
+
+  Handle(ActData_Mesh) aMesh = new ActData_Mesh(NbNodes(), NbEdges(), NbFaces());
+
+  // Nodes are renumbered in the ascending order of their old IDs
+  std::vector<Standard_Integer> anIDs;
+  anIDs.reserve(NbNodes());
+  for (TColStd_MapIteratorOfPackedMapOfInteger it(myNodes); it.More(); it.Next())
+    anIDs.push_back(it.Key());
+  std::sort(anIDs.begin(), anIDs.end());
+
+  const Standard_Integer aNbNodes = (Standard_Integer) anIDs.size();
+  std::vector<Standard_Real> aCoords(3*aNbNodes);
+  theNodeMap.ReSize(aNbNodes);
+  for (Standard_Integer i = 0; i < aNbNodes; ++i) {
+    const Handle(ActData_Mesh_Node) aNode = FindNode(anIDs[i]);
+    aCoords[3*i]     = aNode->X();
+    aCoords[3*i + 1] = aNode->Y();
+    aCoords[3*i + 2] = aNode->Z();
+    theNodeMap.Bind(anIDs[i], i + 1);
+  }
+  if (aNbNodes)
+    aMesh->AddNodes(&aCoords[0], aNbNodes);
+
+  // Edges and faces share the ID space, so they are renumbered together
+  std::vector< std::pair<Standard_Integer, Handle(ActData_Mesh_Element)> > anElems;
+  anElems.reserve(NbEdges() + NbFaces());
+  for (ActData_Mesh_ElementsIterator it(this, ActData_Mesh_ET_Edge); it.More(); it.Next())
+    anElems.push_back(std::make_pair(it.GetValue()->GetID(), it.GetValue()));
+  for (ActData_Mesh_ElementsIterator it(this, ActData_Mesh_ET_Face); it.More(); it.Next())
+    anElems.push_back(std::make_pair(it.GetValue()->GetID(), it.GetValue()));
+  std::sort(anElems.begin(), anElems.end(), ElemIDLess());
+
+  theElemMap.ReSize((Standard_Integer) anElems.size());
+  for (size_t e = 0; e < anElems.size(); ++e) {
+    const Handle(ActData_Mesh_Element)& anElem = anElems[e].second;
+    const Standard_Integer ID = (Standard_Integer) e + 1;
+
+    Standard_Integer aNodes[4] = {0, 0, 0, 0};
+    const Standard_Integer nbcnx = anElem->NbNodes();
+    for (Standard_Integer r = 1; r <= nbcnx && r <= 4; ++r)
+      aNodes[r - 1] = theNodeMap.Find(anElem->GetConnection(r));
+
+    if (nbcnx == 2)
+      aMesh->AddEdgeWithID(aNodes[0], aNodes[1], ID);
+    else
+      aMesh->AddFaceWithID((Standard_Address) aNodes, nbcnx, ID);
+
+    theElemMap.Bind(anElems[e].first, ID);
+  }
+
+  return aMesh;
+}
+
+//=======================================================================
+//function : IsCompact
+//purpose  : checks whether there are no free IDs
+//=======================================================================
+
+Standard_Boolean ActData_Mesh::IsCompact() const
+{
+  if (!myNodes.IsEmpty() && myNodes.GetMaximalMapped() != NbNodes())
+    return Standard_False;
+
+  Standard_Integer aMaxID = 0;
+  for (ActData_Mesh_ElementsIterator it(this, ActData_Mesh_ET_Edge); it.More(); it.Next())
+    aMaxID = Max(aMaxID, it.GetValue()->GetID());
+  for (ActData_Mesh_ElementsIterator it(this, ActData_Mesh_ET_Face); it.More(); it.Next())
+    aMaxID = Max(aMaxID, it.GetValue()->GetID());
+
+  return aMaxID == NbEdges() + NbFaces();
+}
+
 //=======================================================================
 //function : AddElement
 //purpose  : 
@@ -986,12 +1242,65 @@ void ActData_Mesh::RebuildAllInverseConnections()
   if (myHasInverse)
     return;
 
+  std::vector<Handle(ActData_Mesh_Element)> anElems;
   ActData_Mesh_VectorOfElements::Iterator itelem = myElementIDFactory->Iterator();
   for (; itelem.More(); itelem.Next())
-    AddInverseElement(itelem.Value());
+    if (!itelem.Value().IsNull())
+      anElems.push_back(itelem.Value());
+
+  addInverseElements(anElems);
   myHasInverse = Standard_True;
 }
 
+//=======================================================================
+//function : addInverseElements
+//purpose  : groups the elements by nodes and fills the inverse
+//           connections of different nodes in parallel
+//=======================================================================
+
+void ActData_Mesh::addInverseElements
+                        (const std::vector<Handle(ActData_Mesh_Element)>& theElems) const
+{
+  if (theElems.empty() || myNodes.IsEmpty())
+    return;
+
+  const Standard_Integer aMaxNodeID = myNodes.GetMaximalMapped();
+
+  // Count references to each node
+  std::vector<Standard_Integer> anOffsets(aMaxNodeID + 2, 0);
+  for (size_t e = 0; e < theElems.size(); ++e) {
+    const Handle(ActData_Mesh_Element)& anElem = theElems[e];
+    if (anElem.IsNull())
+      continue;
+    const Standard_Integer nbcnx = anElem->NbNodes();
+    for (Standard_Integer r = 1; r <= nbcnx; ++r) {
+      const Standard_Integer idnode = anElem->GetConnection(r);
+      if (idnode > 0 && idnode <= aMaxNodeID)
+        ++anOffsets[idnode + 1];
+    }
+  }
+  for (Standard_Integer i = 1; i <= aMaxNodeID + 1; ++i)
+    anOffsets[i] += anOffsets[i - 1];
+
+  // Fill rows keeping the order of elements
+  std::vector<Standard_Integer> aRows(anOffsets.back());
+  std::vector<Standard_Integer> aCursor(anOffsets.begin(), anOffsets.end() - 1);
+  for (size_t e = 0; e < theElems.size(); ++e) {
+    const Handle(ActData_Mesh_Element)& anElem = theElems[e];
+    if (anElem.IsNull())
+      continue;
+    const Standard_Integer nbcnx = anElem->NbNodes();
+    for (Standard_Integer r = 1; r <= nbcnx; ++r) {
+      const Standard_Integer idnode = anElem->GetConnection(r);
+      if (idnode > 0 && idnode <= aMaxNodeID)
+        aRows[aCursor[idnode]++] = (Standard_Integer) e;
+    }
+  }
+
+  FillInverse aBody = { this, &theElems, &anOffsets, &aRows };
+  ActData_Mesh_ParallelFor(1, aMaxNodeID + 1, aBody);
+}
+
 //=======================================================================
 //function : RemoveAllInverseConnections
 //purpose  : 
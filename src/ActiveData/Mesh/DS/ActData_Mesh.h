@@ -41,8 +41,12 @@
 #include <NCollection_Sequence.hxx>
 #include <Poly_Triangulation.hxx>
 #include <Standard_OStream.hxx>
+#include <TColStd_DataMapOfIntegerInteger.hxx>
 #include <TColStd_PackedMapOfInteger.hxx>
 
+// Standard includes
+#include <vector>
+
 class ActData_Mesh_IDFactory;
 class Standard_NoSuchObject;
 class ActData_Mesh_ElementsIterator;
@@ -61,15 +65,22 @@ struct ActData_Mesh_Link
 
   struct Hasher
   {
+    //! Order-independent hash of both node IDs passed through a 64-bit
+    //! finalizer. Hashing the sum of IDs only would map all links lying
+    //! on the same diagonal of a structured mesh to the same bucket.
     inline static int HashCode(const ActData_Mesh_Link& link,
                                const int        upper)
     {
-      int key = link.n1 + link.n2;
-      key += (key << 10);
-      key ^= (key >> 6);
-      key += (key << 3);
-      key ^= (key >> 11);
-      return (key & 0x7fffffff) % upper;
+      const unsigned long long a = (unsigned int) (link.n1 < link.n2 ? link.n1 : link.n2);
+      const unsigned long long b = (unsigned int) (link.n1 < link.n2 ? link.n2 : link.n1);
+
+      unsigned long long key = (a << 32) | b;
+      key ^= (key >> 33);
+      key *= 0xff51afd7ed558ccdULL;
+      key ^= (key >> 33);
+      key *= 0xc4ceb9fe1a85ec53ULL;
+      key ^= (key >> 33);
+      return (int) ( key % (unsigned long long) upper );
     }
 
     inline static unsigned IsEqual(const ActData_Mesh_Link& l1,
@@ -96,6 +107,9 @@ public:
 
 public:
 
+  //! create a new mesh from the passed triangulation. Nodes and
+  //! triangles are added in bulk (see AddNodes() and AddFaces()), so the
+  //! node IDs are the node indices of the triangulation.
   ActData_EXPORT ActData_Mesh(const Handle(Poly_Triangulation)& tri);
 
   //! create a  new mesh.   It is  possible to  specify the
@@ -164,6 +178,22 @@ public:
   //! theNbNodes Integer values
   ActData_EXPORT virtual Standard_Boolean AddFaceWithID (const Standard_Address theIDnodes, const Standard_Integer theNbNodes, const Standard_Integer ID);
 
+  //! create theNbNodes nodes at once. theCoords points to an
+  //! array of 3*theNbNodes values (X, Y, Z of each node). The
+  //! nodes get consecutive IDs, the first of which is returned.
+  //! The node objects are allocated in parallel if the library
+  //! is built with TBB
+  ActData_EXPORT Standard_Integer AddNodes (const Standard_Real* theCoords, const Standard_Integer theNbNodes);
+
+  //! create theNbFaces faces of theNbNodesPerFace (3 or 4)
+  //! nodes at once. theIDnodes points to an array of
+  //! theNbFaces*theNbNodesPerFace node IDs. The faces get
+  //! consecutive IDs, the first of which is returned. Faces
+  //! referring to missing nodes or duplicating other faces are
+  //! skipped and their IDs remain free. If the inverse
+  //! connections are built, they are updated in one pass
+  ActData_EXPORT Standard_Integer AddFaces (const Standard_Integer* theIDnodes, const Standard_Integer theNbFaces, const Standard_Integer theNbNodesPerFace);
+
   //! create an instance of MeshElement as a clone of
   //! theElem and add it to the mesh. Returns the id of the
   //! element.  Returns 0 if creation failed
@@ -173,6 +203,17 @@ public:
   //! theElem and add it to the mesh.
   ActData_EXPORT virtual Standard_Boolean AddElementWithID (const Handle(ActData_Mesh_Element)& theElem, const Standard_Integer ID);
 
+  //! create a copy of the mesh where the nodes and the elements
+  //! are renumbered to the dense ranges 1..NbNodes and
+  //! 1..NbEdges+NbFaces keeping their relative order. theNodeMap
+  //! and theElemMap receive the old-to-new correspondence of IDs.
+  //! The nodes of the copy are added in bulk
+  ActData_EXPORT Handle(ActData_Mesh) Compacted (TColStd_DataMapOfIntegerInteger& theNodeMap, TColStd_DataMapOfIntegerInteger& theElemMap) const;
+
+  //! returns True if the node IDs and the element IDs form the
+  //! dense ranges starting from 1, so that there are no free IDs
+  ActData_EXPORT Standard_Boolean IsCompact() const;
+
   //! remove the node IDnode in the mesh and in all the
   //! children mesh if it exists, it remains in the parent
   //! mesh if the mesh has no parent, then ID is released.
@@ -304,6 +345,8 @@ private:
 
   void FreeNode (const Handle(ActData_Mesh_Element)& node);
 
+  void addInverseElements (const std::vector<Handle(ActData_Mesh_Element)>& theElems) const;
+
 private:
 
   TColStd_PackedMapOfInteger    myNodes;
@@ -63,6 +63,20 @@ Standard_Integer ActData_Mesh_IDFactory::GetFreeID()
 
 //-----------------------------------------------------------------------------
 
+Standard_Integer ActData_Mesh_IDFactory::ReserveIDs(const Standard_Integer theNbIDs)
+{
+  const Standard_Integer aFirstID = myMaxID + 1;
+  if (theNbIDs > 0) {
+    myMaxID += theNbIDs;
+    // Grow the vector at once, so that the reserved IDs can be released
+    if (myMaxID >= myElements.Length())
+      myElements.SetValue (myMaxID, Handle(ActData_Mesh_Element)());
+  }
+  return aFirstID;
+}
+
+//-----------------------------------------------------------------------------
+
 void ActData_Mesh_IDFactory::ReleaseID(const Standard_Integer theID)
 {
   myElements.ChangeValue(theID).Nullify();
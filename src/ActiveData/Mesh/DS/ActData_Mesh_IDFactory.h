@@ -62,6 +62,11 @@ public:
   //! the pool of ID
   ActData_EXPORT Standard_Integer GetFreeID();
 
+  //! reserves theNbIDs consecutive identifiers following the
+  //! greatest one in use and returns the first of them. The
+  //! reserved identifiers are not taken from the pool of ID
+  ActData_EXPORT Standard_Integer ReserveIDs (const Standard_Integer theNbIDs);
+
   //! free the ID and give it back to the pool of ID
   ActData_EXPORT void ReleaseID (const Standard_Integer ID);
 
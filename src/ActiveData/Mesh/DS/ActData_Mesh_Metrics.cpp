@@ -0,0 +1,351 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <ActData_Mesh_Metrics.h>
+
+// Mesh includes
+#include <ActData_Mesh_Parallel.h>
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+  const Standard_Real RadToDeg = 180.0 / M_PI;
+
+  //! Loop body resolving the nodes of a face to their indices in the
+  //! co-ordinate arrays. The fourth index of a triangle is -1.
+  struct ResolveCorners
+  {
+    const ActData_Mesh_Storage* Storage; //!< Source mesh.
+    Standard_Integer*           Corners; //!< Four node indices per face.
+
+    void operator()(const Standard_Integer f) const
+    {
+      const Standard_Integer nbTri = Storage->NbTriangles();
+      const Standard_Boolean isTri = (f < nbTri);
+      const Standard_Integer nb    = isTri ? 3 : 4;
+
+      const Standard_Integer* n = isTri ? Storage->TriangleNodes() + 3*f
+                                        : Storage->QuadrangleNodes() + 4*(f - nbTri);
+
+      Standard_Integer* c = Corners + 4*f;
+      c[3] = -1;
+      for ( Standard_Integer k = 0; k < nb; ++k )
+        c[k] = Storage->NodeIndex(n[k]);
+    }
+  };
+
+  //! Loop body computing the normal, the area, the bounding box and the
+  //! quality measures of a face.
+  struct FaceKernel
+  {
+    const Standard_Real*    X;       //!< X co-ordinates of nodes.
+    const Standard_Real*    Y;       //!< Y co-ordinates of nodes.
+    const Standard_Real*    Z;       //!< Z co-ordinates of nodes.
+    const Standard_Integer* Corners; //!< Four node indices per face.
+    Standard_Real*          Normals; //!< Three values per face.
+    Standard_Real*          Areas;   //!< One value per face.
+    Standard_Real*          Boxes;   //!< Six values per face.
+    Standard_Real*          Aspects; //!< One value per face.
+    Standard_Real*          Skews;   //!< One value per face.
+    Standard_Real*          Angles;  //!< One value per face.
+
+    void operator()(const Standard_Integer f) const
+    {
+      const Standard_Integer* c  = Corners + 4*f;
+      const Standard_Integer  nb = (c[3] < 0) ? 3 : 4;
+
+      Standard_Real p[4][3];
+      for ( Standard_Integer k = 0; k < nb; ++k )
+      {
+        p[k][0] = X[c[k]];
+        p[k][1] = Y[c[k]];
+        p[k][2] = Z[c[k]];
+      }
+
+      // Bounding box
+      Standard_Real* box = Boxes + 6*f;
+      for ( Standard_Integer j = 0; j < 3; ++j )
+      {
+        box[j] = box[j + 3] = p[0][j];
+        for ( Standard_Integer k = 1; k < nb; ++k )
+        {
+          box[j]     = std::min(box[j],     p[k][j]);
+          box[j + 3] = std::max(box[j + 3], p[k][j]);
+        }
+      }
+
+      // Vector area is the half of the cross product of the diagonals
+      // (for a triangle, of the two edges from the first node)
+      const Standard_Integer last = nb - 1;
+      Standard_Real d1[3], d2[3];
+      for ( Standard_Integer j = 0; j < 3; ++j )
+      {
+        d1[j] = p[nb == 3 ? 1 : 2][j] - p[0][j];
+        d2[j] = p[last][j] - p[nb == 3 ? 0 : 1][j];
+      }
+      Standard_Real n[3] = { d1[1]*d2[2] - d1[2]*d2[1],
+                             d1[2]*d2[0] - d1[0]*d2[2],
+                             d1[0]*d2[1] - d1[1]*d2[0] };
+
+      const Standard_Real nmod = std::sqrt(n[0]*n[0] + n[1]*n[1] + n[2]*n[2]);
+      const Standard_Real area = 0.5*nmod;
+      Areas[f] = area;
+      for ( Standard_Integer j = 0; j < 3; ++j )
+        Normals[3*f + j] = (nmod > 0.0) ? n[j] / nmod : 0.0;
+
+      // Edges and corner angles
+      Standard_Real e[4][3], len[4];
+      for ( Standard_Integer k = 0; k < nb; ++k )
+      {
+        const Standard_Integer next = (k + 1) % nb;
+        for ( Standard_Integer j = 0; j < 3; ++j )
+          e[k][j] = p[next][j] - p[k][j];
+
+        len[k] = std::sqrt(e[k][0]*e[k][0] + e[k][1]*e[k][1] + e[k][2]*e[k][2]);
+      }
+
+      Standard_Real lmin = len[0], lmax = len[0], perimeter = len[0];
+      Standard_Real amin = 180.0, amax = 0.0;
+      for ( Standard_Integer k = 0; k < nb; ++k )
+      {
+        if ( k )
+        {
+          lmin       = std::min(lmin, len[k]);
+          lmax       = std::max(lmax, len[k]);
+          perimeter += len[k];
+        }
+
+        // Angle between the incoming edge reversed and the outgoing one
+        const Standard_Integer prev = (k + nb - 1) % nb;
+        Standard_Real angle = 0.0;
+        if ( len[prev] > 0.0 && len[k] > 0.0 )
+        {
+          Standard_Real cosa = -(e[prev][0]*e[k][0] + e[prev][1]*e[k][1] + e[prev][2]*e[k][2])
+                             / (len[prev]*len[k]);
+          cosa  = std::max(-1.0, std::min(1.0, cosa));
+          angle = std::acos(cosa)*RadToDeg;
+        }
+        amin = std::min(amin, angle);
+        amax = std::max(amax, angle);
+      }
+
+      // Quality measures
+      if ( nb == 3 )
+        Aspects[f] = (area > 0.0) ? lmax*perimeter / (4.0*std::sqrt(3.0)*area) : RealLast();
+      else
+        Aspects[f] = (lmin > 0.0) ? lmax / lmin : RealLast();
+
+      const Standard_Real ideal = (nb == 3) ? 60.0 : 90.0;
+      Skews[f]  = std::max( (amax - ideal) / (180.0 - ideal), (ideal - amin) / ideal );
+      Angles[f] = amin;
+    }
+  };
+
+  //! Loop body summing up the area-weighted normals of the faces sharing
+  //! a node, so that every node is processed by one thread only.
+  struct NodeKernel
+  {
+    const Standard_Integer* Offsets; //!< Row offsets by node index.
+    const Standard_Integer* Rows;    //!< Face indices.
+    const Standard_Real*    Normals; //!< Three values per face.
+    const Standard_Real*    Areas;   //!< One value per face.
+    Standard_Real*          Result;  //!< Three values per node.
+
+    void operator()(const Standard_Integer i) const
+    {
+      Standard_Real n[3] = {0.0, 0.0, 0.0};
+      for ( Standard_Integer k = Offsets[i]; k < Offsets[i + 1]; ++k )
+      {
+        const Standard_Integer f = Rows[k];
+        for ( Standard_Integer j = 0; j < 3; ++j )
+          n[j] += Areas[f]*Normals[3*f + j];
+      }
+
+      const Standard_Real nmod = std::sqrt(n[0]*n[0] + n[1]*n[1] + n[2]*n[2]);
+      for ( Standard_Integer j = 0; j < 3; ++j )
+        Result[3*i + j] = (nmod > 0.0) ? n[j] / nmod : 0.0;
+    }
+  };
+}
+
+//-----------------------------------------------------------------------------
+// Construction
+//-----------------------------------------------------------------------------
+
+//! Computes the metrics of the faces and the nodes of the passed storage.
+//! \param storage [in] mesh to compute the metrics for.
+ActData_Mesh_Metrics::ActData_Mesh_Metrics(const Handle(ActData_Mesh_Storage)& storage)
+: ActData_Mesh_Object()
+{
+  this->compute(storage);
+}
+
+//! Computes the metrics of the faces and the nodes of the passed mesh. The
+//! mesh is converted to ActData_Mesh_Storage first, so it is better to
+//! pass the storage if it is already at hand.
+//! \param mesh [in] mesh to compute the metrics for.
+ActData_Mesh_Metrics::ActData_Mesh_Metrics(const Handle(ActData_Mesh)& mesh)
+: ActData_Mesh_Object()
+{
+  this->compute( new ActData_Mesh_Storage(mesh) );
+}
+
+//-----------------------------------------------------------------------------
+// Results
+//-----------------------------------------------------------------------------
+
+//! Returns the bounding box of all nodes.
+//! \param box [out] bounding box (void if there are no nodes).
+void ActData_Mesh_Metrics::GetBoundingBox(Bnd_Box& box) const
+{
+  box.SetVoid();
+  if ( m_nodeIDs.empty() )
+    return;
+
+  box.Update(m_box[0], m_box[1], m_box[2], m_box[3], m_box[4], m_box[5]);
+}
+
+//! Copies the flat array of values to the array suitable for storing in
+//! a Real Array Parameter.
+//! \param values   [in] values to copy.
+//! \param nbValues [in] number of values.
+//! \return 0-based array or null if there are no values.
+Handle(TColStd_HArray1OfReal)
+  ActData_Mesh_Metrics::ToArray(const Standard_Real*   values,
+                                const Standard_Integer nbValues)
+{
+  if ( !values || nbValues <= 0 )
+    return nullptr;
+
+  Handle(TColStd_HArray1OfReal) arr = new TColStd_HArray1OfReal(0, nbValues - 1);
+  for ( Standard_Integer i = 0; i < nbValues; ++i )
+    arr->SetValue(i, values[i]);
+
+  return arr;
+}
+
+//-----------------------------------------------------------------------------
+// Internal methods
+//-----------------------------------------------------------------------------
+
+//! Runs the kernels over the packed data of the storage.
+//! \param storage [in] mesh to compute the metrics for.
+void ActData_Mesh_Metrics::compute(const Handle(ActData_Mesh_Storage)& storage)
+{
+  const Standard_Integer nbNodes = storage->NbNodes();
+  const Standard_Integer nbFaces = storage->NbFaces();
+  const Standard_Integer nbTri   = storage->NbTriangles();
+
+  m_nodeIDs.resize(nbNodes);
+  for ( Standard_Integer i = 0; i < nbNodes; ++i )
+    m_nodeIDs[i] = storage->NodeID(i);
+
+  m_faceIDs.resize(nbFaces);
+  for ( Standard_Integer f = 0; f < nbTri; ++f )
+    m_faceIDs[f] = storage->TriangleIDs()[f];
+  for ( Standard_Integer f = nbTri; f < nbFaces; ++f )
+    m_faceIDs[f] = storage->QuadrangleIDs()[f - nbTri];
+
+  // Bounding box of nodes
+  const Standard_Real* X = storage->X();
+  const Standard_Real* Y = storage->Y();
+  const Standard_Real* Z = storage->Z();
+  if ( nbNodes )
+  {
+    m_box[0] = m_box[3] = X[0];
+    m_box[1] = m_box[4] = Y[0];
+    m_box[2] = m_box[5] = Z[0];
+    for ( Standard_Integer i = 1; i < nbNodes; ++i )
+    {
+      m_box[0] = std::min(m_box[0], X[i]); m_box[3] = std::max(m_box[3], X[i]);
+      m_box[1] = std::min(m_box[1], Y[i]); m_box[4] = std::max(m_box[4], Y[i]);
+      m_box[2] = std::min(m_box[2], Z[i]); m_box[5] = std::max(m_box[5], Z[i]);
+    }
+  }
+
+  if ( !nbFaces )
+  {
+    m_nodeNormals.assign(3*nbNodes, 0.0);
+    return;
+  }
+
+  /* ===============
+   *  Face kernels
+   * =============== */
+
+  std::vector<Standard_Integer> corners(4*nbFaces);
+  ResolveCorners resolve = { storage.get(), &corners[0] };
+  ActData_Mesh_ParallelFor(0, nbFaces, resolve);
+
+  m_faceNormals  .resize(3*nbFaces);
+  m_faceAreas    .resize(nbFaces);
+  m_faceBoxes    .resize(6*nbFaces);
+  m_aspectRatios .resize(nbFaces);
+  m_skews        .resize(nbFaces);
+  m_minAngles    .resize(nbFaces);
+
+  FaceKernel faceKernel = { X, Y, Z, &corners[0],
+                            &m_faceNormals[0], &m_faceAreas[0], &m_faceBoxes[0],
+                            &m_aspectRatios[0], &m_skews[0], &m_minAngles[0] };
+  ActData_Mesh_ParallelFor(0, nbFaces, faceKernel);
+
+  /* ===============
+   *  Node kernel
+   * =============== */
+
+  // Faces by nodes in CSR form
+  std::vector<Standard_Integer> offsets(nbNodes + 1, 0);
+  for ( Standard_Size k = 0; k < corners.size(); ++k )
+    if ( corners[k] >= 0 )
+      ++offsets[corners[k] + 1];
+
+  for ( Standard_Integer i = 1; i <= nbNodes; ++i )
+    offsets[i] += offsets[i - 1];
+
+  std::vector<Standard_Integer> rows( offsets.back() );
+  std::vector<Standard_Integer> cursor( offsets.begin(), offsets.end() - 1 );
+  for ( Standard_Size k = 0; k < corners.size(); ++k )
+    if ( corners[k] >= 0 )
+      rows[cursor[corners[k]]++] = (Standard_Integer) (k / 4);
+
+  m_nodeNormals.resize(3*nbNodes);
+  if ( !nbNodes )
+    return;
+
+  NodeKernel nodeKernel = { &offsets[0], rows.empty() ? NULL : &rows[0],
+                            &m_faceNormals[0], &m_faceAreas[0], &m_nodeNormals[0] };
+  ActData_Mesh_ParallelFor(0, nbNodes, nodeKernel);
+}
@@ -0,0 +1,181 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+#ifndef ActData_Mesh_Metrics_HeaderFile
+#define ActData_Mesh_Metrics_HeaderFile
+
+// Mesh includes
+#include <ActData_Mesh_Storage.h>
+
+// OCCT includes
+#include <Bnd_Box.hxx>
+#include <TColStd_HArray1OfReal.hxx>
+
+// Standard includes
+#include <vector>
+
+DEFINE_STANDARD_HANDLE(ActData_Mesh_Metrics, ActData_Mesh_Object)
+
+//! \ingroup AD_DF
+//!
+//! Normals, areas, quality measures and bounding boxes of all faces of a
+//! surface mesh computed in bulk. The kernels run over the packed arrays
+//! of ActData_Mesh_Storage without touching the mesh objects, and their
+//! loops are distributed between threads with ActData_Mesh_ParallelFor().
+//! The results are kept in flat arrays indexed by the position of the face
+//! (triangles go first, then quadrangles, both in the order of storage) or
+//! the position of the node, so they can be used as a transient cache or
+//! passed to Real Array Parameters with ToArray().
+//!
+//! Quality measures are the following:
+//!
+//! - aspect ratio is 1 for equilateral triangles and squares and grows for
+//!   stretched faces. For triangles, it is the longest edge times the
+//!   perimeter over the area scaled by 1/(4 sqrt(3)). For quadrangles, it
+//!   is the ratio of the longest edge to the shortest one;
+//! - skew is the equiangle skew: the maximal deviation of the corner angles
+//!   from the ideal one (60 or 90 degrees), normalized to [0, 1];
+//! - minimal corner angle in degrees.
+//!
+//! Degenerate faces get zero normals and RealLast() aspect ratio.
+class ActData_Mesh_Metrics : public ActData_Mesh_Object
+{
+public:
+
+  // OCCT RTTI
+  DEFINE_STANDARD_RTTI_INLINE(ActData_Mesh_Metrics, ActData_Mesh_Object)
+
+public:
+
+  ActData_EXPORT
+    ActData_Mesh_Metrics(const Handle(ActData_Mesh_Storage)& storage);
+
+  ActData_EXPORT
+    ActData_Mesh_Metrics(const Handle(ActData_Mesh)& mesh);
+
+public:
+
+  ActData_EXPORT void
+    GetBoundingBox(Bnd_Box& box) const;
+
+  ActData_EXPORT static Handle(TColStd_HArray1OfReal)
+    ToArray(const Standard_Real*   values,
+            const Standard_Integer nbValues);
+
+public:
+
+  //! \return number of nodes.
+  Standard_Integer NbNodes() const
+  {
+    return (Standard_Integer) m_nodeIDs.size();
+  }
+
+  //! \return number of faces.
+  Standard_Integer NbFaces() const
+  {
+    return (Standard_Integer) m_faceIDs.size();
+  }
+
+  //! \return array of node IDs (NbNodes() values).
+  const Standard_Integer* NodeIDs() const
+  {
+    return m_nodeIDs.empty() ? NULL : &m_nodeIDs[0];
+  }
+
+  //! \return array of face IDs (NbFaces() values).
+  const Standard_Integer* FaceIDs() const
+  {
+    return m_faceIDs.empty() ? NULL : &m_faceIDs[0];
+  }
+
+  //! \return unit normals of faces (three values per face).
+  const Standard_Real* FaceNormals() const
+  {
+    return m_faceNormals.empty() ? NULL : &m_faceNormals[0];
+  }
+
+  //! \return areas of faces (NbFaces() values).
+  const Standard_Real* FaceAreas() const
+  {
+    return m_faceAreas.empty() ? NULL : &m_faceAreas[0];
+  }
+
+  //! \return bounding boxes of faces (minimal and maximal X, Y, Z per face).
+  const Standard_Real* FaceBoxes() const
+  {
+    return m_faceBoxes.empty() ? NULL : &m_faceBoxes[0];
+  }
+
+  //! \return aspect ratios of faces (NbFaces() values).
+  const Standard_Real* AspectRatios() const
+  {
+    return m_aspectRatios.empty() ? NULL : &m_aspectRatios[0];
+  }
+
+  //! \return equiangle skews of faces (NbFaces() values).
+  const Standard_Real* Skews() const
+  {
+    return m_skews.empty() ? NULL : &m_skews[0];
+  }
+
+  //! \return minimal corner angles of faces in degrees (NbFaces() values).
+  const Standard_Real* MinAngles() const
+  {
+    return m_minAngles.empty() ? NULL : &m_minAngles[0];
+  }
+
+  //! \return area-weighted unit normals of nodes (three values per node).
+  const Standard_Real* NodeNormals() const
+  {
+    return m_nodeNormals.empty() ? NULL : &m_nodeNormals[0];
+  }
+
+protected:
+
+  void compute(const Handle(ActData_Mesh_Storage)& storage);
+
+private:
+
+  std::vector<Standard_Integer> m_nodeIDs;      //!< Node IDs by index.
+  std::vector<Standard_Integer> m_faceIDs;      //!< Face IDs by index.
+  std::vector<Standard_Real>    m_faceNormals;  //!< Three values per face.
+  std::vector<Standard_Real>    m_faceAreas;    //!< One value per face.
+  std::vector<Standard_Real>    m_faceBoxes;    //!< Six values per face.
+  std::vector<Standard_Real>    m_aspectRatios; //!< One value per face.
+  std::vector<Standard_Real>    m_skews;        //!< One value per face.
+  std::vector<Standard_Real>    m_minAngles;    //!< One value per face.
+  std::vector<Standard_Real>    m_nodeNormals;  //!< Three values per node.
+  Standard_Real                 m_box[6];       //!< Bounding box of all nodes.
+
+};
+
+#endif
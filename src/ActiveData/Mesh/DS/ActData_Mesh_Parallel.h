@@ -0,0 +1,97 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+#ifndef ActData_Mesh_Parallel_HeaderFile
+#define ActData_Mesh_Parallel_HeaderFile
+
+// Active Data includes
+#include <ActData.h>
+
+// OCCT includes
+#include <Standard_TypeDef.hxx>
+
+// Standard includes
+#include <algorithm>
+
+#if defined ActiveData_USE_TBB
+// TBB includes
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+#endif
+
+//! \ingroup AD_DF
+//!
+//! Runs the passed functor for every index in [theFirst, theLast) range.
+//! The iterations are distributed between threads if Active Data is built
+//! with TBB, otherwise they are executed sequentially. The functor should
+//! provide const operator() accepting Standard_Integer index and must be
+//! safe for concurrent invocation on different indices.
+//! \param theFirst   [in] first index.
+//! \param theLast    [in] index following the last one.
+//! \param theFunctor [in] loop body.
+template<typename TFunctor>
+void ActData_Mesh_ParallelFor(const Standard_Integer theFirst,
+                              const Standard_Integer theLast,
+                              const TFunctor&        theFunctor)
+{
+  if ( theFirst >= theLast )
+    return;
+
+#if defined ActiveData_USE_TBB
+  tbb::parallel_for(theFirst, theLast, theFunctor);
+#else
+  for ( Standard_Integer i = theFirst; i < theLast; ++i )
+    theFunctor(i);
+#endif
+}
+
+//! \ingroup AD_DF
+//!
+//! Sorts the [theFirst, theLast) range with the passed comparator. The
+//! sorting is parallel if Active Data is built with TBB, otherwise
+//! std::sort() is used. The order of equal elements is not preserved.
+//! \param theFirst [in] random access iterator to the first element.
+//! \param theLast  [in] iterator following the last element.
+//! \param theComp  [in] strict weak ordering.
+template<typename TIterator, typename TCompare>
+void ActData_Mesh_ParallelSort(TIterator       theFirst,
+                               TIterator       theLast,
+                               const TCompare& theComp)
+{
+#if defined ActiveData_USE_TBB
+  tbb::parallel_sort(theFirst, theLast, theComp);
+#else
+  std::sort(theFirst, theLast, theComp);
+#endif
+}
+
+#endif
@@ -0,0 +1,641 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <ActData_Mesh_Storage.h>
+
+// Mesh includes
+#include <ActData_Mesh_FacesIterator.h>
+#include <ActData_Mesh_NodesIterator.h>
+#include <ActData_Mesh_Quadrangle.h>
+#include <ActData_Mesh_Triangle.h>
+
+// OCCT includes
+#include <gp_XYZ.hxx>
+#include <Standard_ProgramError.hxx>
+
+//-----------------------------------------------------------------------------
+// Construction
+//-----------------------------------------------------------------------------
+
+//! Creates an empty storage reserving memory for the given number of
+//! entities.
+//! \param nbNodes       [in] expected number of nodes.
+//! \param nbTriangles   [in] expected number of triangles.
+//! \param nbQuadrangles [in] expected number of quadrangles.
+ActData_Mesh_Storage::ActData_Mesh_Storage(const Standard_Integer nbNodes,
+                                           const Standard_Integer nbTriangles,
+                                           const Standard_Integer nbQuadrangles)
+: ActData_Mesh_Object(), m_bInverse(Standard_False)
+{
+  this->Reserve(nbNodes, nbTriangles, nbQuadrangles);
+}
+
+//! Creates storage from the passed mesh. Nodes, triangles and quadrangles
+//! are copied with their original IDs. Edges are not stored.
+//! \param mesh [in] mesh to copy.
+ActData_Mesh_Storage::ActData_Mesh_Storage(const Handle(ActData_Mesh)& mesh)
+: ActData_Mesh_Object(), m_bInverse(Standard_False)
+{
+  if ( mesh.IsNull() )
+    return;
+
+  Standard_Integer nbTri = 0, nbQuad = 0;
+  for ( ActData_MeshFacesIterator fit(mesh); fit.More(); fit.Next() )
+  {
+    if ( fit.GetValue()->NbNodes() == 3 )
+      ++nbTri;
+    else if ( fit.GetValue()->NbNodes() == 4 )
+      ++nbQuad;
+  }
+  this->Reserve(mesh->NbNodes(), nbTri, nbQuad);
+
+  for ( ActData_MeshNodesIterator nit(mesh); nit.More(); nit.Next() )
+  {
+    const Handle(ActData_Mesh_Node)& node = nit.Value();
+    this->AddNodeWithID( node->X(), node->Y(), node->Z(), node->GetID() );
+  }
+
+  for ( ActData_MeshFacesIterator fit(mesh); fit.More(); fit.Next() )
+  {
+    const Handle(ActData_Mesh_Element)& elem = fit.GetValue();
+    this->addFace( (const Standard_Integer*) elem->GetConnections(), elem->NbNodes(), elem->GetID() );
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Conversion
+//-----------------------------------------------------------------------------
+
+//! Creates ActData_Mesh with the same nodes and faces. IDs are preserved.
+//! \return new mesh instance.
+Handle(ActData_Mesh) ActData_Mesh_Storage::ToMesh() const
+{
+  Handle(ActData_Mesh) mesh = new ActData_Mesh( this->NbNodes(), 10, this->NbFaces() );
+
+  const Standard_Integer nbNodes = this->NbNodes();
+  for ( Standard_Integer i = 0; i < nbNodes; ++i )
+    mesh->AddNodeWithID(m_x[i], m_y[i], m_z[i], m_nodeIDs[i]);
+
+  const Standard_Integer nbTri = this->NbTriangles();
+  for ( Standard_Integer i = 0; i < nbTri; ++i )
+    mesh->AddFaceWithID( (Standard_Address) &m_triNodes[3*i], 3, m_triIDs[i] );
+
+  const Standard_Integer nbQuad = this->NbQuadrangles();
+  for ( Standard_Integer i = 0; i < nbQuad; ++i )
+    mesh->AddFaceWithID( (Standard_Address) &m_quadNodes[4*i], 4, m_quadIDs[i] );
+
+  return mesh;
+}
+
+//-----------------------------------------------------------------------------
+// Construction
+//-----------------------------------------------------------------------------
+
+//! Reserves memory for the given number of entities.
+//! \param nbNodes       [in] expected number of nodes.
+//! \param nbTriangles   [in] expected number of triangles.
+//! \param nbQuadrangles [in] expected number of quadrangles.
+void ActData_Mesh_Storage::Reserve(const Standard_Integer nbNodes,
+                                   const Standard_Integer nbTriangles,
+                                   const Standard_Integer nbQuadrangles)
+{
+  if ( nbNodes > 0 )
+  {
+    m_x.reserve(nbNodes);
+    m_y.reserve(nbNodes);
+    m_z.reserve(nbNodes);
+    m_nodeIDs.reserve(nbNodes);
+    m_nodeSlots.reserve(nbNodes + 1);
+  }
+  if ( nbTriangles > 0 )
+  {
+    m_triIDs.reserve(nbTriangles);
+    m_triNodes.reserve(3*nbTriangles);
+  }
+  if ( nbQuadrangles > 0 )
+  {
+    m_quadIDs.reserve(nbQuadrangles);
+    m_quadNodes.reserve(4*nbQuadrangles);
+  }
+  if ( nbTriangles + nbQuadrangles > 0 )
+    m_elemSlots.reserve(nbTriangles + nbQuadrangles + 1);
+}
+
+//! Removes all entities.
+void ActData_Mesh_Storage::Clear()
+{
+  m_x.clear();
+  m_y.clear();
+  m_z.clear();
+  m_nodeIDs.clear();
+  m_nodeSlots.clear();
+  m_triIDs.clear();
+  m_triNodes.clear();
+  m_quadIDs.clear();
+  m_quadNodes.clear();
+  m_elemSlots.clear();
+  this->invalidateInverse();
+}
+
+//! Adds a new node with the next free ID.
+//! \param x [in] X co-ordinate.
+//! \param y [in] Y co-ordinate.
+//! \param z [in] Z co-ordinate.
+//! \return ID of the new node.
+Standard_Integer ActData_Mesh_Storage::AddNode(const Standard_Real x,
+                                               const Standard_Real y,
+                                               const Standard_Real z)
+{
+  const Standard_Integer ID = this->nextNodeID();
+  this->AddNodeWithID(x, y, z, ID);
+  return ID;
+}
+
+//! Adds a new node with the given ID.
+//! \param x  [in] X co-ordinate.
+//! \param y  [in] Y co-ordinate.
+//! \param z  [in] Z co-ordinate.
+//! \param ID [in] ID of the node.
+//! \return false if the ID is not positive or already taken.
+Standard_Boolean ActData_Mesh_Storage::AddNodeWithID(const Standard_Real    x,
+                                                     const Standard_Real    y,
+                                                     const Standard_Real    z,
+                                                     const Standard_Integer ID)
+{
+  if ( ID <= 0 || this->HasNode(ID) )
+    return Standard_False;
+
+  if ( ID >= (Standard_Integer) m_nodeSlots.size() )
+    m_nodeSlots.resize(ID + 1, -1);
+
+  m_nodeSlots[ID] = (Standard_Integer) m_nodeIDs.size();
+  m_nodeIDs.push_back(ID);
+  m_x.push_back(x);
+  m_y.push_back(y);
+  m_z.push_back(z);
+
+  this->invalidateInverse();
+  return Standard_True;
+}
+
+//! Adds a new triangle with the next free ID.
+//! \param idnode1 [in] first node.
+//! \param idnode2 [in] second node.
+//! \param idnode3 [in] third node.
+//! \return ID of the new triangle or 0 if creation failed.
+Standard_Integer ActData_Mesh_Storage::AddFace(const Standard_Integer idnode1,
+                                               const Standard_Integer idnode2,
+                                               const Standard_Integer idnode3)
+{
+  const Standard_Integer nodes[3] = {idnode1, idnode2, idnode3};
+  const Standard_Integer ID       = this->nextElementID();
+  return this->addFace(nodes, 3, ID) ? ID : 0;
+}
+
+//! Adds a new triangle with the given ID.
+//! \param idnode1 [in] first node.
+//! \param idnode2 [in] second node.
+//! \param idnode3 [in] third node.
+//! \param ID      [in] ID of the triangle.
+//! \return true in case of success, false -- otherwise.
+Standard_Boolean ActData_Mesh_Storage::AddFaceWithID(const Standard_Integer idnode1,
+                                                     const Standard_Integer idnode2,
+                                                     const Standard_Integer idnode3,
+                                                     const Standard_Integer ID)
+{
+  const Standard_Integer nodes[3] = {idnode1, idnode2, idnode3};
+  return this->addFace(nodes, 3, ID);
+}
+
+//! Adds a new quadrangle with the next free ID.
+//! \param idnode1 [in] first node.
+//! \param idnode2 [in] second node.
+//! \param idnode3 [in] third node.
+//! \param idnode4 [in] fourth node.
+//! \return ID of the new quadrangle or 0 if creation failed.
+Standard_Integer ActData_Mesh_Storage::AddFace(const Standard_Integer idnode1,
+                                               const Standard_Integer idnode2,
+                                               const Standard_Integer idnode3,
+                                               const Standard_Integer idnode4)
+{
+  const Standard_Integer nodes[4] = {idnode1, idnode2, idnode3, idnode4};
+  const Standard_Integer ID       = this->nextElementID();
+  return this->addFace(nodes, 4, ID) ? ID : 0;
+}
+
+//! Adds a new quadrangle with the given ID.
+//! \param idnode1 [in] first node.
+//! \param idnode2 [in] second node.
+//! \param idnode3 [in] third node.
+//! \param idnode4 [in] fourth node.
+//! \param ID      [in] ID of the quadrangle.
+//! \return true in case of success, false -- otherwise.
+Standard_Boolean ActData_Mesh_Storage::AddFaceWithID(const Standard_Integer idnode1,
+                                                     const Standard_Integer idnode2,
+                                                     const Standard_Integer idnode3,
+                                                     const Standard_Integer idnode4,
+                                                     const Standard_Integer ID)
+{
+  const Standard_Integer nodes[4] = {idnode1, idnode2, idnode3, idnode4};
+  return this->addFace(nodes, 4, ID);
+}
+
+//! Adds a new face with the next free ID.
+//! \param theIDnodes [in] pointer to the array of node IDs.
+//! \param theNbNodes [in] number of nodes (3 or 4).
+//! \return ID of the new face or 0 if creation failed.
+Standard_Integer ActData_Mesh_Storage::AddFace(const Standard_Address theIDnodes,
+                                               const Standard_Integer theNbNodes)
+{
+  const Standard_Integer ID = this->nextElementID();
+  return this->addFace( (const Standard_Integer*) theIDnodes, theNbNodes, ID ) ? ID : 0;
+}
+
+//! Adds a new face with the given ID.
+//! \param theIDnodes [in] pointer to the array of node IDs.
+//! \param theNbNodes [in] number of nodes (3 or 4).
+//! \param ID         [in] ID of the face.
+//! \return true in case of success, false -- otherwise.
+Standard_Boolean ActData_Mesh_Storage::AddFaceWithID(const Standard_Address theIDnodes,
+                                                     const Standard_Integer theNbNodes,
+                                                     const Standard_Integer ID)
+{
+  return this->addFace( (const Standard_Integer*) theIDnodes, theNbNodes, ID );
+}
+
+//! Removes the node with the given ID together with all faces built on it.
+//! Unlike ActData_Mesh, the nodes which become free are kept. The faces are
+//! found by the inverse connections, which are built by the first removal
+//! if missing and kept up to date afterwards.
+//! \param IDnode   [in] ID of the node to remove.
+//! \param OnlyFree [in] if true, the node is removed only if no face
+//!                      references it.
+//! \return true if the node has been removed.
+Standard_Boolean ActData_Mesh_Storage::RemoveNode(const Standard_Integer IDnode,
+                                                  const Standard_Boolean OnlyFree)
+{
+  const Standard_Integer index = this->NodeIndex(IDnode);
+  if ( index < 0 )
+    return Standard_False;
+
+  if ( !m_bInverse )
+    this->BuildInverseConnections();
+
+  // Collect faces referencing the node
+  std::vector<Standard_Integer> owners( m_invElements.begin() + m_invOffsets[index],
+                                        m_invElements.begin() + m_invOffsets[index] + m_invCounts[index] );
+
+  if ( OnlyFree && !owners.empty() )
+    return Standard_False;
+
+  for ( size_t k = 0; k < owners.size(); ++k )
+    this->RemoveElement(owners[k]);
+
+  // Move the last node to the freed position
+  const Standard_Integer last = (Standard_Integer) m_nodeIDs.size() - 1;
+  if ( index != last )
+  {
+    m_x[index]       = m_x[last];
+    m_y[index]       = m_y[last];
+    m_z[index]       = m_z[last];
+    m_nodeIDs[index] = m_nodeIDs[last];
+    m_nodeSlots[m_nodeIDs[index]] = index;
+
+    // The row of the moved node is referenced from its new position
+    m_invOffsets[index] = m_invOffsets[last];
+    m_invCounts[index]  = m_invCounts[last];
+  }
+  m_x.pop_back();
+  m_y.pop_back();
+  m_z.pop_back();
+  m_nodeIDs.pop_back();
+  m_invOffsets.pop_back();
+  m_invCounts.pop_back();
+  m_nodeSlots[IDnode] = -1;
+
+  while ( !m_nodeSlots.empty() && m_nodeSlots.back() < 0 )
+    m_nodeSlots.pop_back();
+
+  return Standard_True;
+}
+
+//! Removes the face with the given ID. Its nodes are kept. If built, the
+//! inverse connections are kept up to date.
+//! \param IDelem [in] ID of the face to remove.
+//! \return true if the face has been removed.
+Standard_Boolean ActData_Mesh_Storage::RemoveElement(const Standard_Integer IDelem)
+{
+  if ( !this->HasElement(IDelem) )
+    return Standard_False;
+
+  const Standard_Integer slot = m_elemSlots[IDelem];
+
+  // Drop the face from the rows of its nodes
+  if ( m_bInverse )
+  {
+    const Standard_Integer  nbNodes = (slot & 1) ? 4 : 3;
+    const Standard_Integer* nodes   = (slot & 1) ? &m_quadNodes[4*(slot >> 1)]
+                                                 : &m_triNodes[3*(slot >> 1)];
+    for ( Standard_Integer k = 0; k < nbNodes; ++k )
+    {
+      const Standard_Integer index = m_nodeSlots[nodes[k]];
+      Standard_Integer*      row   = m_invElements.data() + m_invOffsets[index];
+      Standard_Integer&      count = m_invCounts[index];
+
+      for ( Standard_Integer j = 0; j < count; ++j )
+        if ( row[j] == IDelem )
+        {
+          row[j] = row[--count];
+          break;
+        }
+    }
+  }
+
+  this->removeFace( (slot & 1) != 0, slot >> 1 );
+
+  m_elemSlots[IDelem] = -1;
+  while ( !m_elemSlots.empty() && m_elemSlots.back() < 0 )
+    m_elemSlots.pop_back();
+
+  return Standard_True;
+}
+
+//-----------------------------------------------------------------------------
+// Queries compatible with ActData_Mesh
+//-----------------------------------------------------------------------------
+
+//! Returns the node with the given ID. The returned object is created from
+//! the packed data and is not connected to this storage, so modifying it
+//! does not affect the storage.
+//! \param idnode [in] node ID.
+//! \return node or null handle if there is no such node.
+Handle(ActData_Mesh_Node)
+  ActData_Mesh_Storage::FindNode(const Standard_Integer idnode) const
+{
+  const Standard_Integer index = this->NodeIndex(idnode);
+  if ( index < 0 )
+    return nullptr;
+
+  return new ActData_Mesh_Node(idnode, m_x[index], m_y[index], m_z[index]);
+}
+
+//! Returns the face with the given ID as ActData_Mesh_Triangle or
+//! ActData_Mesh_Quadrangle. The returned object is created from the packed
+//! data and is not connected to this storage.
+//! \param IDelem [in] element ID.
+//! \return element or null handle if there is no such element.
+Handle(ActData_Mesh_Element)
+  ActData_Mesh_Storage::FindElement(const Standard_Integer IDelem) const
+{
+  if ( !this->HasElement(IDelem) )
+    return nullptr;
+
+  const Standard_Integer slot  = m_elemSlots[IDelem];
+  const Standard_Integer index = slot >> 1;
+
+  if ( slot & 1 )
+  {
+    const Standard_Integer* n = &m_quadNodes[4*index];
+    return new ActData_Mesh_Quadrangle(IDelem, n[0], n[1], n[2], n[3]);
+  }
+
+  const Standard_Integer* n = &m_triNodes[3*index];
+  return new ActData_Mesh_Triangle(IDelem, n[0], n[1], n[2]);
+}
+
+//! Calculates the center of gravity of the face with the given ID.
+//! \param IDelem          [in]  element ID.
+//! \param CenterOfGravity [out] calculated point.
+//! \return true if the center of gravity was calculated.
+Standard_Boolean
+  ActData_Mesh_Storage::GetCenterOfGravity(const Standard_Integer IDelem,
+                                           gp_XYZ&                CenterOfGravity) const
+{
+  if ( !this->HasElement(IDelem) )
+    return Standard_False;
+
+  const Standard_Integer  slot    = m_elemSlots[IDelem];
+  const Standard_Integer  nbNodes = (slot & 1) ? 4 : 3;
+  const Standard_Integer* nodes   = (slot & 1) ? &m_quadNodes[4*(slot >> 1)]
+                                               : &m_triNodes[3*(slot >> 1)];
+  CenterOfGravity.SetCoord(0., 0., 0.);
+  for ( Standard_Integer k = 0; k < nbNodes; ++k )
+  {
+    const Standard_Integer index = m_nodeSlots[nodes[k]];
+    CenterOfGravity += gp_XYZ(m_x[index], m_y[index], m_z[index]);
+  }
+  CenterOfGravity /= nbNodes;
+  return Standard_True;
+}
+
+//! Dumps statistics on the stored entities.
+//! \param theOut [in/out] target stream.
+void ActData_Mesh_Storage::DebugStats(Standard_OStream& theOut) const
+{
+  theOut << "Mesh storage:"
+         << " nodes: "       << this->NbNodes()
+         << ", triangles: "   << this->NbTriangles()
+         << ", quadrangles: " << this->NbQuadrangles()
+         << ", inverse connections: " << (m_bInverse ? "built" : "not built")
+         << ", memory: "      << this->MemorySize() << " bytes\n";
+}
+
+//! Returns the number of bytes reserved by the storage.
+//! \return reserved memory in bytes.
+Standard_Size ActData_Mesh_Storage::MemorySize() const
+{
+  return sizeof(ActData_Mesh_Storage)
+       + (m_x.capacity() + m_y.capacity() + m_z.capacity()) * sizeof(Standard_Real)
+       + ( m_nodeIDs.capacity()
+         + m_nodeSlots.capacity()
+         + m_triIDs.capacity()
+         + m_triNodes.capacity()
+         + m_quadIDs.capacity()
+         + m_quadNodes.capacity()
+         + m_elemSlots.capacity()
+         + m_invOffsets.capacity()
+         + m_invCounts.capacity()
+         + m_invElements.capacity() ) * sizeof(Standard_Integer);
+}
+
+//-----------------------------------------------------------------------------
+// Inverse connections
+//-----------------------------------------------------------------------------
+
+//! Builds node-to-element adjacency in CSR form. Removals keep the adjacency
+//! up to date by shrinking the rows, while additions invalidate it.
+void ActData_Mesh_Storage::BuildInverseConnections()
+{
+  const Standard_Integer nbNodes = this->NbNodes();
+
+  // Count faces per node
+  m_invOffsets.assign(nbNodes + 1, 0);
+  for ( size_t k = 0; k < m_triNodes.size(); ++k )
+    ++m_invOffsets[m_nodeSlots[m_triNodes[k]] + 1];
+  for ( size_t k = 0; k < m_quadNodes.size(); ++k )
+    ++m_invOffsets[m_nodeSlots[m_quadNodes[k]] + 1];
+
+  for ( Standard_Integer i = 0; i < nbNodes; ++i )
+    m_invOffsets[i + 1] += m_invOffsets[i];
+
+  // Fill rows
+  std::vector<Standard_Integer> cursor(m_invOffsets.begin(), m_invOffsets.end() - 1);
+  m_invElements.resize(m_invOffsets[nbNodes]);
+  for ( size_t k = 0; k < m_triNodes.size(); ++k )
+    m_invElements[cursor[m_nodeSlots[m_triNodes[k]]]++] = m_triIDs[k / 3];
+  for ( size_t k = 0; k < m_quadNodes.size(); ++k )
+    m_invElements[cursor[m_nodeSlots[m_quadNodes[k]]]++] = m_quadIDs[k / 4];
+
+  // Rows are addressed by their offsets and lengths, so that they can be
+  // shrunk and moved together with the nodes on removals
+  m_invCounts.resize(nbNodes);
+  for ( Standard_Integer i = 0; i < nbNodes; ++i )
+    m_invCounts[i] = m_invOffsets[i + 1] - m_invOffsets[i];
+
+  m_invOffsets.pop_back();
+
+  m_bInverse = Standard_True;
+}
+
+//! Returns the number of faces referencing the given node.
+//! BuildInverseConnections() must be called beforehand.
+//! \param idnode [in] node ID.
+//! \return number of faces.
+Standard_Integer
+  ActData_Mesh_Storage::NbInverseElements(const Standard_Integer idnode) const
+{
+  if ( !m_bInverse )
+    Standard_ProgramError::Raise("Inverse connections are not built");
+
+  const Standard_Integer index = this->NodeIndex(idnode);
+  if ( index < 0 )
+    return 0;
+
+  return m_invCounts[index];
+}
+
+//! Returns IDs of the faces referencing the given node. The returned array
+//! contains NbInverseElements() values and remains valid until the storage
+//! is modified. BuildInverseConnections() must be called beforehand.
+//! \param idnode [in] node ID.
+//! \return pointer to the face IDs or NULL if there are none.
+const Standard_Integer*
+  ActData_Mesh_Storage::InverseElements(const Standard_Integer idnode) const
+{
+  if ( this->NbInverseElements(idnode) == 0 )
+    return NULL;
+
+  return &m_invElements[m_invOffsets[this->NodeIndex(idnode)]];
+}
+
+//-----------------------------------------------------------------------------
+// Internal methods
+//-----------------------------------------------------------------------------
+
+//! Appends a face after checking its ID and nodes.
+//! \param nodes   [in] node IDs.
+//! \param nbNodes [in] number of nodes (3 or 4).
+//! \param ID      [in] face ID.
+//! \return true in case of success, false -- otherwise.
+Standard_Boolean ActData_Mesh_Storage::addFace(const Standard_Integer* nodes,
+                                               const Standard_Integer  nbNodes,
+                                               const Standard_Integer  ID)
+{
+  if ( (nbNodes != 3 && nbNodes != 4) || ID <= 0 || this->HasElement(ID) )
+    return Standard_False;
+
+  for ( Standard_Integer k = 0; k < nbNodes; ++k )
+    if ( !this->HasNode(nodes[k]) )
+      return Standard_False;
+
+  if ( ID >= (Standard_Integer) m_elemSlots.size() )
+    m_elemSlots.resize(ID + 1, -1);
+
+  if ( nbNodes == 3 )
+  {
+    m_elemSlots[ID] = (Standard_Integer) m_triIDs.size() << 1;
+    m_triIDs.push_back(ID);
+    m_triNodes.insert(m_triNodes.end(), nodes, nodes + 3);
+  }
+  else
+  {
+    m_elemSlots[ID] = ( (Standard_Integer) m_quadIDs.size() << 1 ) | 1;
+    m_quadIDs.push_back(ID);
+    m_quadNodes.insert(m_quadNodes.end(), nodes, nodes + 4);
+  }
+
+  this->invalidateInverse();
+  return Standard_True;
+}
+
+//! \return ID following the greatest node ID in use.
+Standard_Integer ActData_Mesh_Storage::nextNodeID() const
+{
+  return Max( (Standard_Integer) m_nodeSlots.size(), 1 );
+}
+
+//! \return ID following the greatest element ID in use.
+Standard_Integer ActData_Mesh_Storage::nextElementID() const
+{
+  return Max( (Standard_Integer) m_elemSlots.size(), 1 );
+}
+
+//! Removes the face at the given position by moving the last face of the
+//! same kind there.
+//! \param isQuad [in] whether the face is a quadrangle.
+//! \param index  [in] 0-based index of the face.
+void ActData_Mesh_Storage::removeFace(const Standard_Boolean isQuad,
+                                      const Standard_Integer index)
+{
+  std::vector<Standard_Integer>& IDs    = isQuad ? m_quadIDs   : m_triIDs;
+  std::vector<Standard_Integer>& nodes  = isQuad ? m_quadNodes : m_triNodes;
+  const Standard_Integer         stride = isQuad ? 4 : 3;
+  const Standard_Integer         last   = (Standard_Integer) IDs.size() - 1;
+
+  if ( index != last )
+  {
+    IDs[index] = IDs[last];
+    for ( Standard_Integer k = 0; k < stride; ++k )
+      nodes[stride*index + k] = nodes[stride*last + k];
+
+    m_elemSlots[IDs[index]] = (index << 1) | (isQuad ? 1 : 0);
+  }
+  IDs.pop_back();
+  nodes.resize(stride*last);
+}
+
+//! Marks the CSR adjacency as outdated.
+void ActData_Mesh_Storage::invalidateInverse()
+{
+  m_bInverse = Standard_False;
+}
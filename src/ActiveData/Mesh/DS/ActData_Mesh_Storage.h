@@ -0,0 +1,319 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+#ifndef ActData_Mesh_Storage_HeaderFile
+#define ActData_Mesh_Storage_HeaderFile
+
+// Mesh includes
+#include <ActData_Mesh.h>
+
+// Standard includes
+#include <vector>
+
+DEFINE_STANDARD_HANDLE(ActData_Mesh_Storage, ActData_Mesh_Object)
+
+//! \ingroup AD_DF
+//!
+//! Compact storage for surface meshes composed of triangles and quadrangles.
+//! Unlike ActData_Mesh, which allocates a heap object per node and per
+//! element, this storage keeps the mesh in a struct-of-arrays layout:
+//!
+//! - nodal co-ordinates are stored in three contiguous arrays (X, Y, Z);
+//! - triangles and quadrangles are stored in fixed-stride connectivity
+//!   arrays (three and four node IDs per element);
+//! - node-to-element adjacency (inverse connections) is stored in CSR form
+//!   (offsets per node plus a flat array of element IDs). It is built on
+//!   demand or by the first removal and is kept up to date by removals.
+//!
+//! IDs are preserved, so a mesh can be converted to ActData_Mesh and back
+//! without renumbering. Node IDs and element IDs live in separate ranges,
+//! just like in ActData_Mesh. The methods for adding and removing entities
+//! follow the API of ActData_Mesh, while FindNode() and FindElement() return
+//! detached mesh objects created from the packed data. See also
+//! ActData_Mesh_StorageIterator.
+//!
+//! Entities are removed by moving the last entity of the same kind to the
+//! freed position. The order of iteration is therefore not preserved by
+//! removals.
+class ActData_Mesh_Storage : public ActData_Mesh_Object
+{
+public:
+
+  // OCCT RTTI
+  DEFINE_STANDARD_RTTI_INLINE(ActData_Mesh_Storage, ActData_Mesh_Object)
+
+public:
+
+  ActData_EXPORT
+    ActData_Mesh_Storage(const Standard_Integer nbNodes       = 0,
+                         const Standard_Integer nbTriangles   = 0,
+                         const Standard_Integer nbQuadrangles = 0);
+
+  ActData_EXPORT
+    ActData_Mesh_Storage(const Handle(ActData_Mesh)& mesh);
+
+// Conversion:
+public:
+
+  ActData_EXPORT Handle(ActData_Mesh)
+    ToMesh() const;
+
+// Construction:
+public:
+
+  ActData_EXPORT void
+    Reserve(const Standard_Integer nbNodes,
+            const Standard_Integer nbTriangles,
+            const Standard_Integer nbQuadrangles);
+
+  ActData_EXPORT void
+    Clear();
+
+  ActData_EXPORT Standard_Integer
+    AddNode(const Standard_Real x,
+            const Standard_Real y,
+            const Standard_Real z);
+
+  ActData_EXPORT Standard_Boolean
+    AddNodeWithID(const Standard_Real    x,
+                  const Standard_Real    y,
+                  const Standard_Real    z,
+                  const Standard_Integer ID);
+
+  ActData_EXPORT Standard_Integer
+    AddFace(const Standard_Integer idnode1,
+            const Standard_Integer idnode2,
+            const Standard_Integer idnode3);
+
+  ActData_EXPORT Standard_Boolean
+    AddFaceWithID(const Standard_Integer idnode1,
+                  const Standard_Integer idnode2,
+                  const Standard_Integer idnode3,
+                  const Standard_Integer ID);
+
+  ActData_EXPORT Standard_Integer
+    AddFace(const Standard_Integer idnode1,
+            const Standard_Integer idnode2,
+            const Standard_Integer idnode3,
+            const Standard_Integer idnode4);
+
+  ActData_EXPORT Standard_Boolean
+    AddFaceWithID(const Standard_Integer idnode1,
+                  const Standard_Integer idnode2,
+                  const Standard_Integer idnode3,
+                  const Standard_Integer idnode4,
+                  const Standard_Integer ID);
+
+  ActData_EXPORT Standard_Integer
+    AddFace(const Standard_Address theIDnodes,
+            const Standard_Integer theNbNodes);
+
+  ActData_EXPORT Standard_Boolean
+    AddFaceWithID(const Standard_Address theIDnodes,
+                  const Standard_Integer theNbNodes,
+                  const Standard_Integer ID);
+
+  ActData_EXPORT Standard_Boolean
+    RemoveNode(const Standard_Integer IDnode,
+               const Standard_Boolean OnlyFree = Standard_False);
+
+  ActData_EXPORT Standard_Boolean
+    RemoveElement(const Standard_Integer IDelem);
+
+// Queries compatible with ActData_Mesh:
+public:
+
+  ActData_EXPORT Handle(ActData_Mesh_Node)
+    FindNode(const Standard_Integer idnode) const;
+
+  ActData_EXPORT Handle(ActData_Mesh_Element)
+    FindElement(const Standard_Integer IDelem) const;
+
+  ActData_EXPORT Standard_Boolean
+    GetCenterOfGravity(const Standard_Integer IDelem,
+                       gp_XYZ&                CenterOfGravity) const;
+
+  ActData_EXPORT void
+    DebugStats(Standard_OStream& theOut) const;
+
+  ActData_EXPORT Standard_Size
+    MemorySize() const;
+
+  //! \return number of nodes.
+  Standard_Integer NbNodes() const
+  {
+    return (Standard_Integer) m_nodeIDs.size();
+  }
+
+  //! \return number of faces (triangles and quadrangles).
+  Standard_Integer NbFaces() const
+  {
+    return this->NbTriangles() + this->NbQuadrangles();
+  }
+
+  //! \return number of triangles.
+  Standard_Integer NbTriangles() const
+  {
+    return (Standard_Integer) m_triIDs.size();
+  }
+
+  //! \return number of quadrangles.
+  Standard_Integer NbQuadrangles() const
+  {
+    return (Standard_Integer) m_quadIDs.size();
+  }
+
+  //! \param idnode [in] node ID.
+  //! \return true if the node with the given ID exists.
+  Standard_Boolean HasNode(const Standard_Integer idnode) const
+  {
+    return this->NodeIndex(idnode) >= 0;
+  }
+
+  //! \param IDelem [in] element ID.
+  //! \return true if the element with the given ID exists.
+  Standard_Boolean HasElement(const Standard_Integer IDelem) const
+  {
+    return IDelem > 0 && IDelem < (Standard_Integer) m_elemSlots.size() && m_elemSlots[IDelem] >= 0;
+  }
+
+// Packed data:
+public:
+
+  //! Returns 0-based index of the node in the co-ordinate arrays.
+  //! \param idnode [in] node ID.
+  //! \return node index or -1 if there is no such node.
+  Standard_Integer NodeIndex(const Standard_Integer idnode) const
+  {
+    if ( idnode <= 0 || idnode >= (Standard_Integer) m_nodeSlots.size() )
+      return -1;
+    return m_nodeSlots[idnode];
+  }
+
+  //! \param index [in] 0-based node index.
+  //! \return ID of the node.
+  Standard_Integer NodeID(const Standard_Integer index) const
+  {
+    return m_nodeIDs[index];
+  }
+
+  //! \return contiguous array of X co-ordinates (NbNodes() values).
+  const Standard_Real* X() const { return m_x.empty() ? NULL : &m_x[0]; }
+
+  //! \return contiguous array of Y co-ordinates (NbNodes() values).
+  const Standard_Real* Y() const { return m_y.empty() ? NULL : &m_y[0]; }
+
+  //! \return contiguous array of Z co-ordinates (NbNodes() values).
+  const Standard_Real* Z() const { return m_z.empty() ? NULL : &m_z[0]; }
+
+  //! \return array of triangle IDs (NbTriangles() values).
+  const Standard_Integer* TriangleIDs() const
+  {
+    return m_triIDs.empty() ? NULL : &m_triIDs[0];
+  }
+
+  //! \return array of triangle node IDs (three per triangle).
+  const Standard_Integer* TriangleNodes() const
+  {
+    return m_triNodes.empty() ? NULL : &m_triNodes[0];
+  }
+
+  //! \return array of quadrangle IDs (NbQuadrangles() values).
+  const Standard_Integer* QuadrangleIDs() const
+  {
+    return m_quadIDs.empty() ? NULL : &m_quadIDs[0];
+  }
+
+  //! \return array of quadrangle node IDs (four per quadrangle).
+  const Standard_Integer* QuadrangleNodes() const
+  {
+    return m_quadNodes.empty() ? NULL : &m_quadNodes[0];
+  }
+
+// Inverse connections:
+public:
+
+  ActData_EXPORT void
+    BuildInverseConnections();
+
+  ActData_EXPORT Standard_Integer
+    NbInverseElements(const Standard_Integer idnode) const;
+
+  ActData_EXPORT const Standard_Integer*
+    InverseElements(const Standard_Integer idnode) const;
+
+  //! \return true if the CSR adjacency is up to date.
+  Standard_Boolean HasInverseConnections() const
+  {
+    return m_bInverse;
+  }
+
+protected:
+
+  Standard_Boolean addFace(const Standard_Integer* nodes,
+                           const Standard_Integer  nbNodes,
+                           const Standard_Integer  ID);
+
+  Standard_Integer nextNodeID() const;
+
+  Standard_Integer nextElementID() const;
+
+  void removeFace(const Standard_Boolean isQuad,
+                  const Standard_Integer index);
+
+  void invalidateInverse();
+
+private:
+
+  /* Nodes */
+  std::vector<Standard_Real>    m_x;         //!< X co-ordinates.
+  std::vector<Standard_Real>    m_y;         //!< Y co-ordinates.
+  std::vector<Standard_Real>    m_z;         //!< Z co-ordinates.
+  std::vector<Standard_Integer> m_nodeIDs;   //!< Node IDs by index.
+  std::vector<Standard_Integer> m_nodeSlots; //!< Node indices by ID (-1 for free IDs).
+
+  /* Elements */
+  std::vector<Standard_Integer> m_triIDs;    //!< Triangle IDs by index.
+  std::vector<Standard_Integer> m_triNodes;  //!< Three node IDs per triangle.
+  std::vector<Standard_Integer> m_quadIDs;   //!< Quadrangle IDs by index.
+  std::vector<Standard_Integer> m_quadNodes; //!< Four node IDs per quadrangle.
+  std::vector<Standard_Integer> m_elemSlots; //!< (index << 1 | isQuad) by ID (-1 for free IDs).
+
+  /* Inverse connections in CSR form */
+  std::vector<Standard_Integer> m_invOffsets;  //!< Row offsets per node index.
+  std::vector<Standard_Integer> m_invCounts;   //!< Row lengths per node index.
+  std::vector<Standard_Integer> m_invElements; //!< Element IDs.
+  Standard_Boolean              m_bInverse;    //!< Whether the adjacency is up to date.
+
+};
+
+#endif
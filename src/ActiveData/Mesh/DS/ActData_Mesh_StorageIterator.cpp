@@ -0,0 +1,102 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <ActData_Mesh_StorageIterator.h>
+
+//! Default constructor.
+ActData_Mesh_StorageIterator::ActData_Mesh_StorageIterator()
+: m_bNodes(Standard_False), m_iCurrent(0), m_iNbItems(0)
+{}
+
+//! Constructor.
+//! \param theStorage [in] storage to iterate.
+//! \param theType    [in] type of entities to iterate.
+ActData_Mesh_StorageIterator::ActData_Mesh_StorageIterator(const Handle(ActData_Mesh_Storage)& theStorage,
+                                                           const ActData_Mesh_ElementType      theType)
+{
+  this->Initialize(theStorage, theType);
+}
+
+//! Resets the iterator on the given storage.
+//! \param theStorage [in] storage to iterate.
+//! \param theType    [in] type of entities to iterate.
+void ActData_Mesh_StorageIterator::Initialize(const Handle(ActData_Mesh_Storage)& theStorage,
+                                              const ActData_Mesh_ElementType      theType)
+{
+  m_storage  = theStorage;
+  m_bNodes   = (theType == ActData_Mesh_ET_Node);
+  m_iCurrent = 0;
+  m_iNbItems = 0;
+  m_value.Nullify();
+
+  if ( m_storage.IsNull() )
+    return;
+
+  if ( m_bNodes )
+    m_iNbItems = m_storage->NbNodes();
+  else if ( theType == ActData_Mesh_ET_Face || theType == ActData_Mesh_ET_All )
+    m_iNbItems = m_storage->NbFaces();
+}
+
+//! Returns the current entity as a mesh object created from the packed
+//! data. The object is created once per position.
+//! \return current node or face.
+const Handle(ActData_Mesh_Element)& ActData_Mesh_StorageIterator::GetValue() const
+{
+  if ( m_value.IsNull() )
+  {
+    if ( m_bNodes )
+      m_value = m_storage->FindNode( this->ID() );
+    else
+      m_value = m_storage->FindElement( this->ID() );
+  }
+  return m_value;
+}
+
+//! \return ID of the current entity.
+Standard_Integer ActData_Mesh_StorageIterator::ID() const
+{
+  if ( m_bNodes )
+    return m_storage->NodeID(m_iCurrent);
+
+  if ( this->IsQuadrangle() )
+    return m_storage->QuadrangleIDs()[m_iCurrent - m_storage->NbTriangles()];
+
+  return m_storage->TriangleIDs()[m_iCurrent];
+}
+
+//! \return true if the current entity is a quadrangle.
+Standard_Boolean ActData_Mesh_StorageIterator::IsQuadrangle() const
+{
+  return !m_bNodes && m_iCurrent >= m_storage->NbTriangles();
+}
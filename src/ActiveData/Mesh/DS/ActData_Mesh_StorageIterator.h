@@ -0,0 +1,108 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+#ifndef ActData_Mesh_StorageIterator_HeaderFile
+#define ActData_Mesh_StorageIterator_HeaderFile
+
+// Mesh includes
+#include <ActData_Mesh_ElementType.h>
+#include <ActData_Mesh_Storage.h>
+
+//! \ingroup AD_DF
+//!
+//! Iterator over the entities of ActData_Mesh_Storage with the same
+//! interface as ActData_Mesh_ElementsIterator. Nodes are iterated for
+//! ActData_Mesh_ET_Node type, faces (triangles first, then quadrangles)
+//! for ActData_Mesh_ET_Face and ActData_Mesh_ET_All types. Edges are not
+//! stored, so nothing is iterated for ActData_Mesh_ET_Edge type.
+//!
+//! GetValue() creates a detached mesh object for the current entity. The
+//! cheaper ID() and Index() accessors should be preferred for bulk
+//! processing.
+class ActData_Mesh_StorageIterator
+{
+public:
+
+  ActData_EXPORT
+    ActData_Mesh_StorageIterator();
+
+  ActData_EXPORT
+    ActData_Mesh_StorageIterator(const Handle(ActData_Mesh_Storage)& theStorage,
+                                 const ActData_Mesh_ElementType      theType);
+
+public:
+
+  ActData_EXPORT void
+    Initialize(const Handle(ActData_Mesh_Storage)& theStorage,
+               const ActData_Mesh_ElementType      theType);
+
+  ActData_EXPORT const Handle(ActData_Mesh_Element)&
+    GetValue() const;
+
+  ActData_EXPORT Standard_Integer
+    ID() const;
+
+  ActData_EXPORT Standard_Boolean
+    IsQuadrangle() const;
+
+  //! \return true if there is a current entity.
+  Standard_Boolean More() const
+  {
+    return m_iCurrent < m_iNbItems;
+  }
+
+  //! Moves to the next entity.
+  void Next()
+  {
+    ++m_iCurrent;
+    m_value.Nullify();
+  }
+
+  //! Returns 0-based index of the current entity in the packed arrays of
+  //! its kind (nodes, triangles or quadrangles).
+  //! \return index of the current entity.
+  Standard_Integer Index() const
+  {
+    return this->IsQuadrangle() ? m_iCurrent - m_storage->NbTriangles() : m_iCurrent;
+  }
+
+private:
+
+  Handle(ActData_Mesh_Storage)         m_storage;  //!< Iterated storage.
+  Standard_Boolean                     m_bNodes;   //!< Whether nodes are iterated.
+  Standard_Integer                     m_iCurrent; //!< Current position.
+  Standard_Integer                     m_iNbItems; //!< Number of positions.
+  mutable Handle(ActData_Mesh_Element) m_value;    //!< Current value created on demand.
+
+};
+
+#endif
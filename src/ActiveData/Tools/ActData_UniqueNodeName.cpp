@@ -34,6 +34,8 @@
 #include <ActData_UniqueNodeName.h>
 
 // ACT Framework includes
+#include <ActData_ChildIndex.h>
+#include <ActData_NodeFactory.h>
 #include <ActData_RecordCollectionOwnerAPI.h>
 
 // Active Data (API) includes
@@ -93,11 +95,23 @@ Handle(ActData_SiblingNodes)
   ActData_SiblingNodes*
     ResPtr = dynamic_cast<ActData_SiblingNodes*>( Res.get() );
 
-  // Collect siblings
-  for ( Handle(ActAPI_IChildIterator) cit = theOwner->GetChildIterator(); cit->More(); cit->Next() )
+  // Collect siblings walking the cached child index. A Node is settled by
+  // the type name it is persisted with, so comparing the persistent type
+  // names is the same as checking IsInstance() on the settled Nodes, while
+  // the children of other types are not settled at all
+  const TCollection_AsciiString ChildType = theChild->GetTypeName();
+  //
+  Handle(ActData_ChildIndex)
+    Index = ActData_ChildIndex::Access( theOwner->RootLabel() );
+  //
+  for ( Standard_Integer c = 1; c <= Index->NbChildren(); ++c )
   {
-    Handle(ActAPI_INode) Child = cit->Value();
-    if ( Child.IsNull() || !Child->IsWellFormed() || !Child->IsInstance(theChild->GetTypeName().ToCString()))
+    TCollection_AsciiString Type;
+    if ( !ActData_NodeFactory::IsNode(Index->ChildLabel(c), Type) || !::IsEqual(Type, ChildType) )
+      continue;
+
+    Handle(ActAPI_INode) Child = Index->Child(c);
+    if ( Child.IsNull() || !Child->IsWellFormed() )
       continue;
 
     *ResPtr << Child;
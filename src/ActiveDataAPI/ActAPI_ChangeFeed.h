@@ -0,0 +1,236 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+#ifndef ActAPI_ChangeFeed_HeaderFile
+#define ActAPI_ChangeFeed_HeaderFile
+
+// Active Data (API) includes
+#include <ActAPI_INode.h>
+#include <ActAPI_IParameter.h>
+
+// OCCT includes
+#include <NCollection_IndexedDataMap.hxx>
+
+DEFINE_STANDARD_HANDLE(ActAPI_ChangeFeed, Standard_Transient)
+
+//! \ingroup AD_API
+//!
+//! Structured description of the changes brought to the Data Model by
+//! a single transactional operation (commit, undo or redo). Unlike the
+//! collection of modified Node IDs, the change feed reports the kind of
+//! each change (addition, removal or modification) for both Nodes and
+//! Parameters. Parameters are also reported with their types, so that
+//! the clients do not need to settle Data Cursors to filter the changes.
+class ActAPI_ChangeFeed : public Standard_Transient
+{
+public:
+
+  // OCCT RTTI
+  DEFINE_STANDARD_RTTI_INLINE(ActAPI_ChangeFeed, Standard_Transient)
+
+public:
+
+  //! Transactional operation which produced the changes.
+  enum Origin
+  {
+    Origin_Commit = 0, //!< Commit of a transaction.
+    Origin_Undo,       //!< Undo.
+    Origin_Redo        //!< Redo.
+  };
+
+  //! Kind of a change.
+  enum ChangeKind
+  {
+    Change_Added = 0, //!< Object has been created.
+    Change_Removed,   //!< Object has been deleted.
+    Change_Modified   //!< Object has been modified.
+  };
+
+  //! Change of a Data Node.
+  struct t_nodeChange
+  {
+    ActAPI_NodeId id;   //!< Node ID.
+    ChangeKind    kind; //!< Kind of change.
+
+    t_nodeChange() : kind(Change_Modified) {}
+  };
+
+  //! Change of a Parameter.
+  struct t_parameterChange
+  {
+    ActAPI_ParameterId id;     //!< Parameter ID.
+    ActAPI_NodeId      nodeId; //!< ID of the owning Node.
+    Standard_Integer   type;   //!< Parameter type (see ActAPI_ParameterType).
+    ChangeKind         kind;   //!< Kind of change.
+
+    t_parameterChange() : type(Parameter_UNDEFINED), kind(Change_Modified) {}
+  };
+
+  //! Short-cut for Node changes.
+  typedef NCollection_IndexedDataMap<ActAPI_NodeId, t_nodeChange> t_nodeChanges;
+
+  //! Short-cut for Parameter changes.
+  typedef NCollection_IndexedDataMap<ActAPI_ParameterId, t_parameterChange> t_parameterChanges;
+
+public:
+
+  //! Constructor.
+  //! \param[in] origin transactional operation producing the changes.
+  ActAPI_ChangeFeed(const Origin origin = Origin_Commit) : Standard_Transient(), m_origin(origin) {}
+
+public:
+
+  //! \return transactional operation which produced the changes.
+  Origin GetOrigin() const
+  {
+    return m_origin;
+  }
+
+  //! \return true if nothing has changed.
+  Standard_Boolean IsEmpty() const
+  {
+    return m_nodes.IsEmpty() && m_params.IsEmpty();
+  }
+
+  //! \return changes of Data Nodes.
+  const t_nodeChanges& Nodes() const
+  {
+    return m_nodes;
+  }
+
+  //! \return changes of Parameters.
+  const t_parameterChanges& Parameters() const
+  {
+    return m_params;
+  }
+
+public:
+
+  //! Registers a change of the Node. If the Node has been already registered,
+  //! the change kinds are merged (see Merge()).
+  //! \param[in] id   Node ID.
+  //! \param[in] kind kind of change.
+  void AddNode(const ActAPI_NodeId& id, const ChangeKind kind)
+  {
+    t_nodeChange* pChange = m_nodes.ChangeSeek(id);
+    //
+    if ( pChange )
+    {
+      pChange->kind = Merge(pChange->kind, kind);
+      return;
+    }
+
+    t_nodeChange change;
+    change.id   = id;
+    change.kind = kind;
+    //
+    m_nodes.Add(id, change);
+  }
+
+  //! Registers a change of the Parameter. If the Parameter has been already
+  //! registered, the change kinds are merged (see Merge()).
+  //! \param[in] id     Parameter ID.
+  //! \param[in] nodeId owning Node ID.
+  //! \param[in] type   Parameter type.
+  //! \param[in] kind   kind of change.
+  void AddParameter(const ActAPI_ParameterId& id,
+                    const ActAPI_NodeId&      nodeId,
+                    const Standard_Integer    type,
+                    const ChangeKind          kind)
+  {
+    t_parameterChange* pChange = m_params.ChangeSeek(id);
+    //
+    if ( pChange )
+    {
+      pChange->kind = Merge(pChange->kind, kind);
+      //
+      if ( pChange->type == Parameter_UNDEFINED )
+        pChange->type = type;
+
+      return;
+    }
+
+    t_parameterChange change;
+    change.id     = id;
+    change.nodeId = nodeId;
+    change.type   = type;
+    change.kind   = kind;
+    //
+    m_params.Add(id, change);
+  }
+
+  //! Registers all changes of the passed feed as the ones following the
+  //! changes already registered in this feed.
+  //! \param[in] other feed to append.
+  void Append(const Handle(ActAPI_ChangeFeed)& other)
+  {
+    for ( Standard_Integer i = 1; i <= other->m_nodes.Extent(); ++i )
+    {
+      const t_nodeChange& change = other->m_nodes.FindFromIndex(i);
+      this->AddNode(change.id, change.kind);
+    }
+
+    for ( Standard_Integer i = 1; i <= other->m_params.Extent(); ++i )
+    {
+      const t_parameterChange& change = other->m_params.FindFromIndex(i);
+      this->AddParameter(change.id, change.nodeId, change.type, change.kind);
+    }
+  }
+
+public:
+
+  //! Merges two consecutive changes of the same object. The object added
+  //! and then modified remains added. The object which was removed and
+  //! added back is reported as modified. Removal always wins otherwise.
+  //! \param[in] prev previous change.
+  //! \param[in] next next change.
+  //! \return resulting change.
+  static ChangeKind Merge(const ChangeKind prev, const ChangeKind next)
+  {
+    if ( next == Change_Modified )
+      return prev;
+
+    if ( prev == Change_Removed && next == Change_Added )
+      return Change_Modified;
+
+    return next;
+  }
+
+protected:
+
+  Origin             m_origin; //!< Operation producing the changes.
+  t_nodeChanges      m_nodes;  //!< Changes of Data Nodes.
+  t_parameterChanges m_params; //!< Changes of Parameters.
+
+};
+
+#endif
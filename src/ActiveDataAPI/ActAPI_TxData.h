@@ -38,214 +38,100 @@
 
 // OCCT includes
 #include <NCollection_Sequence.hxx>
+#include <Standard.hxx>
 #include <Standard_ProgramError.hxx>
-#include <Standard_Type.hxx>
 #include <TCollection_AsciiString.hxx>
 
+// Standard includes
+#include <string.h>
+
 #define ERR_INCONSISTENT_DATA_TYPES "Inconsistent data types"
 
 //-----------------------------------------------------------------------------
-// Shared Integer
+// Application-specific Transaction Data
 //-----------------------------------------------------------------------------
 
 //! \ingroup AD_API
 //!
-//! Integer value for chaining into Transaction Data.
-class ActAPI_TxPrimDataInt : public Standard_Transient
-{
-public:
-
-  // OCCT RTTI
-  DEFINE_STANDARD_RTTI_INLINE(ActAPI_TxPrimDataInt, Standard_Transient)
-
-public:
-
-  //! Factory method ensuring allocation of class instance in a heap.
-  //! \param theValue [in] value.
-  //! \return class instance.
-  inline static Handle(ActAPI_TxPrimDataInt) Instance(const Standard_Integer theValue)
-  {
-    return new ActAPI_TxPrimDataInt(theValue);
-  }
-
-public:
-
-  //! Shared value.
-  Standard_Integer Value;
-
-private:
-
-  //! Default constructor.
-  ActAPI_TxPrimDataInt() : Standard_Transient() {}
-
-  //! Constructor accepting the value to set.
-  //! \param theValue [in] value to set.
-  ActAPI_TxPrimDataInt(const Standard_Integer theValue) : Standard_Transient(), Value(theValue) {}
-
-};
-
-//-----------------------------------------------------------------------------
-// Shared Real
-//-----------------------------------------------------------------------------
-
-//! \ingroup AD_API
+//! Container for associating Data Model Transactions with
+//! application-specific data.
 //!
-//! Real value for chaining into Transaction Data.
-class ActAPI_TxPrimDataReal : public Standard_Transient
+//! The values are packed into a byte buffer one after another, each prefixed
+//! with a one-byte type tag. Strings are stored as their length followed by
+//! the characters. Small payloads fit into the inline storage, so that no
+//! heap allocation happens for them at all. Larger payloads grow a single
+//! heap buffer geometrically.
+class ActAPI_TxData
 {
 public:
 
-  // OCCT RTTI
-  DEFINE_STANDARD_RTTI_INLINE(ActAPI_TxPrimDataReal, Standard_Transient)
+  //! Type tags of the stored values.
+  enum ValueType
+  {
+    Type_Int = 1, //!< Integer value.
+    Type_Real,    //!< Real value.
+    Type_Bool,    //!< Boolean value.
+    Type_String   //!< ASCII string.
+  };
 
 public:
 
-  //! Factory method ensuring allocation of class instance in a heap.
-  //! \param theValue [in] value.
-  //! \return class instance.
-  ActAPI_EXPORT static Handle(ActAPI_TxPrimDataReal) Instance(const Standard_Real theValue)
+  //! Default constructor accepting integer value for the sake of
+  //! convenient conversion.
+  ActAPI_TxData(Standard_Integer = 0)
+  : m_pBuffer   (m_inline),
+    m_iSize     (0),
+    m_iCapacity (InlineCapacity),
+    m_iNbValues (0),
+    m_iSeekPos  (0)
+  {}
+
+  //! Copy constructor. Notice that the seek position is not copied.
+  ActAPI_TxData(const ActAPI_TxData& theData)
+  : m_pBuffer   (m_inline),
+    m_iSize     (0),
+    m_iCapacity (InlineCapacity),
+    m_iNbValues (0),
+    m_iSeekPos  (0) // (!)
   {
-    return new ActAPI_TxPrimDataReal(theValue);
+    this->assign(theData);
   }
 
-public:
-
-  //! Shared value.
-  Standard_Real Value;
-
-private:
-
-  //! Default constructor.
-  ActAPI_TxPrimDataReal() : Standard_Transient() {}
-
-  //! Constructor accepting the value to set.
-  //! \param theValue [in] value to set.
-  ActAPI_TxPrimDataReal(const Standard_Real theValue) : Standard_Transient(), Value(theValue) {}
-
-};
-
-//-----------------------------------------------------------------------------
-// Shared Boolean
-//-----------------------------------------------------------------------------
-
-//! \ingroup AD_API
-//!
-//! Boolean value for chaining into Transaction Data.
-class ActAPI_TxPrimDataBool : public Standard_Transient
-{
-public:
-
-  // OCCT RTTI
-  DEFINE_STANDARD_RTTI_INLINE(ActAPI_TxPrimDataBool, Standard_Transient)
-
-public:
-
-  //! Factory method ensuring allocation of class instance in a heap.
-  //! \param theValue [in] value.
-  //! \return class instance.
-  inline static Handle(ActAPI_TxPrimDataBool) Instance(const Standard_Boolean theValue)
+  //! Destructor.
+  ~ActAPI_TxData()
   {
-    return new ActAPI_TxPrimDataBool(theValue);
+    if ( m_pBuffer != m_inline )
+      Standard::Free(m_pBuffer);
   }
 
-public:
-
-  //! Shared value.
-  Standard_Boolean Value;
-
-private:
-
-  //! Default constructor.
-  ActAPI_TxPrimDataBool() : Standard_Transient() {}
-
-  //! Constructor accepting the value to set.
-  //! \param theValue [in] value to set.
-  ActAPI_TxPrimDataBool(const Standard_Boolean theValue) : Standard_Transient(), Value(theValue) {}
-
-};
-
-//-----------------------------------------------------------------------------
-// Shared String
-//-----------------------------------------------------------------------------
-
-//! \ingroup AD_API
-//!
-//! ASCII string value for chaining into Transaction Data.
-class ActAPI_TxPrimDataString : public Standard_Transient
-{
-public:
-
-  // OCCT RTTI
-  DEFINE_STANDARD_RTTI_INLINE(ActAPI_TxPrimDataString, Standard_Transient)
+  //! Assignment operator. Resets the seek position.
+  //! \param theData [in] data to copy.
+  //! \return this instance.
+  ActAPI_TxData& operator=(const ActAPI_TxData& theData)
+  {
+    if ( this != &theData )
+      this->assign(theData);
 
-public:
+    return *this;
+  }
 
-  //! Factory method ensuring allocation of class instance in a heap.
-  //! \param theStr [in] string.
-  //! \return class instance.
-  inline static Handle(ActAPI_TxPrimDataString) Instance(const TCollection_AsciiString& theStr)
+  //! Returns true if the Data container is empty.
+  //! \return true/false.
+  Standard_Boolean IsEmpty() const
   {
-    return new ActAPI_TxPrimDataString(theStr);
+    return m_iNbValues == 0;
   }
 
-public:
-
-  //! Shared string.
-  TCollection_AsciiString Value;
-
-private:
-
-  //! Default constructor.
-  ActAPI_TxPrimDataString() : Standard_Transient() {}
-
-  //! Constructor accepting the string to set.
-  //! \param theStr [in] string to set.
-  ActAPI_TxPrimDataString(const TCollection_AsciiString& theStr) : Standard_Transient(), Value(theStr) {}
-
-};
-
-//-----------------------------------------------------------------------------
-// Addendum
-//-----------------------------------------------------------------------------
-
-//! \ingroup AD_API
-//!
-//! Collection of Python variables
-typedef NCollection_Sequence<Handle(Standard_Transient)> ActAPI_TxPrimDataSeq;
-typedef NCollection_Shared<ActAPI_TxPrimDataSeq>         ActAPI_HTxPrimDataSeq;
-
-//-----------------------------------------------------------------------------
-// Application-specific Transaction Data
-//-----------------------------------------------------------------------------
-
-//! \ingroup AD_API
-//!
-//! Container for associating Data Model Transactions with
-//! application-specific data.
-class ActAPI_TxData
-{
-public:
-
-  //! Actual ordered data collection.
-  ActAPI_TxPrimDataSeq TxPrimDataSeq;
-
-public:
-
-  //! Default constructor accepting integer value for the sake of
-  //! convenient conversion.
-  ActAPI_TxData(Standard_Integer = 0) : m_iSeekIndx(1) {}
-
-  //! Copy constructor.
-  ActAPI_TxData(const ActAPI_TxData& theData) : m_iSeekIndx(1) // (!)
+  //! \return number of the stored values.
+  Standard_Integer NbValues() const
   {
-    TxPrimDataSeq = theData.TxPrimDataSeq;
+    return m_iNbValues;
   }
 
-  //! Returns true if the Data container is empty.
-  //! \return true/false.
-  Standard_Boolean IsEmpty() const
+  //! \return number of bytes occupied by the packed values.
+  Standard_Size Size() const
   {
-    return TxPrimDataSeq.IsEmpty();
+    return m_iSize;
   }
 
 public:
@@ -255,7 +141,7 @@ public:
   //! \return this instance.
   ActAPI_TxData& operator<<(const Standard_Integer theData)
   {
-    TxPrimDataSeq.Append( ActAPI_TxPrimDataInt::Instance(theData) );
+    this->put(Type_Int, &theData, sizeof(Standard_Integer));
     return *this;
   }
 
@@ -264,7 +150,7 @@ public:
   //! \return this instance.
   ActAPI_TxData& operator<<(const Standard_Real theData)
   {
-    TxPrimDataSeq.Append( ActAPI_TxPrimDataReal::Instance(theData) );
+    this->put(Type_Real, &theData, sizeof(Standard_Real));
     return *this;
   }
 
@@ -273,7 +159,7 @@ public:
   //! \return this instance.
   ActAPI_TxData& operator<<(const Standard_Boolean theData)
   {
-    TxPrimDataSeq.Append( ActAPI_TxPrimDataBool::Instance(theData) );
+    this->put(Type_Bool, &theData, sizeof(Standard_Boolean));
     return *this;
   }
 
@@ -282,7 +168,10 @@ public:
   //! \return this instance.
   ActAPI_TxData& operator<<(const Standard_CString theData)
   {
-    TxPrimDataSeq.Append( ActAPI_TxPrimDataString::Instance(theData) );
+    const Standard_Integer aLen = ( theData == NULL ? 0 : (Standard_Integer) strlen(theData) );
+
+    this->put(Type_String, &aLen, sizeof(Standard_Integer));
+    this->append(theData, aLen);
     return *this;
   }
 
@@ -299,15 +188,7 @@ public:
   //! \return this instance.
   ActAPI_TxData& operator>>(Standard_Integer& theData)
   {
-    if ( m_iSeekIndx > TxPrimDataSeq.Length() )
-      return *this;
-
-    Handle(Standard_Transient) aTxData = TxPrimDataSeq.Value(m_iSeekIndx++);
-
-    if ( !aTxData->IsInstance( STANDARD_TYPE(ActAPI_TxPrimDataInt) ) )
-      Standard_ProgramError::Raise(ERR_INCONSISTENT_DATA_TYPES);
-
-    theData = Handle(ActAPI_TxPrimDataInt)::DownCast(aTxData)->Value;
+    this->get(Type_Int, &theData, sizeof(Standard_Integer));
     return *this;
   }
 
@@ -316,15 +197,7 @@ public:
   //! \return this instance.
   ActAPI_TxData& operator>>(Standard_Real& theData)
   {
-    if ( m_iSeekIndx > TxPrimDataSeq.Length() )
-      return *this;
-
-    Handle(Standard_Transient) aTxData = TxPrimDataSeq.Value(m_iSeekIndx++);
-
-    if ( !aTxData->IsInstance( STANDARD_TYPE(ActAPI_TxPrimDataReal) ) )
-      Standard_ProgramError::Raise(ERR_INCONSISTENT_DATA_TYPES);
-
-    theData = Handle(ActAPI_TxPrimDataReal)::DownCast(aTxData)->Value;
+    this->get(Type_Real, &theData, sizeof(Standard_Real));
     return *this;
   }
 
@@ -333,15 +206,7 @@ public:
   //! \return this instance.
   ActAPI_TxData& operator>>(Standard_Boolean& theData)
   {
-    if ( m_iSeekIndx > TxPrimDataSeq.Length() )
-      return *this;
-
-    Handle(Standard_Transient) aTxData = TxPrimDataSeq.Value(m_iSeekIndx++);
-
-    if ( !aTxData->IsInstance( STANDARD_TYPE(ActAPI_TxPrimDataBool) ) )
-      Standard_ProgramError::Raise(ERR_INCONSISTENT_DATA_TYPES);
-
-    theData = Handle(ActAPI_TxPrimDataBool)::DownCast(aTxData)->Value;
+    this->get(Type_Bool, &theData, sizeof(Standard_Boolean));
     return *this;
   }
 
@@ -350,22 +215,98 @@ public:
   //! \return this instance.
   ActAPI_TxData& operator>>(TCollection_AsciiString& theStr)
   {
-    if ( m_iSeekIndx > TxPrimDataSeq.Length() )
+    Standard_Integer aLen = 0;
+    if ( !this->get(Type_String, &aLen, sizeof(Standard_Integer)) )
       return *this;
 
-    Handle(Standard_Transient) aTxData = TxPrimDataSeq.Value(m_iSeekIndx++);
+    theStr = TCollection_AsciiString(m_pBuffer + m_iSeekPos, aLen);
+
+    m_iSeekPos += aLen;
+    return *this;
+  }
+
+private:
 
-    if ( !aTxData->IsInstance( STANDARD_TYPE(ActAPI_TxPrimDataString) ) )
+  //! Copies the packed values of the passed data.
+  //! \param theData [in] data to copy.
+  void assign(const ActAPI_TxData& theData)
+  {
+    m_iSize     = 0;
+    m_iNbValues = theData.m_iNbValues;
+    m_iSeekPos  = 0;
+    this->append(theData.m_pBuffer, theData.m_iSize);
+  }
+
+  //! Appends the type tag followed by the value bytes.
+  //! \param theType  [in] type tag.
+  //! \param theValue [in] value bytes.
+  //! \param theSize  [in] number of value bytes.
+  void put(const ValueType theType, const void* theValue, const Standard_Size theSize)
+  {
+    const char aTag = (char) theType;
+    this->append(&aTag, 1);
+    this->append(theValue, theSize);
+    m_iNbValues++;
+  }
+
+  //! Reads the value of the given type at the seek position. Nothing is
+  //! read if all values have been already extracted.
+  //! \param theType  [in]  expected type tag.
+  //! \param theValue [out] value bytes.
+  //! \param theSize  [in]  number of value bytes.
+  //! \return false if there is nothing to read.
+  Standard_Boolean get(const ValueType theType, void* theValue, const Standard_Size theSize)
+  {
+    if ( m_iSeekPos >= m_iSize )
+      return Standard_False;
+
+    if ( m_pBuffer[m_iSeekPos] != (char) theType )
       Standard_ProgramError::Raise(ERR_INCONSISTENT_DATA_TYPES);
 
-    theStr = Handle(ActAPI_TxPrimDataString)::DownCast(aTxData)->Value;
-    return *this;
+    memcpy(theValue, m_pBuffer + m_iSeekPos + 1, theSize);
+    m_iSeekPos += 1 + theSize;
+    return Standard_True;
+  }
+
+  //! Appends raw bytes to the buffer growing it if necessary.
+  //! \param theBytes [in] bytes to append.
+  //! \param theSize  [in] number of bytes.
+  void append(const void* theBytes, const Standard_Size theSize)
+  {
+    if ( !theSize )
+      return;
+
+    if ( m_iSize + theSize > m_iCapacity )
+    {
+      Standard_Size aCapacity = m_iCapacity * 2;
+      while ( aCapacity < m_iSize + theSize )
+        aCapacity *= 2;
+
+      char* aBuffer = (char*) Standard::Allocate(aCapacity);
+      memcpy(aBuffer, m_pBuffer, m_iSize);
+
+      if ( m_pBuffer != m_inline )
+        Standard::Free(m_pBuffer);
+
+      m_pBuffer   = aBuffer;
+      m_iCapacity = aCapacity;
+    }
+
+    memcpy(m_pBuffer + m_iSize, theBytes, theSize);
+    m_iSize += theSize;
   }
 
 private:
 
-  //! Internal seek index used for OUTPUT streaming.
-  Standard_Integer m_iSeekIndx;
+  //! Size of the inline storage in bytes.
+  enum { InlineCapacity = 48 };
+
+  char             m_inline[InlineCapacity]; //!< Inline storage for small payloads.
+  char*            m_pBuffer;                //!< Actual storage: inline or heap.
+  Standard_Size    m_iSize;                  //!< Number of occupied bytes.
+  Standard_Size    m_iCapacity;              //!< Number of available bytes.
+  Standard_Integer m_iNbValues;              //!< Number of stored values.
+  Standard_Size    m_iSeekPos;               //!< Read position used for OUTPUT streaming.
 
 };
 
@@ -75,6 +75,7 @@ enum ActTest_CaseIDs
   CaseID_TypeNameParameter,
   CaseID_CAFConversionCtx,
   CaseID_TriangulationParameter,
+  CaseID_TransactionEngine,
 };
 
 #endif
@@ -54,6 +54,7 @@
 #include <ActTest_StringArrayParameter.h>
 #include <ActTest_TimeStamp.h>
 #include <ActTest_TimeStampParameter.h>
+#include <ActTest_TransactionEngine.h>
 #include <ActTest_TreeFunctionParameter.h>
 #include <ActTest_TreeNodeParameter.h>
 #include <ActTest_TriangulationParameter.h>
@@ -100,6 +101,7 @@ int main(int ActTestLib_NotUsed(argc), char* ActTestLib_NotUsed(argv)[])
   CaseLaunchers.push_back( new ActTestLib_CaseLauncher<ActTest_MeshAttrTransactional>  );
   CaseLaunchers.push_back( new ActTestLib_CaseLauncher<ActTest_MeshAttrPersistent>     );
   CaseLaunchers.push_back( new ActTestLib_CaseLauncher<ActTest_ExtTransactionEngine>   );
+  CaseLaunchers.push_back( new ActTestLib_CaseLauncher<ActTest_TransactionEngine>      );
   CaseLaunchers.push_back( new ActTestLib_CaseLauncher<ActTest_CopyPasteEngine>        );
   CaseLaunchers.push_back( new ActTestLib_CaseLauncher<ActTest_TriangulationParameter> );
 
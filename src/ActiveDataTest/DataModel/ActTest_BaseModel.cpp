@@ -46,6 +46,7 @@
 #include <ActData_BaseNode.h>
 #include <ActData_BasePartition.h>
 #include <ActData_BaseTreeFunction.h>
+#include <ActData_ChildIndex.h>
 #include <ActData_DependencyAnalyzer.h>
 #include <ActData_FuncExecutionCtx.h>
 #include <ActData_IntParameter.h>
@@ -1000,6 +1001,88 @@ bool ActTest_BaseModelStructure::accessObservers_D(const int ActTestLib_NotUsed(
   return true;
 }
 
+//! Test function for the cached child index.
+//! \param funcID [in] ID of test function.
+//! \return true if test is passed, false -- otherwise.
+bool ActTest_BaseModelStructure::childIndex(const int ActTestLib_NotUsed(funcID))
+{
+  // Create and populate sample Model
+  Handle(ActAPI_IModel) M;
+  NCollection_Sequence<ActAPI_DataObjectId> node_IDs;
+  init(M, node_IDs);
+
+  Handle(ActData_BaseNode)
+    aNodeA = Handle(ActData_BaseNode)::DownCast( M->FindNode( node_IDs(1) ) );
+  Handle(ActData_BaseNode)
+    aNodeD = Handle(ActData_BaseNode)::DownCast( M->FindNode( node_IDs(4) ) );
+
+  /* ================
+   *  General checks
+   * ================ */
+
+  ACT_VERIFY( aNodeA->GetNbChildren() == 3 )
+  ACT_VERIFY( aNodeA->GetChildNode(1)->GetId() == node_IDs(2) )
+  ACT_VERIFY( aNodeA->GetChildNode(2)->GetId() == node_IDs(3) )
+  ACT_VERIFY( aNodeA->GetChildNode(3)->GetId() == node_IDs(4) )
+  ACT_VERIFY( aNodeA->GetChildNode(4).IsNull() )
+
+  // Labels are available without settling
+  Handle(ActData_ChildIndex) aIndexD = aNodeD->GetChildIndex();
+  ACT_VERIFY( aIndexD->NbChildren() == 3 )
+  ACT_VERIFY( ActData_Utils::GetEntry( aIndexD->ChildLabel(1) ) == node_IDs(8) )
+  ACT_VERIFY( ActData_Utils::GetEntry( aIndexD->ChildLabel(3) ) == node_IDs(10) )
+
+  // The same index is shared by all cursors
+  ACT_VERIFY( M->FindNode( node_IDs(4) )->GetChildNode(2)->GetId() == node_IDs(9) )
+  ACT_VERIFY( aIndexD == aNodeD->GetChildIndex() )
+
+  /* =======================================
+   *  Index follows modifications and Undo
+   * ======================================= */
+
+  M->OpenCommand();
+  ACT_VERIFY( aNodeA->RemoveChildNode( M->FindNode( node_IDs(3) ) ) )
+  M->CommitCommand();
+
+  // Commit drops the cached indices
+  ACT_VERIFY( !ActData_ChildIndex::IsCached( aNodeA->RootLabel() ) )
+  ACT_VERIFY( aNodeA->GetNbChildren() == 2 )
+  ACT_VERIFY( aNodeA->GetChildNode(2)->GetId() == node_IDs(4) )
+
+  M->OpenCommand();
+  aNodeD->AddChildNode( M->FindNode( node_IDs(3) ) );
+  M->CommitCommand();
+
+  ACT_VERIFY( aNodeD->GetNbChildren() == 4 )
+  ACT_VERIFY( aNodeD->GetChildNode(4)->GetId() == node_IDs(3) )
+
+  M->Undo(2);
+
+  ACT_VERIFY( aNodeA->GetNbChildren() == 3 )
+  ACT_VERIFY( aNodeA->GetChildNode(2)->GetId() == node_IDs(3) )
+  ACT_VERIFY( aNodeD->GetNbChildren() == 3 )
+
+  /* ===================================
+   *  Index of a deleted Node is dropped
+   * =================================== */
+
+  Handle(ActData_BaseNode)
+    aNodeJ = Handle(ActData_BaseNode)::DownCast( M->FindNode( node_IDs(10) ) );
+  //
+  const TDF_Label aLabJ = aNodeJ->RootLabel();
+  ACT_VERIFY( aNodeJ->GetNbChildren() == 0 )
+  ACT_VERIFY( ActData_ChildIndex::IsCached(aLabJ) )
+
+  M->OpenCommand();
+  ACT_VERIFY( M->DeleteNode( node_IDs(10) ) )
+  M->CommitCommand();
+
+  ACT_VERIFY( !ActData_ChildIndex::IsCached(aLabJ) )
+  ACT_VERIFY( aNodeD->GetNbChildren() == 2 )
+
+  return true;
+}
+
 //-----------------------------------------------------------------------------
 // EXPRESSION EVALUATION: Test functions support
 //-----------------------------------------------------------------------------
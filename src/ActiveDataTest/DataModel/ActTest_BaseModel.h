@@ -132,7 +132,8 @@ public:
               << &deleteSubTreeNode_D
               << &deleteSubTreeNode_D_AsReferenced
               << deleteSubTreeNode_C
-              << accessObservers_D;
+              << accessObservers_D
+              << &childIndex;
   }
 
 private:
@@ -149,6 +150,7 @@ private:
   static bool deleteSubTreeNode_D_AsReferenced (const int funcID);
   static bool deleteSubTreeNode_C              (const int funcID);
   static bool accessObservers_D                (const int funcID);
+  static bool childIndex                       (const int funcID);
 
 };
 
@@ -33,6 +33,9 @@
 // Own include
 #include <ActTest_ExtTransactionEngine.h>
 
+// OCCT includes
+#include <TDataStd_Integer.hxx>
+
 #pragma warning(disable: 4127) // "Conditional expression is constant" by ACT_VERIFY
 #pragma warning(disable: 4800) // "Standard_Boolean: forcing value to bool" by ACT_VERIFY
 
@@ -62,6 +65,7 @@ bool ActTest_ExtTransactionEngine::namedEngineCommits(const int ActTestLib_NotUs
 
     engine->OpenCommand();
     ACT_VERIFY( engine->HasOpenCommand() )
+    TDataStd_Integer::Set(doc->Main(), i);
     engine->CommitCommandExt( ActAPI_TxData() << Names[i] );
   }
 
@@ -110,6 +114,7 @@ bool ActTest_ExtTransactionEngine::namedEngineUndos(const int ActTestLib_NotUsed
 
     engine->OpenCommand();
     ACT_VERIFY( engine->HasOpenCommand() )
+    TDataStd_Integer::Set(doc->Main(), i);
     engine->CommitCommandExt( ActAPI_TxData() << Names[i] );
   }
 
@@ -174,6 +179,7 @@ bool ActTest_ExtTransactionEngine::namedEngineRedos(const int ActTestLib_NotUsed
 
     engine->OpenCommand();
     ACT_VERIFY( engine->HasOpenCommand() )
+    TDataStd_Integer::Set(doc->Main(), i);
     engine->CommitCommandExt( ActAPI_TxData() << Names[i] );
   }
 
@@ -244,6 +250,7 @@ bool ActTest_ExtTransactionEngine::namedEngineUndoLimit(const int ActTestLib_Not
 
     engine->OpenCommand();
     ACT_VERIFY( engine->HasOpenCommand() )
+    TDataStd_Integer::Set(doc->Main(), i);
     engine->CommitCommandExt( ActAPI_TxData() << Names[i] );
   }
 
@@ -270,5 +277,218 @@ bool ActTest_ExtTransactionEngine::namedEngineUndoLimit(const int ActTestLib_Not
   return true;
 }
 
+//! Checks that the user data follows the deltas actually stacked by the
+//! Document: a commit which stacks nothing binds no data, a commit without
+//! data binds an empty item, and Undo beyond the available history moves
+//! only the data of the undone deltas.
+//! \param funcID [in] ID of test function.
+//! \return true if test is passed, false -- otherwise.
+bool ActTest_ExtTransactionEngine::txDataFollowsDeltas(const int ActTestLib_NotUsed(funcID))
+{
+  ActTest_DocAlloc docAlloc;
+  Handle(TDocStd_Document) doc = docAlloc.Doc;
+
+  Handle(ActData_ExtTransactionEngine) engine = new ActData_ExtTransactionEngine(doc);
+
+  // TR 2 | TR 1 <-|||-> <empty>
+  for ( Standard_Integer i = 1; i <= 2; i++ )
+  {
+    engine->OpenCommand();
+    TDataStd_Integer::Set(doc->Main(), i);
+    engine->CommitCommandExt( ActAPI_TxData() << TCollection_AsciiString("TR ").Cat(i) );
+  }
+
+  // Empty transaction is not stacked, so its data is not kept
+  engine->OpenCommand();
+  engine->CommitCommandExt( ActAPI_TxData() << TCollection_AsciiString("Empty") );
+
+  ACT_VERIFY( engine->NbUndos() == 2 )
+  ACT_VERIFY( engine->NbUndoData() == 2 )
+
+  // Plain commit binds empty data
+  // <empty> | TR 2 | TR 1 <-|||-> <empty>
+  engine->OpenCommand();
+  TDataStd_Integer::Set(doc->Main(), 3);
+  engine->CommitCommand();
+
+  ACT_VERIFY( engine->NbUndoData() == 3 )
+
+  Handle(ActAPI_HTxDataSeq) UndoData = engine->GetUndoData(2);
+  ACT_VERIFY( UndoData->First().IsEmpty() )
+
+  TCollection_AsciiString aName;
+  UndoData->ChangeLast() >> aName;
+  ACT_VERIFY( aName == "TR 2" )
+
+  // <empty> <-|||-> TR 1 | TR 2 | <empty>
+  engine->Undo(10);
+
+  ACT_VERIFY( engine->NbUndoData() == 0 )
+  ACT_VERIFY( engine->NbRedoData() == 3 )
+
+  // Empty transaction does not discard the Redo history
+  engine->OpenCommand();
+  engine->CommitCommandExt( ActAPI_TxData() << TCollection_AsciiString("Empty") );
+
+  ACT_VERIFY( engine->NbRedoData() == 3 )
+
+  // TR 1 <-|||-> TR 2 | <empty>
+  engine->Redo(1);
+
+  Handle(ActAPI_HTxDataSeq) RedoData = engine->GetRedoData(1);
+  ACT_VERIFY( RedoData->Length() == 1 )
+  RedoData->ChangeFirst() >> aName;
+  ACT_VERIFY( aName == "TR 2" )
+
+  return true;
+}
+
 #pragma warning(default: 4127) // "Conditional expression is constant" by ACT_VERIFY
 #pragma warning(default: 4800) // "Standard_Boolean: forcing value to bool" by ACT_VERIFY
+
+//! Checks that Transaction Data returns the streamed values of different
+//! types in their original order, also after being copied and after growing
+//! beyond its inline storage.
+//! \param funcID [in] ID of test function.
+//! \return true if test is passed, false -- otherwise.
+bool ActTest_ExtTransactionEngine::txDataStreaming(const int ActTestLib_NotUsed(funcID))
+{
+  ActAPI_TxData data;
+  ACT_VERIFY( data.IsEmpty() )
+
+  data << 7 << 2.5 << Standard_True << TCollection_AsciiString("Move node");
+  ACT_VERIFY( data.NbValues() == 4 )
+
+  // Copy is extracted from the beginning
+  ActAPI_TxData copy(data);
+
+  Standard_Integer        anInt  = 0;
+  Standard_Real           aReal  = 0.0;
+  Standard_Boolean        aBool  = Standard_False;
+  TCollection_AsciiString aStr;
+  //
+  copy >> anInt >> aReal >> aBool >> aStr;
+
+  ACT_VERIFY( anInt == 7 )
+  ACT_VERIFY( aReal == 2.5 )
+  ACT_VERIFY( aBool )
+  ACT_VERIFY( aStr == "Move node" )
+
+  // Nothing is extracted beyond the end
+  anInt = -1;
+  copy >> anInt;
+  ACT_VERIFY( anInt == -1 )
+
+  // Type mismatch is reported
+  Standard_Boolean isRaised = Standard_False;
+  try
+  {
+    data >> aReal;
+  }
+  catch ( Standard_ProgramError )
+  {
+    isRaised = Standard_True;
+  }
+  ACT_VERIFY( isRaised )
+
+  // Payload larger than the inline storage
+  ActAPI_TxData big;
+  for ( Standard_Integer k = 0; k < 100; ++k )
+    big << k << TCollection_AsciiString("value");
+
+  ActAPI_TxDataSeq seq;
+  seq.Append(big);
+
+  for ( Standard_Integer k = 0; k < 100; ++k )
+  {
+    seq.ChangeFirst() >> anInt >> aStr;
+    ACT_VERIFY( anInt == k )
+    ACT_VERIFY( aStr == "value" )
+  }
+
+  return true;
+}
+
+//! Checks that multi-step Undo and Redo move the user data between the
+//! Undo and Redo histories, that the depth-limited views are clamped, and
+//! that the oldest user data is discarded by the Undo Limit.
+//! \param funcID [in] ID of test function.
+//! \return true if test is passed, false -- otherwise.
+bool ActTest_ExtTransactionEngine::txDataHistoryDepth(const int ActTestLib_NotUsed(funcID))
+{
+  const Standard_Integer UndoLimit = 3,
+                         NbCommits = 7;
+
+  ActTest_DocAlloc docAlloc;
+  Handle(TDocStd_Document) doc = docAlloc.Doc;
+
+  Handle(ActData_ExtTransactionEngine)
+    engine = new ActData_ExtTransactionEngine(doc, UndoLimit);
+
+  // TR 7 | TR 6 | TR 5 <-|||-> <empty>
+  for ( Standard_Integer i = 1; i <= NbCommits; i++ )
+  {
+    engine->OpenCommand();
+    TDataStd_Integer::Set(doc->Main(), i);
+    engine->CommitCommandExt( ActAPI_TxData() << TCollection_AsciiString("TR ").Cat(i) );
+  }
+
+  ACT_VERIFY( engine->NbUndoData() == UndoLimit )
+  ACT_VERIFY( engine->NbRedoData() == 0 )
+
+  // TR 5 <-|||-> TR 6 | TR 7
+  engine->Undo(2);
+
+  ACT_VERIFY( engine->NbUndoData() == 1 )
+  ACT_VERIFY( engine->NbRedoData() == 2 )
+
+  // Views are clamped by the available history
+  Handle(ActAPI_HTxDataSeq) UndoData = engine->GetUndoData(10);
+  Handle(ActAPI_HTxDataSeq) RedoData = engine->GetRedoData(10);
+  //
+  ACT_VERIFY( UndoData->Length() == 1 )
+  ACT_VERIFY( RedoData->Length() == 2 )
+
+  TCollection_AsciiString aName;
+  UndoData->ChangeFirst() >> aName;
+  ACT_VERIFY( aName == "TR 5" )
+  RedoData->ChangeFirst() >> aName;
+  ACT_VERIFY( aName == "TR 6" )
+  RedoData->ChangeLast() >> aName;
+  ACT_VERIFY( aName == "TR 7" )
+
+  // Undo beyond the available history moves what is there
+  // <empty> <-|||-> TR 5 | TR 6 | TR 7
+  engine->Undo(10);
+
+  ACT_VERIFY( engine->NbUndoData() == 0 )
+  ACT_VERIFY( engine->NbRedoData() == 3 )
+
+  // TR 6 | TR 5 <-|||-> TR 7
+  engine->Redo(2);
+
+  UndoData = engine->GetUndoData(1);
+  ACT_VERIFY( UndoData->Length() == 1 )
+  UndoData->ChangeFirst() >> aName;
+  ACT_VERIFY( aName == "TR 6" )
+
+  // New commit discards Redo history
+  // TR 8 | TR 6 | TR 5 <-|||-> <empty>
+  engine->OpenCommand();
+  TDataStd_Integer::Set(doc->Main(), 8);
+  engine->CommitCommandExt( ActAPI_TxData() << TCollection_AsciiString("TR 8") );
+
+  ACT_VERIFY( engine->NbUndoData() == 3 )
+  ACT_VERIFY( engine->NbRedoData() == 0 )
+
+  const ActAPI_TxDataSeq& AllUndoData = engine->GetUndoData();
+  TCollection_AsciiString Names[] = {"TR 8", "TR 6", "TR 5"};
+  Standard_Integer UndoIndex = 0;
+  for ( ActAPI_TxDataSeq::Iterator it(AllUndoData); it.More(); it.Next() )
+  {
+    it.ChangeValue() >> aName;
+    ACT_VERIFY( aName == Names[UndoIndex++] )
+  }
+
+  return true;
+}
@@ -75,7 +75,10 @@ public:
     functions << &namedEngineCommits
               << &namedEngineUndos
               << &namedEngineRedos
-              << &namedEngineUndoLimit;
+              << &namedEngineUndoLimit
+              << &txDataStreaming
+              << &txDataHistoryDepth
+              << &txDataFollowsDeltas;
   }
 
 // Test functions:
@@ -85,6 +88,9 @@ private:
   static bool namedEngineUndos     (const int funcID);
   static bool namedEngineRedos     (const int funcID);
   static bool namedEngineUndoLimit (const int funcID);
+  static bool txDataStreaming      (const int funcID);
+  static bool txDataHistoryDepth   (const int funcID);
+  static bool txDataFollowsDeltas  (const int funcID);
 
 };
 
@@ -35,17 +35,23 @@
 
 // Active Data includes
 #include <ActData_Application.h>
+#include <ActData_MeshDriver.h>
 
 // ACT UT includes
 #include <ActTestLib_Launcher.h>
 
 // OCCT includes
+#include <BinObjMgt_Persistent.hxx>
+#include <gp.hxx>
+#include <Precision.hxx>
 #include <Standard_ImmutableObject.hxx>
 
 // Mesh includes
 #include <ActData_Mesh_ElementsIterator.h>
+#include <ActData_Mesh_Metrics.h>
 #include <ActData_Mesh_Node.h>
 #include <ActData_Mesh_Quadrangle.h>
+#include <ActData_Mesh_StorageIterator.h>
 #include <ActData_Mesh_Triangle.h>
 
 #pragma warning(disable: 4127) // "Conditional expression is constant" by ACT_VERIFY
@@ -361,6 +367,563 @@ bool ActTest_MeshAttrBean::meshBeanTest(const int ActTestLib_NotUsed(funcID))
   return true;
 }
 
+//! Performs test on struct-of-arrays mesh storage: conversion from and to
+//! Mesh DS, iteration, inverse connections, removal of entities and the
+//! packed copy cached on Mesh Attribute.
+//! \param funcID [in] ID of test function.
+//! \return true if test is passed, false -- otherwise.
+bool ActTest_MeshAttrBean::meshStorageTest(const int ActTestLib_NotUsed(funcID))
+{
+  TEST_PRINT_DECOR_L("Struct-of-arrays mesh storage");
+
+  /* =====================
+   *  Prepare source mesh
+   * ===================== */
+
+  Handle(ActData_Mesh) aMesh = new ActData_Mesh;
+
+  for ( Standard_Integer i = 0; i < NB_NODES; ++i )
+    aMesh->AddNode(NODES[i][0], NODES[i][1], NODES[i][2]);
+
+  for ( Standard_Integer i = 0; i < NB_TRIANGLES; ++i )
+    aMesh->AddFace(TRIANGLES[i], 3);
+
+  for ( Standard_Integer i = 0; i < NB_QUADRANGLES; ++i )
+    aMesh->AddFace(QUADRANGLES[i], 4);
+
+  /* =====================================
+   *  Convert to storage and verify data
+   * ===================================== */
+
+  Handle(ActData_Mesh_Storage) aStorage = new ActData_Mesh_Storage(aMesh);
+
+  ACT_VERIFY( aStorage->NbNodes()       == aMesh->NbNodes() )
+  ACT_VERIFY( aStorage->NbTriangles()   == NB_TRIANGLES )
+  ACT_VERIFY( aStorage->NbQuadrangles() == NB_QUADRANGLES )
+
+  for ( Standard_Integer i = 0; i < NB_NODES; ++i )
+  {
+    const Standard_Integer aNodeIdx = aStorage->NodeIndex(i + 1);
+    ACT_VERIFY( aNodeIdx >= 0 )
+    ACT_VERIFY( aStorage->X()[aNodeIdx] == NODES[i][0] )
+    ACT_VERIFY( aStorage->Y()[aNodeIdx] == NODES[i][1] )
+    ACT_VERIFY( aStorage->Z()[aNodeIdx] == NODES[i][2] )
+  }
+
+  // Faces must be the same as in the source mesh
+  Standard_Integer aNbFaces = 0;
+  for ( ActData_Mesh_StorageIterator sit(aStorage, ActData_Mesh_ET_Face); sit.More(); sit.Next(), ++aNbFaces )
+  {
+    Handle(ActData_Mesh_Element) aSrcElem = aMesh->FindElement( sit.ID() );
+    ACT_VERIFY( !aSrcElem.IsNull() )
+    ACT_VERIFY( sit.GetValue()->NbNodes() == aSrcElem->NbNodes() )
+    ACT_VERIFY( sit.IsQuadrangle() == (aSrcElem->NbNodes() == 4) )
+
+    for ( Standard_Integer k = 1; k <= aSrcElem->NbNodes(); ++k )
+      ACT_VERIFY( sit.GetValue()->GetConnection(k) == aSrcElem->GetConnection(k) )
+  }
+  ACT_VERIFY( aNbFaces == NB_TRIANGLES + NB_QUADRANGLES )
+
+  // Conversion back preserves everything
+  Handle(ActData_Mesh) aMeshCopy = aStorage->ToMesh();
+  ACT_VERIFY( aMeshCopy->NbNodes() == aMesh->NbNodes() )
+  ACT_VERIFY( aMeshCopy->NbFaces() == aMesh->NbFaces() )
+
+  /* =====================
+   *  Inverse connections
+   * ===================== */
+
+  aStorage->BuildInverseConnections();
+  ACT_VERIFY( aStorage->HasInverseConnections() )
+
+  Standard_Integer aNbRefs = 0;
+  for ( Standard_Integer i = 0; i < aStorage->NbNodes(); ++i )
+  {
+    const Standard_Integer  aNodeID = aStorage->NodeID(i);
+    const Standard_Integer  aNbInv  = aStorage->NbInverseElements(aNodeID);
+    const Standard_Integer* anInv   = aStorage->InverseElements(aNodeID);
+
+    for ( Standard_Integer k = 0; k < aNbInv; ++k )
+      ACT_VERIFY( aStorage->FindElement(anInv[k])->IsNodeInElement(aNodeID) )
+
+    aNbRefs += aNbInv;
+  }
+  ACT_VERIFY( aNbRefs == 3*NB_TRIANGLES + 4*NB_QUADRANGLES )
+
+  /* ==========
+   *  Removals
+   * ========== */
+
+  const Standard_Integer aNbOwners = aStorage->NbInverseElements(1);
+
+  ACT_VERIFY( !aStorage->RemoveNode(1, Standard_True) )
+  ACT_VERIFY( aStorage->RemoveNode(1) )
+  ACT_VERIFY( !aStorage->HasNode(1) )
+  ACT_VERIFY( aStorage->NbNodes() == NB_NODES - 1 )
+  ACT_VERIFY( aStorage->NbFaces() == NB_TRIANGLES + NB_QUADRANGLES - aNbOwners )
+
+  Standard_Integer aNbRefsLeft = 0;
+  for ( ActData_Mesh_StorageIterator sit(aStorage, ActData_Mesh_ET_Face); sit.More(); sit.Next() )
+  {
+    ACT_VERIFY( !sit.GetValue()->IsNodeInElement(1) )
+    aNbRefsLeft += sit.GetValue()->NbNodes();
+  }
+
+  // Removals keep the inverse connections up to date
+  ACT_VERIFY( aStorage->HasInverseConnections() )
+
+  aNbRefs = 0;
+  for ( Standard_Integer i = 0; i < aStorage->NbNodes(); ++i )
+  {
+    const Standard_Integer  aNodeID = aStorage->NodeID(i);
+    const Standard_Integer  aNbInv  = aStorage->NbInverseElements(aNodeID);
+    const Standard_Integer* anInv   = aStorage->InverseElements(aNodeID);
+
+    for ( Standard_Integer k = 0; k < aNbInv; ++k )
+      ACT_VERIFY( aStorage->FindElement(anInv[k])->IsNodeInElement(aNodeID) )
+
+    aNbRefs += aNbInv;
+  }
+  ACT_VERIFY( aNbRefs == aNbRefsLeft )
+
+  // Addition invalidates them, while the next removal builds them again
+  const Standard_Integer aFreeID = aStorage->AddNode(0.0, 0.0, 0.0);
+  ACT_VERIFY( !aStorage->HasInverseConnections() )
+  ACT_VERIFY( aStorage->RemoveNode(aFreeID, Standard_True) )
+  ACT_VERIFY( aStorage->HasInverseConnections() )
+
+  // Moved nodes are still accessible by their IDs
+  for ( Standard_Integer i = 1; i < NB_NODES; ++i )
+  {
+    Handle(ActData_Mesh_Node) aNode = aStorage->FindNode(i + 1);
+    ACT_VERIFY( !aNode.IsNull() )
+    ACT_VERIFY( aNode->X() == NODES[i][0] )
+  }
+
+  /* ======================================
+   *  Packed copy cached on Mesh Attribute
+   * ====================================== */
+
+  ActTest_DocAlloc docAlloc;
+  Handle(TDocStd_Document) doc = docAlloc.Doc;
+
+  TDF_Label meshLab;
+  DatumIdList NODE_IDS, TRIANGLE_IDS, QUADRANGLE_IDS;
+
+  doc->NewCommand();
+  initializeMeshAttr(doc, meshLab, Standard_False);
+  populateMeshData(doc, meshLab, NODE_IDS, TRIANGLE_IDS, QUADRANGLE_IDS, Standard_False);
+  doc->CommitCommand();
+
+  Handle(ActData_MeshAttr) aMeshAttr;
+  ACT_VERIFY( meshLab.FindAttribute(ActData_MeshAttr::GUID(), aMeshAttr) )
+
+  Handle(ActData_Mesh_Storage) anAttrStorage = aMeshAttr->GetStorage();
+  ACT_VERIFY( !anAttrStorage.IsNull() )
+  ACT_VERIFY( anAttrStorage->NbNodes() == NB_NODES )
+  ACT_VERIFY( anAttrStorage->NbFaces() == NB_TRIANGLES + NB_QUADRANGLES )
+  ACT_VERIFY( aMeshAttr->GetStorage() == anAttrStorage )
+
+  // Moved node makes the packed co-ordinates outdated
+  const Standard_Integer aMovedID     = NODE_IDS.First();
+  const Standard_Real    aMovedXYZ[3] = { 10.0, 20.0, 30.0 };
+
+  doc->NewCommand();
+  ACT_VERIFY( aMeshAttr->SetNodeCoords(&aMovedID, aMovedXYZ, 1) )
+  doc->CommitCommand();
+
+  anAttrStorage = aMeshAttr->GetStorage();
+  ACT_VERIFY( anAttrStorage->X()[anAttrStorage->NodeIndex(aMovedID)] == 10.0 )
+
+  return true;
+}
+
+//! Performs test on spatial index cached on Mesh Attribute: proximity,
+//! ray and range queries, refitting on moved nodes and rebuilding on
+//! added ones.
+//! \param funcID [in] ID of test function.
+//! \return true if test is passed, false -- otherwise.
+bool ActTest_MeshAttrBean::meshBVHTest(const int ActTestLib_NotUsed(funcID))
+{
+  TEST_PRINT_DECOR_L("Spatial index on Mesh Attribute");
+
+  ActTest_DocAlloc docAlloc;
+  Handle(TDocStd_Document) doc = docAlloc.Doc;
+
+  TDF_Label meshLab;
+
+  /* ===================================
+   *  Planar grid of triangulated cells
+   * =================================== */
+
+  const Standard_Integer aNbSide  = 10;
+  const Standard_Integer aNbNodes = aNbSide*aNbSide;
+  const Standard_Integer aNbTris  = 2*(aNbSide - 1)*(aNbSide - 1);
+
+  std::vector<Standard_Real> aCoords;
+  for ( Standard_Integer j = 0; j < aNbSide; ++j )
+    for ( Standard_Integer i = 0; i < aNbSide; ++i )
+    {
+      aCoords.push_back(i);
+      aCoords.push_back(j);
+      aCoords.push_back(0.0);
+    }
+
+  doc->NewCommand();
+  initializeMeshAttr(doc, meshLab, Standard_False);
+
+  Handle(ActData_MeshAttr) aMeshAttr;
+  ACT_VERIFY( meshLab.FindAttribute(ActData_MeshAttr::GUID(), aMeshAttr) )
+
+  const Standard_Integer aFirstID = aMeshAttr->AddNodes(&aCoords[0], aNbNodes);
+
+  std::vector<Standard_Integer> aTris;
+  for ( Standard_Integer j = 0; j < aNbSide - 1; ++j )
+    for ( Standard_Integer i = 0; i < aNbSide - 1; ++i )
+    {
+      const Standard_Integer a = aFirstID + j*aNbSide + i;
+      const Standard_Integer b = a + 1;
+      const Standard_Integer c = b + aNbSide;
+      const Standard_Integer d = a + aNbSide;
+
+      aTris.push_back(a); aTris.push_back(b); aTris.push_back(c);
+      aTris.push_back(a); aTris.push_back(c); aTris.push_back(d);
+    }
+
+  aMeshAttr->AddElements(&aTris[0], aNbTris, 3);
+  doc->CommitCommand();
+
+  Handle(ActData_MeshBVH) aBVH = aMeshAttr->GetBVH();
+  ACT_VERIFY( !aBVH.IsNull() )
+  ACT_VERIFY( aBVH->NbNodes() == aNbNodes )
+  ACT_VERIFY( aBVH->NbFaces() == aNbTris )
+
+  // The index is cached
+  ACT_VERIFY( aMeshAttr->GetBVH() == aBVH )
+
+  /* =========
+   *  Queries
+   * ========= */
+
+  // Nearest node agrees with brute force
+  const gp_Pnt aProbe(3.2, 4.7, 0.5);
+  Standard_Integer aBruteID   = 0;
+  Standard_Real    aBruteDist = RealLast();
+  for ( Standard_Integer k = 0; k < aNbNodes; ++k )
+  {
+    const Standard_Real aDist = aProbe.Distance( gp_Pnt(aCoords[3*k], aCoords[3*k + 1], aCoords[3*k + 2]) );
+    if ( aDist < aBruteDist )
+    {
+      aBruteDist = aDist;
+      aBruteID   = aFirstID + k;
+    }
+  }
+
+  Standard_Real aDist;
+  ACT_VERIFY( aBVH->NearestNode(aProbe, aDist) == aBruteID )
+  ACT_VERIFY( Abs(aDist - aBruteDist) < Precision::Confusion() )
+
+  // Nearest point on the surface is the projection
+  gp_Pnt aClosest;
+  ACT_VERIFY( aBVH->NearestPoint(gp_Pnt(2.5, 2.5, 3.0), aClosest) > 0 )
+  ACT_VERIFY( aClosest.IsEqual(gp_Pnt(2.5, 2.5, 0.0), Precision::Confusion()) )
+
+  // Ray casting
+  Standard_Real aParam;
+  ACT_VERIFY( aBVH->Intersect(gp_Ax1( gp_Pnt(4.3, 5.6, 10.0), -gp::DZ() ), aParam) > 0 )
+  ACT_VERIFY( Abs(aParam - 10.0) < Precision::Confusion() )
+  ACT_VERIFY( aBVH->Intersect(gp_Ax1( gp_Pnt(20.0, 20.0, 10.0), -gp::DZ() ), aParam) == 0 )
+
+  // Range queries
+  TColStd_PackedMapOfInteger anIDs;
+
+  Bnd_Box aBox;
+  aBox.Update(2.0, 2.0, -1.0, 4.0, 4.0, 1.0);
+  aBVH->NodesInBox(aBox, anIDs);
+  ACT_VERIFY( anIDs.Extent() == 9 )
+
+  aBox.SetVoid();
+  aBox.Update(5.2, 5.2, -1.0, 5.8, 5.8, 1.0);
+  aBVH->FacesInBox(aBox, anIDs);
+  ACT_VERIFY( anIDs.Extent() == 2 )
+
+  aBVH->NodesInSphere(gp_Pnt(5.0, 5.0, 0.0), 1.0, anIDs);
+  ACT_VERIFY( anIDs.Extent() == 5 )
+
+  aBVH->FacesInSphere(gp_Pnt(5.5, 5.5, 1.0), 0.5, anIDs);
+  ACT_VERIFY( anIDs.IsEmpty() )
+
+  /* ===================================
+   *  Moved nodes: the index is refitted
+   * =================================== */
+
+  std::vector<Standard_Integer> aNodeIDs(aNbNodes);
+  for ( Standard_Integer k = 0; k < aNbNodes; ++k )
+  {
+    aNodeIDs[k]        = aFirstID + k;
+    aCoords[3*k + 2] += 1.0;
+  }
+
+  doc->NewCommand();
+  ACT_VERIFY( aMeshAttr->SetNodeCoords(&aNodeIDs[0], &aCoords[0], aNbNodes) )
+  doc->CommitCommand();
+
+  ACT_VERIFY( aMeshAttr->GetBVH() == aBVH )
+  ACT_VERIFY( aBVH->Intersect(gp_Ax1( gp_Pnt(4.3, 5.6, 10.0), -gp::DZ() ), aParam) > 0 )
+  ACT_VERIFY( Abs(aParam - 9.0) < Precision::Confusion() )
+
+  /* ==================================
+   *  Added nodes: the index is rebuilt
+   * ================================== */
+
+  doc->NewCommand();
+  aMeshAttr->AddNode(0.0, 0.0, 5.0);
+  doc->CommitCommand();
+
+  Handle(ActData_MeshBVH) aNewBVH = aMeshAttr->GetBVH();
+  ACT_VERIFY( aNewBVH != aBVH )
+  ACT_VERIFY( aNewBVH->NbNodes() == aNbNodes + 1 )
+
+  return true;
+}
+
+//! Performs test on bulk computation of normals, areas, quality measures
+//! and bounding boxes of mesh faces.
+//! \param funcID [in] ID of test function.
+//! \return true if test is passed, false -- otherwise.
+bool ActTest_MeshAttrBean::meshMetricsTest(const int ActTestLib_NotUsed(funcID))
+{
+  TEST_PRINT_DECOR_L("Bulk mesh metrics");
+
+  /* =========================================================
+   *  Unit square with equilateral and right triangles around
+   * ========================================================= */
+
+  const Standard_Real h = 0.5*Sqrt(3.0);
+
+  Handle(ActData_Mesh) aMesh = new ActData_Mesh;
+  const Standard_Integer n1 = aMesh->AddNode( 0.0, 0.0, 0.0);
+  const Standard_Integer n2 = aMesh->AddNode( 1.0, 0.0, 0.0);
+  const Standard_Integer n3 = aMesh->AddNode( 1.0, 1.0, 0.0);
+  const Standard_Integer n4 = aMesh->AddNode( 0.0, 1.0, 0.0);
+  const Standard_Integer n5 = aMesh->AddNode( 2.0, 0.0, 0.0);
+  const Standard_Integer n6 = aMesh->AddNode( 1.5, h,   0.0);
+  const Standard_Integer n7 = aMesh->AddNode(-1.0, 0.0, 0.0);
+
+  const Standard_Integer aSquare   = aMesh->AddFace(n1, n2, n3, n4);
+  const Standard_Integer aEquiTri  = aMesh->AddFace(n2, n5, n6);
+  const Standard_Integer aRightTri = aMesh->AddFace(n1, n4, n7);
+
+  Handle(ActData_Mesh_Metrics) aMetrics = new ActData_Mesh_Metrics(aMesh);
+
+  ACT_VERIFY( aMetrics->NbNodes() == 7 )
+  ACT_VERIFY( aMetrics->NbFaces() == 3 )
+
+  /* ==============
+   *  Face metrics
+   * ============== */
+
+  const Standard_Real aTol = Precision::Confusion();
+
+  for ( Standard_Integer f = 0; f < aMetrics->NbFaces(); ++f )
+  {
+    const Standard_Integer ID = aMetrics->FaceIDs()[f];
+
+    // All faces look up
+    ACT_VERIFY( Abs(aMetrics->FaceNormals()[3*f])     < aTol )
+    ACT_VERIFY( Abs(aMetrics->FaceNormals()[3*f + 1]) < aTol )
+    ACT_VERIFY( Abs(aMetrics->FaceNormals()[3*f + 2] - 1.0) < aTol )
+
+    if ( ID == aSquare )
+    {
+      ACT_VERIFY( Abs(aMetrics->FaceAreas()[f] - 1.0) < aTol )
+      ACT_VERIFY( Abs(aMetrics->AspectRatios()[f] - 1.0) < aTol )
+      ACT_VERIFY( Abs(aMetrics->Skews()[f]) < aTol )
+      ACT_VERIFY( Abs(aMetrics->MinAngles()[f] - 90.0) < aTol )
+    }
+    else if ( ID == aEquiTri )
+    {
+      ACT_VERIFY( Abs(aMetrics->FaceAreas()[f] - 0.5*h) < aTol )
+      ACT_VERIFY( Abs(aMetrics->AspectRatios()[f] - 1.0) < aTol )
+      ACT_VERIFY( Abs(aMetrics->Skews()[f]) < aTol )
+      ACT_VERIFY( Abs(aMetrics->MinAngles()[f] - 60.0) < aTol )
+    }
+    else if ( ID == aRightTri )
+    {
+      ACT_VERIFY( Abs(aMetrics->FaceAreas()[f] - 0.5) < aTol )
+      ACT_VERIFY( Abs(aMetrics->AspectRatios()[f] - (Sqrt(2.0) + 1.0)/Sqrt(3.0)) < aTol )
+      ACT_VERIFY( Abs(aMetrics->Skews()[f] - 0.25) < aTol )
+      ACT_VERIFY( Abs(aMetrics->MinAngles()[f] - 45.0) < aTol )
+
+      const Standard_Real* aBox = aMetrics->FaceBoxes() + 6*f;
+      ACT_VERIFY( Abs(aBox[0] + 1.0) < aTol && Abs(aBox[3]) < aTol )
+      ACT_VERIFY( Abs(aBox[1])       < aTol && Abs(aBox[4] - 1.0) < aTol )
+    }
+    else
+      return false;
+  }
+
+  /* =======================
+   *  Node metrics and box
+   * ======================= */
+
+  for ( Standard_Integer i = 0; i < aMetrics->NbNodes(); ++i )
+    ACT_VERIFY( Abs(aMetrics->NodeNormals()[3*i + 2] - 1.0) < aTol )
+
+  Bnd_Box aBox;
+  aMetrics->GetBoundingBox(aBox);
+
+  Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
+  aBox.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+  ACT_VERIFY( Abs(xMin + 1.0) < aTol && Abs(xMax - 2.0) < aTol )
+  ACT_VERIFY( Abs(yMin) < aTol && Abs(yMax - 1.0) < aTol )
+
+  // Flat results can be stored as Real Array Parameters
+  Handle(TColStd_HArray1OfReal) anAreas = ActData_Mesh_Metrics::ToArray(aMetrics->FaceAreas(), aMetrics->NbFaces());
+  ACT_VERIFY( !anAreas.IsNull() )
+  ACT_VERIFY( anAreas->Length() == 3 )
+
+  return true;
+}
+
+//! Performs test on edge topology cached on Mesh Attribute: boundary
+//! loops, non-manifold edges and feature edges.
+//! \param funcID [in] ID of test function.
+//! \return true if test is passed, false -- otherwise.
+bool ActTest_MeshAttrBean::meshTopologyTest(const int ActTestLib_NotUsed(funcID))
+{
+  TEST_PRINT_DECOR_L("Edge topology on Mesh Attribute");
+
+  ActTest_DocAlloc docAlloc;
+  Handle(TDocStd_Document) doc = docAlloc.Doc;
+
+  TDF_Label meshLab;
+
+  /* ====================================================
+   *  3x3 grid folded by 45 degrees along its middle line
+   * ==================================================== */
+
+  const Standard_Integer aNbSide  = 3;
+  const Standard_Integer aNbNodes = aNbSide*aNbSide;
+  const Standard_Integer aNbTris  = 2*(aNbSide - 1)*(aNbSide - 1);
+
+  std::vector<Standard_Real> aCoords;
+  for ( Standard_Integer j = 0; j < aNbSide; ++j )
+    for ( Standard_Integer i = 0; i < aNbSide; ++i )
+    {
+      aCoords.push_back(i);
+      aCoords.push_back(j);
+      aCoords.push_back(i == aNbSide - 1 ? 1.0 : 0.0);
+    }
+
+  doc->NewCommand();
+  initializeMeshAttr(doc, meshLab, Standard_False);
+
+  Handle(ActData_MeshAttr) aMeshAttr;
+  ACT_VERIFY( meshLab.FindAttribute(ActData_MeshAttr::GUID(), aMeshAttr) )
+
+  const Standard_Integer aFirstID = aMeshAttr->AddNodes(&aCoords[0], aNbNodes);
+
+  std::vector<Standard_Integer> aTris;
+  for ( Standard_Integer j = 0; j < aNbSide - 1; ++j )
+    for ( Standard_Integer i = 0; i < aNbSide - 1; ++i )
+    {
+      const Standard_Integer a = aFirstID + j*aNbSide + i;
+      const Standard_Integer b = a + 1;
+      const Standard_Integer c = b + aNbSide;
+      const Standard_Integer d = a + aNbSide;
+
+      aTris.push_back(a); aTris.push_back(b); aTris.push_back(c);
+      aTris.push_back(a); aTris.push_back(c); aTris.push_back(d);
+    }
+
+  aMeshAttr->AddElements(&aTris[0], aNbTris, 3);
+  doc->CommitCommand();
+
+  Handle(ActData_MeshTopology) aTopo = aMeshAttr->GetTopology();
+  ACT_VERIFY( !aTopo.IsNull() )
+  ACT_VERIFY( aTopo->NbEdges() == 16 )
+  ACT_VERIFY( aTopo->BoundaryEdges().size() == 8 )
+  ACT_VERIFY( aTopo->NonManifoldEdges().empty() )
+
+  // The topology is cached
+  ACT_VERIFY( aMeshAttr->GetTopology() == aTopo )
+
+  /* ====================
+   *  Edges and boundary
+   * ==================== */
+
+  const Standard_Integer aCenterID = aFirstID + 4;
+
+  const Standard_Integer E = aTopo->FindEdge(aCenterID + 1, aCenterID);
+  ACT_VERIFY( E >= 0 )
+  ACT_VERIFY( aTopo->NbEdgeFaces(E) == 2 )
+  ACT_VERIFY( aTopo->FindEdge(aFirstID, aFirstID + aNbNodes - 1) == -1 )
+
+  ACT_VERIFY( aTopo->NbBoundaryLoops() == 1 )
+
+  std::vector<Standard_Integer> aLoop;
+  ACT_VERIFY( aTopo->GetBoundaryLoop(0, aLoop) )
+  ACT_VERIFY( aLoop.size() == 8 )
+  for ( Standard_Size k = 0; k < aLoop.size(); ++k )
+    ACT_VERIFY( aLoop[k] != aCenterID )
+
+  /* ===============
+   *  Feature edges
+   * =============== */
+
+  std::vector<Standard_Integer> aFeatures;
+  aTopo->FeatureEdges(M_PI/6, aFeatures);
+  ACT_VERIFY( aFeatures.size() == 2 )
+  ACT_VERIFY( Abs(aTopo->DihedralAngle(aFeatures[0]) - M_PI/4) < Precision::Angular() )
+
+  aTopo->FeatureEdges(M_PI/3, aFeatures);
+  ACT_VERIFY( aFeatures.empty() )
+
+  /* =======================================
+   *  Moved nodes: the topology is kept, but
+   *  feature edges follow the new geometry
+   * ======================================= */
+
+  std::vector<Standard_Integer> aMovedIDs;
+  std::vector<Standard_Real>    aMovedCoords;
+  for ( Standard_Integer j = 0; j < aNbSide; ++j )
+  {
+    aMovedIDs.push_back(aFirstID + j*aNbSide + aNbSide - 1);
+    aMovedCoords.push_back(aNbSide - 1);
+    aMovedCoords.push_back(j);
+    aMovedCoords.push_back(2.0);
+  }
+
+  doc->NewCommand();
+  ACT_VERIFY( aMeshAttr->SetNodeCoords(&aMovedIDs[0], &aMovedCoords[0], aNbSide) )
+  doc->CommitCommand();
+
+  ACT_VERIFY( aMeshAttr->GetTopology() == aTopo )
+
+  aTopo->FeatureEdges(M_PI/3, aFeatures);
+  ACT_VERIFY( aFeatures.size() == 2 )
+
+  /* ============================================
+   *  Added fin face: the topology is rebuilt and
+   *  the inner edge becomes non-manifold
+   * ============================================ */
+
+  doc->NewCommand();
+  const Standard_Integer aFinID = aMeshAttr->AddNode(1.0, 1.0, 5.0);
+  const Standard_Integer aFin[3] = { aCenterID, aCenterID + 1, aFinID };
+  aMeshAttr->AddElements(aFin, 1, 3);
+  doc->CommitCommand();
+
+  Handle(ActData_MeshTopology) aNewTopo = aMeshAttr->GetTopology();
+  ACT_VERIFY( aNewTopo != aTopo )
+  ACT_VERIFY( aNewTopo->NonManifoldEdges().size() == 1 )
+  ACT_VERIFY( aNewTopo->NonManifoldEdges()[0] == aNewTopo->FindEdge(aCenterID, aCenterID + 1) )
+  ACT_VERIFY( aNewTopo->NbBoundaryLoops() == 2 )
+
+  return true;
+}
+
 //-----------------------------------------------------------------------------
 // ActTest_MeshAttrTransactional: Business logic
 //-----------------------------------------------------------------------------
@@ -458,6 +1021,119 @@ bool ActTest_MeshAttrTransactional::meshTransUndoRedoTest1(const int ActTestLib_
   return true;
 }
 
+//! Performs test of Mesh Attribute by UNDO and REDO of element removal,
+//! replacement of the entire mesh and change of compression tolerance.
+//! \param funcID [in] ID of test function.
+//! \return true if test is passed, false -- otherwise.
+bool ActTest_MeshAttrTransactional::meshTransUndoRedoTest2(const int ActTestLib_NotUsed(funcID))
+{
+  // Collection of resulting mesh elements (nodes, triangles, quadrangles)
+  DatumIdList NODE_IDS, TRIANGLE_IDS, QUADRANGLE_IDS;
+
+  ActTest_DocAlloc docAlloc;
+  Handle(TDocStd_Document) doc = docAlloc.Doc;
+
+  TDF_Label meshLab;
+
+  // Create & Populate Mesh Attribute
+  doc->NewCommand();
+  initializeMeshAttr(doc, meshLab, Standard_False);
+  populateMeshData(doc, meshLab, NODE_IDS, TRIANGLE_IDS, QUADRANGLE_IDS, Standard_False);
+  doc->CommitCommand();
+
+  Handle(ActData_MeshAttr) aMeshAttr;
+  ACT_VERIFY( meshLab.FindAttribute(ActData_MeshAttr::GUID(), aMeshAttr) )
+
+  const Standard_Integer aNbFaces = NB_TRIANGLES + NB_QUADRANGLES;
+
+  /* ===========================================================
+   *  Remove element and check that Undo restores it with the
+   *  original ID and nodes
+   * =========================================================== */
+
+  const Standard_Integer aTriID = TRIANGLE_IDS.First();
+
+  doc->NewCommand();
+  ACT_VERIFY( aMeshAttr->RemoveElement(aTriID) )
+  doc->CommitCommand();
+
+  ACT_VERIFY(aMeshAttr->GetMesh()->NbFaces() == aNbFaces - 1)
+
+  doc->Undo();
+  ACT_VERIFY(aMeshAttr->GetMesh()->NbFaces() == aNbFaces)
+
+  Handle(ActData_Mesh_Element) aTri = aMeshAttr->GetMesh()->FindElement(aTriID);
+  ACT_VERIFY( !aTri.IsNull() )
+  ACT_VERIFY(aTri->NbNodes() == 3)
+  ACT_VERIFY(aTri->GetConnection(1) == TRIANGLES[0][0])
+  ACT_VERIFY(aTri->GetConnection(2) == TRIANGLES[0][1])
+  ACT_VERIFY(aTri->GetConnection(3) == TRIANGLES[0][2])
+
+  /* ===========================================================
+   *  Replace the entire mesh with a new one sharing the nodes
+   *  except the last one which is moved
+   * =========================================================== */
+
+  const Standard_Integer aMovedID = NODE_IDS.Last();
+
+  Handle(ActData_Mesh) aNewMesh = new ActData_Mesh();
+  for ( Standard_Integer i = 0; i < NB_NODES; i++ )
+  {
+    const Standard_Integer aNodeID = NODE_IDS.Value(i + 1);
+    const Standard_Real    aShift  = ( aNodeID == aMovedID ? 1.0 : 0.0 );
+    aNewMesh->AddNodeWithID(NODES[i][0] + aShift, NODES[i][1], NODES[i][2], aNodeID);
+  }
+  for ( Standard_Integer i = 0; i < NB_TRIANGLES; i++ )
+    aNewMesh->AddFaceWithID( TRIANGLES[i], 3, TRIANGLE_IDS.Value(i + 1) );
+
+  doc->NewCommand();
+  aMeshAttr->SetMesh(aNewMesh);
+  doc->CommitCommand();
+
+  ACT_VERIFY(aMeshAttr->GetMesh() == aNewMesh)
+
+  // Undo works on a copy, so the replacing mesh must stay untouched
+  doc->Undo();
+  ACT_VERIFY(aMeshAttr->GetMesh() != aNewMesh)
+  ACT_VERIFY(aMeshAttr->GetMesh()->NbNodes() == NB_NODES)
+  ACT_VERIFY(aMeshAttr->GetMesh()->NbFaces() == aNbFaces)
+  ACT_VERIFY(aMeshAttr->GetMesh()->FindNode(aMovedID)->X() == NODES[NB_NODES - 1][0])
+  ACT_VERIFY(aNewMesh->NbFaces() == NB_TRIANGLES)
+
+  // The copy is owned by the Attribute alone, so it is modified in place
+  const ActData_Mesh* aCopyPtr = aMeshAttr->GetMesh().get();
+
+  doc->Redo();
+  ACT_VERIFY(aMeshAttr->GetMesh().get() == aCopyPtr)
+  ACT_VERIFY(aMeshAttr->GetMesh()->NbNodes() == NB_NODES)
+  ACT_VERIFY(aMeshAttr->GetMesh()->NbFaces() == NB_TRIANGLES)
+  ACT_VERIFY(aMeshAttr->GetMesh()->FindNode(aMovedID)->X() == NODES[NB_NODES - 1][0] + 1.0)
+
+  /* ===========================================================
+   *  Change compression tolerance and check that Undo and Redo
+   *  bring it back and forth
+   * =========================================================== */
+
+  const Standard_Integer aNbUndos = doc->GetAvailableUndos();
+
+  doc->NewCommand();
+  aMeshAttr->SetCompressionTolerance(1.0e-3);
+  aMeshAttr->SetCompressionTolerance(1.0e-2);
+  doc->CommitCommand();
+
+  ACT_VERIFY(doc->GetAvailableUndos() == aNbUndos + 1)
+
+  doc->Undo();
+  ACT_VERIFY(aMeshAttr->GetCompressionTolerance() == 0.0)
+  ACT_VERIFY(aMeshAttr->GetMesh().get() == aCopyPtr)
+
+  doc->Redo();
+  ACT_VERIFY(aMeshAttr->GetCompressionTolerance() == 1.0e-2)
+  ACT_VERIFY(aMeshAttr->GetMesh()->NbFaces() == NB_TRIANGLES)
+
+  return true;
+}
+
 //! Performs test of Mesh Attribute with ABORT action.
 //! \param funcID [in] ID of test function.
 //! \return true if test is passed, false -- otherwise.
@@ -517,6 +1193,204 @@ bool ActTest_MeshAttrTransactional::meshTransAbortTest2(const int ActTestLib_Not
   return true;
 }
 
+//! Performs test of Mesh Attribute by UNDO and REDO of batched node moves.
+//! \param funcID [in] ID of test function.
+//! \return true if test is passed, false -- otherwise.
+bool ActTest_MeshAttrTransactional::meshTransMoveNodesTest(const int ActTestLib_NotUsed(funcID))
+{
+  // Collection of resulting mesh elements (nodes, triangles, quadrangles)
+  DatumIdList NODE_IDS, TRIANGLE_IDS, QUADRANGLE_IDS;
+
+  ActTest_DocAlloc docAlloc;
+  Handle(TDocStd_Document) doc = docAlloc.Doc;
+
+  TDF_Label meshLab;
+
+  // Create & Populate Mesh Attribute
+  doc->NewCommand();
+  initializeMeshAttr(doc, meshLab, Standard_False);
+  populateMeshData(doc, meshLab, NODE_IDS, TRIANGLE_IDS, QUADRANGLE_IDS, Standard_False);
+  doc->CommitCommand();
+
+  Handle(ActData_MeshAttr) aMeshAttr;
+  ACT_VERIFY( meshLab.FindAttribute(ActData_MeshAttr::GUID(), aMeshAttr) )
+
+  const Standard_Integer aNbFaces = NB_TRIANGLES + NB_QUADRANGLES;
+
+  /* ====================================================
+   *  Lift all nodes along Z in one call, twice in a row
+   * ==================================================== */
+
+  std::vector<Standard_Integer> anIDs(NB_NODES);
+  std::vector<Standard_Real>    aCoords(3*NB_NODES);
+
+  for ( Standard_Integer lift = 1; lift <= 2; ++lift )
+  {
+    for ( Standard_Integer i = 0; i < NB_NODES; i++ )
+    {
+      anIDs[i]         = NODE_IDS.Value(i + 1);
+      aCoords[3*i]     = NODES[i][0];
+      aCoords[3*i + 1] = NODES[i][1];
+      aCoords[3*i + 2] = NODES[i][2] + lift;
+    }
+
+    doc->NewCommand();
+    ACT_VERIFY( aMeshAttr->SetNodeCoords(&anIDs[0], &aCoords[0], NB_NODES) )
+    doc->CommitCommand();
+  }
+
+  for ( Standard_Integer i = 0; i < NB_NODES; i++ )
+    ACT_VERIFY(aMeshAttr->GetMesh()->FindNode( NODE_IDS.Value(i + 1) )->Z() == NODES[i][2] + 2)
+
+  ACT_VERIFY(aMeshAttr->GetMesh()->NbNodes() == NB_NODES)
+  ACT_VERIFY(aMeshAttr->GetMesh()->NbFaces() == aNbFaces)
+
+  /* =======================================
+   *  Undo and Redo restore exact positions
+   * ======================================= */
+
+  doc->Undo();
+  for ( Standard_Integer i = 0; i < NB_NODES; i++ )
+    ACT_VERIFY(aMeshAttr->GetMesh()->FindNode( NODE_IDS.Value(i + 1) )->Z() == NODES[i][2] + 1)
+
+  doc->Undo();
+  for ( Standard_Integer i = 0; i < NB_NODES; i++ )
+    ACT_VERIFY(aMeshAttr->GetMesh()->FindNode( NODE_IDS.Value(i + 1) )->Z() == NODES[i][2])
+
+  ACT_VERIFY(aMeshAttr->GetMesh()->NbFaces() == aNbFaces)
+
+  doc->Redo();
+  for ( Standard_Integer i = 0; i < NB_NODES; i++ )
+    ACT_VERIFY(aMeshAttr->GetMesh()->FindNode( NODE_IDS.Value(i + 1) )->Z() == NODES[i][2] + 1)
+
+  /* ===============================================
+   *  Unknown node ID leaves all the nodes in place
+   * =============================================== */
+
+  anIDs[NB_NODES - 1] = -1;
+
+  doc->NewCommand();
+  ACT_VERIFY( !aMeshAttr->SetNodeCoords(&anIDs[0], &aCoords[0], NB_NODES) )
+  doc->CommitCommand();
+
+  for ( Standard_Integer i = 0; i < NB_NODES; i++ )
+    ACT_VERIFY(aMeshAttr->GetMesh()->FindNode( NODE_IDS.Value(i + 1) )->Z() == NODES[i][2] + 1)
+
+  return true;
+}
+
+//! Performs test on renumbering mesh nodes and elements to the dense ranges
+//! of IDs. Checks the old-to-new maps and Undo of compaction.
+//! \param funcID [in] ID of test function.
+//! \return true if test is passed, false -- otherwise.
+bool ActTest_MeshAttrTransactional::meshTransCompactTest(const int ActTestLib_NotUsed(funcID))
+{
+  // Collection of resulting mesh elements (nodes, triangles, quadrangles)
+  DatumIdList NODE_IDS, TRIANGLE_IDS, QUADRANGLE_IDS;
+
+  ActTest_DocAlloc docAlloc;
+  Handle(TDocStd_Document) doc = docAlloc.Doc;
+
+  TDF_Label meshLab;
+
+  // Create & Populate Mesh Attribute
+  doc->NewCommand();
+  initializeMeshAttr(doc, meshLab, Standard_False);
+  populateMeshData(doc, meshLab, NODE_IDS, TRIANGLE_IDS, QUADRANGLE_IDS, Standard_False);
+  doc->CommitCommand();
+
+  Handle(ActData_MeshAttr) aMeshAttr;
+  ACT_VERIFY( meshLab.FindAttribute(ActData_MeshAttr::GUID(), aMeshAttr) )
+
+  ACT_VERIFY( aMeshAttr->GetMesh()->IsCompact() )
+
+  /* =====================================
+   *  Leave holes and far IDs in the mesh
+   * ===================================== */
+
+  const Standard_Integer aFarNodeID = 1000;
+  const Standard_Integer aFarElemID = 5000;
+
+  doc->NewCommand();
+  for ( Standard_Integer k = 1; k <= 5; ++k )
+    ACT_VERIFY( aMeshAttr->RemoveElement( TRIANGLE_IDS.Value(2*k) ) )
+
+  ACT_VERIFY( aMeshAttr->AddNodeWithID(5.0, 5.0, 5.0, aFarNodeID) )
+
+  Standard_Integer aTri[3] = { NODE_IDS.Value(1), NODE_IDS.Value(2), aFarNodeID };
+  ACT_VERIFY( aMeshAttr->AddElementWithID(aTri, 3, aFarElemID) )
+  doc->CommitCommand();
+
+  Handle(ActData_Mesh) anOldMesh = aMeshAttr->GetMesh();
+  ACT_VERIFY( !anOldMesh->IsCompact() )
+
+  /* =========
+   *  Compact
+   * ========= */
+
+  TColStd_DataMapOfIntegerInteger aNodeMap, anElemMap;
+
+  doc->NewCommand();
+  ACT_VERIFY( aMeshAttr->Compact(aNodeMap, anElemMap) )
+  doc->CommitCommand();
+
+  Handle(ActData_Mesh) aNewMesh = aMeshAttr->GetMesh();
+  ACT_VERIFY( aNewMesh != anOldMesh )
+  ACT_VERIFY( aNewMesh->IsCompact() )
+  ACT_VERIFY( aNewMesh->NbNodes() == NB_NODES + 1 )
+  ACT_VERIFY( aNewMesh->NbFaces() == anOldMesh->NbFaces() )
+  ACT_VERIFY( aNodeMap.Extent()   == aNewMesh->NbNodes() )
+  ACT_VERIFY( anElemMap.Extent()  == aNewMesh->NbFaces() )
+
+  // Relative order of IDs is kept
+  ACT_VERIFY( aNodeMap.Find(aFarNodeID)  == NB_NODES + 1 )
+  ACT_VERIFY( anElemMap.Find(aFarElemID) == aNewMesh->NbFaces() )
+
+  // Nodes and connectivity are the same up to renumbering
+  ActData_Mesh_ElementsIterator aNodesIt(anOldMesh, ActData_Mesh_ET_Node);
+  for ( ; aNodesIt.More(); aNodesIt.Next() )
+  {
+    Handle(ActData_Mesh_Node) anOld = Handle(ActData_Mesh_Node)::DownCast( aNodesIt.GetValue() );
+    Handle(ActData_Mesh_Node) aNew  = aNewMesh->FindNode( aNodeMap.Find( anOld->GetID() ) );
+
+    ACT_VERIFY( !aNew.IsNull() )
+    ACT_VERIFY( aNew->Pnt().IsEqual(anOld->Pnt(), 0.0) )
+  }
+
+  ActData_Mesh_ElementsIterator aFacesIt(anOldMesh, ActData_Mesh_ET_Face);
+  for ( ; aFacesIt.More(); aFacesIt.Next() )
+  {
+    const Handle(ActData_Mesh_Element)& anOld = aFacesIt.GetValue();
+    Handle(ActData_Mesh_Element)        aNew  = aNewMesh->FindElement( anElemMap.Find( anOld->GetID() ) );
+
+    ACT_VERIFY( !aNew.IsNull() )
+    ACT_VERIFY( aNew->NbNodes() == anOld->NbNodes() )
+
+    for ( Standard_Integer r = 1; r <= anOld->NbNodes(); ++r )
+      ACT_VERIFY( aNew->GetConnection(r) == aNodeMap.Find( anOld->GetConnection(r) ) )
+  }
+
+  // Dense mesh is left as is
+  doc->NewCommand();
+  ACT_VERIFY( !aMeshAttr->Compact(aNodeMap, anElemMap) )
+  doc->AbortCommand();
+
+  ACT_VERIFY( aNodeMap.IsEmpty() && anElemMap.IsEmpty() )
+  ACT_VERIFY( aMeshAttr->GetMesh() == aNewMesh )
+
+  /* =====================================
+   *  Undo brings the original IDs back
+   * ===================================== */
+
+  doc->Undo();
+
+  ACT_VERIFY( !aMeshAttr->GetMesh()->IsCompact() )
+  ACT_VERIFY( !aMeshAttr->GetMesh()->FindNode(aFarNodeID).IsNull() )
+  ACT_VERIFY( !aMeshAttr->GetMesh()->FindElement(aFarElemID).IsNull() )
+
+  return true;
+}
+
 //-----------------------------------------------------------------------------
 // ActTest_MeshAttrPersistent: business logic
 //-----------------------------------------------------------------------------
@@ -659,5 +1533,205 @@ bool ActTest_MeshAttrPersistent::meshSaveOpenTest(const int ActTestLib_NotUsed(f
   return true;
 }
 
+//! Performs test on the versioned block record of Mesh Attribute: mixed
+//! triangles and quadrangles with an edge are restored with their IDs for
+//! dense and sparse numbering, and the legacy record remains readable.
+//! \param funcID [in] ID of test function.
+//! \return true if test is passed, false -- otherwise.
+bool ActTest_MeshAttrPersistent::meshBlockRecordTest(const int ActTestLib_NotUsed(funcID))
+{
+  TEST_PRINT_DECOR_L("Block record of Mesh Attribute");
+
+  /* ==============================================
+   *  Prepare mesh with interleaved element types
+   * ============================================== */
+
+  Handle(ActData_MeshAttr) aSrcAttr = new ActData_MeshAttr();
+  aSrcAttr->NewEmptyMesh();
+  const Handle(ActData_Mesh)& aSrcMesh = aSrcAttr->GetMesh();
+
+  for ( Standard_Integer i = 0; i < NB_NODES; ++i )
+    aSrcMesh->AddNode(NODES[i][0], NODES[i][1], NODES[i][2]);
+
+  for ( Standard_Integer i = 0; i < NB_QUADRANGLES; ++i )
+  {
+    aSrcMesh->AddFace(TRIANGLES[i], 3);
+    aSrcMesh->AddFace(QUADRANGLES[i], 4);
+  }
+  ACT_VERIFY( aSrcMesh->AddEdge(1, 8) > 0 )
+
+  for ( Standard_Integer i = NB_QUADRANGLES; i < NB_TRIANGLES; ++i )
+    aSrcMesh->AddFace(TRIANGLES[i], 3);
+
+  /* ==========================================
+   *  Dense IDs: record goes to bulk creation
+   * ========================================== */
+
+  {
+    BinObjMgt_Persistent aRecord;
+    ACT_VERIFY( ActData_MeshDriver::Write(aSrcAttr, aRecord) )
+
+    // The record starts with the version tag
+    Standard_Integer aTag;
+    aRecord.BeginReading();
+    aRecord >> aTag;
+    ACT_VERIFY( aTag == -ActData_MeshDriver::FormatVersion_Blocks )
+
+    Handle(ActData_MeshAttr) aDstAttr = new ActData_MeshAttr();
+    aDstAttr->NewEmptyMesh();
+
+    aRecord.BeginReading();
+    ACT_VERIFY( ActData_MeshDriver::Read(aRecord, aDstAttr) )
+    ACT_VERIFY( sameMeshes(aSrcMesh, aDstAttr->GetMesh(), Standard_True) )
+  }
+
+  /* ===========================================
+   *  Sparse IDs: elements are restored by IDs
+   * =========================================== */
+
+  aSrcMesh->RemoveElement(2);
+  aSrcMesh->RemoveNode(4, Standard_False, Standard_False);
+
+  {
+    BinObjMgt_Persistent aRecord;
+    ACT_VERIFY( ActData_MeshDriver::Write(aSrcAttr, aRecord) )
+
+    Handle(ActData_MeshAttr) aDstAttr = new ActData_MeshAttr();
+    aDstAttr->NewEmptyMesh();
+
+    aRecord.BeginReading();
+    ACT_VERIFY( ActData_MeshDriver::Read(aRecord, aDstAttr) )
+    ACT_VERIFY( sameMeshes(aSrcMesh, aDstAttr->GetMesh(), Standard_True) )
+  }
+
+  /* ================================
+   *  Legacy record is still readable
+   * ================================ */
+
+  {
+    BinObjMgt_Persistent aRecord;
+    ACT_VERIFY( ActData_MeshDriver::WriteLegacy(aSrcAttr, aRecord) )
+
+    Handle(ActData_MeshAttr) aDstAttr = new ActData_MeshAttr();
+    aDstAttr->NewEmptyMesh();
+
+    aRecord.BeginReading();
+    ACT_VERIFY( ActData_MeshDriver::Read(aRecord, aDstAttr) )
+    ACT_VERIFY( aDstAttr->GetMesh()->NbEdges() == 0 )
+    ACT_VERIFY( sameMeshes(aSrcMesh, aDstAttr->GetMesh(), Standard_False) )
+  }
+
+  return true;
+}
+
+//! Performs test on the compact record of Mesh Attribute: the nodes deviate
+//! within the compression tolerance, the IDs and connectivity are kept, the
+//! tolerance survives the round trip and the record is smaller than the
+//! block one.
+//! \param funcID [in] ID of test function.
+//! \return true if test is passed, false -- otherwise.
+bool ActTest_MeshAttrPersistent::meshCompactRecordTest(const int ActTestLib_NotUsed(funcID))
+{
+  TEST_PRINT_DECOR_L("Compact record of Mesh Attribute");
+
+  const Standard_Real aTolerance = 1.0e-3;
+
+  Handle(ActData_MeshAttr) aSrcAttr = new ActData_MeshAttr();
+  aSrcAttr->NewEmptyMesh();
+  const Handle(ActData_Mesh)& aSrcMesh = aSrcAttr->GetMesh();
+
+  for ( Standard_Integer i = 0; i < NB_NODES; ++i )
+    aSrcMesh->AddNode(NODES[i][0] + 1.0e-4*i, NODES[i][1], NODES[i][2]);
+
+  for ( Standard_Integer i = 0; i < NB_TRIANGLES; ++i )
+    aSrcMesh->AddFace(TRIANGLES[i], 3);
+
+  for ( Standard_Integer i = 0; i < NB_QUADRANGLES; ++i )
+    aSrcMesh->AddFace(QUADRANGLES[i], 4);
+
+  ACT_VERIFY( aSrcMesh->AddEdge(1, 8) > 0 )
+
+  // Sparse numbering as well
+  aSrcMesh->RemoveElement(2);
+
+  BinObjMgt_Persistent aBlockRecord;
+  ACT_VERIFY( ActData_MeshDriver::Write(aSrcAttr, aBlockRecord) )
+
+  aSrcAttr->SetCompressionTolerance(aTolerance);
+
+  BinObjMgt_Persistent aRecord;
+  ACT_VERIFY( ActData_MeshDriver::Write(aSrcAttr, aRecord) )
+  ACT_VERIFY( aRecord.Length() < aBlockRecord.Length() )
+
+  // The record starts with the version tag
+  Standard_Integer aTag;
+  aRecord.BeginReading();
+  aRecord >> aTag;
+  ACT_VERIFY( aTag == -ActData_MeshDriver::FormatVersion_Compact )
+
+  Handle(ActData_MeshAttr) aDstAttr = new ActData_MeshAttr();
+  aDstAttr->NewEmptyMesh();
+
+  aRecord.BeginReading();
+  ACT_VERIFY( ActData_MeshDriver::Read(aRecord, aDstAttr) )
+  ACT_VERIFY( aDstAttr->GetCompressionTolerance() == aTolerance )
+  ACT_VERIFY( sameMeshes(aSrcMesh, aDstAttr->GetMesh(), Standard_True, aTolerance) )
+
+  // Restored mesh is already on the grid, so it does not drift on re-saving
+  BinObjMgt_Persistent aRecord2;
+  ACT_VERIFY( ActData_MeshDriver::Write(aDstAttr, aRecord2) )
+
+  Handle(ActData_MeshAttr) aDstAttr2 = new ActData_MeshAttr();
+  aDstAttr2->NewEmptyMesh();
+
+  aRecord2.BeginReading();
+  ACT_VERIFY( ActData_MeshDriver::Read(aRecord2, aDstAttr2) )
+  ACT_VERIFY( sameMeshes(aDstAttr->GetMesh(), aDstAttr2->GetMesh(), Standard_True, Precision::Confusion()) )
+
+  return true;
+}
+
+//! Checks that the target mesh has the same nodes and elements (with the
+//! same IDs) as the source one.
+//! \param source [in] reference mesh.
+//! \param target [in] mesh to check.
+//! \param withEdges [in] indicates whether to compare the edges as well.
+//! \param tolerance [in] allowed deviation of the node coordinates.
+//! \return true if meshes are the same, false -- otherwise.
+bool ActTest_MeshAttrPersistent::sameMeshes(const Handle(ActData_Mesh)& source,
+                                            const Handle(ActData_Mesh)& target,
+                                            const Standard_Boolean      withEdges,
+                                            const Standard_Real         tolerance)
+{
+  ACT_VERIFY( target->NbNodes() == source->NbNodes() )
+  ACT_VERIFY( target->NbFaces() == source->NbFaces() )
+  if ( withEdges )
+    ACT_VERIFY( target->NbEdges() == source->NbEdges() )
+
+  for ( ActData_Mesh_ElementsIterator it(source, ActData_Mesh_ET_Node); it.More(); it.Next() )
+  {
+    Handle(ActData_Mesh_Node) aSrcNode = Handle(ActData_Mesh_Node)::DownCast( it.GetValue() );
+    Handle(ActData_Mesh_Node) aDstNode = target->FindNode( aSrcNode->GetID() );
+    ACT_VERIFY( !aDstNode.IsNull() )
+    ACT_VERIFY( aDstNode->Pnt().IsEqual(aSrcNode->Pnt(), tolerance) )
+  }
+
+  ActData_Mesh_ElementsIterator it(source, withEdges ? ActData_Mesh_ET_All : ActData_Mesh_ET_Face);
+  for ( ; it.More(); it.Next() )
+  {
+    const Handle(ActData_Mesh_Element)& aSrcElem = it.GetValue();
+
+    Handle(ActData_Mesh_Element) aDstElem = target->FindElement( aSrcElem->GetID() );
+    ACT_VERIFY( !aDstElem.IsNull() )
+    ACT_VERIFY( aDstElem->DynamicType() == aSrcElem->DynamicType() )
+    ACT_VERIFY( aDstElem->NbNodes() == aSrcElem->NbNodes() )
+
+    for ( Standard_Integer k = 1; k <= aSrcElem->NbNodes(); ++k )
+      ACT_VERIFY( aDstElem->GetConnection(k) == aSrcElem->GetConnection(k) )
+  }
+
+  return true;
+}
+
 #pragma warning(default: 4127) // "Conditional expression is constant" by ACT_VERIFY
 #pragma warning(default: 4800) // "Standard_Boolean: forcing value to bool" by ACT_VERIFY
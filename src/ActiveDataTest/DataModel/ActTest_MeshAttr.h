@@ -124,13 +124,21 @@ public:
   //! \param functions [out] output collection of pointers.
   static void Functions(ActiveDataTestFunctions& functions)
   {
-    functions << &meshBeanTest;
+    functions << &meshBeanTest
+              << &meshStorageTest
+              << &meshBVHTest
+              << &meshMetricsTest
+              << &meshTopologyTest;
   }
 
 // Test functions:
 private:
 
-  static bool meshBeanTest(const int funcID);
+  static bool meshBeanTest    (const int funcID);
+  static bool meshStorageTest (const int funcID);
+  static bool meshBVHTest     (const int funcID);
+  static bool meshMetricsTest (const int funcID);
+  static bool meshTopologyTest(const int funcID);
 
 };
 
@@ -170,15 +178,21 @@ public:
   {
     functions << &meshTransUndoRedoTest1
               << &meshTransAbortTest1
-              << &meshTransAbortTest2;
+              << &meshTransAbortTest2
+              << &meshTransUndoRedoTest2
+              << &meshTransMoveNodesTest
+              << &meshTransCompactTest;
   }
 
 // Test functions:
 private:
 
   static bool meshTransUndoRedoTest1 (const int funcID);
+  static bool meshTransUndoRedoTest2 (const int funcID);
   static bool meshTransAbortTest1    (const int funcID);
   static bool meshTransAbortTest2    (const int funcID);
+  static bool meshTransMoveNodesTest (const int funcID);
+  static bool meshTransCompactTest   (const int funcID);
 
 };
 
@@ -216,13 +230,25 @@ public:
   //! \param functions [out] output collection of pointers.
   static void Functions(ActiveDataTestFunctions& functions)
   {
-    functions << &meshSaveOpenTest;
+    functions << &meshSaveOpenTest
+              << &meshBlockRecordTest
+              << &meshCompactRecordTest;
   }
 
 // Test functions:
 private:
 
-  static bool meshSaveOpenTest(const int funcID);
+  static bool meshSaveOpenTest      (const int funcID);
+  static bool meshBlockRecordTest   (const int funcID);
+  static bool meshCompactRecordTest (const int funcID);
+
+private:
+
+  static bool
+    sameMeshes(const Handle(ActData_Mesh)& source,
+               const Handle(ActData_Mesh)& target,
+               const Standard_Boolean      withEdges,
+               const Standard_Real         tolerance = 0.0);
 
 };
 
@@ -36,6 +36,9 @@
 // Mesh includes
 #include <ActData_Mesh_Node.h>
 
+// OCCT includes
+#include <Poly_Triangulation.hxx>
+
 #pragma warning(disable: 4127) // "Conditional expression is constant" by ACT_VERIFY
 #pragma warning(disable: 4800) // "Standard_Boolean: forcing value to bool" by ACT_VERIFY
 
@@ -110,5 +113,106 @@ bool ActTest_MeshParameter::accessValue(const int ActTestLib_NotUsed(funcID))
   return true;
 }
 
+//! Performs test on bulk construction of mesh in MeshParameter.
+//! \param funcID [in] ID of test function.
+//! \return true if test is passed, false -- otherwise.
+bool ActTest_MeshParameter::bulkConstruction(const int ActTestLib_NotUsed(funcID))
+{
+  /* ====================================
+   *  Initialize underlying CAF document
+   * ==================================== */
+
+  TEST_PRINT_DECOR_L("Bulk construction of mesh");
+
+  ActTest_DocAlloc docAlloc;
+  Handle(TDocStd_Document) doc = docAlloc.Doc;
+
+  doc->NewCommand();
+  Handle(ActData_MeshParameter)
+    param = ActParamTool::AsMesh( createParameter(doc, Parameter_Mesh) );
+  param->SetMesh( new ActData_Mesh() );
+  doc->CommitCommand();
+
+  /* =====================================
+   *  Add 3x3 grid of nodes and triangles
+   * ===================================== */
+
+  Standard_Real COORDS[9*3];
+  for ( Standard_Integer i = 0; i < 9; ++i )
+  {
+    COORDS[3*i]     = i % 3;
+    COORDS[3*i + 1] = i / 3;
+    COORDS[3*i + 2] = 0.0;
+  }
+
+  // Eight triangles, then one referring to a missing node and one duplicate
+  Standard_Integer TRIS[10*3] = { 1, 2, 5,   1, 5, 4,   2, 3, 6,   2, 6, 5,
+                                  4, 5, 8,   4, 8, 7,   5, 6, 9,   5, 9, 8,
+                                  1, 2, 100, 5, 1, 2 };
+
+  Standard_Integer EXTRA_TRI[3] = {1, 4, 7};
+
+  doc->NewCommand();
+  const Standard_Integer aFirstNode = param->AddNodes(COORDS, 9);
+  const Standard_Integer aFirstTri  = param->AddElements(TRIS, 10, 3);
+  const Standard_Integer anExtraTri = param->AddElement(EXTRA_TRI, 3);
+  doc->CommitCommand();
+
+  ACT_VERIFY( aFirstNode == 1 )
+  ACT_VERIFY( aFirstTri  == 1 )
+  ACT_VERIFY( anExtraTri == 9 ) // IDs of the skipped faces are given back
+
+  Handle(ActData_Mesh) aMesh = param->GetMesh();
+  ACT_VERIFY( aMesh->NbNodes() == 9 )
+  ACT_VERIFY( aMesh->NbFaces() == 9 )
+  ACT_VERIFY( aMesh->FindElement(10).IsNull() )
+  ACT_VERIFY( aMesh->FindNode(9)->X() == 2.0 )
+  ACT_VERIFY( aMesh->FindNode(9)->Y() == 2.0 )
+
+  // Inverse connections are built in one pass
+  aMesh->RebuildAllInverseConnections();
+  ACT_VERIFY( aMesh->FindNode(5)->InverseElements().Extent() == 6 )
+  ACT_VERIFY( aMesh->FindNode(1)->InverseElements().Extent() == 3 )
+
+  /* ==================================
+   *  Bulk addition is undone at once
+   * ================================== */
+
+  doc->Undo();
+  ACT_VERIFY( param->GetMesh()->NbNodes() == 0 )
+  ACT_VERIFY( param->GetMesh()->NbFaces() == 0 )
+
+  doc->Redo();
+  ACT_VERIFY( param->GetMesh()->NbNodes() == 9 )
+  ACT_VERIFY( param->GetMesh()->NbFaces() == 9 )
+
+  /* ============================
+   *  Mesh from triangulation
+   * ============================ */
+
+  TColgp_Array1OfPnt aPoints(1, 4);
+  aPoints(1) = gp_Pnt(0.0, 0.0, 0.0);
+  aPoints(2) = gp_Pnt(1.0, 0.0, 0.0);
+  aPoints(3) = gp_Pnt(1.0, 1.0, 0.0);
+  aPoints(4) = gp_Pnt(0.0, 1.0, 0.0);
+
+  Poly_Array1OfTriangle aTriangles(1, 2);
+  aTriangles(1) = Poly_Triangle(1, 2, 3);
+  aTriangles(2) = Poly_Triangle(1, 3, 4);
+
+  doc->NewCommand();
+  param->SetTriangulation( new Poly_Triangulation(aPoints, aTriangles) );
+  doc->CommitCommand();
+
+  aMesh = param->GetMesh();
+  ACT_VERIFY( aMesh->NbNodes() == 4 )
+  ACT_VERIFY( aMesh->NbFaces() == 2 )
+  ACT_VERIFY( aMesh->FindNode(3)->X() == 1.0 )
+  ACT_VERIFY( aMesh->FindNode(3)->Y() == 1.0 )
+  ACT_VERIFY( !aMesh->FindFace(1, 3, 4).IsNull() )
+
+  return true;
+}
+
 #pragma warning(default: 4127) // "Conditional expression is constant" by ACT_VERIFY
 #pragma warning(default: 4800) // "Standard_Boolean: forcing value to bool" by ACT_VERIFY
@@ -72,13 +72,15 @@ public:
   //! \param functions [out] output collection of pointers.
   static void Functions(ActiveDataTestFunctions& functions)
   {
-    functions << &accessValue;
+    functions << &accessValue
+              << &bulkConstruction;
   }
 
 // Test functions:
 private:
 
-  static bool accessValue(const int funcID);
+  static bool accessValue      (const int funcID);
+  static bool bulkConstruction (const int funcID);
 
 };
 
@@ -0,0 +1,1344 @@
+//-----------------------------------------------------------------------------
+// Created on: October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, OPEN CASCADE SAS
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of OPEN CASCADE SAS nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Web: http://dev.opencascade.org
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <ActTest_TransactionEngine.h>
+
+// ActTestLib includes
+#include <ActTestLib_Launcher.h>
+
+// Active Data unit tests
+#include <ActTest_StubBNode.h>
+#include <ActTest_StubMeshNode.h>
+
+// Active Data includes
+#include <ActData_BaseNode.h>
+#include <ActData_ParameterFactory.h>
+#include <ActData_TxStatistics.h>
+
+// OCCT includes
+#include <TDF_Data.hxx>
+
+// ACT Algo includes
+#include <ActAux_Env.h>
+
+// Standard includes
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#pragma warning(disable: 4800) // "Standard_Boolean: forcing value to bool" by ACT_VERIFY
+
+//-----------------------------------------------------------------------------
+// Test functions support
+//-----------------------------------------------------------------------------
+
+//! Creates new Data Model with a single well-formed Node committed to it.
+//! \param M        [out] test Model.
+//! \param theNodeA [out] created Node.
+void ActTest_TransactionEngine::init(Handle(ActTest_DummyModel)& M,
+                                     Handle(ActTest_StubANode)&  theNodeA)
+{
+  M = new ActTest_DummyModel;
+  M->NewEmpty();
+
+  theNodeA = Handle(ActTest_StubANode)::DownCast( ActTest_StubANode::Instance() );
+
+  M->OpenCommand();
+  {
+    M->StubAPartition()->AddNode(theNodeA);
+    theNodeA->Init( ActTestLib_Common::RandomShape(), ActTestLib_Common::RandomShape(), 1.0 );
+    theNodeA->SetName("A");
+  }
+  M->CommitCommand();
+}
+
+//-----------------------------------------------------------------------------
+// Business logic
+//-----------------------------------------------------------------------------
+
+//! Performs test on the packed LogBook mode: the records must follow
+//! Commit, Abort, Undo and Redo just like the OCAF-based ones do.
+//! \param funcID [in] ID of test function.
+//! \return true if test is passed, false -- otherwise.
+bool ActTest_TransactionEngine::packedLogBook(const int ActTestLib_NotUsed(funcID))
+{
+  Handle(ActTest_DummyModel) M = new ActTest_DummyModel;
+  M->SetPackedLogBook(Standard_True);
+  ACT_VERIFY( M->NewEmpty() )
+  ACT_VERIFY( M->IsPackedLogBook() )
+  ACT_VERIFY( M->LogBook().IsPacked() )
+
+  // The packed LogBook is kept by its own Document only
+  Handle(ActTest_DummyModel) M2 = new ActTest_DummyModel;
+  ACT_VERIFY( M2->NewEmpty() )
+  ACT_VERIFY( !M2->LogBook().IsPacked() )
+  M2->Release();
+
+  /* =====================
+   *  Populate Data Model
+   * ===================== */
+
+  Handle(ActTest_StubANode)
+    aNodeA = Handle(ActTest_StubANode)::DownCast( ActTest_StubANode::Instance() );
+  Handle(ActTest_StubANode)
+    aNodeB = Handle(ActTest_StubANode)::DownCast( ActTest_StubANode::Instance() );
+
+  M->OpenCommand();
+  {
+    M->StubAPartition()->AddNode(aNodeA);
+    M->StubAPartition()->AddNode(aNodeB);
+    //
+    aNodeA->Init( ActTestLib_Common::RandomShape(),
+                  ActTestLib_Common::RandomShape(),
+                  ActTestLib_Common::RandomReal() );
+    aNodeB->Init( ActTestLib_Common::RandomShape(),
+                  ActTestLib_Common::RandomShape(),
+                  ActTestLib_Common::RandomReal() );
+  }
+  M->CommitCommand();
+
+  M->FuncReleaseLogBook();
+  ACT_VERIFY( !M->LogBook().IsModified( aNodeA->RootLabel() ) )
+
+  /* ===============================
+   *  Check transactional semantics
+   * =============================== */
+
+  M->OpenCommand();
+  aNodeA->AddChildNode(aNodeB);
+  M->CommitCommand();
+
+  ACT_VERIFY( M->LogBook().IsImpacted( aNodeA->RootLabel() ) )
+  ACT_VERIFY( M->LogBook().IsModified( aNodeA->RootLabel() ) )
+
+  // Packed records do not produce any OCAF attributes
+  ACT_VERIFY( M->LogBook().Label().FindChild(ActData_LogBook::StructureTag_Impacted,
+                                             Standard_False).IsNull() )
+
+  M->Undo();
+  ACT_VERIFY( !M->LogBook().IsImpacted( aNodeA->RootLabel() ) )
+
+  M->Redo();
+  ACT_VERIFY( M->LogBook().IsImpacted( aNodeA->RootLabel() ) )
+
+  M->FuncReleaseLogBook();
+  ACT_VERIFY( !M->LogBook().IsImpacted( aNodeA->RootLabel() ) )
+
+  M->OpenCommand();
+  aNodeA->RemoveChildNode(aNodeB);
+  ACT_VERIFY( M->LogBook().IsImpacted( aNodeA->RootLabel() ) )
+  M->AbortCommand();
+
+  ACT_VERIFY( !M->LogBook().IsImpacted( aNodeA->RootLabel() ) )
+
+  /* ==================================
+   *  Compaction of unused ordinals
+   * ================================== */
+
+  Handle(TDF_Data)              aData   = new TDF_Data;
+  Handle(ActData_PackedLogBook) aPacked = new ActData_PackedLogBook;
+
+  aPacked->OpenCommand();
+  for ( Standard_Integer tag = 1; tag <= 100; ++tag )
+    aPacked->Log(aData->Root().FindChild(tag), ActData_PackedLogBook::Flag_Touched);
+  aPacked->CommitCommand(Standard_True, 10);
+
+  ACT_VERIFY( aPacked->NbOrdinals() == 101 )
+
+  // Released records are kept while the history refers to them
+  aPacked->OpenCommand();
+  aPacked->Release(ActData_PackedLogBook::Flag_Touched);
+  aPacked->CommitCommand(Standard_True, 10);
+
+  ACT_VERIFY( aPacked->NbOrdinals() == 101 )
+  aPacked->Undo();
+  ACT_VERIFY( aPacked->IsLogged(aData->Root().FindChild(50), ActData_PackedLogBook::Flag_Touched) )
+  aPacked->Redo();
+
+  aPacked->Log(aData->Root().FindChild(7), ActData_PackedLogBook::Flag_Forced);
+  aPacked->ReleaseHistory();
+
+  ACT_VERIFY( aPacked->NbOrdinals() == 2 )
+  ACT_VERIFY( aPacked->IsLogged(aData->Root().FindChild(7), ActData_PackedLogBook::Flag_Forced) )
+  ACT_VERIFY( !aPacked->IsLogged(aData->Root().FindChild(50), ActData_PackedLogBook::Flag_Touched) )
+
+  /* =========================
+   *  Back to OCAF attributes
+   * ========================= */
+
+  M->SetPackedLogBook(Standard_False);
+  ACT_VERIFY( !M->LogBook().IsPacked() )
+
+  M->OpenCommand();
+  aNodeA->RemoveChildNode(aNodeB);
+  M->CommitCommand();
+
+  ACT_VERIFY( M->LogBook().IsImpacted( aNodeA->RootLabel() ) )
+
+  return true;
+}
+
+//! Change observer remembering the last received feed.
+class ActTest_ChangeObserver : public ActAPI_IChangeObserver
+{
+public:
+
+  ActTest_ChangeObserver() : ActAPI_IChangeObserver(), NbCalls(0) {}
+
+  virtual void OnChanges(const Handle(ActAPI_ChangeFeed)& theFeed)
+  {
+    LastFeed = theFeed;
+    NbCalls++;
+  }
+
+  Handle(ActAPI_ChangeFeed) LastFeed; //!< Last received feed.
+  int                       NbCalls;  //!< Number of notifications.
+};
+
+//! Performs test on the change feed: Nodes and Parameters must be reported
+//! with proper change kinds for commit, undo and redo.
+//! \param funcID [in] ID of test function.
+//! \return true if test is passed, false -- otherwise.
+bool ActTest_TransactionEngine::changeFeed(const int ActTestLib_NotUsed(funcID))
+{
+  Handle(ActTest_DummyModel) M = new ActTest_DummyModel;
+  ACT_VERIFY( M->NewEmpty() )
+
+  Handle(ActTest_ChangeObserver) observer = new ActTest_ChangeObserver;
+  M->AddChangeObserver(observer);
+
+  /* =============
+   *  Add a Node
+   * ============= */
+
+  Handle(ActTest_StubANode)
+    aNode = Handle(ActTest_StubANode)::DownCast( ActTest_StubANode::Instance() );
+
+  M->OpenCommand();
+  {
+    M->StubAPartition()->AddNode(aNode);
+    aNode->Init( ActTestLib_Common::RandomShape(),
+                 ActTestLib_Common::RandomShape(),
+                 ActTestLib_Common::RandomReal() );
+  }
+  M->CommitCommand();
+
+  const ActAPI_NodeId      nodeId  = aNode->GetId();
+  const ActAPI_ParameterId realId  = aNode->Parameter(ActTest_StubANode::PID_Real)->GetId();
+  const ActAPI_ParameterId shapeId = aNode->Parameter(ActTest_StubANode::PID_DummyShapeA)->GetId();
+
+  ACT_VERIFY( observer->NbCalls == 1 )
+  ACT_VERIFY( observer->LastFeed == M->LastChangeFeed() )
+  ACT_VERIFY( observer->LastFeed->GetOrigin() == ActAPI_ChangeFeed::Origin_Commit )
+  ACT_VERIFY( observer->LastFeed->Nodes().Seek(nodeId) )
+  ACT_VERIFY( observer->LastFeed->Nodes().FindFromKey(nodeId).kind == ActAPI_ChangeFeed::Change_Added )
+  ACT_VERIFY( observer->LastFeed->Parameters().Seek(realId) )
+  ACT_VERIFY( observer->LastFeed->Parameters().FindFromKey(realId).kind == ActAPI_ChangeFeed::Change_Added )
+  ACT_VERIFY( observer->LastFeed->Parameters().FindFromKey(realId).type == Parameter_Real )
+
+  /* ==================
+   *  Modify the Node
+   * ================== */
+
+  M->OpenCommand();
+  ActData_ParameterFactory::AsReal( aNode->Parameter(ActTest_StubANode::PID_Real) )->SetValue(1.0);
+  M->CommitCommand();
+
+  ACT_VERIFY( observer->NbCalls == 2 )
+  ACT_VERIFY( observer->LastFeed->Nodes().FindFromKey(nodeId).kind == ActAPI_ChangeFeed::Change_Modified )
+  ACT_VERIFY( observer->LastFeed->Parameters().FindFromKey(realId).kind == ActAPI_ChangeFeed::Change_Modified )
+  ACT_VERIFY( observer->LastFeed->Parameters().FindFromKey(realId).type == Parameter_Real )
+  ACT_VERIFY( !observer->LastFeed->Parameters().Seek(shapeId) )
+
+  /* ===============
+   *  Undo and Redo
+   * =============== */
+
+  M->Undo();
+
+  ACT_VERIFY( observer->NbCalls == 3 )
+  ACT_VERIFY( observer->LastFeed->GetOrigin() == ActAPI_ChangeFeed::Origin_Undo )
+  ACT_VERIFY( observer->LastFeed->Parameters().FindFromKey(realId).kind == ActAPI_ChangeFeed::Change_Modified )
+
+  M->Undo();
+
+  ACT_VERIFY( observer->NbCalls == 4 )
+  ACT_VERIFY( observer->LastFeed->Nodes().FindFromKey(nodeId).kind == ActAPI_ChangeFeed::Change_Removed )
+  ACT_VERIFY( observer->LastFeed->Parameters().FindFromKey(realId).kind == ActAPI_ChangeFeed::Change_Removed )
+  ACT_VERIFY( observer->LastFeed->Parameters().FindFromKey(realId).type == Parameter_Real )
+
+  M->Redo();
+
+  ACT_VERIFY( observer->NbCalls == 5 )
+  ACT_VERIFY( observer->LastFeed->GetOrigin() == ActAPI_ChangeFeed::Origin_Redo )
+  ACT_VERIFY( observer->LastFeed->Nodes().FindFromKey(nodeId).kind == ActAPI_ChangeFeed::Change_Added )
+
+  /* =================
+   *  Delete the Node
+   * ================= */
+
+  M->OpenCommand();
+  M->DeleteNode(nodeId);
+  M->CommitCommand();
+
+  ACT_VERIFY( observer->NbCalls == 6 )
+  ACT_VERIFY( observer->LastFeed->Nodes().FindFromKey(nodeId).kind == ActAPI_ChangeFeed::Change_Removed )
+
+  // Commit has cleared the Redo stack, so Redo fails and nothing is reported
+  M->Redo();
+
+  ACT_VERIFY( observer->NbCalls == 6 )
+  ACT_VERIFY( observer->LastFeed->GetOrigin() == ActAPI_ChangeFeed::Origin_Commit )
+
+  // No more notifications after unsubscribing
+  M->RemoveChangeObserver(observer);
+  M->Undo();
+
+  ACT_VERIFY( observer->NbCalls == 6 )
+  ACT_VERIFY( M->LastChangeFeed().IsNull() )
+
+  return true;
+}
+
+//! Performs test on immutable snapshots: the captured data must not change
+//! with the Data Model, and unchanged Partitions must be shared.
+//! \param funcID [in] ID of test function.
+//! \return true if test is passed, false -- otherwise.
+bool ActTest_TransactionEngine::snapshot(const int ActTestLib_NotUsed(funcID))
+{
+  Handle(ActTest_DummyModel) M = new ActTest_DummyModel;
+  ACT_VERIFY( M->NewEmpty() )
+
+  /* =====================
+   *  Populate Data Model
+   * ===================== */
+
+  Handle(ActTest_StubANode)
+    aNodeA = Handle(ActTest_StubANode)::DownCast( ActTest_StubANode::Instance() );
+  Handle(ActTest_StubBNode)
+    aNodeB = Handle(ActTest_StubBNode)::DownCast( ActTest_StubBNode::Instance() );
+
+  M->OpenCommand();
+  {
+    M->StubAPartition()->AddNode(aNodeA);
+    M->StubBPartition()->AddNode(aNodeB);
+    //
+    aNodeA->Init( ActTestLib_Common::RandomShape(), ActTestLib_Common::RandomShape(), 1.5 );
+    aNodeB->Init(10, 2.0);
+    //
+    aNodeA->AddChildNode(aNodeB);
+  }
+  M->CommitCommand();
+
+  /* =====================
+   *  Capture and inspect
+   * ===================== */
+
+  Handle(ActData_ModelSnapshot) S1 = M->CaptureSnapshot();
+
+  Handle(ActData_PartitionSnapshot) PA1, PB1;
+  Standard_Integer                  iA = -1, iB = -1;
+  //
+  ACT_VERIFY( S1->FindNode(aNodeA->GetId(), PA1, iA) )
+  ACT_VERIFY( S1->FindNode(aNodeB->GetId(), PB1, iB) )
+  ACT_VERIFY( PA1 != PB1 )
+
+  ACT_VERIFY( PA1->NbChildren(iA) == 1 )
+  ACT_VERIFY( PA1->ChildId(iA, 0) == aNodeB->GetId() )
+  ACT_VERIFY( PB1->ParentId(iB) == aNodeA->GetId() )
+
+  const Standard_Integer pReal = PA1->FindParameter(iA, ActTest_StubANode::PID_Real);
+  const Standard_Integer pInt  = PB1->FindParameter(iB, ActTest_StubBNode::PID_Int);
+  //
+  ACT_VERIFY( pReal >= 0 && pInt >= 0 )
+  ACT_VERIFY( PA1->ParameterType(iA, pReal) == Parameter_Real )
+  ACT_VERIFY( PA1->ParameterValueKind(iA, pReal) == ActData_PartitionSnapshot::Value_Scalar )
+  ACT_VERIFY( PA1->Value(iA, pReal) == 1.5 )
+  ACT_VERIFY( PB1->Value(iB, pInt) == 10.0 )
+
+  // Nothing changed, so everything is shared
+  Handle(ActData_ModelSnapshot) S2 = M->CaptureSnapshot();
+  ACT_VERIFY( S2->Partitions().Extent() == S1->Partitions().Extent() )
+
+  Handle(ActData_PartitionSnapshot) PA2, PB2;
+  ACT_VERIFY( S2->FindNode(aNodeA->GetId(), PA2, iA) )
+  ACT_VERIFY( S2->FindNode(aNodeB->GetId(), PB2, iB) )
+  ACT_VERIFY( PA2 == PA1 )
+  ACT_VERIFY( PB2 == PB1 )
+
+  /* ======================================
+   *  Modify and capture only Partition A
+   * ====================================== */
+
+  M->OpenCommand();
+  ActData_ParameterFactory::AsReal( aNodeA->Parameter(ActTest_StubANode::PID_Real) )->SetValue(2.5);
+  M->CommitCommand();
+
+  Handle(ActData_ModelSnapshot) S3 = M->CaptureSnapshot();
+
+  Handle(ActData_PartitionSnapshot) PA3, PB3;
+  ACT_VERIFY( S3->FindNode(aNodeA->GetId(), PA3, iA) )
+  ACT_VERIFY( S3->FindNode(aNodeB->GetId(), PB3, iB) )
+  ACT_VERIFY( PA3 != PA1 )
+  ACT_VERIFY( PB3 == PB1 )
+  ACT_VERIFY( PA3->Value(iA, PA3->FindParameter(iA, ActTest_StubANode::PID_Real)) == 2.5 )
+
+  // Previous snapshot is immutable
+  ACT_VERIFY( PA1->Value(PA1->FindNode( aNodeA->GetId() ), pReal) == 1.5 )
+
+  return true;
+}
+
+//! Test function for bulk creation of Nodes in a Partition.
+//! \param funcID [in] ID of test function.
+//! \return true if test is passed, false -- otherwise.
+bool ActTest_TransactionEngine::bulkNodes(const int ActTestLib_NotUsed(funcID))
+{
+  Handle(ActTest_DummyModel) M;
+  Handle(ActTest_StubANode)  aNodeA;
+  init(M, aNodeA);
+
+  const Standard_Integer NbNodes = 5;
+
+  Handle(ActAPI_HNodeList) aNodesB;
+
+  M->OpenCommand();
+  aNodesB = M->StubBPartition()->AddNodes(NbNodes, aNodeA);
+  M->CommitCommand();
+
+  ACT_VERIFY( aNodesB->Extent() == NbNodes )
+
+  // Nodes are well-formed, typed and attached in order
+  Standard_Integer idx = 1;
+  for ( ActAPI_NodeList::Iterator nit(*aNodesB); nit.More(); nit.Next(), ++idx )
+  {
+    const Handle(ActAPI_INode)& aNode = nit.Value();
+    //
+    ACT_VERIFY( aNode->IsWellFormed() )
+    ACT_VERIFY( aNode->IsKind( STANDARD_TYPE(ActTest_StubBNode) ) )
+    ACT_VERIFY( aNode->GetParentNode()->GetId() == aNodeA->GetId() )
+    ACT_VERIFY( aNodeA->GetChildNode(idx)->GetId() == aNode->GetId() )
+  }
+
+  // Parameters of the batch share one modification timestamp
+  if ( ActData_BaseModel::MTime_On )
+  {
+    Handle(ActAux_TimeStamp) aFirstMTime =
+      Handle(ActData_UserParameter)::DownCast( aNodesB->First()->Parameter(ActTest_StubBNode::PID_Int) )->GetMTime();
+    Handle(ActAux_TimeStamp) aLastMTime =
+      Handle(ActData_UserParameter)::DownCast( aNodesB->Last()->Parameter(ActTest_StubBNode::PID_Real) )->GetMTime();
+    //
+    ACT_VERIFY( aFirstMTime->IsEqual(aLastMTime) )
+  }
+
+  // Parent cannot become a child of its own child
+  Handle(ActAPI_HNodeList) aCycle = new ActAPI_HNodeList;
+  aCycle->Append(aNodeA);
+
+  M->OpenCommand();
+  ACT_VERIFY( !Handle(ActData_BaseNode)::DownCast( aNodesB->First() )->AddChildNodes(aCycle) )
+  M->AbortCommand();
+
+  ACT_VERIFY( aNodeA->GetParentNode().IsNull() )
+
+  // Regular AddNode() continues after the reserved tags
+  Handle(ActTest_StubBNode)
+    aNodeB = Handle(ActTest_StubBNode)::DownCast( ActTest_StubBNode::Instance() );
+
+  M->OpenCommand();
+  M->StubBPartition()->AddNode(aNodeB);
+  M->CommitCommand();
+
+  ACT_VERIFY( aNodeB->RootLabel().Tag() == aNodesB->Last()->RootLabel().Tag() + 1 )
+
+  // Single Undo removes the whole batch
+  M->Undo(); // AddNode()
+  M->Undo(); // AddNodes()
+  //
+  Handle(ActAPI_HNodeList) aChildren;
+  ACT_VERIFY( aNodeA->IsWellFormed() )
+  ACT_VERIFY( !aNodesB->First()->IsWellFormed() )
+  ACT_VERIFY( aNodeA->GetChildren(aChildren) == 0 )
+
+  return true;
+}
+
+//! Test function for multi-step Undo and Redo.
+//! \param funcID [in] ID of test function.
+//! \return true if test is passed, false -- otherwise.
+bool ActTest_TransactionEngine::multiStepUndo(const int ActTestLib_NotUsed(funcID))
+{
+  Handle(ActTest_DummyModel) M;
+  Handle(ActTest_StubANode)  aNodeA;
+  init(M, aNodeA);
+
+  Handle(ActData_RealParameter)
+    aRealParam = ActData_ParameterFactory::AsReal( aNodeA->Parameter(ActTest_StubANode::PID_Real) );
+  Handle(ActData_NameParameter)
+    aNameParam = ActData_ParameterFactory::AsName( aNodeA->Parameter(ActTest_StubANode::PID_Name) );
+
+  // Several steps touching the same Parameters
+  for ( Standard_Integer k = 2; k <= 5; ++k )
+  {
+    M->OpenCommand();
+    aRealParam->SetValue(k);
+    aNodeA->SetName("A");
+    M->CommitCommand();
+  }
+
+  /* ========================
+   *  Undo four steps at once
+   * ======================== */
+
+  Handle(ActAPI_TxRes) aRes = M->Undo(4);
+  //
+  ACT_VERIFY( aRealParam->GetValue() == 1.0 )
+
+  // Each Parameter is reported once
+  Standard_Integer aNbReal = 0;
+  for ( Standard_Integer k = 1; k <= aRes->parameterRefs.Extent(); ++k )
+  {
+    if ( aRes->parameterRefs(k).id == aRealParam->GetId() )
+      ++aNbReal;
+  }
+  ACT_VERIFY( aNbReal == 1 )
+
+  // All affected Parameters share one modification timestamp
+  ACT_VERIFY( aRealParam->GetMTime()->IsEqual( aNameParam->GetMTime() ) )
+
+  /* ========================
+   *  Redo them back at once
+   * ======================== */
+
+  aRes = M->Redo(4);
+  //
+  ACT_VERIFY( aRealParam->GetValue() == 5.0 )
+  ACT_VERIFY( aRealParam->GetMTime()->IsEqual( aNameParam->GetMTime() ) )
+
+  return true;
+}
+
+//! Test function for the memory cap of Undo history.
+//! \param funcID [in] ID of test function.
+//! \return true if test is passed, false -- otherwise.
+bool ActTest_TransactionEngine::undoMemoryLimit(const int ActTestLib_NotUsed(funcID))
+{
+  Handle(ActTest_DummyModel) M;
+  Handle(ActTest_StubANode)  aNodeA;
+  init(M, aNodeA);
+
+  Handle(ActData_RealParameter)
+    aRealParam = ActData_ParameterFactory::AsReal( aNodeA->Parameter(ActTest_StubANode::PID_Real) );
+
+  /* =================================
+   *  Accounting of the stacked deltas
+   * ================================= */
+
+  ACT_VERIFY( M->GetUndoMemoryUsage() == 0 ) // Not tracked without budget
+
+  M->SetUndoMemoryLimit(1 << 30);
+  ACT_VERIFY( M->GetUndoMemoryUsage() > 0 )
+
+  const Standard_Size aUsage1 = M->GetUndoMemoryUsage();
+  //
+  M->OpenCommand();
+  aRealParam->SetValue(2.0);
+  M->CommitCommand();
+  //
+  ACT_VERIFY( M->GetUndoMemoryUsage() > aUsage1 )
+  ACT_VERIFY( M->NbUndos() == 2 )
+
+  M->Undo();
+  ACT_VERIFY( M->GetUndoMemoryUsage() == aUsage1 )
+  M->Redo();
+  ACT_VERIFY( M->GetUndoMemoryUsage() > aUsage1 )
+
+  /* =====================================
+   *  Tiny budget keeps the last step only
+   * ===================================== */
+
+  M->SetUndoMemoryLimit(1);
+  ACT_VERIFY( M->NbUndos() == 1 )
+
+  for ( Standard_Integer k = 3; k <= 5; ++k )
+  {
+    M->OpenCommand();
+    aRealParam->SetValue(k);
+    M->CommitCommand();
+
+    ACT_VERIFY( M->NbUndos() == 1 )
+  }
+
+  M->Undo();
+  ACT_VERIFY( aRealParam->GetValue() == 4.0 )
+  ACT_VERIFY( M->NbUndos() == 0 )
+
+  return true;
+}
+
+//! Test function for coalescing of consecutive commits.
+//! \param funcID [in] ID of the Test Function.
+//! \return true in case of success, false -- otherwise.
+bool ActTest_TransactionEngine::coalescedCommits(const int ActTestLib_NotUsed(funcID))
+{
+  Handle(ActTest_DummyModel) M;
+  Handle(ActTest_StubANode)  aNodeA;
+  init(M, aNodeA);
+
+  Handle(ActData_RealParameter)
+    aRealParam = ActData_ParameterFactory::AsReal( aNodeA->Parameter(ActTest_StubANode::PID_Real) );
+  Handle(ActData_NameParameter)
+    aNameParam = ActData_ParameterFactory::AsName( aNodeA->Parameter(ActTest_StubANode::PID_Name) );
+
+  const Standard_Integer aNbUndos = M->NbUndos();
+
+  /* ===================================
+   *  Keyed run results in a single step
+   * =================================== */
+
+  M->BeginCoalescing("drag");
+  //
+  for ( Standard_Integer k = 2; k <= 5; ++k )
+  {
+    M->OpenCommand();
+    aRealParam->SetValue(k);
+    M->CommitCommand();
+  }
+  //
+  ACT_VERIFY( M->NbUndos() == aNbUndos + 1 )
+
+  M->Undo();
+  ACT_VERIFY( aRealParam->GetValue() == 1.0 )
+  M->Redo();
+  ACT_VERIFY( aRealParam->GetValue() == 5.0 )
+
+  /* ==========================================
+   *  Undone head or other Parameters break run
+   * ========================================== */
+
+  M->OpenCommand();
+  aRealParam->SetValue(6.0);
+  M->CommitCommand();
+  //
+  ACT_VERIFY( M->NbUndos() == aNbUndos + 2 )
+
+  M->OpenCommand();
+  aNameParam->SetValue("B");
+  M->CommitCommand();
+  //
+  ACT_VERIFY( M->NbUndos() == aNbUndos + 3 )
+
+  M->EndCoalescing();
+
+  M->OpenCommand();
+  aNameParam->SetValue("C");
+  M->CommitCommand();
+  //
+  ACT_VERIFY( M->NbUndos() == aNbUndos + 4 )
+
+  /* ============================
+   *  Commits within time window
+   * ============================ */
+
+  M->SetCoalescingWindow(60.0);
+
+  M->OpenCommand();
+  aNameParam->SetValue("D");
+  M->CommitCommand();
+  //
+  M->OpenCommand();
+  aNameParam->SetValue("E");
+  M->CommitCommand();
+  //
+  ACT_VERIFY( M->NbUndos() == aNbUndos + 5 )
+
+  M->Undo();
+  ACT_VERIFY( aNameParam->GetValue().IsEqual( TCollection_ExtendedString("C") ) )
+
+  M->SetCoalescingWindow(0.0);
+
+  /* ===========================
+   *  Run in a full Undo history
+   * =========================== */
+
+  const Standard_Integer aLimit = M->NbUndos();
+  M->Document()->SetUndoLimit(aLimit);
+
+  M->BeginCoalescing("limit");
+  //
+  for ( Standard_Integer k = 7; k <= 9; ++k )
+  {
+    M->OpenCommand();
+    aRealParam->SetValue(k);
+    M->CommitCommand();
+
+    ACT_VERIFY( M->NbUndos() == aLimit )
+  }
+  //
+  M->EndCoalescing();
+
+  M->Undo();
+  ACT_VERIFY( aRealParam->GetValue() == 6.0 )
+  ACT_VERIFY( M->NbUndos() == aLimit - 1 )
+  M->Redo();
+
+  /* ==========================
+   *  Run under a memory cap
+   * ========================== */
+
+  M->SetUndoMemoryLimit(1 << 30);
+  M->BeginCoalescing("budget");
+
+  M->OpenCommand();
+  aRealParam->SetValue(10.0);
+  M->CommitCommand();
+
+  const Standard_Size aUsage = M->GetUndoMemoryUsage();
+  //
+  M->OpenCommand();
+  aRealParam->SetValue(11.0);
+  M->CommitCommand();
+  //
+  ACT_VERIFY( M->GetUndoMemoryUsage() == aUsage )
+
+  M->SetUndoMemoryLimit(1);
+  ACT_VERIFY( M->NbUndos() == 1 )
+
+  M->OpenCommand();
+  aRealParam->SetValue(12.0);
+  M->CommitCommand();
+  //
+  ACT_VERIFY( M->NbUndos() == 1 )
+
+  M->EndCoalescing();
+  M->SetUndoMemoryLimit(0);
+
+  M->Undo();
+  ACT_VERIFY( aRealParam->GetValue() == 9.0 )
+  ACT_VERIFY( M->NbUndos() == 0 )
+
+  return true;
+}
+
+//! Test function for savepoints inside an open command.
+//! \param funcID [in] ID of the Test Function.
+//! \return true in case of success, false -- otherwise.
+bool ActTest_TransactionEngine::savepoints(const int ActTestLib_NotUsed(funcID))
+{
+  Handle(ActTest_DummyModel) M;
+  Handle(ActTest_StubANode)  aNodeA;
+  init(M, aNodeA);
+
+  Handle(ActData_RealParameter)
+    aRealParam = ActData_ParameterFactory::AsReal( aNodeA->Parameter(ActTest_StubANode::PID_Real) );
+  Handle(ActData_NameParameter)
+    aNameParam = ActData_ParameterFactory::AsName( aNodeA->Parameter(ActTest_StubANode::PID_Name) );
+
+  const Standard_Integer aNbUndos = M->NbUndos();
+
+  /* ==============================================
+   *  Rollback keeps the changes before savepoint
+   * ============================================== */
+
+  M->OpenCommand();
+  {
+    aRealParam->SetValue(2.0);
+
+    M->SetSavepoint("import");
+    {
+      aRealParam->SetValue(3.0);
+      aNameParam->SetValue("B");
+
+      M->SetSavepoint("validate");
+      aRealParam->SetValue(4.0);
+    }
+    M->RollbackToSavepoint("import");
+
+    ACT_VERIFY( aRealParam->GetValue() == 2.0 )
+    ACT_VERIFY( aNameParam->GetValue().IsEqual( TCollection_ExtendedString("A") ) )
+    ACT_VERIFY( M->HasSavepoint("import") )
+    ACT_VERIFY( !M->HasSavepoint("validate") )
+
+    // Work goes on after rollback
+    aRealParam->SetValue(5.0);
+    M->ReleaseSavepoint("import");
+
+    ACT_VERIFY( !M->HasSavepoint("import") )
+    ACT_VERIFY( M->HasOpenCommand() )
+  }
+  M->CommitCommand();
+
+  ACT_VERIFY( aRealParam->GetValue() == 5.0 )
+  ACT_VERIFY( M->NbUndos() == aNbUndos + 1 )
+
+  M->Undo();
+  ACT_VERIFY( aRealParam->GetValue() == 1.0 )
+
+  /* ===================================
+   *  Rollback removes the created Nodes
+   * =================================== */
+
+  Handle(ActTest_StubANode)
+    aNodeB = Handle(ActTest_StubANode)::DownCast( ActTest_StubANode::Instance() );
+
+  M->OpenCommand();
+  {
+    M->SetSavepoint("nodes");
+    M->StubAPartition()->AddNode(aNodeB);
+    aNodeB->Init( ActTestLib_Common::RandomShape(), ActTestLib_Common::RandomShape(), 2.0 );
+    //
+    ACT_VERIFY( aNodeB->IsWellFormed() )
+
+    M->RollbackToSavepoint("nodes");
+    //
+    ACT_VERIFY( !aNodeB->IsWellFormed() )
+  }
+  M->CommitCommand();
+
+  ACT_VERIFY( M->NbUndos() == aNbUndos )
+  ACT_VERIFY( aNodeA->IsWellFormed() )
+
+  return true;
+}
+
+//! Test function for per-commit transaction statistics.
+//! \param funcID [in] ID of test function.
+//! \return true if test is passed, false -- otherwise.
+bool ActTest_TransactionEngine::txStatistics(const int ActTestLib_NotUsed(funcID))
+{
+  Handle(ActTest_DummyModel) M = new ActTest_DummyModel;
+  ACT_VERIFY( M->NewEmpty() )
+
+  Handle(ActData_TxStatistics) aStats = new ActData_TxStatistics(2, 1);
+  M->SetTxStatistics(aStats);
+
+  Handle(ActTest_StubANode)
+    aNodeA = Handle(ActTest_StubANode)::DownCast( ActTest_StubANode::Instance() );
+
+  M->OpenCommand();
+  {
+    M->StubAPartition()->AddNode(aNodeA);
+    aNodeA->Init( ActTestLib_Common::RandomShape(), ActTestLib_Common::RandomShape(), 1.0 );
+  }
+  M->CommitCommand();
+
+  ACT_VERIFY( aStats->NbCommits() == 1 )
+  ACT_VERIFY( aStats->Commit(0).nbDeltas > 0 )
+  ACT_VERIFY( aStats->Commit(0).bytes > 0 )
+  ACT_VERIFY( !aStats->Commit(0).types.empty() )
+  ACT_VERIFY( aStats->Commit(0).hotLabels.size() == 1 )
+
+  Handle(ActData_RealParameter)
+    aRealParam = ActData_ParameterFactory::AsReal( aNodeA->Parameter(ActTest_StubANode::PID_Real) );
+
+  // Only the most recent commits are kept
+  for ( Standard_Integer k = 2; k <= 3; ++k )
+  {
+    M->OpenCommand();
+    aRealParam->SetValue(k);
+    M->CommitCommand();
+  }
+
+  ACT_VERIFY( aStats->NbCommits() == 2 )
+  ACT_VERIFY( aStats->Commit(0).index == 2 )
+  ACT_VERIFY( aStats->Commit(1).index == 3 )
+  ACT_VERIFY( aStats->Commit(1).latency >= 0.0 )
+
+  // Statistics are dumped with a header row plus a row per commit
+  std::ostringstream aCSV;
+  aStats->DumpCSV(aCSV);
+  const std::string aRows = aCSV.str();
+  ACT_VERIFY( std::count( aRows.begin(), aRows.end(), '\n' ) == 3 )
+
+  std::ostringstream aJSON;
+  aStats->DumpJSON(aJSON);
+  ACT_VERIFY( aJSON.str().find("\"hot_labels\"") != std::string::npos )
+
+  // Coalesced commit replaces the record of the previous one
+  M->BeginCoalescing("drag");
+  //
+  M->OpenCommand();
+  aRealParam->SetValue(5.0);
+  M->CommitCommand();
+  //
+  const Standard_Integer aLastIndex = aStats->Commit(1).index;
+  const Standard_Size    aBytes     = aStats->TotalBytes();
+  //
+  M->OpenCommand();
+  aRealParam->SetValue(6.0);
+  M->CommitCommand();
+  //
+  M->EndCoalescing();
+
+  ACT_VERIFY( aStats->NbCommits() == 2 )
+  ACT_VERIFY( aStats->Commit(1).coalesced )
+  ACT_VERIFY( aStats->Commit(1).index == aLastIndex + 1 )
+  ACT_VERIFY( aStats->Commit(0).index == aLastIndex - 1 )
+  ACT_VERIFY( aStats->TotalBytes() == aBytes )
+
+  // Commits are not recorded once the collector is detached
+  M->SetTxStatistics(NULL);
+
+  M->OpenCommand();
+  aRealParam->SetValue(4.0);
+  M->CommitCommand();
+
+  ACT_VERIFY( aStats->NbCommits() == 2 )
+
+  return true;
+}
+
+//! Test function for the write-ahead journal.
+//! \param funcID [in] ID of test function.
+//! \return true if test is passed, false -- otherwise.
+bool ActTest_TransactionEngine::journal(const int ActTestLib_NotUsed(funcID))
+{
+  TCollection_AsciiString
+    aFilename = (ActAux::slashed( ActTestLib_Launcher::current_temp_dir_files() ) + "journal.cbf").c_str();
+
+  Handle(ActTest_DummyModel) M = new ActTest_DummyModel;
+  M->SetJournaling(Standard_True);
+  ACT_VERIFY( M->NewEmpty() )
+
+  Handle(ActTest_StubANode)
+    aNodeA = Handle(ActTest_StubANode)::DownCast( ActTest_StubANode::Instance() );
+  Handle(ActTest_StubBNode)
+    aNodeB1 = Handle(ActTest_StubBNode)::DownCast( ActTest_StubBNode::Instance() );
+  Handle(ActTest_StubMeshNode)
+    aMeshNode = Handle(ActTest_StubMeshNode)::DownCast( ActTest_StubMeshNode::Instance() );
+
+  // Mesh big enough to make its full state noticeable in the journal
+  const Standard_Integer aNbMeshNodes = 1000;
+  Handle(ActData_Mesh) aMesh = new ActData_Mesh;
+  for ( Standard_Integer k = 0; k < aNbMeshNodes; ++k )
+    aMesh->AddNode(k, 0.0, 0.0);
+
+  M->OpenCommand();
+  {
+    M->StubAPartition()->AddNode(aNodeA);
+    M->StubBPartition()->AddNode(aNodeB1);
+    M->StubMeshPartition()->AddNode(aMeshNode);
+    //
+    aNodeA->Init( ActTestLib_Common::RandomShape(), ActTestLib_Common::RandomShape(), 1.0 );
+    aNodeB1->Init(1, 1.0);
+    aMeshNode->Init(aMesh);
+    //
+    aNodeA->AddChildNode(aNodeB1);
+    ActData_ParameterFactory::AsReferenceList( aNodeB1->Parameter(ActTest_StubBNode::PID_RefList) )->AddTarget(aNodeA);
+  }
+  M->CommitCommand();
+
+  // Journal starts with the full save
+  ACT_VERIFY( M->GetJournal().IsNull() )
+  ACT_VERIFY( M->SaveAs(aFilename) )
+  ACT_VERIFY( !M->GetJournal().IsNull() )
+  ACT_VERIFY( M->GetJournal()->NbRecords() == 0 )
+  ACT_VERIFY( !ActData_BaseModel::HasRecoverableChanges(aFilename) )
+
+  const ActAPI_DataObjectId aNodeId     = aNodeA->GetId();
+  const ActAPI_DataObjectId aMeshNodeId = aMeshNode->GetId();
+
+  Handle(ActData_RealParameter)
+    aRealParam = ActData_ParameterFactory::AsReal( aNodeA->Parameter(ActTest_StubANode::PID_Real) );
+
+  // Existing Tree Node and reference list are journaled together with
+  // the new Node
+  Handle(ActTest_StubBNode)
+    aNodeB2 = Handle(ActTest_StubBNode)::DownCast( ActTest_StubBNode::Instance() );
+
+  M->OpenCommand();
+  {
+    M->StubBPartition()->AddNode(aNodeB2);
+    aNodeB2->Init(2, 2.0);
+    //
+    aNodeA->AddChildNode(aNodeB2);
+    ActData_ParameterFactory::AsReferenceList( aNodeB1->Parameter(ActTest_StubBNode::PID_RefList) )->AddTarget(aNodeB2);
+  }
+  M->CommitCommand();
+
+  const ActAPI_DataObjectId aNodeB1Id = aNodeB1->GetId();
+  const ActAPI_DataObjectId aNodeB2Id = aNodeB2->GetId();
+
+  // Modified mesh is journaled by its delta rather than in full
+  const Standard_Size aSizeBeforeMesh = M->GetJournal()->Size();
+
+  M->OpenCommand();
+  ActData_ParameterFactory::AsMesh( aMeshNode->Parameter(ActTest_StubMeshNode::Param_Mesh) )->AddNode(0.0, 1.0, 0.0);
+  M->CommitCommand();
+
+  ACT_VERIFY( M->GetJournal()->Size() - aSizeBeforeMesh < aNbMeshNodes*3*sizeof(Standard_Real) )
+
+  // Each commit, Undo and Redo is journaled
+  for ( Standard_Integer k = 2; k <= 3; ++k )
+  {
+    M->OpenCommand();
+    aRealParam->SetValue(k);
+    M->CommitCommand();
+  }
+  M->Undo();
+
+  ACT_VERIFY( M->GetJournal()->NbRecords() == 5 )
+
+  // The Data Model is not released as if the application crashed, so the
+  // journal is left for recovery
+  M->GetJournal()->Close();
+  ACT_VERIFY( ActData_BaseModel::HasRecoverableChanges(aFilename) )
+
+  Handle(ActTest_DummyModel) M2 = new ActTest_DummyModel;
+  M2->SetJournaling(Standard_True);
+  ACT_VERIFY( M2->Open(aFilename) )
+  ACT_VERIFY( M2->IsModified() )
+
+  Handle(ActTest_StubANode)
+    aNodeA2 = Handle(ActTest_StubANode)::DownCast( M2->FindNode(aNodeId) );
+
+  ACT_VERIFY( !aNodeA2.IsNull() )
+  ACT_VERIFY( aNodeA2->IsWellFormed() )
+  ACT_VERIFY( ActData_ParameterFactory::AsReal( aNodeA2->Parameter(ActTest_StubANode::PID_Real) )->GetValue() == 2.0 )
+
+  // Replay does not duplicate the children and the references
+  Handle(ActAPI_IChildIterator) aChildIt = aNodeA2->GetChildIterator();
+  ACT_VERIFY( aChildIt->More() && aChildIt->Value()->GetId().IsEqual(aNodeB1Id) )
+  aChildIt->Next();
+  ACT_VERIFY( aChildIt->More() && aChildIt->Value()->GetId().IsEqual(aNodeB2Id) )
+  aChildIt->Next();
+  ACT_VERIFY( !aChildIt->More() )
+
+  Handle(ActData_ReferenceListParameter)
+    aRefList2 = ActData_ParameterFactory::AsReferenceList( M2->FindNode(aNodeB1Id)->Parameter(ActTest_StubBNode::PID_RefList) );
+  //
+  ACT_VERIFY( aRefList2->NbTargets() == 2 )
+  ACT_VERIFY( aRefList2->GetTarget(1)->GetId().IsEqual(aNodeId) )
+  ACT_VERIFY( aRefList2->GetTarget(2)->GetId().IsEqual(aNodeB2Id) )
+
+  // Mesh delta is replayed over the saved mesh
+  Handle(ActTest_StubMeshNode)
+    aMeshNode2 = Handle(ActTest_StubMeshNode)::DownCast( M2->FindNode(aMeshNodeId) );
+
+  ACT_VERIFY( !aMeshNode2.IsNull() )
+  ACT_VERIFY( aMeshNode2->GetMesh()->NbNodes() == aNbMeshNodes + 1 )
+
+  // Compaction folds the journal into the full save
+  M2->SetJournaling(Standard_True, 1);
+
+  M2->OpenCommand();
+  ActData_ParameterFactory::AsReal( aNodeA2->Parameter(ActTest_StubANode::PID_Real) )->SetValue(5.0);
+  M2->CommitCommand();
+
+  ACT_VERIFY( M2->GetJournal()->NbRecords() == 0 )
+
+  // Closing without save abandons the changes, so the journal is removed
+  M2->SetJournaling(Standard_True);
+
+  M2->OpenCommand();
+  ActData_ParameterFactory::AsReal( aNodeA2->Parameter(ActTest_StubANode::PID_Real) )->SetValue(6.0);
+  M2->CommitCommand();
+
+  ACT_VERIFY( M2->GetJournal()->NbRecords() == 1 )
+  M2->Release();
+  ACT_VERIFY( !ActData_BaseModel::HasRecoverableChanges(aFilename) )
+
+  Handle(ActTest_DummyModel) M3 = new ActTest_DummyModel;
+  M3->SetJournaling(Standard_True);
+  ACT_VERIFY( M3->Open(aFilename) )
+  ACT_VERIFY( !M3->IsModified() )
+
+  Handle(ActTest_StubANode)
+    aNodeA3 = Handle(ActTest_StubANode)::DownCast( M3->FindNode(aNodeId) );
+
+  ACT_VERIFY( !aNodeA3.IsNull() )
+  ACT_VERIFY( ActData_ParameterFactory::AsReal( aNodeA3->Parameter(ActTest_StubANode::PID_Real) )->GetValue() == 5.0 )
+
+  Handle(ActTest_StubMeshNode)
+    aMeshNode3 = Handle(ActTest_StubMeshNode)::DownCast( M3->FindNode(aMeshNodeId) );
+
+  ACT_VERIFY( aMeshNode3->GetMesh()->NbNodes() == aNbMeshNodes + 1 )
+
+  // Recovery can be declined by discarding the journal before opening
+  M3->OpenCommand();
+  ActData_ParameterFactory::AsReal( aNodeA3->Parameter(ActTest_StubANode::PID_Real) )->SetValue(7.0);
+  M3->CommitCommand();
+  M3->GetJournal()->Close();
+
+  ACT_VERIFY( ActData_BaseModel::HasRecoverableChanges(aFilename) )
+  ACT_VERIFY( ActData_BaseModel::DiscardJournal(aFilename) )
+  ACT_VERIFY( !ActData_BaseModel::HasRecoverableChanges(aFilename) )
+
+  Handle(ActTest_DummyModel) M4 = new ActTest_DummyModel;
+  M4->SetJournaling(Standard_True);
+  ACT_VERIFY( M4->Open(aFilename) )
+  ACT_VERIFY( !M4->IsModified() )
+
+  Handle(ActTest_StubANode)
+    aNodeA4 = Handle(ActTest_StubANode)::DownCast( M4->FindNode(aNodeId) );
+
+  ACT_VERIFY( ActData_ParameterFactory::AsReal( aNodeA4->Parameter(ActTest_StubANode::PID_Real) )->GetValue() == 5.0 )
+  M4->Release();
+
+  return true;
+}
+
+//! Test function for the change-set diff between two states of Data Model.
+//! \param funcID [in] ID of test function.
+//! \return true if test is passed, false -- otherwise.
+bool ActTest_TransactionEngine::modelDiff(const int ActTestLib_NotUsed(funcID))
+{
+  TCollection_AsciiString
+    aFilename1 = (ActAux::slashed( ActTestLib_Launcher::current_temp_dir_files() ) + "modelDiff_1.cbf").c_str(),
+    aFilename2 = (ActAux::slashed( ActTestLib_Launcher::current_temp_dir_files() ) + "modelDiff_2.cbf").c_str();
+
+  Handle(ActTest_DummyModel) M = new ActTest_DummyModel;
+  ACT_VERIFY( M->NewEmpty() )
+
+  Handle(ActTest_StubANode)
+    aNode1 = Handle(ActTest_StubANode)::DownCast( ActTest_StubANode::Instance() ),
+    aNode2 = Handle(ActTest_StubANode)::DownCast( ActTest_StubANode::Instance() ),
+    aNode3 = Handle(ActTest_StubANode)::DownCast( ActTest_StubANode::Instance() );
+
+  M->OpenCommand();
+  {
+    M->StubAPartition()->AddNode(aNode1);
+    M->StubAPartition()->AddNode(aNode2);
+    aNode1->Init( ActTestLib_Common::RandomShape(), ActTestLib_Common::RandomShape(), 1.0 );
+    aNode2->Init( ActTestLib_Common::RandomShape(), ActTestLib_Common::RandomShape(), 2.0 );
+    aNode2->SetName("Second");
+    aNode1->ConnectReference( ActTest_StubANode::PID_Ref, aNode2->Parameter(ActTest_StubANode::PID_Real) );
+  }
+  M->CommitCommand();
+  ACT_VERIFY( M->SaveAs(aFilename1) )
+
+  // Nothing differs from the current state
+  ACT_VERIFY( M->DiffWithUndo(0)->IsEmpty() )
+
+  M->OpenCommand();
+  {
+    M->StubAPartition()->AddNode(aNode3);
+    aNode3->Init( ActTestLib_Common::RandomShape(), ActTestLib_Common::RandomShape(), 3.0 );
+    ActData_ParameterFactory::AsReal( aNode1->Parameter(ActTest_StubANode::PID_Real) )->SetValue(10.0);
+    aNode2->SetName("Renamed");
+    aNode1->ConnectReference( ActTest_StubANode::PID_Ref, aNode3->Parameter(ActTest_StubANode::PID_Real) );
+  }
+  M->CommitCommand();
+
+  const Standard_Integer nbUndos = M->NbUndos();
+
+  Handle(ActData_ModelDiff) aDiff = M->DiffWithUndo(1);
+  ACT_VERIFY( !aDiff.IsNull() )
+
+  // History and the current state are kept
+  ACT_VERIFY( M->NbUndos() == nbUndos )
+  ACT_VERIFY( ActData_ParameterFactory::AsReal( aNode1->Parameter(ActTest_StubANode::PID_Real) )->GetValue() == 10.0 )
+
+  ACT_VERIFY( aDiff->AddedNodes().Length() == 1 )
+  ACT_VERIFY( aDiff->AddedNodes().First() == aNode3->GetId() )
+  ACT_VERIFY( aDiff->RemovedNodes().IsEmpty() )
+
+  ACT_VERIFY( aDiff->RenamedNodes().Length() == 1 )
+  ACT_VERIFY( aDiff->RenamedNodes().First().id == aNode2->GetId() )
+  ACT_VERIFY( aDiff->RenamedNodes().First().oldName == "Second" )
+
+  Standard_Boolean isRealChanged = Standard_False;
+  for ( Standard_Integer i = 1; i <= aDiff->ChangedParameters().Length(); ++i )
+  {
+    const ActData_ModelDiff::t_changedParameter& change = aDiff->ChangedParameters()(i);
+    //
+    if ( change.nodeId == aNode1->GetId() && change.key == ActTest_StubANode::PID_Real )
+      isRealChanged = (change.kind == ActAPI_ChangeFeed::Change_Modified);
+  }
+  ACT_VERIFY( isRealChanged )
+
+  ACT_VERIFY( aDiff->RewiredReferences().Length() == 1 )
+  ACT_VERIFY( aDiff->RewiredReferences().First().nodeId == aNode1->GetId() )
+  ACT_VERIFY( aDiff->RewiredReferences().First().removed.First() == aNode2->Parameter(ActTest_StubANode::PID_Real)->GetId() )
+  ACT_VERIFY( aDiff->RewiredReferences().First().added.First() == aNode3->Parameter(ActTest_StubANode::PID_Real)->GetId() )
+
+  // Statuses set by the execution of functions are not differences
+  M->OpenCommand();
+  {
+    aNode1->Parameter(ActTest_StubANode::PID_Real)->SetValidity(Standard_False);
+    aNode1->Parameter(ActTest_StubANode::PID_Real)->SetPending(Standard_True);
+  }
+  M->CommitCommand();
+  ACT_VERIFY( M->DiffWithUndo(1)->IsEmpty() )
+
+  // Another saved Document
+  ACT_VERIFY( M->SaveAs(aFilename2) )
+
+  aDiff = M->DiffWithFile(aFilename1);
+  ACT_VERIFY( !aDiff.IsNull() )
+  ACT_VERIFY( aDiff->AddedNodes().Length() == 1 )
+  ACT_VERIFY( aDiff->RenamedNodes().Length() == 1 )
+  ACT_VERIFY( aDiff->RewiredReferences().Length() == 1 )
+
+  return true;
+}
+
+//! Test function for the mesh payloads kept out of the Document.
+//! \param funcID [in] ID of test function.
+//! \return true if test is passed, false -- otherwise.
+bool ActTest_TransactionEngine::externalPayloads(const int ActTestLib_NotUsed(funcID))
+{
+  TCollection_AsciiString
+    aFilename = (ActAux::slashed( ActTestLib_Launcher::current_temp_dir_files() ) + "externalPayloads.cbf").c_str();
+
+  Handle(ActTest_DummyModel) M = new ActTest_DummyModel;
+  M->SetExternalPayloads(Standard_True);
+  ACT_VERIFY( M->NewEmpty() )
+
+  Handle(ActData_Mesh) aMesh = new ActData_Mesh;
+  const Standard_Integer n1 = aMesh->AddNode(0.0, 0.0, 0.0);
+  const Standard_Integer n2 = aMesh->AddNode(1.0, 0.0, 0.0);
+  const Standard_Integer n3 = aMesh->AddNode(1.0, 1.0, 0.0);
+  const Standard_Integer n4 = aMesh->AddNode(0.0, 1.0, 0.0);
+  aMesh->AddFace(n1, n2, n3);
+  aMesh->AddFace(n1, n3, n4);
+  aMesh->AddFace(n1, n2, n3, n4);
+
+  Handle(ActTest_StubMeshNode)
+    aMeshNode = Handle(ActTest_StubMeshNode)::DownCast( ActTest_StubMeshNode::Instance() );
+
+  M->OpenCommand();
+  {
+    M->StubMeshPartition()->AddNode(aMeshNode);
+    aMeshNode->Init(aMesh);
+  }
+  M->CommitCommand();
+
+  // The mesh goes to the sidecar file
+  ACT_VERIFY( M->GetPayloadStore().IsNull() )
+  ACT_VERIFY( M->SaveAs(aFilename) )
+  ACT_VERIFY( !M->GetPayloadStore().IsNull() )
+  ACT_VERIFY( M->GetPayloadStore()->NbPayloads() == 1 )
+
+  const Standard_Size aSidecarSize = M->GetPayloadStore()->Size();
+
+  // Unchanged mesh is not written once again
+  ACT_VERIFY( M->SaveAs(aFilename) )
+  ACT_VERIFY( M->GetPayloadStore()->NbPayloads() == 1 )
+  ACT_VERIFY( M->GetPayloadStore()->Size() == aSidecarSize )
+
+  const ActAPI_DataObjectId aNodeId = aMeshNode->GetId();
+  M->Release();
+
+  Handle(ActTest_DummyModel) M2 = new ActTest_DummyModel;
+  M2->SetExternalPayloads(Standard_True);
+  ACT_VERIFY( M2->Open(aFilename) )
+  ACT_VERIFY( !M2->GetPayloadStore().IsNull() )
+  ACT_VERIFY( M2->GetPayloadStore()->NbPayloads() == 1 )
+
+  Handle(ActTest_StubMeshNode)
+    aMeshNode2 = Handle(ActTest_StubMeshNode)::DownCast( M2->FindNode(aNodeId) );
+
+  ACT_VERIFY( !aMeshNode2.IsNull() )
+  ACT_VERIFY( aMeshNode2->IsWellFormed() )
+
+  // The mesh is decoded on first access
+  Handle(ActData_Mesh) aMesh2 = aMeshNode2->GetMesh();
+  ACT_VERIFY( !aMesh2.IsNull() )
+  ACT_VERIFY( aMesh2->NbNodes() == 4 )
+  ACT_VERIFY( aMesh2->NbFaces() == 3 )
+
+  // Materialized mesh is deduplicated against its own payload
+  ACT_VERIFY( M2->SaveAs(aFilename) )
+  ACT_VERIFY( M2->GetPayloadStore()->NbPayloads() == 1 )
+  ACT_VERIFY( M2->GetPayloadStore()->Size() == aSidecarSize )
+
+  M2->Release();
+
+  // Saving back to the opened sidecar file does not truncate it while
+  // the mesh is not yet decoded
+  TCollection_AsciiString
+    aFilename2 = (ActAux::slashed( ActTestLib_Launcher::current_temp_dir_files() ) + "externalPayloads2.cbf").c_str();
+
+  Handle(ActTest_DummyModel) M3 = new ActTest_DummyModel;
+  M3->SetExternalPayloads(Standard_True);
+  ACT_VERIFY( M3->Open(aFilename) )
+  ACT_VERIFY( M3->SaveAs(aFilename2) )
+  ACT_VERIFY( M3->SaveAs(aFilename) )
+  ACT_VERIFY( M3->GetPayloadStore()->NbPayloads() == 1 )
+  ACT_VERIFY( M3->GetPayloadStore()->Size() == aSidecarSize )
+
+  Handle(ActTest_StubMeshNode)
+    aMeshNode3 = Handle(ActTest_StubMeshNode)::DownCast( M3->FindNode(aNodeId) );
+
+  ACT_VERIFY( !aMeshNode3.IsNull() )
+
+  Handle(ActData_Mesh) aMesh3 = aMeshNode3->GetMesh();
+  ACT_VERIFY( !aMesh3.IsNull() )
+  ACT_VERIFY( aMesh3->NbNodes() == 4 )
+  ACT_VERIFY( aMesh3->NbFaces() == 3 )
+
+  M3->Release();
+
+  // The sidecar file is still intact
+  Handle(ActTest_DummyModel) M4 = new ActTest_DummyModel;
+  M4->SetExternalPayloads(Standard_True);
+  ACT_VERIFY( M4->Open(aFilename) )
+
+  Handle(ActTest_StubMeshNode)
+    aMeshNode4 = Handle(ActTest_StubMeshNode)::DownCast( M4->FindNode(aNodeId) );
+
+  ACT_VERIFY( !aMeshNode4.IsNull() )
+
+  Handle(ActData_Mesh) aMesh4 = aMeshNode4->GetMesh();
+  ACT_VERIFY( !aMesh4.IsNull() )
+  ACT_VERIFY( aMesh4->NbNodes() == 4 )
+  ACT_VERIFY( aMesh4->NbFaces() == 3 )
+
+  // The store belongs to its Document only, so another Document saved
+  // meanwhile keeps its meshes embedded
+  TCollection_AsciiString
+    aFilename3 = (ActAux::slashed( ActTestLib_Launcher::current_temp_dir_files() ) + "externalPayloads3.cbf").c_str();
+
+  Handle(ActTest_DummyModel) M5 = new ActTest_DummyModel;
+  ACT_VERIFY( M5->NewEmpty() )
+
+  Handle(ActTest_StubMeshNode)
+    aMeshNode5 = Handle(ActTest_StubMeshNode)::DownCast( ActTest_StubMeshNode::Instance() );
+
+  M5->OpenCommand();
+  {
+    M5->StubMeshPartition()->AddNode(aMeshNode5);
+    aMeshNode5->Init(aMesh);
+  }
+  M5->CommitCommand();
+
+  ACT_VERIFY( M5->SaveAs(aFilename3) )
+  ACT_VERIFY( M5->GetPayloadStore().IsNull() )
+  ACT_VERIFY( !std::ifstream( (aFilename3 + ".adp").ToCString() ).is_open() )
+  ACT_VERIFY( M4->GetPayloadStore()->NbPayloads() == 1 )
+
+  M5->Release();
+  M4->Release();
+  return true;
+}